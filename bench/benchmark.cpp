@@ -0,0 +1,63 @@
+/***********************************************************************
+* benchmark.cpp - Allocation counter for the FINAL CUT benchmarks      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstdlib>
+#include <new>
+
+#include "benchmark.h"
+
+namespace bench
+{
+
+namespace internal
+{
+
+std::atomic<uInt64> var::allocations{0};
+volatile std::size_t var::sink{0};
+
+}  // namespace internal
+
+}  // namespace bench
+
+// Counting replacement of the global allocation functions
+//----------------------------------------------------------------------
+auto operator new (std::size_t size) -> void*
+{
+  bench::internal::var::allocations++;
+
+  if ( void* ptr = std::malloc(size ? size : 1) )
+    return ptr;
+
+  throw std::bad_alloc{};
+}
+
+//----------------------------------------------------------------------
+void operator delete (void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+//----------------------------------------------------------------------
+void operator delete (void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
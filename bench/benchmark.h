@@ -0,0 +1,165 @@
+/***********************************************************************
+* benchmark.h - Benchmark harness for the FINAL CUT benchmarks         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+// Each benchmark is run once for warm-up and then REPETITIONS times.
+// The median time per operation is reported together with the bytes
+// the operation emitted and the number of heap allocations. Results
+// are written as one JSON object per line to stdout and as a table
+// to stderr.
+//
+// benchmark.cpp replaces the global operator new to count the
+// allocations. Each benchmark program has to link it.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <final/final.h>
+
+namespace bench
+{
+
+namespace internal
+{
+
+struct var
+{
+  static std::atomic<uInt64> allocations;
+  static volatile std::size_t sink;
+};
+
+}  // namespace internal
+
+// Keeps the compiler from optimizing away an unused result
+//----------------------------------------------------------------------
+inline void keep (std::size_t value)
+{
+  internal::var::sink = value;
+}
+
+
+//----------------------------------------------------------------------
+// class Benchmark
+//----------------------------------------------------------------------
+
+class Benchmark final
+{
+  public:
+    // Constructor
+    explicit Benchmark (std::string name)
+      : suite{std::move(name)}
+    { }
+
+    // Methods
+    template <typename Func>
+    void run (const std::string&, std::size_t, Func&&);
+
+  private:
+    // Constants
+    static constexpr std::size_t REPETITIONS = 5;
+
+    // Methods
+    static auto escape (const std::string&) -> std::string;
+
+    // Data member
+    std::string suite{};
+};
+
+//----------------------------------------------------------------------
+template <typename Func>
+void Benchmark::run (const std::string& name, std::size_t iterations, Func&& func)
+{
+  // Func is called once per operation and returns the number
+  // of bytes it has emitted (0 if no output is produced)
+
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  std::array<double, REPETITIONS> ns_per_op{};
+  uInt64 bytes{0};
+  uInt64 allocations{0};
+
+  for (std::size_t i{0}; i < std::max(iterations / 10, std::size_t(1)); i++)
+    func();  // Warm-up
+
+  for (auto& result : ns_per_op)
+  {
+    bytes = 0;
+    const auto alloc_start = internal::var::allocations.load();
+    const auto start = steady_clock::now();
+
+    for (std::size_t i{0}; i < iterations; i++)
+      bytes += uInt64(func());
+
+    const auto end = steady_clock::now();
+    allocations = internal::var::allocations.load() - alloc_start;
+    result = duration<double, std::nano>(end - start).count()
+           / double(iterations);
+  }
+
+  std::sort (ns_per_op.begin(), ns_per_op.end());
+  const auto median = ns_per_op[REPETITIONS / 2];
+  const auto bytes_per_op = double(bytes) / double(iterations);
+  const auto allocs_per_op = double(allocations) / double(iterations);
+
+  std::cout << std::fixed << std::setprecision(3)
+            << "{\"suite\": \"" << escape(suite) << "\""
+            << ", \"name\": \"" << escape(name) << "\""
+            << ", \"iterations\": " << iterations
+            << ", \"ns_per_op\": " << median
+            << ", \"bytes_per_op\": " << bytes_per_op
+            << ", \"allocs_per_op\": " << allocs_per_op
+            << "}" << std::endl;
+  std::cerr << std::fixed << std::setprecision(1)
+            << std::left << std::setw(36) << name << std::right
+            << std::setw(14) << median << " ns/op"
+            << std::setw(12) << bytes_per_op << " bytes/op"
+            << std::setw(10) << allocs_per_op << " allocs/op\n";
+}
+
+//----------------------------------------------------------------------
+inline auto Benchmark::escape (const std::string& str) -> std::string
+{
+  std::string escaped{};
+
+  for (const auto& ch : str)
+  {
+    if ( ch == '"' || ch == '\\' )
+      escaped += '\\';
+
+    escaped += ch;
+  }
+
+  return escaped;
+}
+
+}  // namespace bench
+
+#endif  // BENCHMARK_H
@@ -0,0 +1,486 @@
+/***********************************************************************
+* micro-bench.cpp - Microbenchmarks of the FINAL CUT core classes      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <clocale>
+#include <string>
+
+#include "benchmark.h"
+
+using finalcut::FChar;
+using finalcut::FColor;
+using finalcut::FPoint;
+using finalcut::FRect;
+using finalcut::FSize;
+using finalcut::FString;
+
+//----------------------------------------------------------------------
+// class VTermBench
+//----------------------------------------------------------------------
+
+class VTermBench final : public finalcut::FVTerm
+{
+  public:
+    // Constructor
+    VTermBench();
+
+    // Accessor
+    static auto getOutput() -> finalcut::FHeadlessOutput*;
+
+    // Methods
+    void addLayerTest (bench::Benchmark&);
+    void addTransparentLayerTest (bench::Benchmark&);
+    void addLargeLayerTest (bench::Benchmark&);
+    void copyAreaTest (bench::Benchmark&);
+    void updateTerminalTest (bench::Benchmark&);
+
+  private:
+    // Methods
+    static void fillArea (FTermArea*, wchar_t);
+    static void markAreaChanged (FTermArea*);
+};
+
+//----------------------------------------------------------------------
+VTermBench::VTermBench()
+  : finalcut::FVTerm{finalcut::outputClass<finalcut::FHeadlessOutput>{}}
+{
+  initTerminal();
+}
+
+//----------------------------------------------------------------------
+auto VTermBench::getOutput() -> finalcut::FHeadlessOutput*
+{
+  return static_cast<finalcut::FHeadlessOutput*>(getFOutput().get());
+}
+
+//----------------------------------------------------------------------
+void VTermBench::addLayerTest (bench::Benchmark& b)
+{
+  // Adds a 60 × 20 window to the virtual terminal
+
+  auto area = createArea(FRect{FPoint{10, 2}, FSize{60, 20}});
+  area->visible = true;
+  fillArea (area.get(), L'A');
+
+  b.run ( "FVTerm::addLayer", 20'000
+        , [this, &area] ()
+          {
+            markAreaChanged (area.get());
+            addLayer (area.get());
+            return 0;
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void VTermBench::addTransparentLayerTest (bench::Benchmark& b)
+{
+  // Adds a 60 × 20 window with a shadow and a transparent
+  // 10-column gap in each line to the virtual terminal
+
+  auto area = createArea(FRect{FPoint{10, 2}, FSize{60, 20}}, FSize{2, 1});
+  area->visible = true;
+  fillArea (area.get(), L'C');
+  const int full_width = area->width + area->right_shadow;
+  const int full_height = area->height + area->bottom_shadow;
+
+  for (auto y{0}; y < full_height; y++)
+  {
+    uInt trans_count{0};
+
+    for (auto x{0}; x < full_width; x++)
+    {
+      auto& fchar = area->getFChar(x, y);
+      const bool is_shadow = x >= area->width || y >= area->height;
+      const bool is_gap = x >= 25 && x < 35;
+
+      if ( ! is_shadow && ! is_gap )
+        continue;
+
+      if ( is_gap || (y == 0 && is_shadow) || (x < 2 && y == area->height) )
+        fchar.attr.bit.transparent = true;
+      else
+        fchar.attr.bit.color_overlay = true;
+
+      trans_count++;
+    }
+
+    area->changes[unsigned(y)].trans_count = trans_count;
+  }
+
+  b.run ( "FVTerm::addLayer (transparent)", 20'000
+        , [this, &area, full_width] ()
+          {
+            for (auto&& line_changes : area->changes)
+            {
+              line_changes.xmin = 0;
+              line_changes.xmax = uInt(full_width - 1);
+            }
+
+            area->has_changes = true;
+            addLayer (area.get());
+            return 0;
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void VTermBench::addLargeLayerTest (bench::Benchmark& b)
+{
+  // Adds a 398 × 119 window with a shadow to a 400 × 120 virtual
+  // terminal, serially and in row bands on 3 worker threads
+
+  const auto vterm = getVirtualTerminal();
+  const FSize term_size{std::size_t(vterm->width), std::size_t(vterm->height)};
+  resizeVTerm (FSize{400, 120});
+  auto area = createArea(FRect{FPoint{0, 0}, FSize{398, 119}}, FSize{2, 1});
+  area->visible = true;
+  fillArea (area.get(), L'D');
+  const int full_width = area->width + area->right_shadow;
+  const int full_height = area->height + area->bottom_shadow;
+
+  for (auto y{0}; y < full_height; y++)
+  {
+    uInt trans_count{0};
+
+    for (auto x{0}; x < full_width; x++)
+    {
+      if ( x < area->width && y < area->height )
+        continue;
+
+      area->getFChar(x, y).attr.bit.color_overlay = true;
+      trans_count++;
+    }
+
+    area->changes[unsigned(y)].trans_count = trans_count;
+  }
+
+  const auto add_layer = [this, &area, full_width] ()
+  {
+    for (auto&& line_changes : area->changes)
+    {
+      line_changes.xmin = 0;
+      line_changes.xmax = uInt(full_width - 1);
+    }
+
+    area->has_changes = true;
+    addLayer (area.get());
+    return 0;
+  };
+
+  b.run ("FVTerm::addLayer (400x120)", 500, add_layer);
+  setCompositingThreads (3);
+  b.run ("FVTerm::addLayer (400x120, 3 threads)", 500, add_layer);
+  setCompositingThreads (0);
+  resizeVTerm (term_size);
+}
+
+//----------------------------------------------------------------------
+void VTermBench::copyAreaTest (bench::Benchmark& b)
+{
+  // Copies a 40 × 10 area into a 80 × 24 area
+
+  auto dst = createArea(FRect{FPoint{0, 0}, FSize{80, 24}});
+  auto src = createArea(FRect{FPoint{0, 0}, FSize{40, 10}});
+  fillArea (src.get(), L'B');
+
+  b.run ( "FVTerm::copyArea", 50'000
+        , [this, &dst, &src] ()
+          {
+            copyArea (dst.get(), FPoint{20, 8}, src.get());
+            return 0;
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void VTermBench::updateTerminalTest (bench::Benchmark& b)
+{
+  // Encodes a full-screen frame with alternating content.
+  // FTermOutput requires a terminal, so the headless output
+  // measures the frame encoding instead.
+
+  auto vterm = getVirtualTerminal();
+  auto output = getOutput();
+  wchar_t ch{L'a'};
+
+  b.run ( "FOutput::updateTerminal (headless)", 2'000
+        , [&vterm, &output, &ch] ()
+          {
+            ch = ( ch == L'a' ) ? L'b' : L'a';
+            fillArea (vterm, ch);
+            markAreaChanged (vterm);
+            output->updateTerminal();
+            output->flush();
+            return output->getLastFrameBytes();
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void VTermBench::fillArea (FTermArea* area, wchar_t fillchar)
+{
+  FChar fchar{};
+  fchar.ch[0] = fillchar;
+  fchar.fg_color = FColor::White;
+  fchar.bg_color = FColor::Blue;
+  fchar.attr.bit.char_width = 1;
+  std::fill (area->data.begin(), area->data.end(), fchar);
+}
+
+//----------------------------------------------------------------------
+void VTermBench::markAreaChanged (FTermArea* area)
+{
+  for (auto y{0}; y < area->height; y++)
+  {
+    area->changes[unsigned(y)].xmin = 0;
+    area->changes[unsigned(y)].xmax = uInt(area->width - 1);
+  }
+
+  area->has_changes = true;
+}
+
+
+//----------------------------------------------------------------------
+//                        standalone benchmarks
+//----------------------------------------------------------------------
+void changeAttributeTest (bench::Benchmark& b)
+{
+  // Simulate an xterm-256color terminal
+
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (256);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode ("\033[1m");
+  oa.set_exit_bold_mode ("\033[22m");
+  oa.set_enter_dim_mode ("\033[2m");
+  oa.set_exit_dim_mode ("\033[22m");
+  oa.set_enter_italics_mode ("\033[3m");
+  oa.set_exit_italics_mode ("\033[23m");
+  oa.set_enter_underline_mode ("\033[4m");
+  oa.set_exit_underline_mode ("\033[24m");
+  oa.set_enter_reverse_mode ("\033[7m");
+  oa.set_exit_reverse_mode ("\033[27m");
+  oa.set_exit_attribute_mode ("\033[0m");
+  oa.set_a_foreground_color ( "\033[%?%p1%{8}%<%t3%p1%d%e%p1%{16}%<"
+                              "%t9%p1%{8}%-%d%e38;5;%p1%d%;m" );
+  oa.set_a_background_color ( "\033[%?%p1%{8}%<%t4%p1%d%e%p1%{16}%<"
+                              "%t10%p1%{8}%-%d%e48;5;%p1%d%;m" );
+  oa.set_orig_pair ("\033[39;49m");
+  oa.initialize();
+
+  std::array<FChar, 4> attributes{};
+  attributes[0].fg_color = FColor::Default;
+  attributes[0].bg_color = FColor::Default;
+  attributes[1].fg_color = FColor::Yellow;
+  attributes[1].bg_color = FColor::Blue;
+  attributes[1].attr.bit.bold = true;
+  attributes[2].fg_color = FColor::Black;
+  attributes[2].bg_color = FColor::LightGray;
+  attributes[2].attr.bit.underline = true;
+  attributes[3].fg_color = FColor(196);
+  attributes[3].bg_color = FColor(236);
+  attributes[3].attr.bit.reverse = true;
+  FChar term{};
+  std::size_t n{0};
+
+  b.run ( "FOptiAttr::changeAttribute", 200'000
+        , [&oa, &attributes, &term, &n] ()
+          {
+            auto next = attributes[n++ % attributes.size()];
+            return oa.changeAttribute(term, next).length();
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void moveCursorTest (bench::Benchmark& b)
+{
+  // Simulate an xterm terminal
+
+  finalcut::FOptiMove om;
+  om.setTermSize (80, 25);
+  om.setBaudRate (38400);
+  om.setTabStop (8);
+  om.set_eat_newline_glitch (true);
+  om.set_tabular ("\t");
+  om.set_back_tab ("\033[Z");
+  om.set_cursor_home ("\033[H");
+  om.set_carriage_return ("\r");
+  om.set_cursor_up ("\033[A");
+  om.set_cursor_down ("\n");
+  om.set_cursor_right ("\033[C");
+  om.set_cursor_left ("\b");
+  om.set_cursor_address ("\033[%i%p1%d;%p2%dH");
+  om.set_column_address ("\033[%i%p1%dG");
+  om.set_row_address ("\033[%i%p1%dd");
+  om.set_parm_up_cursor ("\033[%p1%dA");
+  om.set_parm_down_cursor ("\033[%p1%dB");
+  om.set_parm_right_cursor ("\033[%p1%dC");
+  om.set_parm_left_cursor ("\033[%p1%dD");
+  int x{0};
+  int y{0};
+
+  b.run ( "FOptiMove::moveCursor", 200'000
+        , [&om, &x, &y] ()
+          {
+            const int xnew = (x * 7 + 13) % 80;
+            const int ynew = (y * 5 + 3) % 25;
+            const auto length = om.moveCursor(x, y, xnew, ynew).length();
+            x = xnew;
+            y = ynew;
+            return length;
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void keyboardTest (bench::Benchmark& b)
+{
+  // Parses keys and escape sequences that are written into a pipe
+  // connected to stdin
+
+  std::array<int, 2> pipe_fd{{-1, -1}};
+
+  if ( pipe(pipe_fd.data()) != 0 )
+    return;
+
+  const int saved_stdin = dup(STDIN_FILENO);
+  dup2 (pipe_fd[0], STDIN_FILENO);
+  auto& keyboard = finalcut::FKeyboard::getInstance();
+  keyboard.setTermcapMap();
+  keyboard.enableUTF8();
+  std::size_t keys{0};
+  keyboard.setPressCommand (finalcut::FKeyboardCommand([&keys] () { keys++; }));
+  static const std::string input
+  {
+    "hello\033[A\033[B\033OP\033[1;5C\033[3~\033[15;2~\xc3\xa4\xe2\x82\xac\r"
+  };
+
+  b.run ( "FKeyboard::fetchKeyCode", 50'000
+        , [&keyboard, &pipe_fd] ()
+          {
+            if ( write(pipe_fd[1], input.data(), input.length()) < 0 )
+              return std::size_t(0);
+
+            keyboard.fetchKeyCode();
+
+            while ( keyboard.hasDataInQueue() )
+              keyboard.processQueuedInput();
+
+            return input.length();
+          }
+        );
+
+  dup2 (saved_stdin, STDIN_FILENO);
+  close (saved_stdin);
+  close (pipe_fd[0]);
+  close (pipe_fd[1]);
+}
+
+//----------------------------------------------------------------------
+void stringTest (bench::Benchmark& b)
+{
+  const std::string utf8{"Grüße aus der Konsole – «FINAL CUT» ✓"};
+  const FString wide{utf8};
+  const FString number{"-1234567"};
+
+  b.run ( "FString (UTF-8 to wide)", 200'000
+        , [&utf8] ()
+          {
+            const FString str{utf8};
+            bench::keep (str.getLength());
+            return 0;
+          }
+        );
+
+  b.run ( "FString::toString", 200'000
+        , [&wide] ()
+          {
+            bench::keep (wide.toString().length());
+            return 0;
+          }
+        );
+
+  b.run ( "FString::toInt", 200'000
+        , [&number] ()
+          {
+            bench::keep (std::size_t(number.toInt()));
+            return 0;
+          }
+        );
+}
+
+//----------------------------------------------------------------------
+void columnWidthTest (bench::Benchmark& b)
+{
+  const FString ascii{"The quick brown fox jumps over the lazy dog"};
+  const FString fullwidth{"全角文字と半角文字が混在するテキスト"};
+
+  b.run ( "getColumnWidth (ASCII)", 200'000
+        , [&ascii] ()
+          {
+            bench::keep (finalcut::getColumnWidth(ascii));
+            return 0;
+          }
+        );
+
+  b.run ( "getColumnWidth (full-width)", 200'000
+        , [&fullwidth] ()
+          {
+            bench::keep (finalcut::getColumnWidth(fullwidth));
+            return 0;
+          }
+        );
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main() -> int
+{
+  bench::Benchmark b{"micro"};
+
+  {
+    VTermBench vterm_bench{};
+    vterm_bench.addLayerTest(b);
+    vterm_bench.addTransparentLayerTest(b);
+    vterm_bench.addLargeLayerTest(b);
+    vterm_bench.copyAreaTest(b);
+    vterm_bench.updateTerminalTest(b);
+  }
+
+  // Reproducible string results independent of the user locale
+  std::setlocale (LC_ALL, "C.UTF-8");
+
+  changeAttributeTest(b);
+  moveCursorTest(b);
+  keyboardTest(b);
+  stringTest(b);
+  columnWidthTest(b);
+  return 0;
+}
@@ -0,0 +1,291 @@
+/***********************************************************************
+* scenario-bench.cpp - Benchmarks of typical user interactions         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <string>
+
+#include "benchmark.h"
+
+using finalcut::FKey;
+using finalcut::FPoint;
+using finalcut::FSize;
+using finalcut::FString;
+
+//----------------------------------------------------------------------
+// class ScenarioDialog
+//----------------------------------------------------------------------
+
+class ScenarioDialog final : public finalcut::FDialog
+{
+  public:
+    // Constructor
+    explicit ScenarioDialog (finalcut::FWidget* = nullptr);
+
+    // Accessor
+    static auto getOutput() -> finalcut::FHeadlessOutput*;
+
+    // Method
+    auto frame() const -> std::size_t;
+};
+
+//----------------------------------------------------------------------
+ScenarioDialog::ScenarioDialog (finalcut::FWidget* parent)
+  : finalcut::FDialog{parent}
+{ }
+
+//----------------------------------------------------------------------
+auto ScenarioDialog::getOutput() -> finalcut::FHeadlessOutput*
+{
+  return static_cast<finalcut::FHeadlessOutput*>(getFOutput().get());
+}
+
+//----------------------------------------------------------------------
+auto ScenarioDialog::frame() const -> std::size_t
+{
+  // Outputs the pending changes and returns the frame size in bytes
+
+  forceTerminalUpdate();
+  return getOutput()->getLastFrameBytes();
+}
+
+
+//----------------------------------------------------------------------
+//                              scenarios
+//----------------------------------------------------------------------
+void windowDragTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Drags a dialog horizontally across the desktop
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("Window drag");
+  dialog.setGeometry (FPoint{2, 3}, FSize{36, 12});
+  finalcut::FLabel label{"Dragged with the mouse", &dialog};
+  label.setGeometry (FPoint{2, 2}, FSize{30, 1});
+  dialog.show();
+  dialog.frame();
+  int step{1};
+
+  b.run ( "scenario: window drag", 2'000
+        , [&dialog, &step] ()
+          {
+            const int x = dialog.getX();
+
+            if ( x + step < 1 || x + step > 44 )
+              step = -step;
+
+            dialog.move (FPoint{step, 0});
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+//----------------------------------------------------------------------
+void listScrollTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Scrolls through a list box with the cursor keys
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("List scroll");
+  dialog.setGeometry (FPoint{2, 2}, FSize{44, 20});
+  finalcut::FListBox list{&dialog};
+  list.setGeometry (FPoint{2, 1}, FSize{40, 16});
+
+  for (auto i{1}; i <= 1000; i++)
+    list.insert (FString("List entry ") << i);
+
+  dialog.show();
+  dialog.frame();
+  FKey key{FKey::Down};
+
+  b.run ( "scenario: list scroll", 5'000
+        , [&dialog, &list, &key] ()
+          {
+            if ( list.currentItem() == list.getCount() )
+              key = FKey::Up;
+            else if ( list.currentItem() == 1 )
+              key = FKey::Down;
+
+            finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+            list.onKeyPress (&ev);
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+//----------------------------------------------------------------------
+void virtualListScrollTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Pages through ten million virtual list box rows
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("Virtual list scroll");
+  dialog.setGeometry (FPoint{2, 2}, FSize{44, 20});
+  finalcut::FListBox list{&dialog};
+  list.setGeometry (FPoint{2, 1}, FSize{40, 16});
+  list.setVirtualRows ( 10'000'000
+                      , [] (std::size_t row)
+                        {
+                          return FString("Virtual entry ") << row + 1;
+                        }
+                      , 64 );
+  dialog.show();
+  dialog.frame();
+  FKey key{FKey::Page_down};
+
+  b.run ( "scenario: virtual list scroll", 5'000
+        , [&dialog, &list, &key] ()
+          {
+            if ( list.currentItem() == list.getCount() )
+              key = FKey::Page_up;
+            else if ( list.currentItem() == 1 )
+              key = FKey::Page_down;
+
+            finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+            list.onKeyPress (&ev);
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+//----------------------------------------------------------------------
+void listViewSortTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Sorts a large list view alternately by name and by number
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("List view sort");
+  dialog.setGeometry (FPoint{2, 2}, FSize{44, 20});
+  finalcut::FListView list_view{&dialog};
+  list_view.setGeometry (FPoint{2, 1}, FSize{40, 16});
+  list_view.addColumn ("Name");
+  list_view.addColumn ("Size");
+  list_view.setColumnSortType (2, finalcut::SortType::Number);
+
+  for (auto i{0}; i < 50'000; i++)
+    list_view.insert ({ FString("File ") << (i * 7919) % 50'000
+                      , FString() << (i * 104'729) % 1'000'000 << " kB" });
+
+  dialog.show();
+  dialog.frame();
+  int column{1};
+
+  b.run ( "scenario: list view sort", 10
+        , [&dialog, &list_view, &column] ()
+          {
+            column = 3 - column;
+            list_view.setColumnSort (column, finalcut::SortOrder::Ascending);
+            list_view.sort();
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+//----------------------------------------------------------------------
+void textViewAppendTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Appends log lines to a text view that follows the end
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("Text view append");
+  dialog.setGeometry (FPoint{2, 2}, FSize{70, 20});
+  finalcut::FTextView text_view{&dialog};
+  text_view.setGeometry (FPoint{1, 1}, FSize{68, 18});
+  dialog.show();
+  dialog.frame();
+  std::size_t line{0};
+
+  b.run ( "scenario: text view append", 5'000
+        , [&dialog, &text_view, &line] ()
+          {
+            text_view.append (FString("Log message ") << ++line
+                                                     << ": operation completed");
+            text_view.scrollToEnd();
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+//----------------------------------------------------------------------
+void fullRepaintTest (finalcut::FWidget* parent, bench::Benchmark& b)
+{
+  // Repaints the whole content of a full-screen dialog with
+  // alternating characters and colors (frames/s = 1e9 / ns per op)
+
+  ScenarioDialog dialog{parent};
+  dialog.setText ("Full-screen repaint");
+  dialog.setGeometry (FPoint{1, 1}, FSize{80, 24});
+  dialog.show();
+  dialog.frame();
+  const FString line(78, L'#');
+  const FString alt_line(78, L'*');
+  int n{0};
+
+  b.run ( "scenario: full-screen repaint", 2'000
+        , [&dialog, &line, &alt_line, &n] ()
+          {
+            n++;
+            dialog.setColor (finalcut::FColor(n % 16), finalcut::FColor::Black);
+
+            for (auto y{1}; y <= 22; y++)
+            {
+              dialog.setPrintPos (FPoint{2, y + 1});
+              dialog.print ((n % 2) ? alt_line : line);
+            }
+
+            return dialog.frame();
+          }
+        );
+
+  dialog.hide();
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  // The first FVTerm object selects the output of the application
+  finalcut::FVTerm headless{finalcut::outputClass<finalcut::FHeadlessOutput>{}};
+  bench::Benchmark b{"scenario"};
+
+  {  // Create the application object in this scope
+    finalcut::FApplication app{argc, argv};
+    windowDragTest (&app, b);
+    listScrollTest (&app, b);
+    virtualListScrollTest (&app, b);
+    listViewSortTest (&app, b);
+    textViewAppendTest (&app, b);
+    fullRepaintTest (&app, b);
+  }  // Hide and destroy the application object
+
+  return 0;
+}
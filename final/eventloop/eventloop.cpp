@@ -37,66 +37,77 @@ auto EventLoop::run() -> int
 
   do
   {
-    nfds_t fd_count = 0;
-    monitors_changed = false;
+    processNextEvents (WAIT_INDEFINITELY);
+  }
+  while ( running );
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto EventLoop::processNextEvents (int timeout) -> bool
+{
+  // Waits up to timeout milliseconds for monitor events and
+  // dispatches them. Returns true if at least one monitor was triggered.
+
+  nfds_t fd_count = 0;
+  monitors_changed = false;
 
-    for (Monitor* monitor : monitors)
+  for (Monitor* monitor : monitors)
+  {
+    if ( monitor->isActive() )
     {
-      if ( monitor->isActive() )
-      {
-        fds[fd_count] = { monitor->getFd(), monitor->getEvents(), 0 };
-        lookup_table[fd_count] = monitor;
-        fd_count++;
-      }
-
-      if ( fd_count >= MAX_MONITORS )
-        break;
+      fds[fd_count] = { monitor->getFd(), monitor->getEvents(), 0 };
+      lookup_table[fd_count] = monitor;
+      fd_count++;
     }
 
-    int poll_result{};
+    if ( fd_count >= MAX_MONITORS )
+      break;
+  }
 
-    while ( true )
-    {
-      poll_result = poll(fds.data(), fd_count, WAIT_INDEFINITELY);
+  int poll_result{};
 
-      if ( poll_result != -1 || errno != EINTR )
-        break;
-    }
+  while ( true )
+  {
+    poll_result = poll(fds.data(), fd_count, timeout);
 
-    if ( poll_result == -1 )
-    {
-      std::cerr << "Arghh! " << errno << std::endl;
-      continue;
-    }
+    if ( poll_result != -1 || errno != EINTR )
+      break;
+  }
 
-    if ( poll_result <= 0 )
-      continue;
+  if ( poll_result == -1 )
+  {
+    std::cerr << "Arghh! " << errno << std::endl;
+    return false;
+  }
 
-    nfds_t processed_fds{0};
+  if ( poll_result <= 0 )
+    return false;
 
-    for (nfds_t index{0}; index < fd_count; index++)
-    {
-      bool leave{false};
-      const pollfd& current_fd = fds[index];
+  nfds_t processed_fds{0};
 
-      if ( current_fd.revents == 0
-        || ! (current_fd.revents & current_fd.events) )
-        continue;
+  for (nfds_t index{0}; index < fd_count; index++)
+  {
+    bool leave{false};
+    const pollfd& current_fd = fds[index];
 
-      lookup_table[index]->trigger(current_fd.revents);
+    if ( current_fd.revents == 0
+      || ! (current_fd.revents & current_fd.events) )
+      continue;
 
-      if ( monitors_changed || ! running )
-        leave = true;
+    lookup_table[index]->trigger(current_fd.revents);
 
-      ++processed_fds;
+    if ( monitors_changed || ! running )
+      leave = true;
 
-      if ( leave || int(processed_fds) == poll_result )
-        break;
-    }
+    ++processed_fds;
+
+    if ( leave || int(processed_fds) == poll_result )
+      break;
   }
-  while ( running );
 
-  return 0;
+  return processed_fds > 0;
 }
 
 //----------------------------------------------------------------------
@@ -43,17 +43,20 @@ namespace finalcut
 class EventLoop
 {
   public:
+    // Constant
+    static constexpr int WAIT_INDEFINITELY{-1};
+
     // Constructor
     EventLoop() = default;
 
     // Methods
     auto run() -> int;
+    auto processNextEvents (int = WAIT_INDEFINITELY) -> bool;
     void leave();
 
   private:
-    // Constants
+    // Constant
     static constexpr nfds_t MAX_MONITORS{50};
-    static constexpr int WAIT_INDEFINITELY{-1};
 
     // Methods
     void addMonitor (Monitor*);
@@ -20,7 +20,11 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -29,6 +33,9 @@
 #include <thread>
 
 #include "final/dialog/fmessagebox.h"
+#include "final/eventloop/eventloop.h"
+#include "final/eventloop/io_monitor.h"
+#include "final/eventloop/signal_monitor.h"
 #include "final/fapplication.h"
 #include "final/fevent.h"
 #include "final/fstartoptions.h"
@@ -234,6 +241,7 @@ auto FApplication::sendEvent (FObject* receiver, FEvent* event ) -> bool
     return false;
 
   // Sends the event event directly to receiver
+  getRenderStatistics().count(FRenderStatistics::Counter::Events);
   const auto& ret = receiver->event(event);
   setSend(*event);
   return ret;
@@ -306,8 +314,11 @@ void FApplication::registerMouseHandler (const FMouseHandler& fn)
 //----------------------------------------------------------------------
 void FApplication::initTerminal()
 {
-  if ( ! isQuit() )
-    FWidget::initTerminal();
+  if ( isQuit() )
+    return;
+
+  FWidget::initTerminal();
+  initEventLoop();
 }
 
 //----------------------------------------------------------------------
@@ -419,14 +430,17 @@ void FApplication::init()
   auto cmd2 = [this] () { this->keyReleased(); };
   auto cmd3 = [this] () { this->escapeKeyPressed(); };
   auto cmd4 = [this] () { this->mouseTracking(); };
+  auto cmd5 = [this] () { this->pasteText(); };
   FKeyboardCommand key_cmd1 (cmd1);
   FKeyboardCommand key_cmd2 (cmd2);
   FKeyboardCommand key_cmd3 (cmd3);
   FKeyboardCommand key_cmd4 (cmd4);
+  FKeyboardCommand key_cmd5 (cmd5);
   keyboard.setPressCommand (key_cmd1);
   keyboard.setReleaseCommand (key_cmd2);
   keyboard.setEscPressedCommand (key_cmd3);
   keyboard.setMouseTrackingCommand (key_cmd4);
+  keyboard.setPasteCommand (key_cmd5);
   // Set the keyboard keypress timeout
   keyboard.setKeypressTimeout (key_timeout);
 
@@ -449,6 +463,50 @@ void FApplication::init()
     getLog()->setLineEnding(FLog::LineEnding::CRLF);
 }
 
+//----------------------------------------------------------------------
+void FApplication::initEventLoop()
+{
+  // Wait for keyboard input and terminal resizing with poll()
+  // instead of checking stdin at short intervals
+
+  if ( event_loop )
+    return;
+
+  auto stdin_handler = [] (const Monitor*, short)
+  {
+    static auto& keyboard = FKeyboard::getInstance();
+    keyboard.setPendingInput();
+  };
+
+  auto sigwinch_handler = [] (const Monitor*, short)
+  {
+    static auto& fterm_data = FTermData::getInstance();
+    fterm_data.setTermResized(true);
+  };
+
+  try
+  {
+    event_loop = std::make_unique<EventLoop>();
+    stdin_monitor = std::make_unique<IoMonitor>(event_loop.get());
+    stdin_monitor->init (FTermios::getStdIn(), POLLIN, stdin_handler, nullptr);
+    // Replaces the SIGWINCH handler of FTerm while the monitor exists
+    sigwinch_monitor = std::make_unique<SignalMonitor>(event_loop.get());
+    sigwinch_monitor->init (SIGWINCH, sigwinch_handler, nullptr);
+  }
+  catch (const std::exception& ex)
+  {
+    // Fall back to checking stdin at short intervals
+    getLog()->warn(std::string("Event loop not available: ") + ex.what());
+    sigwinch_monitor.reset();
+    stdin_monitor.reset();
+    event_loop.reset();
+    return;
+  }
+
+  stdin_monitor->resume();
+  sigwinch_monitor->resume();
+}
+
 //----------------------------------------------------------------------
 void FApplication::setTerminalEncoding (const FString& enc_str)
 {
@@ -480,13 +538,19 @@ inline auto FApplication::getLongOptions() -> const std::vector<CmdOption>&
   {
     {"encoding",                 required_argument, nullptr,  'e' },
     {"log-file",                 required_argument, nullptr,  'l' },
+    {"compositing-threads",      required_argument, nullptr,  'T' },
+    {"render-statistics",        no_argument,       nullptr,  'R' },
+    {"max-frame-rate",           required_argument, nullptr,  'F' },
     {"no-mouse",                 no_argument,       nullptr,  'm' },
     {"no-optimized-cursor",      no_argument,       nullptr,  'o' },
     {"no-terminal-detection",    no_argument,       nullptr,  'd' },
+    {"terminal-detection-cache", no_argument,       nullptr,  'D' },
     {"no-terminal-data-request", no_argument,       nullptr,  'r' },
     {"no-terminal-focus-events", no_argument,       nullptr,  'f' },
+    {"no-bracketed-paste",       no_argument,       nullptr,  'p' },
     {"no-color-change",          no_argument,       nullptr,  'c' },
     {"no-sgr-optimizer",         no_argument,       nullptr,  's' },
+    {"no-synchronized-update",   no_argument,       nullptr,  'u' },
     {"vgafont",                  no_argument,       nullptr,  'v' },
     {"newfont",                  no_argument,       nullptr,  'n' },
     {"dark-theme",               no_argument,       nullptr,  't' },
@@ -514,20 +578,43 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['e'] = [enc] (const auto& arg) { enc(FString(arg)); };
   // --log-file
   cmd_map['l'] = [log] (const auto& arg) { log(FString(arg)); };
+  // --compositing-threads
+  cmd_map['T'] = [opt] (const auto& arg)
+  {
+    opt().compositing_threads = std::size_t(std::strtoul(arg, nullptr, 10));
+  };
+  // --render-statistics
+  cmd_map['R'] = [] (const auto&)
+  {
+    auto& render_statistics = FVTerm::getRenderStatistics();
+    render_statistics.setEnable();
+    render_statistics.setLogging();
+  };
+  // --max-frame-rate
+  cmd_map['F'] = [opt] (const auto& arg)
+  {
+    opt().max_frame_rate = uInt(std::strtoul(arg, nullptr, 10));
+  };
   // --no-mouse
   cmd_map['m'] = [opt] (const auto&) { opt().mouse_support = false; };
   // --no-optimized-cursor
   cmd_map['o'] = [opt] (const auto&) { opt().cursor_optimisation = false; };
   // --no-terminal-detection
   cmd_map['d'] = [opt] (const auto&) { opt().terminal_detection = false; };
+  // --terminal-detection-cache
+  cmd_map['D'] = [opt] (const auto&) { opt().terminal_detection_cache = true; };
   // --no-terminal-data-request
   cmd_map['r'] = [opt] (const auto&) { opt().terminal_data_request = false; };
   // --no-terminal-focus-events
   cmd_map['f'] = [opt] (const auto&) { opt().terminal_focus_events = false; };
+  // --no-bracketed-paste
+  cmd_map['p'] = [opt] (const auto&) { opt().bracketed_paste = false; };
   // --no-color-change
   cmd_map['c'] = [opt] (const auto&) { opt().color_change = false; };
   // --no-sgr-optimizer
   cmd_map['s'] = [opt] (const auto&) { opt().sgr_optimizer = false; };
+  // --no-synchronized-update
+  cmd_map['u'] = [opt] (const auto&) { opt().synchronized_update = false; };
   // --vgafont
   cmd_map['v'] = [opt] (const auto&) { opt().vgafont = true; };
   // --newfont
@@ -606,20 +693,32 @@ void FApplication::showParameterUsage()
     << "    {utf8, vt100, pc, ascii}\n"
     << "  --log-file=<FILE>         "
     << "    Writes log output to FILE\n"
+    << "  --compositing-threads=<N> "
+    << "    Composites large windows with N worker threads\n"
+    << "  --render-statistics       "
+    << "    Writes per-frame render statistics to the log\n"
+    << "  --max-frame-rate=<N>      "
+    << "    Updates the terminal at most N times per second\n"
     << "  --no-mouse                "
     << "    Disable mouse support\n"
     << "  --no-optimized-cursor     "
     << "    Disable cursor optimization\n"
     << "  --no-terminal-detection   "
     << "    Disable terminal detection\n"
+    << "  --terminal-detection-cache"
+    << "    Reuse the terminal replies of the last start\n"
     << "  --no-terminal-data-request"
     << "    Do not determine terminal font and title\n"
     << "  --no-terminal-focus-events"
     << "    Do not send focus-in and focus-out events\n"
+    << "  --no-bracketed-paste      "
+    << "    Do not receive pasted text in one piece\n"
     << "  --no-color-change         "
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
     << "    Do not optimize SGR sequences\n"
+    << "  --no-synchronized-update  "
+    << "    Do not output frames as synchronized updates\n"
     << "  --vgafont                 "
     << "    Set the standard vga 8x16 font\n"
     << "  --newfont                 "
@@ -690,6 +789,9 @@ inline auto FApplication::isKeyPressed(uInt64 ms) const -> bool
   if ( mouse.isGpmMouseEnabled() )
     return mouse.getGpmKeyPressed(keyboard.hasUnprocessedInput());
 
+  if ( event_loop )  // stdin is monitored by the event loop
+    return keyboard.hasPendingInput();
+
   return (keyboard.isKeyPressed(blocking_time) || keyboard.hasPendingInput());
 }
 
@@ -717,6 +819,16 @@ void FApplication::mouseTracking() const
   performMouseAction();
 }
 
+//----------------------------------------------------------------------
+void FApplication::pasteText() const
+{
+  // A widget without a paste event handler receives the
+  // pasted text as a sequence of key events
+
+  if ( ! sendPasteEvent(keyboard_widget) )
+    sendPasteAsKeyEvents();
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::performKeyboardAction()
 {
@@ -812,6 +924,38 @@ inline auto FApplication::sendKeyUpEvent (FWidget* widget) const -> bool
   return k_up_ev.isAccepted();
 }
 
+//----------------------------------------------------------------------
+inline auto FApplication::sendPasteEvent (FWidget* widget) const -> bool
+{
+  // Send paste event
+  static const auto& keyboard = FKeyboard::getInstance();
+  FPasteEvent paste_ev (Event::Paste, keyboard.getPasteText());
+  sendEvent (widget, &paste_ev);
+  return paste_ev.isAccepted();
+}
+
+//----------------------------------------------------------------------
+void FApplication::sendPasteAsKeyEvents() const
+{
+  static const auto& keyboard = FKeyboard::getInstance();
+
+  for (const auto& ch : keyboard.getPasteText())
+  {
+    if ( quit_now || internal::var::exit_loop )
+      return;
+
+    // A key event can change the focus
+    findKeyboardWidget();
+    const auto key = ( ch == L'\n' ) ? FKey::Return : FKey(ch);
+    FKeyEvent k_down_ev (Event::KeyDown, key);
+    sendEvent (keyboard_widget, &k_down_ev);
+    FKeyEvent k_press_ev (Event::KeyPress, key);
+    sendEvent (keyboard_widget, &k_press_ev);
+    FKeyEvent k_up_ev (Event::KeyUp, key);
+    sendEvent (keyboard_widget, &k_up_ev);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::sendKeyboardAccelerator()
 {
@@ -1241,7 +1385,8 @@ void FApplication::sendWheelEvent ( const FMouseData& md
   FWheelEvent wheel_ev ( Event::MouseWheel
                        , widgetMousePos
                        , mouse_position
-                       , mouse_wheel );
+                       , mouse_wheel
+                       , md.getWheelDelta() );
   auto scroll_over_widget = clicked_widget;
   setClickedWidget(nullptr);
   sendEvent (scroll_over_widget, &wheel_ev);
@@ -1318,6 +1463,27 @@ void FApplication::processLogger() const
   logger->flush();
 }
 
+//----------------------------------------------------------------------
+void FApplication::processRenderStatistics() const
+{
+  // Completes the statistics of this frame and streams them to the log
+
+  auto& render_statistics = getRenderStatistics();
+
+  if ( ! render_statistics.isEnabled() )
+    return;
+
+  const auto frame_count = render_statistics.getFrameCount();
+  render_statistics.finishFrame();
+
+  if ( render_statistics.isLogging()
+    && render_statistics.getFrameCount() != frame_count )
+  {
+    const auto& frame = render_statistics.getLastFrame();
+    getLog()->info(FRenderStatistics::toString(frame));
+  }
+}
+
 //----------------------------------------------------------------------
 auto FApplication::processNextEvent() -> bool
 {
@@ -1325,24 +1491,97 @@ auto FApplication::processNextEvent() -> bool
 
   if ( hasDataInQueue() || hasTerminalResized() || isNextEventTimeout() )
   {
+    using Phase = FRenderStatistics::Phase;
     time_last_event = FObjectTimer::getCurrentTime();
-    num_events += processTimerEvent();
-    processInput();
-    processResizeEvent();
-    processCloseWidget();
-    sendQueuedEvents();
-    processDialogResizeMove();
+
+    {
+      FRenderStatistics::FPhaseTimer phase_timer{Phase::Timer};
+      num_events += processTimerEvent();
+    }
+
+    {
+      FRenderStatistics::FPhaseTimer phase_timer{Phase::Input};
+      processInput();
+    }
+
+    {
+      FRenderStatistics::FPhaseTimer phase_timer{Phase::Event};
+      processResizeEvent();
+      processCloseWidget();
+      sendQueuedEvents();
+      processDialogResizeMove();
+    }
+
     processTerminalUpdate();  // after terminal changes
     flush();
+    processRenderStatistics();
     processLogger();
   }
-  else if ( isKeyPressed(next_event_wait) )
+  else
+    waitForNextEvent();
+
+  processExternalUserEvent();
+  return ( num_events > 0 );
+}
+
+//----------------------------------------------------------------------
+void FApplication::waitForNextEvent()
+{
+  // Sleeps until keyboard input arrives, the terminal is resized,
+  // or the next timer or keyboard timeout expires
+
+  static auto& mouse = FMouseControl::getInstance();
+
+  if ( ! event_loop || mouse.isGpmMouseEnabled() )
   {
+    if ( isKeyPressed(next_event_wait) )
+      time_last_event = TimeValue{};
+
+    return;
+  }
+
+  if ( event_loop->processNextEvents(getNextEventTimeout()) )
     time_last_event = TimeValue{};
+}
+
+//----------------------------------------------------------------------
+auto FApplication::getNextEventTimeout() const -> int
+{
+  // Returns the poll() timeout in milliseconds until the next
+  // event must be processed (-1 = no time-dependent event)
+
+  static const auto& keyboard = FKeyboard::getInstance();
+  const auto& foutput = FVTerm::getFOutput();
+
+  if ( hasDataInQueue() || eventInQueue() || foutput->hasTerminalResized() )
+    return 0;
+
+  const auto earliest = time_last_event + microseconds(next_event_wait);
+  auto deadline = FObjectTimer::getNextTimeout();
+
+  if ( keyboard.hasUnprocessedInput() )  // Incomplete key sequence
+  {
+    const auto key_timeout = microseconds(FKeyboard::getKeypressTimeout());
+    deadline = std::min(deadline, keyboard.getKeyPressedTime() + key_timeout);
   }
 
-  processExternalUserEvent();
-  return ( num_events > 0 );
+  if ( keyboard.hasPendingInput()  // Unread bytes in the keyboard buffer
+    || FVTerm::hasPendingTerminalUpdates() || foutput->hasPendingOutput() )
+    deadline = std::min(deadline, earliest);
+
+  if ( deadline == TimeValue::max() )
+    return EventLoop::WAIT_INDEFINITELY;
+
+  // Process events at most every next_event_wait µs
+  deadline = std::max(deadline, earliest);
+  const auto now = FObjectTimer::getCurrentTime();
+
+  if ( deadline <= now )
+    return 0;
+
+  // Round up so that the timeout has expired after waking up
+  const auto wait = duration_cast<milliseconds>(deadline - now).count() + 1;
+  return int(std::min(wait, milliseconds::rep(INT_MAX)));
 }
 
 //----------------------------------------------------------------------
@@ -1379,11 +1618,12 @@ auto FApplication::isEventProcessable ( FObject* receiver
       && ! window->getFlags().visibility.modal
       && ! window->isMenuWidget() )
     {
-      constexpr std::array<const Event, 13> blocked_events
+      constexpr std::array<const Event, 14> blocked_events
       {{
         Event::KeyPress,
         Event::KeyUp,
         Event::KeyDown,
+        Event::Paste,
         Event::MouseDown,
         Event::MouseUp,
         Event::MouseDoubleClick,
@@ -74,6 +74,7 @@ namespace finalcut
 {
 
 // class forward declaration
+class EventLoop;
 class FAccelEvent;
 class FCloseEvent;
 class FEvent;
@@ -88,6 +89,8 @@ class FWheelEvent;
 class FMouseControl;
 class FPoint;
 class FObject;
+class IoMonitor;
+class SignalMonitor;
 
 //----------------------------------------------------------------------
 // class FApplication
@@ -170,6 +173,7 @@ class FApplication : public FWidget
 
     // Methods
     void         init();
+    void         initEventLoop();
     static void  setTerminalEncoding (const FString&);
     static auto  getLongOptions() -> const std::vector<struct option>&;
     static void  setCmdOptionsMap (CmdMap&);
@@ -183,6 +187,7 @@ class FApplication : public FWidget
     void         keyReleased() const;
     void         escapeKeyPressed() const;
     void         mouseTracking() const;
+    void         pasteText() const;
     void         performKeyboardAction();
     void         performMouseAction() const;
     void         mouseEvent (const FMouseData&) const;
@@ -190,6 +195,8 @@ class FApplication : public FWidget
     auto         sendKeyDownEvent (FWidget*) const -> bool;
     auto         sendKeyPressEvent (FWidget*) const -> bool;
     auto         sendKeyUpEvent (FWidget*) const -> bool;
+    auto         sendPasteEvent (FWidget*) const -> bool;
+    void         sendPasteAsKeyEvents() const;
     void         sendKeyboardAccelerator();
     auto         hasDataInQueue() const -> bool;
     void         queuingKeyboardInput() const;
@@ -227,7 +234,10 @@ class FApplication : public FWidget
     void         processCloseWidget();
     void         processDialogResizeMove() const;
     void         processLogger() const;
+    void         processRenderStatistics() const;
     auto         processNextEvent() -> bool;
+    void         waitForNextEvent();
+    auto         getNextEventTimeout() const -> int;
     void         performTimerAction (FObject*, FEvent*) override;
     auto         hasTerminalResized() -> bool;
     static auto  isEventProcessable (FObject*, const FEvent*) -> bool;
@@ -240,6 +250,9 @@ class FApplication : public FWidget
     std::streambuf*   default_clog_rdbuf{std::clog.rdbuf()};
     FEventQueue       event_queue{};
     FMouseHandlerList mouse_handler_list{};
+    std::unique_ptr<EventLoop>     event_loop{};
+    std::unique_ptr<IoMonitor>     stdin_monitor{};
+    std::unique_ptr<SignalMonitor> sigwinch_monitor{};
     bool              has_terminal_resized{false};
     static uInt64     next_event_wait;
     static TimeValue  time_last_event;
@@ -79,6 +79,7 @@ enum class Event
   Hide,              // widget is hidden
   Close,             // widget close
   Timer,             // timer event occur
+  Paste,             // bracketed paste
   User               // user defined event
 };
 
@@ -705,6 +706,7 @@ enum class FKey : uInt32
   X11mouse                   = 0x02000020,  // xterm mouse
   Extended_mouse             = 0x02000021,  // SGR extended mouse
   Urxvt_mouse                = 0x02000022,  // urxvt mouse extension
+  Bracketed_paste            = 0x02000023,  // bracketed paste
   Meta_offset                = 0x020000e0,  // meta key offset
   Meta_tab                   = 0x020000e9,  // M-tab
   Meta_enter                 = 0x020000ea,  // M-enter
@@ -1544,6 +1546,7 @@ enum class Termcap
   t_cursor_style,
   t_scroll_forward,
   t_scroll_reverse,
+  t_change_scroll_region,
   t_enter_ca_mode,
   t_exit_ca_mode,
   t_enable_acs,
@@ -21,6 +21,8 @@
 ***********************************************************************/
 
 #include <cstdio>
+#include <utility>
+
 #include "final/fevent.h"
 
 namespace finalcut
@@ -138,18 +140,21 @@ void FMouseEvent::setTermPos (const FPoint& termPos)
 FWheelEvent::FWheelEvent ( Event ev_type  // constructor
                          , const FPoint& pos
                          , const FPoint& termPos
-                         , MouseWheel wheel )
+                         , MouseWheel wheel
+                         , int steps )
   : FEvent{ev_type}
   , p{pos}
   , tp{termPos}
   , w{wheel}
+  , delta{steps}
 { }
 
 //----------------------------------------------------------------------
 FWheelEvent::FWheelEvent ( Event ev_type  // constructor
                          , const FPoint& pos
-                         , MouseWheel wheel )
-  : FWheelEvent{ev_type, pos, FPoint{}, wheel}
+                         , MouseWheel wheel
+                         , int steps )
+  : FWheelEvent{ev_type, pos, FPoint{}, wheel, steps}
 { }
 
 //----------------------------------------------------------------------
@@ -180,6 +185,10 @@ auto FWheelEvent::getTermY() const -> int
 auto FWheelEvent::getWheel() const -> MouseWheel
 { return w; }
 
+//----------------------------------------------------------------------
+auto FWheelEvent::getDelta() const -> int
+{ return delta; }
+
 
 //----------------------------------------------------------------------
 // class FFocusEvent
@@ -322,6 +331,32 @@ auto FTimerEvent::getTimerId() const -> int
 { return id; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent (Event ev_type, FString paste_text)  // constructor
+  : FEvent{ev_type}
+  , text{std::move(paste_text)}
+{ }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::getText() const & -> const FString&
+{ return text; }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::isAccepted() const -> bool
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept()
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore()
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FUserEvent
 //----------------------------------------------------------------------
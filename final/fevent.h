@@ -68,6 +68,10 @@
  *      ├─────▏FTimerEvent ▏
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
+ *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *      ├─────▏FPasteEvent ▏
+ *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *      │
  *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▏
  *      └─────▏FUserEvent ▏- - - -▕ FData ▏
  *           ▕▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▏
@@ -87,6 +91,7 @@
 #include "final/ftypes.h"
 #include "final/util/fdata.h"
 #include "final/util/fpoint.h"
+#include "final/util/fstring.h"
 
 namespace finalcut
 {
@@ -171,8 +176,8 @@ class FMouseEvent : public FEvent  // mouse event
 class FWheelEvent : public FEvent  // wheel event
 {
   public:
-    FWheelEvent (Event, const FPoint&, MouseWheel);
-    FWheelEvent (Event, const FPoint&, const FPoint&, MouseWheel);
+    FWheelEvent (Event, const FPoint&, MouseWheel, int = 1);
+    FWheelEvent (Event, const FPoint&, const FPoint&, MouseWheel, int = 1);
 
     auto getPos() const & -> const FPoint&;
     auto getTermPos() const & -> const FPoint&;
@@ -181,11 +186,13 @@ class FWheelEvent : public FEvent  // wheel event
     auto getTermX() const -> int;
     auto getTermY() const -> int;
     auto getWheel() const -> MouseWheel;
+    auto getDelta() const -> int;
 
   private:
     FPoint     p{};
     FPoint     tp{};
     MouseWheel w{MouseWheel::None};
+    int        delta{1};  // number of wheel steps
 };
 
 
@@ -309,6 +316,26 @@ class FTimerEvent : public FEvent  // timer event
 };
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+class FPasteEvent : public FEvent  // paste event
+{
+  public:
+    FPasteEvent (Event, FString);
+
+    auto getText() const & -> const FString&;
+    auto isAccepted() const -> bool;
+    void accept();
+    void ignore();
+
+  private:
+    FString text{};
+    bool    accpt{false};  // reject by default
+};
+
+
 //----------------------------------------------------------------------
 // class FUserEvent
 //----------------------------------------------------------------------
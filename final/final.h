@@ -54,8 +54,10 @@
 #include <final/menu/fmenuitem.h>
 #include <final/menu/fradiomenuitem.h>
 #include <final/output/fcolorpalette.h>
+#include <final/output/fheadlessoutput.h>
 #include <final/output/foutput.h>
 #include <final/output/tty/fcharmap.h>
+#include <final/output/tty/fflushscheduler.h>
 #include <final/output/tty/foptiattr.h>
 #include <final/output/tty/foptimove.h>
 #include <final/output/tty/ftermcap.h>
@@ -75,6 +77,7 @@
 #include <final/util/flog.h>
 #include <final/util/fpoint.h>
 #include <final/util/frect.h>
+#include <final/util/frenderstatistics.h>
 #include <final/util/fsize.h>
 #include <final/util/fstring.h>
 #include <final/util/fsystem.h>
@@ -91,6 +94,7 @@
 #include <final/widget/flineedit.h>
 #include <final/widget/flistbox.h>
 #include <final/widget/flistview.h>
+#include <final/widget/flistviewmodel.h>
 #include <final/widget/fprogressbar.h>
 #include <final/widget/fradiobutton.h>
 #include <final/widget/fscrollbar.h>
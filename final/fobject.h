@@ -62,6 +62,7 @@ namespace finalcut
 // class forward declaration
 class FEvent;
 class FKeyEvent;
+class FPasteEvent;
 class FMouseEvent;
 class FWheelEvent;
 class FFocusEvent;
@@ -52,6 +52,9 @@ FStartOptions::FStartOptions()
 #endif
   , dark_theme{false}
   , color_change{true}
+  , bracketed_paste{true}
+  , terminal_detection_cache{false}
+  , synchronized_update{true}
 { }
 
 
@@ -73,8 +76,13 @@ void FStartOptions::setDefault()
   vgafont = false;
   newfont = false;
   encoding = Encoding::Unknown;
+  compositing_threads = 0;
+  max_frame_rate = 60;
   dark_theme = false;
   terminal_focus_events = true;
+  bracketed_paste = true;
+  terminal_detection_cache = false;
+  synchronized_update = true;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
@@ -83,9 +83,14 @@ class FStartOptions final
 
     uInt16 dark_theme           : 1;
     uInt16 color_change         : 1;
-    uInt16                      : 14;  // padding bits
+    uInt16 bracketed_paste      : 1;
+    uInt16 terminal_detection_cache : 1;
+    uInt16 synchronized_update  : 1;
+    uInt16                      : 11;  // padding bits
 
     Encoding      encoding{Encoding::Unknown};
+    std::size_t   compositing_threads{0};
+    uInt          max_frame_rate{60};  // 0 = unlimited
     std::ofstream logfile_stream{};
 };
 
@@ -20,12 +20,12 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-/*  Standalone class    Base class
- *  ════════════════    ══════════
+/*  Standalone class                          Base class
+ *  ════════════════                          ══════════
  *
- *     ▕▔▔▔▔▔▔▔▔▏    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- *     ▕ FTimer ▏    ▕ FObjectTimer ▏
- *     ▕▁▁▁▁▁▁▁▁▏    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *     ▕▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *     ▕ FTimer ▏- - - -▕ FTimerQueue ▏    ▕ FObjectTimer ▏
+ *     ▕▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *
  */
 
@@ -40,6 +40,7 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "final/fevent.h"
@@ -62,12 +63,290 @@ using std::chrono::duration_cast;
 using std::chrono::seconds;
 using std::chrono::milliseconds;
 using std::chrono::microseconds;
-using std::chrono::system_clock;
+using std::chrono::steady_clock;
 using std::chrono::time_point;
 
 // class forward declaration
 class FEvent;
 
+//----------------------------------------------------------------------
+// class FTimerQueue
+//----------------------------------------------------------------------
+
+template <typename ObjectT>
+class FTimerQueue
+{
+  public:
+    struct FTimerData
+    {
+      int          id;
+      milliseconds interval;
+      TimeValue    timeout;
+      ObjectT*     object;
+    };
+
+    // Accessors
+    inline auto getClassName() const -> FString
+    {
+      return "FTimerQueue";
+    }
+
+    auto  size() const noexcept -> std::size_t;
+    auto  getNextTimeout() -> TimeValue;
+
+    // Inquiry
+    auto  empty() const noexcept -> bool;
+
+    // Methods
+    void  insert (const FTimerData&);
+    auto  erase (int) -> bool;
+    auto  erase (const ObjectT*) -> bool;
+    void  clear();
+    auto  popExpired (const TimeValue&, FTimerData&) -> bool;
+    void  rearmExpired (const TimeValue&);
+
+  private:
+    struct FTimerEntry
+    {
+      FTimerData data;
+      uInt64     seq;  // Identifies the valid heap node
+    };
+
+    struct FHeapNode
+    {
+      TimeValue  timeout;
+      uInt64     seq;
+      int        id;
+    };
+
+    // Using-declarations
+    using FTimerMap = std::unordered_map<int, FTimerEntry>;
+    using FObjectIndex = std::unordered_multimap<const ObjectT*, int>;
+
+    // Constant
+    static constexpr std::size_t MIN_COMPACT_SIZE{64};
+
+    // Methods
+    void  schedule (FTimerEntry&);
+    auto  isValid (const FHeapNode&) const -> bool;
+    void  removeStaleNodes();
+    void  compact();
+    static auto later (const FHeapNode&, const FHeapNode&) noexcept -> bool;
+
+    // Data members
+    FTimerMap              timers{};    // Timer data by identifier
+    FObjectIndex           object_index{};
+    std::vector<FHeapNode> heap{};      // Min-heap of expiry times
+    std::vector<int>       expired{};   // Timers to be rearmed
+    uInt64                 next_seq{0};
+};
+
+// public methods of FTimerQueue
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimerQueue<ObjectT>::size() const noexcept -> std::size_t
+{
+  return timers.size();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimerQueue<ObjectT>::getNextTimeout() -> TimeValue
+{
+  // Returns the expiry time of the next timer
+  // or TimeValue::max() if there is no timer
+
+  removeStaleNodes();
+  return heap.empty() ? TimeValue::max() : heap.front().timeout;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimerQueue<ObjectT>::empty() const noexcept -> bool
+{
+  return timers.empty();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimerQueue<ObjectT>::insert (const FTimerData& timer_data)
+{
+  auto& entry = timers[timer_data.id];
+  entry.data = timer_data;
+  object_index.emplace(timer_data.object, timer_data.id);
+  schedule(entry);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimerQueue<ObjectT>::erase (int id) -> bool
+{
+  // Removes a timer in O(1), its heap node becomes invalid
+
+  const auto iter = timers.find(id);
+
+  if ( iter == timers.end() )
+    return false;
+
+  auto range = object_index.equal_range(iter->second.data.object);
+
+  for (auto obj_iter = range.first; obj_iter != range.second; ++obj_iter)
+  {
+    if ( obj_iter->second == id )
+    {
+      object_index.erase(obj_iter);
+      break;
+    }
+  }
+
+  timers.erase(iter);
+  compact();
+  return true;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimerQueue<ObjectT>::erase (const ObjectT* object) -> bool
+{
+  // Removes all timers of the given object
+
+  auto range = object_index.equal_range(object);
+
+  if ( range.first == range.second )
+    return false;
+
+  for (auto iter = range.first; iter != range.second; ++iter)
+    timers.erase(iter->second);
+
+  object_index.erase(range.first, range.second);
+  compact();
+  return true;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimerQueue<ObjectT>::clear()
+{
+  timers.clear();
+  object_index.clear();
+  heap.clear();
+  heap.shrink_to_fit();
+  expired.clear();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimerQueue<ObjectT>::popExpired ( const TimeValue& time
+                                      , FTimerData& timer_data ) -> bool
+{
+  // Removes the next timer that expired before the given time
+  // from the heap. Each timer expires only once until rearmExpired()
+  // is called.
+
+  while ( ! heap.empty() && heap.front().timeout <= time )
+  {
+    const auto node = heap.front();
+    std::pop_heap (heap.begin(), heap.end(), later);
+    heap.pop_back();
+
+    if ( ! isValid(node) )
+      continue;
+
+    expired.push_back(node.id);
+    timer_data = timers[node.id].data;
+    return true;
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimerQueue<ObjectT>::rearmExpired (const TimeValue& time)
+{
+  // Schedules the next expiry of all expired timers
+
+  for (const auto id : expired)
+  {
+    const auto iter = timers.find(id);
+
+    if ( iter == timers.end() )  // Timer was deleted in the meantime
+      continue;
+
+    auto& timer = iter->second.data;
+    timer.timeout += timer.interval;
+
+    if ( timer.timeout < time )
+      timer.timeout = time + timer.interval;
+
+    schedule(iter->second);
+  }
+
+  expired.clear();
+}
+
+// private methods of FTimerQueue
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline void FTimerQueue<ObjectT>::schedule (FTimerEntry& entry)
+{
+  entry.seq = next_seq++;
+  heap.push_back({entry.data.timeout, entry.seq, entry.data.id});
+  std::push_heap (heap.begin(), heap.end(), later);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimerQueue<ObjectT>::isValid (const FHeapNode& node) const -> bool
+{
+  const auto iter = timers.find(node.id);
+  return iter != timers.end() && iter->second.seq == node.seq;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimerQueue<ObjectT>::removeStaleNodes()
+{
+  while ( ! heap.empty() && ! isValid(heap.front()) )
+  {
+    std::pop_heap (heap.begin(), heap.end(), later);
+    heap.pop_back();
+  }
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimerQueue<ObjectT>::compact()
+{
+  // Rebuilds the heap when most nodes belong to deleted timers
+
+  if ( heap.size() < MIN_COMPACT_SIZE || heap.size() < 2 * timers.size() )
+    return;
+
+  heap.erase ( std::remove_if ( heap.begin()
+                              , heap.end()
+                              , [this] (const auto& node)
+                                {
+                                  return ! isValid(node);
+                                } )
+             , heap.end() );
+  std::make_heap (heap.begin(), heap.end(), later);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimerQueue<ObjectT>::later ( const FHeapNode& lhs
+                                        , const FHeapNode& rhs ) noexcept -> bool
+{
+  // Orders the heap by expiry time and then by scheduling order
+
+  if ( lhs.timeout != rhs.timeout )
+    return lhs.timeout > rhs.timeout;
+
+  return lhs.seq > rhs.seq;
+}
+
+
 //----------------------------------------------------------------------
 // class FTimer
 //----------------------------------------------------------------------
@@ -87,9 +366,11 @@ class FTimer
 
     inline auto getCurrentTime() const -> TimeValue
     {
-      return system_clock::now();  // Get the current time
+      return steady_clock::now();  // Get the current time
     }
 
+    auto  getNextTimeout() const & -> TimeValue;
+
     // Inquiries
     auto  isTimeout (const TimeValue&, uInt64) -> bool;
 
@@ -100,16 +381,9 @@ class FTimer
     auto  delAllTimers() const & -> bool;
 
   protected:
-    struct FTimerData
-    {
-      int          id;
-      milliseconds interval;
-      TimeValue    timeout;
-      ObjectT*     object;
-    };
-
     // Using-declaration
-    using FTimerList = std::vector<FTimerData>;
+    using FTimerList = FTimerQueue<ObjectT>;
+    using FTimerData = typename FTimerList::FTimerData;
     using FTimerListUniquePtr = std::unique_ptr<FTimerList>;
 
     // Accessor
@@ -135,6 +409,22 @@ class FTimer
 auto getNextId() -> int;
 
 // public methods of FTimer
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimer<ObjectT>::getNextTimeout() const & -> TimeValue
+{
+  // Returns the expiry time of the next timer
+  // or TimeValue::max() if there is no timer
+
+  std::lock_guard<std::mutex> lock_guard(internal::timer_var::mutex);
+  const auto& timer_list = globalTimerList();
+
+  if ( ! timer_list )
+    return TimeValue::max();
+
+  return timer_list->getNextTimeout();
+}
+
 //----------------------------------------------------------------------
 template <typename ObjectT>
 inline auto FTimer<ObjectT>::isTimeout (const TimeValue& time, uInt64 timeout) -> bool
@@ -163,18 +453,7 @@ auto FTimer<ObjectT>::addTimer (ObjectT* object, int interval) & -> int
   int id = getNextId();
   const auto time_interval = milliseconds(interval);
   const auto timeout = getCurrentTime() + time_interval;
-  FTimerData timedata{ id, time_interval, timeout, object };
-
-  // Insert in list sorted by timeout
-  timer_list->insert( std::lower_bound( timer_list->cbegin()
-                                      , timer_list->cend()
-                                      , timedata
-                                      , [] (const auto& a, const auto& b)
-                                        {
-                                          return a.timeout < b.timeout;
-                                        }
-                                      )
-                    , timedata);
+  timer_list->insert({ id, time_interval, timeout, object });
   return id;
 }
 
@@ -193,19 +472,7 @@ auto FTimer<ObjectT>::delTimer (int id) const & -> bool
   if ( ! timer_list || timer_list->empty() )
     return false;
 
-  auto iter = std::find_if ( timer_list->cbegin()
-                           , timer_list->cend()
-                           , [id] (const auto& timer)
-                             {
-                               return timer.id == id;
-                             }
-                           );
-
-  if ( iter == timer_list->cend() )
-    return false;
-
-  timer_list->erase(iter);
-  return true;
+  return timer_list->erase(id);
 }
 
 //----------------------------------------------------------------------
@@ -220,13 +487,7 @@ auto FTimer<ObjectT>::delOwnTimers(const ObjectT* object) const & -> bool
   if ( ! timer_list || timer_list->empty() )
     return false;
 
-  timer_list->erase ( std::remove_if( timer_list->begin()
-                                    , timer_list->end()
-                                    , [&object] (const auto& timer)
-                                      {
-                                        return timer.object == object;
-                                      }
-                                    ), timer_list->end() );
+  timer_list->erase(object);
   return true;
 }
 
@@ -243,7 +504,6 @@ auto FTimer<ObjectT>::delAllTimers() const & -> bool
     return false;
 
   timer_list->clear();
-  timer_list->shrink_to_fit();
   return true;
 }
 
@@ -266,19 +526,14 @@ auto FTimer<ObjectT>::processTimerEvent (CallbackT callback) -> uInt
     return 0;
 
   const auto& currentTime = getCurrentTime();
+  FTimerData timer{};
 
-  for (auto&& timer : *timer_list)
+  // Only expired timers are visited (in order of their expiry time)
+  while ( timer_list->popExpired(currentTime, timer) )
   {
-    if ( ! timer.id
-      || ! timer.object
-      || currentTime < timer.timeout )  // Timer not expired
+    if ( ! timer.id || ! timer.object )
       continue;
 
-    timer.timeout += timer.interval;
-
-    if ( timer.timeout < currentTime )
-      timer.timeout = currentTime + timer.interval;
-
     if ( timer.interval > microseconds(0) )
       ++activated;
 
@@ -288,6 +543,7 @@ auto FTimer<ObjectT>::processTimerEvent (CallbackT callback) -> uInt
     lock.lock();
   }
 
+  timer_list->rearmExpired(currentTime);
   return activated;
 }
 
@@ -330,6 +586,11 @@ class FObjectTimer
       return timer->getCurrentTime();
     }
 
+    static inline auto getNextTimeout() -> TimeValue
+    {
+      return timer->getNextTimeout();
+    }
+
     // Inquiries
     static auto isTimeout (const TimeValue& time, uInt64 timeout) -> bool
     {
@@ -67,7 +67,7 @@ using sInt32    = std::int32_t;
 using sInt64    = std::int64_t;
 
 using lDouble   = long double;
-using TimeValue = std::chrono::time_point<std::chrono::system_clock>;
+using TimeValue = std::chrono::time_point<std::chrono::steady_clock>;
 using FCall     = std::function<void()>;
 
 namespace finalcut
@@ -288,11 +288,10 @@ enum class FColor : uInt16;   // forward declaration
 
 struct FChar
 {
-  FUnicode   ch{};            // Character code
-  FUnicode   encoded_char{};  // Encoded output character
-  FColor     fg_color{};      // Foreground color
-  FColor     bg_color{};      // Background color
-  FAttribute attr{};          // Attributes
+  FUnicode   ch{};        // Character code
+  FColor     fg_color{};  // Foreground color
+  FColor     bg_color{};  // Background color
+  FAttribute attr{};      // Attributes
 };
 
 // FChar operator functions
@@ -823,7 +823,7 @@ void FWidget::redraw()
   else if ( ! isShown() )
     return;
 
-  draw();
+  drawWidget();
 
   if ( isRootWidget() )
     drawWindows();
@@ -888,7 +888,7 @@ void FWidget::show()
 
   initWidgetLayout();  // Makes initial layout settings
   adjustSize();        // Alignment before drawing
-  draw();              // Draw the widget
+  drawWidget();        // Draw the widget
   flags.visibility.hidden = false;
   flags.visibility.shown = true;
 
@@ -1399,6 +1399,14 @@ void FWidget::onKeyDown (FKeyEvent*)
   // to receive key down events for the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::onPaste (FPasteEvent*)
+{
+  // This event handler can be reimplemented in a subclass to receive
+  // the text of a bracketed paste in one piece. An ignored paste event
+  // is delivered as a sequence of key events.
+}
+
 //----------------------------------------------------------------------
 void FWidget::onMouseDown (FMouseEvent*)
 {
@@ -1575,6 +1583,12 @@ inline void FWidget::mapKeyEvents()
       {
         KeyDownEvent(static_cast<FKeyEvent*>(ev));
       }
+    },
+    { Event::Paste,
+      [this] (FEvent* ev)
+      {
+        onPaste (static_cast<FPasteEvent*>(ev));
+      }
     }
   } );
 }
@@ -2093,6 +2107,16 @@ void FWidget::draw()
   // for drawing the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::drawWidget()
+{
+  // Draws the widget and records the time in the render statistics
+
+  FRenderStatistics::FPhaseTimer phase_timer{FRenderStatistics::Phase::Draw};
+  getRenderStatistics().count(FRenderStatistics::Counter::DrawnWidgets);
+  draw();
+}
+
 //----------------------------------------------------------------------
 void FWidget::drawWindows() const
 {
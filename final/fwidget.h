@@ -55,6 +55,10 @@
  *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▏
  *                   :
  *                   :      *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *                   :- - - -▕ FPasteEvent ▏
+ *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                   :
+ *                   :      *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
  *                   :- - - -▕ FMouseEvent ▏
  *                   :       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *                   :
@@ -335,6 +339,7 @@ class FWidget : public FVTerm
     virtual void onKeyPress (FKeyEvent*);
     virtual void onKeyUp (FKeyEvent*);
     virtual void onKeyDown (FKeyEvent*);
+    virtual void onPaste (FPasteEvent*);
     virtual void onMouseDown (FMouseEvent*);
     virtual void onMouseUp (FMouseEvent*);
     virtual void onMouseDoubleClick (FMouseEvent*);
@@ -457,6 +462,7 @@ class FWidget : public FVTerm
     auto  sendFocusInEvent (FWidget*, FocusTypes) const -> bool;
     void  processDestroy() const;
     virtual void draw();
+    void  drawWidget();
     void  drawWindows() const;
     void  drawChildren();
     static auto  isDefaultTheme() -> bool;
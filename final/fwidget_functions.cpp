@@ -364,7 +364,6 @@ void drawTransparentShadow (FWidget* w)
   const FChar transparent_char
   {
     { { L'\0',  L'\0', L'\0', L'\0', L'\0' } },
-    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
     FColor::Default,
     FColor::Default,
     { { 0x00, 0x20, 0x00, 0x00} }  // byte 0..3 (byte 1 = 0x32 = transparent)
@@ -372,7 +371,6 @@ void drawTransparentShadow (FWidget* w)
 
   const FChar color_overlay_char
   {
-    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
     { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
     wc->shadow_bg,
     wc->shadow_fg,
@@ -432,28 +430,24 @@ void drawBlockShadow (FWidget* w)
   {{
     {
       { { wchar_t(UniChar::LowerHalfBlock),  L'\0', L'\0', L'\0', L'\0' } },  // ▄
-      { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
       wc->shadow_fg,
       wc->shadow_bg,
       { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
     },
     {
       { { wchar_t(UniChar::FullBlock),  L'\0', L'\0', L'\0', L'\0' } },  // █
-      { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
       wc->shadow_fg,
       wc->shadow_bg,
       { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
     },
     {
       { { L' ',  L'\0', L'\0', L'\0', L'\0' } },  // ' '
-      { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
       wc->shadow_fg,
       wc->shadow_bg,
       { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
     },
     {
       { { wchar_t(UniChar::UpperHalfBlock),  L'\0', L'\0', L'\0', L'\0' } },  // ▄
-      { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
       wc->shadow_fg,
       wc->shadow_bg,
       { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
@@ -489,7 +483,6 @@ void clearBlockShadow (FWidget* w)
   FChar spacer_char
   {
     { { L' ',  L'\0', L'\0', L'\0', L'\0' } },  // ' '
-    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
     wc->shadow_fg,
     wc->shadow_bg,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
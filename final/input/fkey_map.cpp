@@ -885,6 +885,7 @@ constexpr FKeyMap::KeyNameType FKeyMap::fkeyname =
   { FKey::X11mouse                  , "xterm mouse" },
   { FKey::Extended_mouse            , "SGR extended mouse" },
   { FKey::Urxvt_mouse               , "urxvt mouse extension" },
+  { FKey::Bracketed_paste           , "bracketed paste" },
   { FKey::Incomplete                , "incomplete key string" }
 }};
 
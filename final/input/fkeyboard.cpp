@@ -128,6 +128,7 @@ auto FKeyboard::setNonBlockingInput (bool enable) -> bool
   if ( enable )  // make stdin non-blocking
   {
     stdin_status_flags |= O_NONBLOCK;
+    syscall_count++;
 
     if ( fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
       non_blocking_stdin = true;
@@ -135,6 +136,7 @@ auto FKeyboard::setNonBlockingInput (bool enable) -> bool
   else
   {
     stdin_status_flags &= ~O_NONBLOCK;
+    syscall_count++;
 
     if ( fcntl (FTermios::getStdIn(), F_SETFL, stdin_status_flags) != -1 )
       non_blocking_stdin = false;
@@ -146,7 +148,7 @@ auto FKeyboard::setNonBlockingInput (bool enable) -> bool
 //----------------------------------------------------------------------
 auto FKeyboard::hasUnprocessedInput() const noexcept -> bool
 {
-  return fifo_buf.hasData();
+  return fifo_buf.hasData() || paste_mode;
 }
 
 //----------------------------------------------------------------------
@@ -194,6 +196,8 @@ void FKeyboard::clearKeyBuffer() noexcept
   fkey = FKey::None;
   key = FKey::None;
   fifo_buf.clear();
+  paste_buffer.clear();
+  paste_mode = false;
 }
 
 //----------------------------------------------------------------------
@@ -201,7 +205,20 @@ void FKeyboard::clearKeyBufferOnTimeout()
 {
   // Empty the buffer on timeout
 
-  if ( fifo_buf.hasData() && isKeypressTimeout() )
+  if ( ! isKeypressTimeout() )
+    return;
+
+  if ( paste_mode && ! fkey_queue.isFull() )
+  {
+    // The paste end sequence did not arrive in time,
+    // so the text received so far is delivered
+    paste_mode = false;
+
+    if ( ! paste_buffer.empty() )
+      queuePasteText (paste_buffer.size());
+  }
+
+  if ( fifo_buf.hasData() )
     clearKeyBuffer();
 }
 
@@ -231,7 +248,19 @@ void FKeyboard::processQueuedInput()
     key = fkey_queue.front();
     fkey_queue.pop();
 
-    if ( key > FKey::None )
+    if ( key == FKey::Bracketed_paste )
+    {
+      paste_text = std::move(paste_queue.front());
+      paste_queue.pop_front();
+      pasteCommand();
+      paste_text.clear();
+
+      if ( FApplication::isQuit() )
+        return;
+
+      key = FKey::None;
+    }
+    else if ( key > FKey::None )
     {
       keyPressedCommand();
 
@@ -284,6 +313,23 @@ inline auto FKeyboard::getMouseProtocolKey() const -> FKey
   return NOT_SET;
 }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getBracketedPasteKey() -> FKey
+{
+  // Looking for the bracketed paste start sequence in the key buffer
+
+  static constexpr std::array<char, 6> paste_start{{ '\033', '[', '2', '0', '0', '~' }};
+
+  if ( fifo_buf.getSize() != paste_start.size()
+    || ! std::equal(paste_start.cbegin(), paste_start.cend(), fifo_buf.begin()) )
+    return NOT_SET;
+
+  fifo_buf.clear();
+  paste_buffer.clear();
+  paste_mode = true;
+  return FKey::Incomplete;  // The paste text follows
+}
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::getTermcapKey() -> FKey
 {
@@ -440,24 +486,44 @@ auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 }
 
 //----------------------------------------------------------------------
-inline auto FKeyboard::readKey() -> ssize_t
+inline auto FKeyboard::readInput() -> bool
 {
+  // Reads all available bytes (up to READ_BUF_SIZE) with one read() call.
+  // stdin stays non-blocking until parseKeyBuffer() has drained it.
+
   setNonBlockingInput();
-  const ssize_t bytes = read(FTermios::getStdIn(), &read_character, 1);
-  unsetNonBlockingInput();
-  return bytes;
+  const ssize_t bytes = read(FTermios::getStdIn(), read_buffer.data(), READ_BUF_SIZE);
+  syscall_count++;
+  read_pos = 0;
+  read_length = ( bytes > 0 ) ? std::size_t(bytes) : 0;
+
+  if ( bytes > 0 )
+    time_keypressed = FObjectTimer::getCurrentTime();
+
+  return bytes > 0;
 }
 
 //----------------------------------------------------------------------
 void FKeyboard::parseKeyBuffer()
 {
-  while ( readKey() > 0 )
+  while ( hasBufferedInput() || readInput() )
   {
-    time_keypressed = FObjectTimer::getCurrentTime();
     has_pending_input = false;
 
+    if ( paste_mode )
+    {
+      parsePasteText();
+
+      if ( fkey_queue.isFull() )
+        break;
+
+      continue;
+    }
+
     if ( ! fifo_buf.isFull() )
-      fifo_buf.push(read_character);
+      fifo_buf.push(read_buffer[read_pos]);
+
+    read_pos++;
 
     // Read the rest from the fifo buffer
     while ( fifo_buf.hasData() && fkey != FKey::Incomplete )
@@ -480,9 +546,121 @@ void FKeyboard::parseKeyBuffer()
 
     fkey = FKey::None;
 
-    if ( fkey_queue.isFull() )
+    if ( fkey_queue.isFull() )  // The rest remains in read_buffer
       break;
   }
+
+  if ( ! hasBufferedInput() )
+    has_pending_input = false;  // stdin was drained
+
+  unsetNonBlockingInput();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::parsePasteText()
+{
+  // Moves the buffered input into the paste buffer up to the
+  // bracketed paste end sequence "ESC [ 2 0 1 ~"
+
+  if ( fkey_queue.isFull() )
+    return;
+
+  static constexpr char paste_end[] = "\033[201~";
+  static constexpr std::size_t paste_end_length = sizeof(paste_end) - 1;
+  const auto old_size = paste_buffer.size();
+  paste_buffer.append(&read_buffer[read_pos], read_length - read_pos);
+  read_pos = read_length;
+  // The end sequence can start in the previously read data
+  const auto start = ( old_size < paste_end_length ) ? 0 : old_size - paste_end_length + 1;
+  const auto pos = paste_buffer.find(paste_end, start);
+
+  if ( pos == std::string::npos )
+  {
+    if ( paste_buffer.size() < MAX_PASTE_SIZE )
+      return;
+
+    // Delivers a long paste in chunks. The tail stays in the buffer
+    // because it can be the start of the end sequence or of "\r\n".
+    auto length = paste_buffer.size() - paste_end_length + 1;
+
+    if ( paste_buffer[length - 1] == '\r' )
+      length--;
+
+    queuePasteText (getPasteChunkLength(length));
+    return;
+  }
+
+  // Leave the input after the end sequence in read_buffer
+  read_pos -= paste_buffer.size() - pos - paste_end_length;
+  paste_buffer.resize(pos);
+  paste_mode = false;
+  queuePasteText (pos);
+}
+
+//----------------------------------------------------------------------
+auto FKeyboard::getPasteChunkLength (std::size_t length) const -> std::size_t
+{
+  // Moves the chunk end back to the start of a UTF-8 sequence
+  // that is not complete within the first length bytes
+
+  std::size_t pos = length;
+  std::size_t continuation_bytes{0};
+
+  while ( pos > 0 && continuation_bytes < 3
+       && (uChar(paste_buffer[pos - 1]) & 0xc0) == 0x80 )
+  {
+    pos--;
+    continuation_bytes++;
+  }
+
+  if ( pos == 0 )
+    return length;
+
+  const auto lead = uChar(paste_buffer[pos - 1]);
+  std::size_t sequence_length{1};
+
+  if ( (lead & 0xe0) == 0xc0 )
+    sequence_length = 2;
+  else if ( (lead & 0xf0) == 0xe0 )
+    sequence_length = 3;
+  else if ( (lead & 0xf8) == 0xf0 )
+    sequence_length = 4;
+
+  if ( sequence_length > continuation_bytes + 1 )
+    return pos - 1;  // Incomplete sequence
+
+  return length;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::queuePasteText (std::size_t length)
+{
+  // Queues the first length bytes of the paste buffer as paste text
+  // and normalizes the line endings to '\n'
+
+  std::string text{};
+  text.reserve(length);
+  const auto end = paste_buffer.cbegin() + std::ptrdiff_t(length);
+  auto iter = paste_buffer.cbegin();
+
+  while ( iter != end )
+  {
+    if ( *iter == '\r' )
+    {
+      text.push_back('\n');
+
+      if ( iter + 1 != end && *(iter + 1) == '\n' )
+        ++iter;
+    }
+    else
+      text.push_back(*iter);
+
+    ++iter;
+  }
+
+  paste_buffer.erase(0, length);
+  paste_queue.emplace_back(text);
+  fkey_queue.emplace(FKey::Bracketed_paste);
 }
 
 //----------------------------------------------------------------------
@@ -498,6 +676,11 @@ auto FKeyboard::parseKeyString() -> FKey
 
   FKey keycode = getMouseProtocolKey();
 
+  if ( keycode != NOT_SET )
+    return keycode;
+
+  keycode = getBracketedPasteKey();
+
   if ( keycode != NOT_SET )
     return keycode;
 
@@ -583,4 +766,10 @@ void FKeyboard::mouseTrackingCommand() const
   mouse_tracking_cmd.execute();
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::pasteCommand() const
+{
+  paste_cmd.execute();
+}
+
 }  // namespace finalcut
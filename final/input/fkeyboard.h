@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <array>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
@@ -115,10 +116,12 @@ class FKeyboard final
     static auto getInstance() -> FKeyboard&;
     auto  getKey() const noexcept -> FKey;
     auto  getKeyName (const FKey) const -> FString;
+    auto  getPasteText() const & noexcept -> const FString&;
     auto  getKeyBuffer() & noexcept -> keybuffer&;
     auto  getKeyPressedTime() const noexcept -> TimeValue;
     static auto  getKeypressTimeout() noexcept -> uInt64;
     static auto  getReadBlockingTime() noexcept -> uInt64;
+    auto  getSyscallCount() const noexcept -> uInt64;
 
     // Mutators
     template <typename T>
@@ -129,6 +132,8 @@ class FKeyboard final
     static void  setNonBlockingInputSupport (bool = true) noexcept;
     auto  setNonBlockingInput (bool = true) -> bool;
     auto  unsetNonBlockingInput() noexcept -> bool;
+    void  setPendingInput (bool = true) noexcept;
+    void  resetSyscallCount() noexcept;
     void  enableUTF8() noexcept;
     void  disableUTF8() noexcept;
     void  enableMouseSequences() noexcept;
@@ -137,6 +142,7 @@ class FKeyboard final
     void  setReleaseCommand (const FKeyboardCommand&);
     void  setEscPressedCommand (const FKeyboardCommand&);
     void  setMouseTrackingCommand (const FKeyboardCommand&);
+    void  setPasteCommand (const FKeyboardCommand&);
 
     // Inquiry
     auto  hasPendingInput() const noexcept -> bool;
@@ -155,14 +161,19 @@ class FKeyboard final
     // Constants
     static constexpr FKey NOT_SET = static_cast<FKey>(-2);
     static constexpr std::size_t MAX_QUEUE_SIZE = 32;
+    static constexpr std::size_t READ_BUF_SIZE = 4096;
+    static constexpr std::size_t MAX_PASTE_SIZE = 65536;  // Paste chunk size
 
     // Using-declaration
+    using ReadBuffer = std::array<char, READ_BUF_SIZE>;
     using FKeyMapPtr = std::shared_ptr<FKeyMap::KeyCapMapType>;
     using KeyMapEnd = FKeyMap::KeyCapMapType::const_iterator;
     using KeyQueue = FRingBuffer<FKey, MAX_QUEUE_SIZE>;
+    using PasteQueue = std::deque<FString>;
 
     // Accessors
     auto  getMouseProtocolKey() const -> FKey;
+    auto  getBracketedPasteKey() -> FKey;
     auto  getTermcapKey() -> FKey;
     auto  getKnownKey() -> FKey;
     auto  getSingleKey() -> FKey;
@@ -173,8 +184,12 @@ class FKeyboard final
 
     // Methods
     auto  UTF8decode (const std::size_t) const noexcept -> FKey;
-    auto  readKey() -> ssize_t;
+    auto  hasBufferedInput() const noexcept -> bool;
+    auto  readInput() -> bool;
     void  parseKeyBuffer();
+    void  parsePasteText();
+    auto  getPasteChunkLength (std::size_t) const -> std::size_t;
+    void  queuePasteText (std::size_t);
     auto  parseKeyString() -> FKey;
     auto  keyCorrection (const FKey&) const -> FKey;
     void  substringKeyHandling();
@@ -182,12 +197,14 @@ class FKeyboard final
     void  keyReleasedCommand() const;
     void  escapeKeyPressedCommand() const;
     void  mouseTrackingCommand() const;
+    void  pasteCommand() const;
 
     // Data members
     FKeyboardCommand  keypressed_cmd{};
     FKeyboardCommand  keyreleased_cmd{};
     FKeyboardCommand  escape_key_cmd{};
     FKeyboardCommand  mouse_tracking_cmd{};
+    FKeyboardCommand  paste_cmd{};
 
     static TimeValue  time_keypressed;
     static uInt64     read_blocking_time;
@@ -201,11 +218,18 @@ class FKeyboard final
     FKey              fkey{FKey::None};
     FKey              key{FKey::None};
     int               stdin_status_flags{0};
-    char              read_character{};
+    ReadBuffer        read_buffer{};
+    std::size_t       read_pos{0};
+    std::size_t       read_length{0};
+    uInt64            syscall_count{0};
+    std::string       paste_buffer{};
+    PasteQueue        paste_queue{};
+    FString           paste_text{};
     bool              has_pending_input{false};
     bool              fifo_in_use{false};
     bool              utf8_input{false};
     bool              mouse_support{true};
+    bool              paste_mode{false};
     bool              non_blocking_stdin{false};
 };
 
@@ -222,6 +246,10 @@ inline auto FKeyboard::getKey() const noexcept -> FKey
 inline auto FKeyboard::getKeyBuffer() & noexcept -> keybuffer&
 { return fifo_buf; }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getPasteText() const & noexcept -> const FString&
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::getKeyPressedTime() const noexcept -> TimeValue
 { return time_keypressed; }
@@ -257,6 +285,10 @@ inline void FKeyboard::setTermcapMap()
   fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
 }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getSyscallCount() const noexcept -> uInt64
+{ return syscall_count; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::setKeypressTimeout (const uInt64 timeout) noexcept
 { key_timeout = timeout; }
@@ -273,9 +305,21 @@ inline void FKeyboard::setNonBlockingInputSupport (bool enable) noexcept
 inline auto FKeyboard::unsetNonBlockingInput() noexcept -> bool
 { return setNonBlockingInput(false); }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPendingInput (bool enable) noexcept
+{ has_pending_input = enable; }
+
+//----------------------------------------------------------------------
+inline void FKeyboard::resetSyscallCount() noexcept
+{ syscall_count = 0; }
+
+//----------------------------------------------------------------------
+inline auto FKeyboard::hasBufferedInput() const noexcept -> bool
+{ return read_pos < read_length; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::hasPendingInput() const noexcept -> bool
-{ return has_pending_input; }
+{ return has_pending_input || hasBufferedInput(); }
 
 //----------------------------------------------------------------------
 inline auto FKeyboard::hasDataInQueue() const -> bool
@@ -313,6 +357,10 @@ inline void FKeyboard::setEscPressedCommand (const FKeyboardCommand& cmd)
 inline void FKeyboard::setMouseTrackingCommand (const FKeyboardCommand& cmd)
 { mouse_tracking_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPasteCommand (const FKeyboardCommand& cmd)
+{ paste_cmd = cmd; }
+
 }  // namespace finalcut
 
 #endif  // FKEYBOARD_H
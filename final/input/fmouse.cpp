@@ -97,6 +97,12 @@ auto FMouseData::getPos() const & noexcept -> const FPoint&
   return mouse;
 }
 
+//----------------------------------------------------------------------
+auto FMouseData::getWheelDelta() const noexcept -> int
+{
+  return wheel_delta;
+}
+
 //----------------------------------------------------------------------
 auto FMouseData::isLeftButtonPressed() const noexcept -> bool
 {
@@ -186,6 +192,12 @@ auto FMouseData::isMoved() const noexcept -> bool
   return getButtonState().mouse_moved;
 }
 
+//----------------------------------------------------------------------
+auto FMouseData::isWheel() const noexcept -> bool
+{
+  return isWheelUp() || isWheelDown() || isWheelLeft() || isWheelRight();
+}
+
 //----------------------------------------------------------------------
 void FMouseData::clearButtonState() noexcept
 {
@@ -202,6 +214,31 @@ void FMouseData::clearButtonState() noexcept
   b_state.mouse_moved    = false;
 }
 
+//----------------------------------------------------------------------
+auto FMouseData::coalesce (const FMouseData& md) noexcept -> bool
+{
+  // Merges the directly following mouse report md into this one.
+  // Motion reports with the same button state keep only the latest
+  // position, wheel steps at the same position are added up.
+
+  if ( ! hasSameButtonState(md) )
+    return false;
+
+  if ( isMoved() && ! isWheel() )
+  {
+    mouse = md.mouse;
+    return true;
+  }
+
+  if ( isWheel() && mouse == md.mouse )
+  {
+    wheel_delta += md.wheel_delta;
+    return true;
+  }
+
+  return false;
+}
+
 
 // protected methods of FMouseData
 //----------------------------------------------------------------------
@@ -223,6 +260,26 @@ void FMouseData::setPos (const FPoint& m) noexcept
 }
 
 
+// private methods of FMouseData
+//----------------------------------------------------------------------
+inline auto FMouseData::hasSameButtonState (const FMouseData& md) const noexcept -> bool
+{
+  const auto& b1 = getButtonState();
+  const auto& b2 = md.getButtonState();
+  return b1.left_button    == b2.left_button
+      && b1.right_button   == b2.right_button
+      && b1.middle_button  == b2.middle_button
+      && b1.shift_button   == b2.shift_button
+      && b1.control_button == b2.control_button
+      && b1.meta_button    == b2.meta_button
+      && b1.wheel_up       == b2.wheel_up
+      && b1.wheel_down     == b2.wheel_down
+      && b1.wheel_left     == b2.wheel_left
+      && b1.wheel_right    == b2.wheel_right
+      && b1.mouse_moved    == b2.mouse_moved;
+}
+
+
 //----------------------------------------------------------------------
 // class FMouse
 //----------------------------------------------------------------------
@@ -1646,6 +1703,10 @@ void FMouseControl::processEvent (const TimeValue& time)
   {
     (*iter)->processEvent(time);
     auto& md = static_cast<FMouseData&>(**iter);
+
+    if ( coalesce_events && coalesceWithLastEvent(md) )
+      return;
+
     fmousedata_queue.emplace(std::make_unique<FMouseData>(std::move(md)));
   }
 }
@@ -1747,4 +1808,24 @@ void FMouseControl::resetCurrentMouseEvent()
   getCurrentMouseEvent() = nullptr;
 }
 
+//----------------------------------------------------------------------
+auto FMouseControl::coalesceWithLastEvent (const FMouseData& md) -> bool
+{
+  // Merges a motion or wheel report into the last queued mouse
+  // report, if it has not yet been dispatched
+
+  if ( fmousedata_queue.isEmpty() || ! fmousedata_queue.back() )
+    return false;
+
+  if ( ! fmousedata_queue.back()->coalesce(md) )
+    return false;
+
+  if ( md.isWheel() )
+    merged_wheels++;
+  else
+    dropped_moves++;
+
+  return true;
+}
+
 }  // namespace finalcut
@@ -113,6 +113,7 @@ class FMouseData
     // Accessors
     virtual auto getClassName() const -> FString;
     auto getPos() const & noexcept -> const FPoint&;
+    auto getWheelDelta() const noexcept -> int;
 
     // Inquiries
     auto isLeftButtonPressed() const noexcept -> bool;
@@ -130,9 +131,11 @@ class FMouseData
     auto isWheelLeft() const noexcept -> bool;
     auto isWheelRight() const noexcept -> bool;
     auto isMoved() const noexcept -> bool;
+    auto isWheel() const noexcept -> bool;
 
     // Methods
     void clearButtonState() noexcept;
+    auto coalesce (const FMouseData&) noexcept -> bool;
 
   protected:
     // Enumerations
@@ -167,9 +170,13 @@ class FMouseData
     void setPos (const FPoint&) noexcept;
 
   private:
+    // Inquiry
+    auto hasSameButtonState (const FMouseData&) const noexcept -> bool;
+
     // Data members
     FMouseButton b_state{};
     FPoint       mouse{0, 0};  // mouse click position
+    int          wheel_delta{1};  // number of merged wheel steps
 };
 
 
@@ -541,6 +548,8 @@ class FMouseControl
     static auto  getInstance() -> FMouseControl&;
     static auto  getCurrentMouseEvent() -> FMouseDataPtr&;
     auto  getPos() & -> const FPoint&;
+    auto  getDroppedMoveCount() const noexcept -> uInt64;
+    auto  getMergedWheelCount() const noexcept -> uInt64;
     void  clearEvent();
 
     // Mutators
@@ -551,6 +560,8 @@ class FMouseControl
     void  setEventCommand (const FMouseCommand&);
     void  useGpmMouse (bool = true);
     void  useXtermMouse (bool = true);
+    void  setEventCoalescing (bool = true) noexcept;
+    void  unsetEventCoalescing() noexcept;
 
     // Inquiries
     auto  hasData() -> bool;
@@ -573,6 +584,7 @@ class FMouseControl
     auto  hasUnprocessedInput() const -> bool;
     auto  hasDataInQueue() const -> bool;
     auto  isGpmMouseEnabled() noexcept -> bool;
+    auto  isEventCoalescing() const noexcept -> bool;
 
     // Methods
     void  enable();
@@ -583,6 +595,7 @@ class FMouseControl
     void  processQueuedInput();
     auto  getGpmKeyPressed (bool = true) -> bool;
     void  drawPointer();
+    void  resetCoalescingCounters() noexcept;
 
   private:
     // Constants
@@ -605,13 +618,19 @@ class FMouseControl
     static void  setCurrentMouseEvent (const FMouseDataPtr&);
     static void  resetCurrentMouseEvent();
 
+    // Methods
+    auto  coalesceWithLastEvent (const FMouseData&) -> bool;
+
     // Data member
     FMouseProtocol  mouse_protocol{};
     FMouseCommand   event_cmd{};
     MouseQueue      fmousedata_queue{};
     FPoint          zero_point{0, 0};
+    uInt64          dropped_moves{0};
+    uInt64          merged_wheels{0};
     bool            use_gpm_mouse{false};
     bool            use_xterm_mouse{false};
+    bool            coalesce_events{false};
 };
 
 // FMouseControl inline functions
@@ -619,10 +638,37 @@ class FMouseControl
 inline auto FMouseControl::getClassName() const -> FString
 { return "FMouseControl"; }
 
+//----------------------------------------------------------------------
+inline auto FMouseControl::getDroppedMoveCount() const noexcept -> uInt64
+{ return dropped_moves; }
+
+//----------------------------------------------------------------------
+inline auto FMouseControl::getMergedWheelCount() const noexcept -> uInt64
+{ return merged_wheels; }
+
 //----------------------------------------------------------------------
 inline void FMouseControl::setEventCommand (const FMouseCommand& cmd)
 { event_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FMouseControl::setEventCoalescing (bool enable) noexcept
+{ coalesce_events = enable; }
+
+//----------------------------------------------------------------------
+inline void FMouseControl::unsetEventCoalescing() noexcept
+{ setEventCoalescing(false); }
+
+//----------------------------------------------------------------------
+inline auto FMouseControl::isEventCoalescing() const noexcept -> bool
+{ return coalesce_events; }
+
+//----------------------------------------------------------------------
+inline void FMouseControl::resetCoalescingCounters() noexcept
+{
+  dropped_moves = 0;
+  merged_wheels = 0;
+}
+
 //----------------------------------------------------------------------
 inline auto FMouseControl::hasDataInQueue() const -> bool
 { return ! fmousedata_queue.isEmpty(); }
@@ -0,0 +1,459 @@
+/***********************************************************************
+* fheadlessoutput.cpp - Virtual terminal output into memory            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/input/fkeyboard.h"
+#include "final/output/fheadlessoutput.h"
+#include "final/output/tty/foptiattr.h"
+#include "final/output/tty/fterm_functions.h"
+#include "final/util/frenderstatistics.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FHeadlessOutput
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FHeadlessOutput::FHeadlessOutput (const FVTerm& t)  // constructor
+  : FOutput{t}
+{ }
+
+//----------------------------------------------------------------------
+FHeadlessOutput::~FHeadlessOutput() noexcept = default;  // destructor
+
+
+// public methods of FHeadlessOutput
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getKeyName (FKey keynum) const -> FString
+{
+  static const auto& keyboard = FKeyboard::getInstance();
+  return keyboard.getKeyName (keynum);
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getFChar (const FPoint& pos) const & -> const FChar&
+{
+  const auto index = std::size_t(pos.getY()) * size.getWidth()
+                   + std::size_t(pos.getX());
+  return grid[index];
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getLine (int y) const -> FString
+{
+  // Returns the text of the terminal line y
+
+  FString line{};
+
+  if ( y < 0 || y >= int(size.getHeight()) )
+    return line;
+
+  const auto width = size.getWidth();
+  const auto first = grid.cbegin() + std::ptrdiff_t(std::size_t(y) * width);
+  std::for_each ( first, first + std::ptrdiff_t(width)
+                , [&line] (const FChar& fchar)
+                  {
+                    if ( fchar.attr.bit.fullwidth_padding )
+                      return;
+
+                    for (const auto& ch : fchar.ch)
+                    {
+                      if ( ch == L'\0' )
+                        break;
+
+                      line << ch;
+                    }
+                  }
+                );
+  return line;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::setCursor (FPoint pos)
+{
+  cursor_pos = pos;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::hideCursor (bool enable)
+{
+  if ( cursor_hidden == enable )
+    return;
+
+  cursor_hidden = enable;
+  appendOutputBuffer (enable ? "\033[?25l" : "\033[?25h");
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::setTerminalSize (FSize new_size)
+{
+  // The in-memory terminal takes on every size immediately
+
+  if ( new_size.isEmpty() )
+    return;
+
+  resizeGrid (new_size);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
+{
+  vterm = virtual_terminal;
+  resizeGrid (size);
+  term_pos.setPoint (-1, -1);
+  term_attribute = getBlankChar(L'\0');
+  resetStatistics();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::finishTerminal()
+{
+  clearTerminalAttributes();
+  showCursor();
+  flush();
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::updateTerminal() -> bool
+{
+  // Copies the pending changes into the cell grid and encodes
+  // them as one frame in the output buffer
+
+  if ( ! vterm )
+    return false;
+
+  const auto frame_start = byte_count;
+  const int height = std::min(vterm->height, int(size.getHeight()));
+  std::size_t changedlines = 0;
+
+  for (auto y{0}; y < height; y++)
+  {
+    FVTerm::reduceTerminalLineUpdates(uInt(y));
+
+    if ( updateTerminalLine(y) )
+      changedlines++;
+  }
+
+  vterm->has_changes = false;
+  FRenderStatistics::getInstance().count ( FRenderStatistics::Counter::UpdatedLines
+                                         , changedlines );
+
+  // Sets the new input cursor position
+  bool cursor_update{false};
+
+  if ( vterm->input_cursor_visible
+    && vterm->input_cursor_x >= 0
+    && vterm->input_cursor_x < int(size.getWidth())
+    && vterm->input_cursor_y >= 0
+    && vterm->input_cursor_y < int(size.getHeight()) )
+  {
+    const FPoint input_cursor{vterm->input_cursor_x, vterm->input_cursor_y};
+    setCursor (input_cursor);
+
+    if ( term_pos != input_cursor )
+      appendCursorAddress (input_cursor.getX(), input_cursor.getY());
+
+    showCursor();
+    cursor_update = true;
+  }
+  else
+    hideCursor();
+
+  last_frame_bytes = std::size_t(byte_count - frame_start);
+
+  if ( ! cursor_update && changedlines == 0 )
+    return false;
+
+  frame_count++;
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::scrollTerminalForward (int top, int bottom) -> bool
+{
+  // Scrolls the terminal lines from top to bottom up one line
+
+  if ( top < 0 || top >= bottom || bottom >= int(size.getHeight()) )
+    return false;
+
+  const auto width = std::ptrdiff_t(size.getWidth());
+  const auto first = grid.begin() + top * width;
+  const auto last = grid.begin() + (bottom + 1) * width;
+  std::move (first + width, last, first);
+  clearGridLine (bottom);
+  clearTerminalAttributes();
+  appendOutputBuffer ( "\033[" + std::to_string(top + 1)
+                     + ";" + std::to_string(bottom + 1) + "r"
+                     + "\033[" + std::to_string(bottom + 1) + ";1H\n"
+                     + "\033[r" );
+  term_pos.setPoint (-1, -1);
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::scrollTerminalReverse (int top, int bottom) -> bool
+{
+  // Scrolls the terminal lines from top to bottom down one line
+
+  if ( top < 0 || top >= bottom || bottom >= int(size.getHeight()) )
+    return false;
+
+  const auto width = std::ptrdiff_t(size.getWidth());
+  const auto first = grid.begin() + top * width;
+  const auto last = grid.begin() + (bottom + 1) * width;
+  std::move_backward (first, last - width, last);
+  clearGridLine (top);
+  clearTerminalAttributes();
+  appendOutputBuffer ( "\033[" + std::to_string(top + 1)
+                     + ";" + std::to_string(bottom + 1) + "r"
+                     + "\033[" + std::to_string(top + 1) + ";1H\033M"
+                     + "\033[r" );
+  term_pos.setPoint (-1, -1);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::clearTerminalAttributes()
+{
+  appendAttributes (getBlankChar());
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::clearTerminal (wchar_t fillchar) -> bool
+{
+  // Clears the terminal with the default colors
+
+  std::fill (grid.begin(), grid.end(), getBlankChar(fillchar));
+  clearTerminalAttributes();
+  appendOutputBuffer ("\033[H\033[2J");
+  term_pos.setPoint (0, 0);
+
+  if ( fillchar != L' ' )
+  {
+    for (auto y{0}; y < int(size.getHeight()); y++)
+      for (auto x{0}; x < int(size.getWidth()); x++)
+        printCharacter (x, y, getFChar(FPoint{x, y}));
+  }
+
+  flush();
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::flush()
+{
+  // Hands the encoded bytes over to the byte sink
+
+  if ( output_buffer.empty() )
+    return;
+
+  if ( byte_sink )
+    byte_sink (output_buffer.data(), output_buffer.length());
+
+  FRenderStatistics::getInstance().count ( FRenderStatistics::Counter::WrittenBytes
+                                         , output_buffer.length() );
+  output_buffer.clear();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::beep() const
+{
+  bell_count++;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::resetStatistics() noexcept
+{
+  frame_count = 0;
+  byte_count = 0;
+  last_frame_bytes = 0;
+  bell_count = 0;
+}
+
+
+// private methods of FHeadlessOutput
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getBlankChar (wchar_t fillchar) const -> FChar
+{
+  FChar blank_char{};
+  blank_char.ch[0] = fillchar;
+  blank_char.fg_color = FColor::Default;
+  blank_char.bg_color = FColor::Default;
+  blank_char.attr.bit.char_width = 1;
+  return blank_char;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::resizeGrid (const FSize& new_size)
+{
+  size = new_size;
+  grid.assign (size.getArea(), getBlankChar());
+  term_pos.setPoint (-1, -1);
+}
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::clearGridLine (int y)
+{
+  const auto width = std::ptrdiff_t(size.getWidth());
+  const auto first = grid.begin() + y * width;
+  std::fill (first, first + width, getBlankChar());
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::updateTerminalLine (int y) -> bool
+{
+  // Takes over the pending changes from line y of the virtual terminal
+
+  auto& vterm_changes = vterm->changes[unsigned(y)];
+  uInt& xmin = vterm_changes.xmin;
+  uInt& xmax = vterm_changes.xmax;
+  const auto width = uInt(std::min(vterm->width, int(size.getWidth())));
+
+  if ( xmin > xmax || xmin >= width )  // This line has no changes
+    return false;
+
+  auto* cell = &grid[std::size_t(y) * size.getWidth() + xmin];
+  const auto* print_char = &vterm->getFChar(int(xmin), y);
+
+  for (auto x = xmin; x <= std::min(xmax, width - 1); x++)
+  {
+    *cell = *print_char;
+    cell->attr.bit.no_changes = false;
+    cell->attr.bit.printed = false;
+
+    if ( ! print_char->attr.bit.no_changes
+      && ! print_char->attr.bit.fullwidth_padding )
+      printCharacter (int(x), y, *print_char);
+
+    ++cell;
+    ++print_char;
+  }
+
+  // Reset line changes
+  xmin = uInt(vterm->width);
+  xmax = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::printCharacter (int x, int y, const FChar& print_char)
+{
+  if ( term_pos != FPoint{x, y} )
+    appendCursorAddress (x, y);
+
+  appendAttributes (print_char);
+  std::string encoded_char{};
+
+  for (const auto& ch : print_char.ch)
+  {
+    if ( ch == L'\0' )
+      break;
+
+    encoded_char += unicode_to_utf8(ch);
+  }
+
+  appendOutputBuffer (encoded_char.empty() ? " " : encoded_char);
+  const int char_width = ( print_char.attr.bit.char_width == 2 ) ? 2 : 1;
+
+  if ( x + char_width < int(size.getWidth()) )
+    term_pos.setPoint (x + char_width, y);
+  else
+    term_pos.setPoint (-1, -1);  // Pending line wrap
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::appendCursorAddress (int x, int y)
+{
+  appendOutputBuffer ( "\033[" + std::to_string(y + 1)
+                     + ";" + std::to_string(x + 1) + "H" );
+  term_pos.setPoint (x, y);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::appendAttributes (const FChar& next_attr)
+{
+  // Encodes changed colors and attributes as one SGR sequence
+
+  const auto& next = next_attr.attr.bit;
+  const auto& term = term_attribute.attr.bit;
+
+  if ( next_attr.fg_color == term_attribute.fg_color
+    && next_attr.bg_color == term_attribute.bg_color
+    && next_attr.attr.byte[0] == term_attribute.attr.byte[0]
+    && next.crossed_out == term.crossed_out
+    && next.dbl_underline == term.dbl_underline )
+    return;
+
+  std::string sgr{"\033[0"};
+
+  if ( next.bold )
+    sgr += ";1";
+
+  if ( next.dim )
+    sgr += ";2";
+
+  if ( next.italic )
+    sgr += ";3";
+
+  if ( next.underline )
+    sgr += ";4";
+
+  if ( next.blink )
+    sgr += ";5";
+
+  if ( next.reverse || next.standout )
+    sgr += ";7";
+
+  if ( next.invisible )
+    sgr += ";8";
+
+  if ( next.crossed_out )
+    sgr += ";9";
+
+  if ( next.dbl_underline )
+    sgr += ";21";
+
+  // FColor uses the VGA color order for the first 16 colors
+  if ( next_attr.fg_color != FColor::Default )
+    sgr += ";38;5;" + std::to_string(uInt16(FOptiAttr::vga2ansi(next_attr.fg_color)));
+
+  if ( next_attr.bg_color != FColor::Default )
+    sgr += ";48;5;" + std::to_string(uInt16(FOptiAttr::vga2ansi(next_attr.bg_color)));
+
+  appendOutputBuffer (sgr + "m");
+  term_attribute.fg_color = next_attr.fg_color;
+  term_attribute.bg_color = next_attr.bg_color;
+  term_attribute.attr = next_attr.attr;
+}
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::appendOutputBuffer (const std::string& str)
+{
+  output_buffer += str;
+  byte_count += str.length();
+}
+
+}  // namespace finalcut
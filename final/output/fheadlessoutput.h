@@ -0,0 +1,342 @@
+/***********************************************************************
+* fheadlessoutput.h - Virtual terminal output into memory              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ *     ▕▔▔▔▔▔▔▔▔▔▏
+ *     ▕ FOutput ▏
+ *     ▕▁▁▁▁▁▁▁▁▁▏
+ *          ▲
+ *          │
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FHeadlessOutput ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// FHeadlessOutput renders the virtual terminal into an in-memory cell
+// grid and encodes each frame as an ANSI byte stream for a byte sink.
+// No terminal is required, so screens can be measured in frames and
+// bytes per frame. The first FVTerm object selects the output:
+//
+//   finalcut::FVTerm vterm{finalcut::outputClass<FHeadlessOutput>{}};
+
+#ifndef FHEADLESSOUTPUT_H
+#define FHEADLESSOUTPUT_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "final/output/foutput.h"
+#include "final/util/fpoint.h"
+#include "final/util/fsize.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FHeadlessOutput
+//----------------------------------------------------------------------
+
+class FHeadlessOutput final : public FOutput
+{
+  public:
+    // Using-declaration
+    using FByteSink = std::function<void(const char*, std::size_t)>;
+
+    // Constructor
+    FHeadlessOutput() = default;
+
+    explicit FHeadlessOutput (const FVTerm&);
+
+    // Destructor
+    ~FHeadlessOutput() noexcept override;
+
+    // Accessors
+    auto getClassName() const -> FString override;
+    auto getColumnNumber() const -> std::size_t override;
+    auto getLineNumber() const -> std::size_t override;
+    auto getTabstop() const -> int override;
+    auto getMaxColor() const -> int override;
+    auto getEncoding() const -> Encoding override;
+    auto getKeyName (FKey) const -> FString override;
+    auto getFChar (const FPoint&) const & -> const FChar&;
+    auto getLine (int) const -> FString;
+    auto getCursorPos() const noexcept -> FPoint;
+    auto getFrameCount() const noexcept -> uInt64;
+    auto getByteCount() const noexcept -> uInt64;
+    auto getLastFrameBytes() const noexcept -> std::size_t;
+    auto getBellCount() const noexcept -> uInt64;
+
+    // Mutators
+    void setCursor (FPoint) override;
+    void setCursor (CursorMode) override;
+    void hideCursor (bool = true) override;
+    void showCursor() override;
+    void setTerminalSize (FSize) override;
+    auto setVGAFont() -> bool override;
+    auto setNewFont() -> bool override;
+    void setNonBlockingRead (bool = true) override;
+    void setByteSink (FByteSink&&);
+
+    // Inquiries
+    auto isCursorHidden() const noexcept -> bool;
+    auto isCursorHideable() const -> bool override;
+    auto isMonochron() const -> bool override;
+    auto isNewFont() const -> bool override;
+    auto isEncodable (const wchar_t&) const -> bool override;
+    auto isFlushTimeout() const -> bool override;
+    auto hasPendingOutput() const -> bool override;
+    auto hasTerminalResized() const -> bool override;
+    auto allowsTerminalSizeManipulation() const -> bool override;
+    auto canChangeColorPalette() const -> bool override;
+    auto hasHalfBlockCharacter() const -> bool override;
+    auto hasShadowCharacter() const -> bool override;
+    auto areMetaAndArrowKeysSupported() const -> bool override;
+
+    // Methods
+    void initTerminal (FVTerm::FTermArea*) override;
+    void finishTerminal() override;
+    auto updateTerminal() -> bool override;
+    void detectTerminalSize() override;
+    void commitTerminalResize() override;
+    void initScreenSettings() override;
+    auto scrollTerminalForward() -> bool override;
+    auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalForward (int, int) -> bool override;
+    auto scrollTerminalReverse (int, int) -> bool override;
+    void clearTerminalAttributes() override;
+    void clearTerminalState() override;
+    auto clearTerminal (wchar_t = L' ') -> bool override;
+    void flush() override;
+    void beep() const override;
+    void resetStatistics() noexcept;
+
+  private:
+    // Using-declaration
+    using FCellGrid = std::vector<FChar>;
+
+    // Accessors
+    auto getFSetPaletteRef() const & -> const FSetPalette& override;
+
+    // Methods
+    auto isDefaultPaletteTheme() -> bool override;
+    void redefineColorPalette() override;
+    void restoreColorPalette() override;
+    auto getBlankChar (wchar_t = L' ') const -> FChar;
+    void resizeGrid (const FSize&);
+    void clearGridLine (int);
+    auto updateTerminalLine (int) -> bool;
+    void printCharacter (int, int, const FChar&);
+    void appendCursorAddress (int, int);
+    void appendAttributes (const FChar&);
+    void appendOutputBuffer (const std::string&);
+
+    // Data members
+    FVTerm::FTermArea*    vterm{nullptr};
+    FCellGrid             grid{};
+    FSize                 size{80, 24};
+    FPoint                term_pos{-1, -1};  // Terminal cursor position
+    FPoint                cursor_pos{-1, -1};  // Input cursor position
+    FChar                 term_attribute{};
+    std::string           output_buffer{};
+    FByteSink             byte_sink{};
+    uInt64                frame_count{0};
+    uInt64                byte_count{0};
+    std::size_t           last_frame_bytes{0};
+    mutable uInt64        bell_count{0};
+    bool                  cursor_hidden{true};
+};
+
+// FHeadlessOutput inline functions
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getClassName() const -> FString
+{ return "FHeadlessOutput"; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getColumnNumber() const -> std::size_t
+{ return size.getWidth(); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getLineNumber() const -> std::size_t
+{ return size.getHeight(); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getTabstop() const -> int
+{ return 8; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getMaxColor() const -> int
+{ return 256; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getEncoding() const -> Encoding
+{ return Encoding::UTF8; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getCursorPos() const noexcept -> FPoint
+{ return cursor_pos; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getFrameCount() const noexcept -> uInt64
+{ return frame_count; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getByteCount() const noexcept -> uInt64
+{ return byte_count; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getLastFrameBytes() const noexcept -> std::size_t
+{ return last_frame_bytes; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getBellCount() const noexcept -> uInt64
+{ return bell_count; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::setCursor (CursorMode)
+{ }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::showCursor()
+{ return hideCursor(false); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::setVGAFont() -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::setNewFont() -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::setNonBlockingRead (bool)
+{ }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::setByteSink (FByteSink&& sink)
+{ byte_sink = std::move(sink); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isCursorHidden() const noexcept -> bool
+{ return cursor_hidden; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isCursorHideable() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isMonochron() const -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isNewFont() const -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isEncodable (const wchar_t&) const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isFlushTimeout() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::hasPendingOutput() const -> bool
+{ return ! output_buffer.empty(); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::hasTerminalResized() const -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::allowsTerminalSizeManipulation() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::canChangeColorPalette() const -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::hasHalfBlockCharacter() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::hasShadowCharacter() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::areMetaAndArrowKeysSupported() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::detectTerminalSize()
+{ }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::commitTerminalResize()
+{ }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::initScreenSettings()
+{ }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::scrollTerminalForward() -> bool
+{ return scrollTerminalForward(0, int(size.getHeight()) - 1); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::scrollTerminalReverse() -> bool
+{ return scrollTerminalReverse(0, int(size.getHeight()) - 1); }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::clearTerminalState()
+{ }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getFSetPaletteRef() const & -> const FSetPalette&
+{
+  static const FSetPalette& f = [] (FColor, int, int, int) { };
+  return f;
+}
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isDefaultPaletteTheme() -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::redefineColorPalette()
+{ }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::restoreColorPalette()
+{ }
+
+}  // namespace finalcut
+
+#endif  // FHEADLESSOUTPUT_H
@@ -100,6 +100,7 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual auto isNewFont() const -> bool = 0;
     virtual auto isEncodable (const wchar_t&) const -> bool = 0;
     virtual auto isFlushTimeout() const -> bool = 0;
+    virtual auto hasPendingOutput() const -> bool = 0;
     virtual auto hasTerminalResized() const -> bool = 0;
     virtual auto allowsTerminalSizeManipulation() const -> bool = 0;
     virtual auto canChangeColorPalette() const -> bool = 0;
@@ -116,6 +117,8 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual void initScreenSettings() = 0;
     virtual auto scrollTerminalForward() -> bool = 0;
     virtual auto scrollTerminalReverse() -> bool = 0;
+    virtual auto scrollTerminalForward (int, int) -> bool = 0;
+    virtual auto scrollTerminalReverse (int, int) -> bool = 0;
     virtual void clearTerminalAttributes() = 0;
     virtual void clearTerminalState() = 0;
     virtual auto clearTerminal (wchar_t = L' ') -> bool = 0;
@@ -22,6 +22,8 @@
 
 #include <array>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "final/fc.h"
 #include "final/ftypes.h"
@@ -59,6 +61,35 @@ auto FCharMap::getCharEncodeMap() -> CharEncodeType&
   return character;
 }
 
+//----------------------------------------------------------------------
+auto FCharMap::getCharEncodeIndex (wchar_t c) -> std::size_t
+{
+  // Returns the position of c in the 'character' array or NOT_FOUND.
+  // Only the unicode column is indexed, which never changes, so
+  // the encoding columns can still be adjusted after the index has
+  // been built during the terminal initialization.
+
+  static const auto& index = createCharEncodeIndex();
+  constexpr uInt8 EMPTY{0xff};
+  uInt8 pos{EMPTY};
+  const auto code = uInt32(c);
+
+  if ( code < 0x10000 && index.page_slot[code >> 8] != 0 )
+  {
+    const auto& page = index.dense[index.page_slot[code >> 8] - 1];
+    pos = page[code & 0xff];
+  }
+  else
+  {
+    const auto iter = index.sparse.find(c);
+
+    if ( iter != index.sparse.end() )
+      pos = iter->second;
+  }
+
+  return ( pos == EMPTY ) ? NOT_FOUND : std::size_t(pos);
+}
+
 //----------------------------------------------------------------------
 auto FCharMap::getDECSpecialGraphics() -> const DECGraphicsType&
 {
@@ -77,6 +108,60 @@ auto FCharMap::getHalfFullWidthMap() -> const HalfFullWidthType&
   return halfwidth_fullwidth;
 }
 
+//----------------------------------------------------------------------
+auto FCharMap::createCharEncodeIndex() -> CharEncodeIndex
+{
+  // BMP pages with many entries (ASCII/Latin-1, box drawing,
+  // newfont) get a dense 256-byte table, the rest goes into a hash
+
+  static_assert ( std::tuple_size<CharEncodeType>::value < 0xff
+                , "Character positions must fit into a byte" );
+  constexpr std::size_t min_dense_entries{8};
+  std::array<std::size_t, 256> page_count{};
+  CharEncodeIndex index{};
+
+  for (const auto& entry : character)
+  {
+    const auto code = uInt32(entry.unicode);
+
+    if ( code < 0x10000 )
+      page_count[code >> 8]++;
+  }
+
+  // Page 0 is always dense, so that ASCII is never hashed
+  page_count[0] = min_dense_entries;
+
+  for (std::size_t page{0}; page < page_count.size(); page++)
+  {
+    if ( page_count[page] < min_dense_entries )
+      continue;
+
+    DensePage dense_page{};
+    dense_page.fill(0xff);
+    index.dense.push_back(dense_page);
+    index.page_slot[page] = uInt8(index.dense.size());
+  }
+
+  for (std::size_t pos{0}; pos < character.size(); pos++)
+  {
+    const auto c = character[pos].unicode;
+    const auto code = uInt32(c);
+    const auto slot = ( code < 0x10000 ) ? index.page_slot[code >> 8] : 0;
+
+    if ( slot != 0 )
+    {
+      auto& entry = index.dense[slot - 1][code & 0xff];
+
+      if ( entry == 0xff )  // The first entry wins
+        entry = uInt8(pos);
+    }
+    else
+      index.sparse.emplace(c, uInt8(pos));
+  }
+
+  return index;
+}
+
 //----------------------------------------------------------------------
 FCharMap::CharEncodeType FCharMap::character =
 {{
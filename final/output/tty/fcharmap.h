@@ -28,6 +28,8 @@
 #endif
 
 #include <array>
+#include <unordered_map>
+#include <vector>
 
 #include "final/fc.h"
 #include "final/ftypes.h"
@@ -61,6 +63,9 @@ class FCharMap final
     using Cp437UcsType = std::array<std::array<wchar_t, 2>, 256>;
     using HalfFullWidthType = std::array<std::array<wchar_t, 2>, 227>;
 
+    // Constant
+    static constexpr auto NOT_FOUND = static_cast<std::size_t>(-1);
+
     // Constructors
     FCharMap() = default;
 
@@ -70,6 +75,7 @@ class FCharMap final
     static auto getCharacter ( const CharEncodeMap& char_enc
                              , const Encoding& enc ) -> const wchar_t&;
     static auto getCharEncodeMap() -> CharEncodeType&;
+    static auto getCharEncodeIndex (wchar_t) -> std::size_t;
     static auto getDECSpecialGraphics() -> const DECGraphicsType&;
     static auto getCP437UCSMap() -> const Cp437UcsType&;
     static auto getHalfFullWidthMap() -> const HalfFullWidthType&;
@@ -79,6 +85,22 @@ class FCharMap final
                              , const Encoding& enc ) -> wchar_t&;
 
   private:
+    // Using-declaration
+    using DensePage = std::array<uInt8, 256>;
+    using PageSlots = std::array<uInt8, 256>;
+    using SparseIndex = std::unordered_map<wchar_t, uInt8>;
+
+    // Unicode to 'character' position lookup
+    struct CharEncodeIndex
+    {
+      PageSlots              page_slot{};  // BMP page -> dense page + 1
+      std::vector<DensePage> dense{};
+      SparseIndex            sparse{};
+    };
+
+    // Methods
+    static auto createCharEncodeIndex() -> CharEncodeIndex;
+
     // Data members
     static CharEncodeType          character;
     static const DECGraphicsType   dec_special_graphics;
@@ -0,0 +1,174 @@
+/***********************************************************************
+* fflushscheduler.cpp - Adapts the flush rate to the terminal          *
+*                       throughput                                     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+
+#include "final/output/tty/fflushscheduler.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline auto getMicroseconds (const TimeValue& start, const TimeValue& end) -> uInt64
+{
+  return ( end > start )
+         ? uInt64(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count())
+         : 0;
+}
+
+}  // namespace internal
+
+// static class attributes
+constexpr std::size_t FFlushScheduler::MIN_BACKLOG;
+constexpr uInt64      FFlushScheduler::MAX_DRAIN_WAIT;
+constexpr uInt64      FFlushScheduler::MIN_BLOCKED_WRITE_TIME;
+
+//----------------------------------------------------------------------
+// class FFlushScheduler
+//----------------------------------------------------------------------
+
+// public methods of FFlushScheduler
+//----------------------------------------------------------------------
+auto FFlushScheduler::getClassName() const -> FString
+{
+  return "FFlushScheduler";
+}
+
+//----------------------------------------------------------------------
+auto FFlushScheduler::getBacklogLimit() const noexcept -> std::size_t
+{
+  // Bytes the terminal can take within one frame budget
+
+  const auto frame_bytes_limit = std::size_t(throughput * frame_budget / 1'000'000);
+  return std::max(MIN_BACKLOG, frame_bytes_limit);
+}
+
+//----------------------------------------------------------------------
+auto FFlushScheduler::getDrainTime() const noexcept -> uInt64
+{
+  // Estimated time in microseconds until the terminal
+  // has taken the last frame and the queued output
+
+  if ( throughput == 0 )
+    return 0;
+
+  const auto queued = uInt64(std::max(queue_length, 0));
+  const auto usec = (uInt64(frame_bytes) + queued) * 1'000'000 / throughput;
+  return std::min(usec, MAX_DRAIN_WAIT);
+}
+
+//----------------------------------------------------------------------
+auto FFlushScheduler::canFlush (int queue) const noexcept -> bool
+{
+  // A negative queue length means that the
+  // output queue of the terminal is unknown
+
+  return queue < 0 || std::size_t(queue) <= getBacklogLimit();
+}
+
+//----------------------------------------------------------------------
+void FFlushScheduler::startWrite (const TimeValue& now, int queue) noexcept
+{
+  // The terminal is busy if it has not taken all previous output
+
+  write_start = now;
+  backpressure = queue > 0;
+
+  if ( queue > 0 && queue < queue_length )
+  {
+    // The terminal was draining during the entire time since the
+    // last write, so the drained bytes indicate its throughput
+    const auto usec = internal::getMicroseconds(write_end, now);
+    addSample (std::size_t(queue_length - queue), usec);
+  }
+}
+
+//----------------------------------------------------------------------
+void FFlushScheduler::finishWrite ( const TimeValue& now, std::size_t bytes
+                                  , bool blocked, int queue ) noexcept
+{
+  // A blocking write only returns when the terminal has taken the
+  // frame, so a slow write indicates backpressure as well
+
+  const auto usec = internal::getMicroseconds(write_start, now);
+
+  if ( blocked || usec >= MIN_BLOCKED_WRITE_TIME )
+  {
+    // The terminal could only take the frame at its own pace
+    backpressure = true;
+    addSample (bytes, usec);
+  }
+
+  frame_bytes = bytes;
+  queue_length = queue;
+  write_end = now;
+
+  if ( queue > 0 && std::size_t(queue) > getBacklogLimit() )
+    backpressure = true;
+}
+
+//----------------------------------------------------------------------
+auto FFlushScheduler::adjustFlushWait (uInt64 wait) const noexcept -> uInt64
+{
+  // Under backpressure, the next frame waits
+  // until the terminal has taken the last one
+
+  if ( ! backpressure )
+    return wait;
+
+  return std::max(wait, getDrainTime());
+}
+
+//----------------------------------------------------------------------
+void FFlushScheduler::reset() noexcept
+{
+  write_start = TimeValue{};
+  write_end = TimeValue{};
+  throughput = 0;
+  frame_bytes = 0;
+  queue_length = -1;
+  backpressure = false;
+}
+
+
+// private methods of FFlushScheduler
+//----------------------------------------------------------------------
+void FFlushScheduler::addSample (std::size_t bytes, uInt64 usec) noexcept
+{
+  if ( bytes == 0 || usec == 0 )
+    return;
+
+  const auto sample = uInt64(bytes) * 1'000'000 / usec;
+
+  if ( throughput == 0 )
+    throughput = sample;
+  else
+    throughput = (3 * throughput + sample) / 4;  // Moving average
+}
+
+}  // namespace finalcut
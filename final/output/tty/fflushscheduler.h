@@ -0,0 +1,121 @@
+/***********************************************************************
+* fflushscheduler.h - Adapts the flush rate to the terminal throughput *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FFlushScheduler ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The flush scheduler measures how fast the terminal (or a slow
+// network link in front of it) takes the written frames. Throughput
+// is only sampled while the terminal is busy: the write blocked or
+// took longer than MIN_BLOCKED_WRITE_TIME, or the tty output queue
+// had not drained before the next write. On a pseudo terminal, a
+// blocking write only returns when all bytes are taken and TIOCOUTQ
+// reports an empty queue, so the write duration is the only signal
+// there. Under such backpressure, the flush wait is extended to the
+// drain time of the last frame, and frames are held back while the
+// output queue exceeds one frame budget. Held back frames are not
+// encoded, so their changes merge into the next terminal update.
+
+#ifndef FFLUSHSCHEDULER_H
+#define FFLUSHSCHEDULER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FString;
+
+//----------------------------------------------------------------------
+// class FFlushScheduler
+//----------------------------------------------------------------------
+
+class FFlushScheduler final
+{
+  public:
+    // Constants
+    static constexpr std::size_t MIN_BACKLOG = 4096;           // Bytes
+    static constexpr uInt64 MAX_DRAIN_WAIT = 1'000'000;        // 1 s
+    static constexpr uInt64 MIN_BLOCKED_WRITE_TIME = 2'000;    // 2 ms
+
+    // Constructor
+    FFlushScheduler() = default;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getThroughput() const noexcept -> uInt64;
+    auto getBacklogLimit() const noexcept -> std::size_t;
+    auto getDrainTime() const noexcept -> uInt64;
+
+    // Mutator
+    void setFrameBudget (uInt64) noexcept;
+
+    // Inquiries
+    auto isBackpressured() const noexcept -> bool;
+    auto canFlush (int) const noexcept -> bool;
+
+    // Methods
+    void startWrite (const TimeValue&, int) noexcept;
+    void finishWrite (const TimeValue&, std::size_t, bool, int) noexcept;
+    auto adjustFlushWait (uInt64) const noexcept -> uInt64;
+    void reset() noexcept;
+
+  private:
+    // Method
+    void addSample (std::size_t, uInt64) noexcept;
+
+    // Data members
+    TimeValue    write_start{};
+    TimeValue    write_end{};
+    uInt64       frame_budget{0};  // Microseconds
+    uInt64       throughput{0};    // Bytes per second (0 = unknown)
+    std::size_t  frame_bytes{0};   // Size of the last written frame
+    int          queue_length{-1};  // Output queue after the last write
+    bool         backpressure{false};
+};
+
+// FFlushScheduler inline functions
+//----------------------------------------------------------------------
+inline auto FFlushScheduler::getThroughput() const noexcept -> uInt64
+{ return throughput; }
+
+//----------------------------------------------------------------------
+inline void FFlushScheduler::setFrameBudget (uInt64 usec) noexcept
+{ frame_budget = usec; }
+
+//----------------------------------------------------------------------
+inline auto FFlushScheduler::isBackpressured() const noexcept -> bool
+{ return backpressure; }
+
+}  // namespace finalcut
+
+#endif  // FFLUSHSCHEDULER_H
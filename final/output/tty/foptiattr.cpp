@@ -482,6 +482,15 @@ auto FOptiAttr::isNormal (const FChar& ch) -> bool
   return hasNoAttribute(ch) && ! hasColor(ch);
 }
 
+//----------------------------------------------------------------------
+auto FOptiAttr::isFakeInvisible (const FChar& ch) const -> bool
+{
+  // Invisible characters must be simulated with a space
+  // if the terminal has no secure mode
+
+  return ! F_enter_secure_mode.cap && ch.attr.bit.invisible;
+}
+
 //----------------------------------------------------------------------
 void FOptiAttr::initialize()
 {
@@ -568,7 +577,7 @@ auto FOptiAttr::vga2ansi (FColor color) -> FColor
 }
 
 //----------------------------------------------------------------------
-auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> std::string
+auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> const std::string&
 {
   const bool next_has_color = hasColor(next);
   fake_reverse = false;
@@ -578,13 +587,9 @@ auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> std::string
   detectSwitchOn (term, next);
   detectSwitchOff (term, next);
 
-  // Simulate invisible characters
-  if ( ! F_enter_secure_mode.cap && next.attr.bit.invisible )
-    next.encoded_char[0] = ' ';
-
   // Look for no changes
   if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
-    return {};
+    return attr_buf;
 
   if ( hasNoAttribute(next) )
   {
@@ -145,13 +145,14 @@ class FOptiAttr final
     void        set_orig_pair (const char[]);
     void        set_orig_orig_colors (const char[]);
 
-    // Inquiry
+    // Inquiries
     static auto isNormal (const FChar&) -> bool;
+    auto        isFakeInvisible (const FChar&) const -> bool;
 
     // Methods
     void        initialize();
     static auto vga2ansi (FColor) -> FColor;
-    auto        changeAttribute (FChar&, FChar&) -> std::string;
+    auto        changeAttribute (FChar&, FChar&) -> const std::string&;
 
   private:
     struct Capability
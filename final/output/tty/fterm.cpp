@@ -74,11 +74,15 @@ struct var
   static FTerm*      init_term_object;  // Global FTerm object
   static bool        term_initialized;  // Global init state
   static std::size_t object_counter;    // Counts the number of object instances
+  static FTerm::FStartupTime      startup_time;       // Initialization time
+  static FTerm::FStartupTimeHook  startup_time_hook;  // Reports startup_time
 };
 
 FTerm*      var::init_term_object{nullptr};
 bool        var::term_initialized{false};
 std::size_t var::object_counter{0};
+FTerm::FStartupTime     var::startup_time{};
+FTerm::FStartupTimeHook var::startup_time_hook{};
 
 }  // namespace internal
 
@@ -179,6 +183,12 @@ auto FTerm::getMaxColor() -> int
   return FTermcap::max_color;
 }
 
+//----------------------------------------------------------------------
+auto FTerm::getStartupTime() -> const FStartupTime&
+{
+  return internal::var::startup_time;
+}
+
 //----------------------------------------------------------------------
 auto FTerm::hasUTF8() -> bool
 {
@@ -298,6 +308,13 @@ void FTerm::setDblclickInterval (const uInt64 timeout)
   mouse.setDblclickInterval(timeout);
 }
 
+//----------------------------------------------------------------------
+void FTerm::setStartupTimeHook (const FStartupTimeHook& hook)
+{
+  // The hook is called after the terminal initialization
+  internal::var::startup_time_hook = hook;
+}
+
 //----------------------------------------------------------------------
 void FTerm::useAlternateScreen (bool enable)
 {
@@ -816,19 +833,13 @@ auto FTerm::charEncode (const wchar_t& c) -> wchar_t
 //----------------------------------------------------------------------
 auto FTerm::charEncode (const wchar_t& c, const Encoding& enc) -> wchar_t
 {
-  const auto& character = FCharMap::getCharEncodeMap();
-  const auto& cend = character.cend();
-  const auto& found = \
-      std::find_if ( character.cbegin(), cend
-                   , [&c] (const auto& entry)
-                     {
-                       return entry.unicode == c;
-                     } );
+  const auto pos = FCharMap::getCharEncodeIndex(c);
 
-  if ( found == cend )
+  if ( pos == FCharMap::NOT_FOUND )
     return c;
 
-  const auto& ch_enc = FCharMap::getCharacter(*found, enc);
+  const auto& character = FCharMap::getCharEncodeMap();
+  const auto& ch_enc = FCharMap::getCharacter(character[pos], enc);
 
   if ( enc == Encoding::PC && ch_enc == c )
     return finalcut::unicode_to_cp437(c);
@@ -931,6 +942,9 @@ void FTerm::init_global_values()
   {
     FTermDetection::getInstance().setTerminalDetection (false);
   }
+
+  FTermDetection::getInstance().setTerminalDetectionCache \
+      (getStartOptions().terminal_detection_cache);
 }
 
 //----------------------------------------------------------------------
@@ -1000,14 +1014,10 @@ void FTerm::init_alt_charset()
     const auto& keyChar = uChar(pair.key);
     const auto& altChar = wchar_t(vt100_alt_char[keyChar]);
     const auto& utf8char = wchar_t(pair.unicode);
-    const auto& p = std::find_if ( character.cbegin()
-                                 , character.cend()
-                                 , [&utf8char] (const auto& entry)
-                                   { return entry.unicode == utf8char; } );
-    if ( p != character.cend() )  // found in character
-    {
-      const auto item = std::size_t(std::distance(character.cbegin(), p));
+    const auto item = FCharMap::getCharEncodeIndex(utf8char);
 
+    if ( item != FCharMap::NOT_FOUND )  // found in character
+    {
       if ( altChar )                 // update alternate character set
         FCharMap::setCharacter(character[item], Encoding::VT100) = altChar;
       else                           // delete VT100 char in character
@@ -1463,7 +1473,10 @@ void FTerm::init_captureFontAndTitle()
 
   static auto& data = FTermData::getInstance();
   static auto& xterm = FTermXTerminal::getInstance();
+  const auto start_time = TimeValue::clock::now();
   xterm.captureFontAndTitle();
+  internal::var::startup_time.data_request = \
+      duration_cast<microseconds>(TimeValue::clock::now() - start_time);
   const auto& font = xterm.getFont();
   const auto& title = xterm.getTitle();
 
@@ -1728,6 +1741,7 @@ void FTerm::useNormalScreenBuffer()
 void FTerm::init()
 {
   internal::var::init_term_object = this;
+  const auto start_time = TimeValue::clock::now();
 
   // Initialize global values for all objects
   init_global_values();
@@ -1767,12 +1781,16 @@ void FTerm::init()
   enableMouse();
 
   // Activate meta key sends escape + terminal focus event
+  // + bracketed paste
   if ( FTermData::getInstance().isTermType(FTermType::xterm) )
   {
     FTermXTerminal::getInstance().metaSendsESC(true);
 
     if ( getStartOptions().terminal_focus_events )
       FTermXTerminal::getInstance().setFocusSupport(true);
+
+    if ( getStartOptions().bracketed_paste )
+      FTermXTerminal::getInstance().setBracketedPaste(true);
   }
 
   // switch to application escape key mode
@@ -1820,6 +1838,14 @@ void FTerm::init()
 
   // The terminal is now initialized
   internal::var::term_initialized = true;
+
+  // Report the startup time
+  auto& startup_time = internal::var::startup_time;
+  startup_time.total = \
+      duration_cast<microseconds>(TimeValue::clock::now() - start_time);
+
+  if ( internal::var::startup_time_hook )
+    internal::var::startup_time_hook(startup_time);
 }
 
 //----------------------------------------------------------------------
@@ -1861,7 +1887,12 @@ auto FTerm::init_terminal() const -> bool
 
   // Terminal detection
   static auto& term_detection = FTermDetection::getInstance();
+  const auto start_time = TimeValue::clock::now();
   term_detection.detect();
+  auto& startup_time = internal::var::startup_time;
+  startup_time.detection = \
+      duration_cast<microseconds>(TimeValue::clock::now() - start_time);
+  startup_time.cached = term_detection.isCachedResult();
   const auto& termtype = term_detection.getTermType();
   setTermType(termtype.toString());
   return true;
@@ -1976,9 +2007,13 @@ void FTerm::finish() const
   if ( getStartOptions().mouse_support )
     disableMouse();
 
-  // Deactivate terminal focus event + meta key sends escape
+  // Deactivate bracketed paste + terminal focus event
+  // + meta key sends escape
   if ( data.isTermType(FTermType::xterm) )
   {
+    if ( getStartOptions().bracketed_paste )
+      xterm.setBracketedPaste(false);
+
     if ( getStartOptions().terminal_focus_events )
       xterm.setFocusSupport(false);
 
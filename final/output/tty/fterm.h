@@ -111,6 +111,7 @@
 #include <cmath>
 #include <csignal>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -143,8 +144,17 @@ class FVTermBuffer;
 class FTerm final
 {
   public:
+    struct FStartupTime
+    {
+      std::chrono::microseconds detection{0};     // Terminal detection
+      std::chrono::microseconds data_request{0};  // Font and title request
+      std::chrono::microseconds total{0};         // Terminal initialization
+      bool                      cached{false};    // Cached detection replies
+    };
+
     // Using-declaration
     using FSetPalette = FColorPalette::FSetPalette;
+    using FStartupTimeHook = std::function<void(const FStartupTime&)>;
 
     // Constructor
     FTerm();
@@ -175,6 +185,7 @@ class FTerm final
     static auto getTermFileName() -> std::string;
     static auto getTabstop() -> int;
     static auto getMaxColor() -> int;
+    static auto getStartupTime() -> const FStartupTime&;
 
     // Inquiries
     static auto isRaw() -> bool;
@@ -197,6 +208,7 @@ class FTerm final
     static void unsetInsertCursor();
     static void redefineDefaultColors (bool = true);
     static void setDblclickInterval (const uInt64);
+    static void setStartupTimeHook (const FStartupTimeHook&);
     static void useAlternateScreen (bool = true);
     static auto setUTF8 (bool = true) -> bool;
     static auto unsetUTF8() -> bool;
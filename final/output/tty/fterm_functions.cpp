@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -61,6 +62,7 @@ constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
 
 // Function prototypes
 auto hasAmbiguousWidth (wchar_t) -> bool;
+auto getTerminalReplyEnd (const std::string&, std::size_t) -> std::size_t;
 
 // Data array
 const wchar_t ambiguous_width_list[] =
@@ -347,52 +349,79 @@ auto unicode_to_cp437 (wchar_t ucs) -> uChar
 
 //----------------------------------------------------------------------
 #if defined(__CYGWIN__)
-auto unicode_to_utf8 (wchar_t ucs) -> std::string
+auto unicode_to_utf8 (wchar_t ucs, char* buf) -> std::size_t
 {
   // 1 Byte (7-bit): 0xxxxxxx
   if ( ucs < 0x80 )
-    return { char(ucs) };
+  {
+    buf[0] = char(ucs);
+    return 1;
+  }
 
   // 2 byte (11-bit): 110xxxxx 10xxxxxx
   if ( ucs < 0x800 )
-    return { char(0xc0 | uChar(ucs >> 6u))
-           , char(0x80 | uChar(ucs & 0x3f)) };
+  {
+    buf[0] = char(0xc0 | uChar(ucs >> 6u));
+    buf[1] = char(0x80 | uChar(ucs & 0x3f));
+    return 2;
+  }
 
   // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
-  return { char(0xe0 | uChar(ucs >> 12u))
-         , char(0x80 | uChar((ucs >> 6u) & 0x3f))
-         , char(0x80 | uChar(ucs & 0x3f)) };
+  buf[0] = char(0xe0 | uChar(ucs >> 12u));
+  buf[1] = char(0x80 | uChar((ucs >> 6u) & 0x3f));
+  buf[2] = char(0x80 | uChar(ucs & 0x3f));
+  return 3;
 }
 
 #else
-auto unicode_to_utf8 (wchar_t ucs) -> std::string
+auto unicode_to_utf8 (wchar_t ucs, char* buf) -> std::size_t
 {
   // 1 Byte (7-bit): 0xxxxxxx
   if ( ucs < 0x80 )
-    return { char(ucs) };
+  {
+    buf[0] = char(ucs);
+    return 1;
+  }
 
   // 2 byte (11-bit): 110xxxxx 10xxxxxx
   if ( ucs < 0x800 )
-    return { char(0xc0 | uChar(ucs >> 6u))
-           , char(0x80 | uChar(ucs & 0x3f)) };
+  {
+    buf[0] = char(0xc0 | uChar(ucs >> 6u));
+    buf[1] = char(0x80 | uChar(ucs & 0x3f));
+    return 2;
+  }
 
   // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
   if ( ucs < 0x10000 )
-    return { char(0xe0 | uChar(ucs >> 12u))
-           , char(0x80 | uChar((ucs >> 6u) & 0x3f))
-           , char(0x80 | uChar(ucs & 0x3f)) };
+  {
+    buf[0] = char(0xe0 | uChar(ucs >> 12u));
+    buf[1] = char(0x80 | uChar((ucs >> 6u) & 0x3f));
+    buf[2] = char(0x80 | uChar(ucs & 0x3f));
+    return 3;
+  }
 
   // 4 byte (21-bit): 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
   if ( ucs < 0x200000 )
-    return { char(0xf0 | uChar(ucs >> 18u))
-           , char(0x80 | uChar((ucs >> 12u) & 0x3f))
-           , char(0x80 | uChar((ucs >> 6u) & 0x3f))
-           , char(0x80 | uChar(ucs & 0x3f)) };
+  {
+    buf[0] = char(0xf0 | uChar(ucs >> 18u));
+    buf[1] = char(0x80 | uChar((ucs >> 12u) & 0x3f));
+    buf[2] = char(0x80 | uChar((ucs >> 6u) & 0x3f));
+    buf[3] = char(0x80 | uChar(ucs & 0x3f));
+    return 4;
+  }
 
-  return unicode_to_utf8(L'�');  // Invalid character
+  return unicode_to_utf8(L'�', buf);  // Invalid character
 }
 #endif
 
+//----------------------------------------------------------------------
+auto unicode_to_utf8 (wchar_t ucs) -> std::string
+{
+  std::array<char, UTF8_MAX_BYTES> buf{};
+  const auto length = unicode_to_utf8(ucs, buf.data());
+  return { buf.data(), length };
+}
+
 //----------------------------------------------------------------------
 auto getFullWidth (const FString& str) -> FString
 {
@@ -790,4 +819,162 @@ auto readCursorPos() -> FPoint
   return {x, y};
 }
 
+//----------------------------------------------------------------------
+auto getTerminalReplyEnd (const std::string& input, std::size_t pos) -> std::size_t
+{
+  // Returns the position after the reply that starts at pos
+  // or NOT_FOUND if the reply is not yet complete
+
+  const auto length = input.length();
+
+  if ( input[pos] != ESC[0] )  // Text (e.g. an answerback message)
+  {
+    const auto esc_pos = input.find(ESC[0], pos);
+    return ( esc_pos == std::string::npos ) ? length : esc_pos;
+  }
+
+  if ( pos + 1 >= length )
+    return NOT_FOUND;
+
+  const auto type = input[pos + 1];
+
+  if ( type == '[' )  // Control sequence introducer (CSI)
+  {
+    for (auto n = pos + 2; n < length; n++)
+    {
+      // Final byte of a control sequence
+      if ( input[n] >= 0x40 && input[n] <= 0x7e )
+        return n + 1;
+    }
+
+    return NOT_FOUND;
+  }
+
+  if ( type == ']' || type == 'P' )  // Operating system command or DCS
+  {
+    for (auto n = pos + 2; n < length; n++)
+    {
+      if ( type == ']' && input[n] == BEL[0] )
+        return n + 1;
+
+      // ESC + \ = string terminator (ST)
+      if ( input[n] == ESC[0] && n + 1 < length && input[n + 1] == '\\' )
+        return n + 2;
+    }
+
+    return NOT_FOUND;
+  }
+
+  return pos + 2;  // Two-character escape sequence
+}
+
+//----------------------------------------------------------------------
+auto isDeviceAttributesReply (const std::string& reply) -> bool
+{
+  // Device attributes (DA) have the form "CSI ... c"
+  return reply.length() > 2
+      && reply[0] == ESC[0]
+      && reply[1] == '['
+      && reply.back() == 'c';
+}
+
+//----------------------------------------------------------------------
+auto splitTerminalReplies (const std::string& input) -> std::vector<std::string>
+{
+  // Splits the terminal input into its single replies.
+  // An incomplete reply at the end is not returned.
+
+  std::vector<std::string> replies{};
+  std::size_t pos{0};
+
+  while ( pos < input.length() )
+  {
+    const auto end = getTerminalReplyEnd(input, pos);
+
+    if ( end == NOT_FOUND )
+      break;
+
+    replies.emplace_back(input.substr(pos, end - pos));
+    pos = end;
+  }
+
+  return replies;
+}
+
+//----------------------------------------------------------------------
+auto queryTerminal ( const std::string& queries
+                   , std::size_t da_queries
+                   , uInt64 timeout_us ) -> std::vector<std::string>
+{
+  // Sends all queries in a single write, followed by a request for
+  // the primary device attributes (DA1). Terminals answer in order,
+  // so all replies are complete when the last DA reply has arrived.
+  // da_queries is the number of queries that are also answered with
+  // a "CSI ... c" sequence (like the secondary DA).
+
+  const int stdout_no{FTermios::getStdOut()};
+  const std::string batch{queries + ESC "[c"};
+
+  if ( write(stdout_no, batch.data(), batch.length()) < 1 )
+    return {};
+
+  std::fflush(stdout);
+  using std::chrono::microseconds;
+  using std::chrono::duration_cast;
+  constexpr microseconds idle_timeout{50'000};
+  const int stdin_no{FTermios::getStdIn()};
+  const auto expected_da_replies = da_queries + 1;
+  auto deadline = TimeValue::clock::now() + microseconds(timeout_us);
+  std::string input{};
+  std::array<char, 256> buffer{};
+
+  while ( true )
+  {
+    const auto now = TimeValue::clock::now();
+
+    if ( now >= deadline )
+      break;
+
+    const auto wait = duration_cast<microseconds>(deadline - now).count();
+    fd_set ifds{};
+    struct timeval tv{};
+    FD_ZERO(&ifds);
+    FD_SET(stdin_no, &ifds);
+    tv.tv_sec  = time_t(wait / 1'000'000);
+    tv.tv_usec = suseconds_t(wait % 1'000'000);
+
+    if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1 )
+      break;
+
+    const ssize_t bytes = read(stdin_no, buffer.data(), buffer.size());
+
+    if ( bytes <= 0 )
+      break;
+
+    input.append(buffer.data(), std::size_t(bytes));
+    const auto replies = splitTerminalReplies(input);
+    std::size_t da_replies{0};
+    bool primary_da{false};
+
+    for (const auto& reply : replies)
+    {
+      if ( ! isDeviceAttributesReply(reply) )
+        continue;
+
+      da_replies++;
+      primary_da = ( reply[2] == '?' );
+    }
+
+    if ( da_replies >= expected_da_replies )
+      break;
+
+    // Terminals that ignore a query may have already sent the final
+    // DA1 reply, so only wait a little longer for further data
+    if ( primary_da )
+      deadline = std::min(deadline, TimeValue::clock::now() + idle_timeout);
+  }
+
+  return splitTerminalReplies(input);
+}
+
 }  // namespace finalcut
@@ -35,6 +35,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "final/ftypes.h"
 
@@ -47,6 +48,9 @@ class FSize;
 class FString;
 class FVTermBuffer;
 
+// Constant
+constexpr std::size_t UTF8_MAX_BYTES = 4;  // Maximum UTF-8 sequence length
+
 // non-member function forward declarations
 auto env2uint (const std::string&) -> uInt;
 auto getExitMessage() -> std::string&;
@@ -56,12 +60,8 @@ auto isReverseNewFontchar (wchar_t) -> bool;
 auto hasFullWidthSupports() -> bool;
 auto cp437_to_unicode (uChar) -> wchar_t;
 auto unicode_to_cp437 (wchar_t) -> uChar;
-
-#if defined(__CYGWIN__)
-  auto unicode_to_utf8 (wchar_t ucs) -> std::string;
-#else
-  auto unicode_to_utf8 (wchar_t ucs) -> std::string;
-#endif
+auto unicode_to_utf8 (wchar_t, char*) -> std::size_t;
+auto unicode_to_utf8 (wchar_t) -> std::string;
 
 auto getFullWidth (const FString&) -> FString;
 auto getHalfWidth (const FString&) -> FString;
@@ -78,6 +78,9 @@ auto getPrevCharLength (const FString&, std::size_t) -> int;
 auto searchLeftCharBegin (const FString&, std::size_t) -> std::size_t;
 auto searchRightCharBegin (const FString&, std::size_t) -> std::size_t;
 auto readCursorPos() -> FPoint;
+auto isDeviceAttributesReply (const std::string&) -> bool;
+auto splitTerminalReplies (const std::string&) -> std::vector<std::string>;
+auto queryTerminal (const std::string&, std::size_t, uInt64) -> std::vector<std::string>;
 
 template<std::size_t size, typename UnaryPredicate>
 auto captureTerminalInput ( std::array<char, size>& data
@@ -646,6 +646,7 @@ FTermcap::TCapMapType FTermcap::strings =
   { nullptr, "Ss" },  // set cursor style       -> Select the DECSCUSR cursor style
   { nullptr, "sf" },  // scroll_forward         -> scroll text up (P)
   { nullptr, "sr" },  // scroll_reverse         -> scroll text down (P)
+  { nullptr, "cs" },  // change_scroll_region   -> change region to line #1 to line #2 (P)
   { nullptr, "ti" },  // enter_ca_mode          -> string to start programs using cup
   { nullptr, "te" },  // exit_ca_mode           -> strings to end programs using cup
   { nullptr, "eA" },  // enable_acs             -> enable alternate char set
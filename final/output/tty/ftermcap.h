@@ -75,7 +75,7 @@ class FTermcap final
     };
 
     // Using-declaration
-    using TCapMapType = std::array<TCapMap, 85>;
+    using TCapMapType = std::array<TCapMap, 86>;
     using PutCharFunc = int (*)(int);
     using PutStringFunc = int (*)(const std::string&);
 
@@ -169,6 +169,7 @@ class FTermData final
     auto hasCursorOptimisation() const noexcept -> bool;
     auto isCursorHidden() const noexcept -> bool;
     auto hasAlternateScreen() const noexcept -> bool;
+    auto hasSynchronizedUpdate() const noexcept -> bool;
     auto isInAlternateScreen() const noexcept -> bool;
     auto hasASCIIConsole() const noexcept -> bool;
     auto hasVT100Console() const noexcept -> bool;
@@ -190,6 +191,7 @@ class FTermData final
     void supportCursorOptimisation (bool = true) noexcept;
     void setCursorHidden (bool = true) noexcept;
     void useAlternateScreen (bool = true) noexcept;
+    void supportSynchronizedUpdate (bool = true) noexcept;
     void setAlternateScreenInUse (bool = true) noexcept;
     void setASCIIConsole (bool = true) noexcept;
     void setVT100Console (bool = true) noexcept;
@@ -245,6 +247,7 @@ class FTermData final
     bool               cursor_optimisation{true};
     bool               hidden_cursor{false};  // Global cursor hidden state
     bool               use_alternate_screen{true};
+    bool               synchronized_update{false};
     bool               alternate_screen{false};
     bool               ascii_console{false};
     bool               vt100_console{false};
@@ -345,6 +348,10 @@ inline auto FTermData::isCursorHidden() const noexcept -> bool
 inline auto FTermData::hasAlternateScreen() const noexcept -> bool
 { return use_alternate_screen; }
 
+//----------------------------------------------------------------------
+inline auto FTermData::hasSynchronizedUpdate() const noexcept -> bool
+{ return synchronized_update; }
+
 //----------------------------------------------------------------------
 inline auto FTermData::isInAlternateScreen() const noexcept -> bool
 { return alternate_screen; }
@@ -424,6 +431,10 @@ inline void FTermData::setCursorHidden (bool hidden_state) noexcept
 inline void FTermData::useAlternateScreen (bool use) noexcept
 { use_alternate_screen = use; }
 
+//----------------------------------------------------------------------
+inline void FTermData::supportSynchronizedUpdate (bool enable) noexcept
+{ synchronized_update = enable; }
+
 //----------------------------------------------------------------------
 inline void FTermData::setAlternateScreenInUse (bool in_use) noexcept
 { alternate_screen = in_use; }
@@ -24,7 +24,11 @@
   #include "final/fconfig.h"  // includes _GNU_SOURCE
 #endif
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
+#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -91,11 +95,23 @@ void FTermDetection::setTtyTypeFileName (const FString& ttytype_filename)
   ttytypename = ttytype_filename;
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::setCacheFileName (const FString& filename)
+{
+  if ( ! filename )
+    return;
+
+  cache_filename = filename;
+}
+
 //----------------------------------------------------------------------
 void FTermDetection::detect()
 {
   // Reset terminal_detection for the 2nd detectio run
   terminal_detection = true;
+  cached_result = false;
+  synchronized_update = false;
+  primary_da.clear();
 
   // Set the variable 'termtype' to the predefined type of the terminal
   getSystemTermType();
@@ -327,6 +343,13 @@ void FTermDetection::detectTerminal()
     // Initialize 256 colors terminals
     new_termtype = init_256colorTerminal();
 
+    // Query the terminal unless there are cached replies
+    if ( ! readCache() )
+    {
+      requestTerminalReplies();
+      writeCache();
+    }
+
     // Identify the terminal via the answerback-message
     new_termtype = parseAnswerbackMsg (new_termtype);
 
@@ -344,6 +367,7 @@ void FTermDetection::detectTerminal()
   // Additional termtype analysis
   //
   static auto& fterm_data = FTermData::getInstance();
+  fterm_data.supportSynchronizedUpdate (synchronized_update);
 
   // Test if the terminal is a xterm
   if ( termtype.left(5) == "xterm" || termtype.left(5) == "Eterm" )
@@ -469,84 +493,398 @@ auto FTermDetection::termtype_256color_quirks() -> FString
 }
 
 //----------------------------------------------------------------------
-auto FTermDetection::determineMaxColor (const FString& current_termtype) -> FString
+void FTermDetection::requestTerminalReplies()
 {
-  // Determine xterm maximum number of colors via OSC 4
+  // Sends all terminal queries in one batch
+  // and assigns the replies as they arrive
 
-  FString new_termtype{current_termtype};
   static const auto& fterm_data = FTermData::getInstance();
-  static auto& keyboard = FKeyboard::getInstance();
-  keyboard.setNonBlockingInput();
 
-  if ( ! color256
-    && ! fterm_data.isTermType ( FTermType::cygwin
-                               | FTermType::tera_term
-                               | FTermType::linux_con
-                               | FTermType::netbsd_con )
-    && ! getXTermColorName(FColor(0)).isEmpty() )
+  // The Linux console and older cygwin terminals knows no Sec_DA
+  const bool with_sec_da = ! fterm_data.isTermType ( FTermType::linux_con
+                                                   | FTermType::cygwin );
+  const bool with_colors = canQueryXTermColors();
+  std::string queries{ENQ};  // Answerback message
+
+  if ( with_sec_da )
   {
-    if ( ! getXTermColorName(FColor(255)).isEmpty() )
-    {
-      color256 = true;
+    queries += ESC "[>c";  // Secondary device attributes (SEC_DA)
+    queries += ESC "[?2026$p";  // Request the synchronized update mode
+  }
 
-      if ( fterm_data.isTermType(FTermType::putty) )
-        new_termtype = "putty-256color";
-      else
-        new_termtype = "xterm-256color";
-    }
-    else if ( ! getXTermColorName(FColor(87)).isEmpty() )
-    {
-      new_termtype = "xterm-88color";
-    }
-    else if ( ! getXTermColorName(FColor(15)).isEmpty() )
-    {
-      new_termtype = "xterm-16color";
-    }
+  if ( with_colors )
+  {
+    // Get xterm color names via OSC 4 to determine the palette size
+    for (const auto color : {0, 15, 87, 255})
+      queries += OSC "4;" + std::to_string(color) + ";?" BEL;
   }
 
-  keyboard.unsetNonBlockingInput();
-  return new_termtype;
+  const auto& replies = queryTerminal(queries, with_sec_da ? 1 : 0, 600'000);
+  primary_da = getPrimaryDA(replies);
+  answer_back = getAnswerbackMsg(replies);
+  sec_da = getSecDA(replies, with_sec_da);
+  xterm_palette_size = with_colors ? getXTermPaletteSize(replies) : 0;
+  synchronized_update = getSynchronizedUpdateMode(replies);
+
+  // Some terminals like cygwin or the Windows terminal
+  // have to delete the printed character '♣'
+  std::fprintf (stdout, "\r " BS);
+  std::fflush (stdout);
 }
 
 //----------------------------------------------------------------------
-auto FTermDetection::getXTermColorName (FColor color) const -> FString
+void FTermDetection::requestPrimaryDA()
 {
-  // get color
-  auto index = uInt16(color);
-  std::fprintf (stdout, OSC "4;%hu;?" BEL, index);
-  std::fflush (stdout);
-  std::array<char, 35> temp{};
-  auto pos = captureTerminalInput(temp, 150'000);
-  constexpr auto parse = "\033]4;%10hu;%509[^\n]s";
-  std::array<char, 30> buf{};
+  // Only the primary device attributes (DA1) are requested
+  // to check whether a cached entry belongs to this terminal
+
+  const auto& replies = queryTerminal({}, 0, 600'000);
+  primary_da = getPrimaryDA(replies);
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::canQueryXTermColors() const -> bool
+{
+  static const auto& fterm_data = FTermData::getInstance();
+
+  return ! color256
+      && ! fterm_data.isTermType ( FTermType::cygwin
+                                 | FTermType::tera_term
+                                 | FTermType::linux_con
+                                 | FTermType::netbsd_con );
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getPrimaryDA (const Replies& replies) const -> FString
+{
+  // The DA1 reply "CSI ? Ps ; ... c" terminates each batch
+
+  const auto& iter = std::find_if ( replies.crbegin(), replies.crend()
+                                  , [] (const auto& reply)
+                                    {
+                                      return isDeviceAttributesReply(reply)
+                                          && reply[2] == '?';
+                                    } );
+
+  if ( iter != replies.crend() )
+    return {iter->substr(2)};
+
+  return {};
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getAnswerbackMsg (const Replies& replies) const -> FString
+{
+  // The answerback message is the only reply without an escape sequence
+
+  const auto& iter = std::find_if ( replies.cbegin(), replies.cend()
+                                  , [] (const auto& reply)
+                                    { return reply[0] != ESC[0]; } );
+
+  if ( iter != replies.cend() )
+    return {*iter};
+
+  return {};
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getSecDA ( const Replies& replies
+                              , bool with_sec_da ) const -> FString
+{
+  // The first device attributes reply belongs to the SEC_DA query
+
+  if ( ! with_sec_da )
+    return {};
 
-  if ( pos > 4 && std::sscanf(temp.data(), parse, &index, buf.data()) == 2 )
+  const auto& iter = std::find_if ( replies.cbegin(), replies.cend()
+                                  , isDeviceAttributesReply );
+  constexpr auto parse = "\033[>%10d;%10d;%10dc";
+  FString sec_da_str{""};
+  int a{0};
+  int b{0};
+  int c{0};
+
+  if ( iter != replies.cend()
+    && std::sscanf(iter->c_str(), parse, &a, &b, &c) == 3 )
+    sec_da_str.sprintf("\033[>%d;%d;%dc", a, b, c);
+
+  return sec_da_str;
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getXTermPaletteSize (const Replies& replies) const -> int
+{
+  // Returns the highest answered color index + 1
+
+  int palette_size{0};
+
+  for (const auto& reply : replies)
   {
-    auto n = stringLength(buf.data());
+    uInt16 index{0};
+    int value_pos{0};
+    constexpr auto parse = "\033]4;%5hu;%n";
 
-    // BEL + '\0' = string terminator
-    if ( n >= 6 && buf[n - 1] == BEL[0] && buf[n] == '\0' )
-      buf[n - 1] = '\0';
+    if ( std::sscanf(reply.c_str(), parse, &index, &value_pos) != 1
+      || value_pos == 0 )
+      continue;
 
-    // Esc + \ = OSC string terminator (mintty)
-    if ( n >= 6 && buf[n - 2] == ESC[0] && buf[n - 1] == '\\' )
-      buf[n - 2] = '\0';
+    // BEL or ESC + \ (ST) = OSC string terminator
+    const std::size_t terminator = ( reply.back() == BEL[0] ) ? 1 : 2;
 
-    return buf.data();
+    // Ignore replies without a color name
+    if ( reply.length() > std::size_t(value_pos) + terminator )
+      palette_size = std::max(palette_size, int(index) + 1);
   }
 
+  return palette_size;
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getSynchronizedUpdateMode (const Replies& replies) const -> bool
+{
+  // DECRPM reply "CSI ? 2026 ; Ps $ y" with Ps = 1 (set), 2 (reset)
+  // or 3 (permanently set) if the terminal supports this mode
+
+  for (const auto& reply : replies)
+  {
+    int mode{0};
+    int value{0};
+    char intermediate{'\0'};
+    char final_byte{'\0'};
+    constexpr auto parse = "\033[?%5d;%1d%c%c";
+
+    if ( std::sscanf(reply.c_str(), parse, &mode, &value
+                    , &intermediate, &final_byte) == 4
+      && mode == 2026 && intermediate == '$' && final_byte == 'y' )
+      return value >= 1 && value <= 3;
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getCacheFileName() const -> std::string
+{
+  if ( ! cache_filename.isEmpty() )
+    return cache_filename.toString();
+
+  const auto& cache_home = std::getenv("XDG_CACHE_HOME");
+
+  if ( cache_home && cache_home[0] != '\0' )
+    return std::string(cache_home) + "/finalcut-terminals";
+
+  const auto& home = std::getenv("HOME");
+
+  if ( home && home[0] != '\0' )
+    return std::string(home) + "/.cache/finalcut-terminals";
+
   return {};
 }
 
+//----------------------------------------------------------------------
+auto FTermDetection::getCacheKey() const -> std::string
+{
+  // The tab-separated environment and the DA1 reply
+  // that identify a terminal
+
+  static constexpr std::array<const char*, 5> env_names
+  {{
+    "TERM_PROGRAM",
+    "TERM_PROGRAM_VERSION",
+    "COLORTERM",
+    "VTE_VERSION",
+    "XTERM_VERSION"
+  }};
+  std::string key{termtype.toString()};
+
+  for (const auto& name : env_names)
+  {
+    const auto& value = std::getenv(name);
+    key += '\t';
+
+    if ( value )
+      key += value;
+  }
+
+  // Without a live DA1 reply, a cached entry cannot be validated
+  if ( primary_da.isEmpty() )
+    return {};
+
+  key += '\t';
+  key += primary_da.toString();
+  const auto tabs = std::count(key.cbegin(), key.cend(), '\t');
+  const auto has_control_char = \
+      std::any_of ( key.cbegin(), key.cend()
+                  , [] (char ch) { return uChar(ch) < 0x20 && ch != '\t'; } );
+
+  if ( tabs != int(env_names.size() + 1) || has_control_char )
+    return {};  // Not usable as a cache key
+
+  return key;
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::readCache() -> bool
+{
+  // Gets answerback message, SEC_DA, palette size and
+  // synchronized update support from the cache
+
+  if ( ! detection_cache )
+    return false;
+
+  const auto& filename = getCacheFileName();
+
+  if ( filename.empty() )
+    return false;
+
+  // The cheap DA1 query is part of the key, so that a terminal
+  // with the same environment does not get a foreign entry
+  requestPrimaryDA();
+  const auto& key = getCacheKey();
+
+  if ( key.empty() )
+    return false;
+
+  std::FILE* fp{};
+  std::array<char, BUFSIZ> line{};
+  static const auto& fsystem = FSystem::getInstance();
+
+  if ( (fp = fsystem->fopen(filename.c_str(), "r")) == nullptr )
+    return false;
+
+  // File format (tab-separated, the key ends with the DA1 reply):
+  // <key> <answerback> <SEC_DA parameters> <palette size> <sync update>
+  while ( fgets(line.data(), int(line.size()), fp) != nullptr )
+  {
+    const std::string entry{line.data()};
+    const auto key_end = key.length();
+
+    if ( entry.compare(0, key_end, key) != 0 || entry[key_end] != '\t' )
+      continue;
+
+    const auto pos1 = entry.find('\t', key_end + 1);
+    const auto pos2 = ( pos1 == std::string::npos )
+                    ? pos1 : entry.find('\t', pos1 + 1);
+
+    if ( pos2 == std::string::npos )
+      continue;
+
+    const auto& sec_da_param = entry.substr(pos1 + 1, pos2 - pos1 - 1);
+    answer_back = entry.substr(key_end + 1, pos1 - key_end - 1);
+    sec_da = sec_da_param.empty() ? FString{""}
+                                  : FString{ESC "[>" + sec_da_param};
+    char* end{nullptr};
+    xterm_palette_size = int(std::strtol(&entry[pos2 + 1], &end, 10));
+    synchronized_update = ( end && end[0] == '\t' && end[1] == '1' );
+    cached_result = true;
+    break;
+  }
+
+  fsystem->fclose(fp);
+  return cached_result;
+}
+
+//----------------------------------------------------------------------
+void FTermDetection::writeCache() const
+{
+  // Saves the terminal replies for the next program start
+
+  if ( ! detection_cache )
+    return;
+
+  const auto& filename = getCacheFileName();
+  const auto& key = getCacheKey();
+  const auto& answer = answer_back.toString();
+  const auto has_control_char = \
+      std::any_of ( answer.cbegin(), answer.cend()
+                  , [] (char ch) { return uChar(ch) < 0x20; } );
+
+  if ( filename.empty() || key.empty() || has_control_char )
+    return;
+
+  // Keep the entries of all other terminals
+  std::vector<std::string> entries{};
+  std::FILE* fp{};
+  std::array<char, BUFSIZ> line{};
+  static const auto& fsystem = FSystem::getInstance();
+
+  if ( (fp = fsystem->fopen(filename.c_str(), "r")) != nullptr )
+  {
+    while ( fgets(line.data(), int(line.size()), fp) != nullptr )
+    {
+      const std::string entry{line.data()};
+
+      if ( entry.back() == '\n'
+        && entry.compare(0, key.length() + 1, key + '\t') != 0 )
+        entries.push_back(entry);
+    }
+
+    fsystem->fclose(fp);
+  }
+
+  constexpr std::size_t max_entries{32};
+
+  if ( entries.size() >= max_entries )
+    entries.erase(entries.begin(), entries.end() - (max_entries - 1));
+
+  const auto& sec_da_param = ( sec_da.getLength() > 3 )
+                           ? sec_da.toString().substr(3)
+                           : std::string{};
+  entries.push_back ( key + '\t' + answer + '\t' + sec_da_param + '\t'
+                    + std::to_string(xterm_palette_size) + '\t'
+                    + ( synchronized_update ? '1' : '0' ) + '\n' );
+
+  // Replace the cache file in one step
+  const auto& temp_filename = filename + "." + std::to_string(getpid());
+
+  if ( (fp = fsystem->fopen(temp_filename.c_str(), "w")) == nullptr )
+    return;
+
+  for (const auto& entry : entries)
+    fsystem->fputs(entry.c_str(), fp);
+
+  fsystem->fclose(fp);
+
+  if ( std::rename(temp_filename.c_str(), filename.c_str()) != 0 )
+    std::remove(temp_filename.c_str());
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::determineMaxColor (const FString& current_termtype) -> FString
+{
+  // Determine xterm maximum number of colors via OSC 4
+
+  FString new_termtype{current_termtype};
+  static const auto& fterm_data = FTermData::getInstance();
+
+  if ( ! canQueryXTermColors() )
+    return new_termtype;
+
+  if ( xterm_palette_size >= 256 )
+  {
+    color256 = true;
+
+    if ( fterm_data.isTermType(FTermType::putty) )
+      new_termtype = "putty-256color";
+    else
+      new_termtype = "xterm-256color";
+  }
+  else if ( xterm_palette_size >= 88 )
+  {
+    new_termtype = "xterm-88color";
+  }
+  else if ( xterm_palette_size >= 16 )
+  {
+    new_termtype = "xterm-16color";
+  }
+
+  return new_termtype;
+}
+
 //----------------------------------------------------------------------
 auto FTermDetection::parseAnswerbackMsg (const FString& current_termtype) -> FString
 {
   FString new_termtype{current_termtype};
-  static auto& keyboard = FKeyboard::getInstance();
-  keyboard.setNonBlockingInput();
-  // send ENQ and read the answerback message
-  answer_back = getAnswerbackMsg();
-  keyboard.unsetNonBlockingInput();
 
   if ( answer_back == "PuTTY" )
   {
@@ -559,11 +897,6 @@ auto FTermDetection::parseAnswerbackMsg (const FString& current_termtype) -> FSt
       new_termtype = "putty";
   }
 
-  // Some terminals like cygwin or the Windows terminal
-  // have to delete the printed character '♣'
-  std::fprintf (stdout, "\r " BS);
-  std::fflush (stdout);
-
 #if DEBUG
   if ( ! new_termtype.isEmpty() )
     termtype_Answerback = new_termtype;
@@ -572,21 +905,6 @@ auto FTermDetection::parseAnswerbackMsg (const FString& current_termtype) -> FSt
   return new_termtype;
 }
 
-//----------------------------------------------------------------------
-auto FTermDetection::getAnswerbackMsg() const -> FString
-{
-  // Send enquiry character
-  std::putchar (ENQ[0]);
-  std::fflush(stdout);
-  std::array<char, 10> temp{};
-  auto pos = captureTerminalInput(temp, 150'000);
-
-  if ( pos > 0 )
-    return temp.data();
-
-  return {};
-}
-
 //----------------------------------------------------------------------
 auto FTermDetection::parseSecDA (const FString& current_termtype) -> FString
 {
@@ -598,8 +916,6 @@ auto FTermDetection::parseSecDA (const FString& current_termtype) -> FString
     return current_termtype;
 
   // Secondary device attributes (SEC_DA) <- decTerminalID string
-  sec_da = getSecDA();
-
   if ( sec_da.getLength() < 6 )
     return current_termtype;
 
@@ -668,32 +984,6 @@ auto FTermDetection::str2int (const FString& s) const -> int
   }
 }
 
-//----------------------------------------------------------------------
-auto FTermDetection::getSecDA() const -> FString
-{
-  const auto& stdout_no{FTermios::getStdOut()};
-  const std::string SECDA{ESC "[>c"};
-
-  // Get the secondary device attributes
-  if ( write(stdout_no, SECDA.data(), SECDA.length()) == -1 )
-    return {};
-
-  std::fflush(stdout);
-  std::array<char, 40> temp{};
-  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
-  auto pos = captureTerminalInput(temp, 600'000, isWithout_c);
-  constexpr auto parse = "\033[>%10d;%10d;%10dc";
-  FString sec_da_str{""};
-  int a{0};
-  int b{0};
-  int c{0};
-
-  if ( pos > 3 && std::sscanf(temp.data(), parse, &a, &b, &c) == 3 )
-    sec_da_str.sprintf("\033[>%d;%d;%dc", a, b, c);
-
-  return sec_da_str;
-}
-
 //----------------------------------------------------------------------
 auto FTermDetection::secDA_Analysis (const FString& current_termtype) -> FString
 {
@@ -39,6 +39,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "final/fconfig.h"  // Supplies F_HAVE_GETTTYNAM if available
 #include "final/util/fstring.h"
@@ -72,11 +74,16 @@ class FTermDetection final
     // Inquiries
     auto  canDisplay256Colors() const noexcept -> bool;
     auto  hasTerminalDetection() const noexcept -> bool;
+    auto  hasTerminalDetectionCache() const noexcept -> bool;
     auto  hasSetCursorStyleSupport() const noexcept -> bool;
+    auto  hasSynchronizedUpdateSupport() const noexcept -> bool;
+    auto  isCachedResult() const noexcept -> bool;
 
     // Mutators
     void  setTerminalDetection (bool = true) noexcept;
+    void  setTerminalDetectionCache (bool = true) noexcept;
     void  setTtyTypeFileName (const FString&);
+    void  setCacheFileName (const FString&);
 
     // Methods
     void  detect();
@@ -101,6 +108,9 @@ class FTermDetection final
       int terminal_id_hardware{-1};
     };
 
+    // Using-declaration
+    using Replies = std::vector<std::string>;
+
     // Methods
     void  getSystemTermType();
     auto  getTTYtype() -> bool;
@@ -112,13 +122,22 @@ class FTermDetection final
     auto  init_256colorTerminal() -> FString;
     auto  get256colorEnvString() -> bool;
     auto  termtype_256color_quirks() -> FString;
+    void  requestTerminalReplies();
+    void  requestPrimaryDA();
+    auto  canQueryXTermColors() const -> bool;
+    auto  getPrimaryDA (const Replies&) const -> FString;
+    auto  getAnswerbackMsg (const Replies&) const -> FString;
+    auto  getSecDA (const Replies&, bool) const -> FString;
+    auto  getXTermPaletteSize (const Replies&) const -> int;
+    auto  getSynchronizedUpdateMode (const Replies&) const -> bool;
+    auto  getCacheFileName() const -> std::string;
+    auto  getCacheKey() const -> std::string;
+    auto  readCache() -> bool;
+    void  writeCache() const;
     auto  determineMaxColor (const FString&) -> FString;
-    auto  getXTermColorName (FColor) const -> FString;
     auto  parseAnswerbackMsg (const FString&) -> FString;
-    auto  getAnswerbackMsg() const -> FString;
     auto  parseSecDA (const FString&) -> FString;
     auto  str2int (const FString&) const -> int;
-    auto  getSecDA() const -> FString;
     auto  secDA_Analysis (const FString&) -> FString;
     auto  secDA_Analysis_0 (const FString&) const -> FString;
     auto  secDA_Analysis_1 (const FString&) -> FString;
@@ -142,11 +161,17 @@ class FTermDetection final
 #endif
     FString      termtype{};
     FString      ttytypename{"/etc/ttytype"};  // Default ttytype file
+    FString      cache_filename{};             // Empty = default location
     bool         decscusr_support{false};      // Preset to false
+    bool         synchronized_update{false};   // DEC private mode 2026
     bool         terminal_detection{true};     // Preset to true
+    bool         detection_cache{false};       // Preset to false
+    bool         cached_result{false};
     bool         color256{};
     FString      answer_back{};
+    FString      primary_da{};                 // DA1 reply parameters
     FString      sec_da{};
+    int          xterm_palette_size{0};        // 0 = no OSC 4 reply
     colorEnv     color_env{};
     secondaryDA  secondary_da{};
 };
@@ -183,14 +208,30 @@ inline auto FTermDetection::canDisplay256Colors() const noexcept -> bool
 inline auto FTermDetection::hasSetCursorStyleSupport() const noexcept -> bool
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasSynchronizedUpdateSupport() const noexcept -> bool
+{ return synchronized_update; }
+
 //----------------------------------------------------------------------
 inline auto FTermDetection::hasTerminalDetection() const noexcept -> bool
 { return terminal_detection; }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasTerminalDetectionCache() const noexcept -> bool
+{ return detection_cache; }
+
+//----------------------------------------------------------------------
+inline auto FTermDetection::isCachedResult() const noexcept -> bool
+{ return cached_result; }
+
 //----------------------------------------------------------------------
 inline void FTermDetection::setTerminalDetection (bool enable) noexcept
 { terminal_detection = enable; }
 
+//----------------------------------------------------------------------
+inline void FTermDetection::setTerminalDetectionCache (bool enable) noexcept
+{ detection_cache = enable; }
+
 }  // namespace finalcut
 
 #endif  // FTERMDETECTION_H
@@ -543,6 +543,7 @@ auto FTermLinux::getUnicodeMap() -> bool
   if ( fd_tty < 0 )
     return false;
 
+  font_pos_map.clear();
   screen_unicode_map.entry_ct = 0;
   screen_unicode_map.entries = nullptr;
 
@@ -574,6 +575,7 @@ auto FTermLinux::getUnicodeMap() -> bool
       return false;
   }
 
+  initFontPosMap();
   return true;
 }
 
@@ -1148,21 +1150,34 @@ inline void FTermLinux::initSpecialCharacter() const
   }
 }
 
+//----------------------------------------------------------------------
+void FTermLinux::initFontPosMap()
+{
+  // Index the unicode-to-font mapping for getFontPos()
+
+  font_pos_map.clear();
+
+  if ( ! screen_unicode_map.entries )
+    return;
+
+  const std::size_t count = screen_unicode_map.entry_ct;
+  font_pos_map.reserve(count);
+
+  for (std::size_t n{0}; n < count; n++)
+  {
+    const auto& entry = screen_unicode_map.entries[n];
+    // The first entry of a character wins
+    font_pos_map.emplace ( wchar_t(entry.unicode)
+                         , static_cast<sInt16>(entry.fontpos) );
+  }
+}
+
 //----------------------------------------------------------------------
 auto FTermLinux::getFontPos (wchar_t ucs) const -> sInt16
 {
   constexpr sInt16 NOT_FOUND = -1;
-  auto& count = screen_unicode_map.entry_ct;
-  const auto& begin = &screen_unicode_map.entries[0];
-  const auto& end = &screen_unicode_map.entries[count];
-  const auto& iter = std::find_if ( begin, end,
-                                    [&ucs] (const auto& entry)
-                                    {
-                                      return ucs == wchar_t(entry.unicode);
-                                    } );
-  return ( iter != end )
-       ? static_cast<sInt16>(iter->fontpos)
-       : NOT_FOUND;
+  const auto iter = font_pos_map.find(ucs);
+  return ( iter != font_pos_map.end() ) ? iter->second : NOT_FOUND;
 }
 
 //----------------------------------------------------------------------
@@ -1177,6 +1192,9 @@ inline void FTermLinux::deleteUnicodeMapEntries (unimapdesc& unicode_map)
 {
   delete[] unicode_map.entries;
   unicode_map.entries = nullptr;
+
+  if ( &unicode_map == &screen_unicode_map )
+    font_pos_map.clear();
 }
 
 //----------------------------------------------------------------------
@@ -193,6 +193,7 @@ class FTermLinux final
 
     // Using-declaration
     using KeyMap = std::unordered_map<Pair, FKey, PairHash, PairEqual>;
+    using FontPosMap = std::unordered_map<wchar_t, sInt16>;
 
     // Accessors
     auto  getFramebuffer_bpp() const -> int;
@@ -234,6 +235,7 @@ class FTermLinux final
     void  ctrlAltKeyCorrection();
     void  shiftCtrlAltKeyCorrection();
     void  initSpecialCharacter() const;
+    void  initFontPosMap();
     auto  getFontPos (wchar_t ucs) const -> sInt16;
     void  deleteFontData (console_font_op&);
     void  deleteUnicodeMapEntries (unimapdesc&);
@@ -248,6 +250,7 @@ class FTermLinux final
     CursorStyle      linux_console_cursor_style{};
     console_font_op  screen_font{};
     unimapdesc       screen_unicode_map{};
+    FontPosMap       font_pos_map{};
     ColorMap         saved_color_map{};
     ColorMap         cmap{};
     KeyMap           key_map{};
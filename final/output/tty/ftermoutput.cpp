@@ -20,8 +20,13 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#include <algorithm>
+#include <poll.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <unordered_map>
 
 #include "final/fobject.h"
@@ -36,9 +41,10 @@
 #include "final/output/tty/ftermios.h"
 #include "final/output/tty/ftermoutput.h"
 #include "final/output/tty/ftermxterminal.h"
-#include "final/util/char_ringbuffer.h"
 #include "final/util/fpoint.h"
+#include "final/util/frenderstatistics.h"
 #include "final/util/fsize.h"
+#include "final/util/fsystem.h"
 
 namespace finalcut
 {
@@ -60,6 +66,7 @@ FVTerm::FTermArea* FTermOutput::vterm{nullptr};
 FTermData*         FTermOutput::fterm_data{nullptr};
 constexpr uInt64   FTermOutput::MIN_FLUSH_WAIT;
 constexpr uInt64   FTermOutput::MAX_FLUSH_WAIT;
+constexpr std::size_t FTermOutput::BUFFER_SIZE;
 
 //----------------------------------------------------------------------
 // class FTermOutput
@@ -137,7 +144,18 @@ auto FTermOutput::isEncodable (const wchar_t& wide_char) const -> bool
 //----------------------------------------------------------------------
 auto FTermOutput::isFlushTimeout() const -> bool
 {
-  return FObjectTimer::isTimeout (time_last_flush, flush_wait);
+  // Under backpressure, frames are held back until the terminal
+  // has drained its output queue
+
+  return FObjectTimer::isTimeout (time_last_flush, flush_wait)
+      && ( ! flush_scheduler.isBackpressured()
+        || flush_scheduler.canFlush(getOutputQueueLength()) );
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::hasPendingOutput() const -> bool
+{
+  return output_length > 0;
 }
 
 //----------------------------------------------------------------------
@@ -290,7 +308,9 @@ void FTermOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
   redefineColorPalette();
 
   vterm         = virtual_terminal;
-  output_buffer = std::make_shared<OutputBuffer>();
+  output_buffer = std::make_shared<OutputBuffer>(BUFFER_SIZE);
+  output_length = 0;
+  frame_open    = false;
   term_pos      = std::make_shared<FPoint>(-1, -1);
 
   // Hide the input cursor
@@ -306,6 +326,9 @@ void FTermOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
   // Resetting the status of terminal attributes
   clearTerminalState();
 
+  // Synchronized updates and the minimum time between two frames
+  initFrameBudget();
+
   // Initialize the last flush time
   time_last_flush = TimeValue{};
 }
@@ -313,6 +336,10 @@ void FTermOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
 //----------------------------------------------------------------------
 void FTermOutput::finishTerminal()
 {
+  // Write out the last frame
+  finishFrame();
+  writeOutputBuffer();
+
   // Restore the color palette
   restoreColorPalette();
 
@@ -330,6 +357,7 @@ auto FTermOutput::updateTerminal() -> bool
   // Updates pending changes to the terminal
 
   std::size_t changedlines = 0;
+  startFrame();
 
   for (uInt y{0}; y < uInt(vterm->height); y++)
   {
@@ -340,6 +368,8 @@ auto FTermOutput::updateTerminal() -> bool
   }
 
   vterm->has_changes = false;
+  FRenderStatistics::getInstance().count ( FRenderStatistics::Counter::UpdatedLines
+                                         , changedlines );
 
   // sets the new input cursor position
   const auto& cursor_update = updateTerminalCursor();
@@ -384,6 +414,48 @@ auto FTermOutput::scrollTerminalReverse() -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::scrollTerminalForward (int top, int bottom) -> bool
+{
+  // Scrolls the terminal lines from top to bottom up one line
+
+  const auto& sf = TCAP(t_scroll_forward);
+
+  if ( ! sf )
+    return false;
+
+  startFrame();
+
+  if ( ! setScrollRegion(top, bottom) )
+    return false;
+
+  setCursor (FPoint{0, bottom});
+  appendOutputBuffer (FTermControl{sf});
+  resetScrollRegion (top, bottom);
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::scrollTerminalReverse (int top, int bottom) -> bool
+{
+  // Scrolls the terminal lines from top to bottom down one line
+
+  const auto& sr = TCAP(t_scroll_reverse);
+
+  if ( ! sr )
+    return false;
+
+  startFrame();
+
+  if ( ! setScrollRegion(top, bottom) )
+    return false;
+
+  setCursor (FPoint{0, top});
+  appendOutputBuffer (FTermControl{sr});
+  resetScrollRegion (top, bottom);
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::clearTerminalAttributes()
 {
@@ -458,25 +530,16 @@ void FTermOutput::flush()
 
   flushTimeAdjustment();
 
-  if ( ! output_buffer || output_buffer->isEmpty()
+  if ( ! output_buffer || (output_length == 0 && ! frame_open)
     || ! (isFlushTimeout() || getFVTerm().isTerminalUpdateForced()) )
     return;
 
-  while ( ! output_buffer->isEmpty() )
-  {
-    const auto& first = output_buffer->front();
-    const auto& type = first.type;
-    const auto& data = first.data;
-
-    if ( type == OutputType::String )
-      FTerm::stringPrint (data);
-    else if ( type == OutputType::Control )
-      FTerm::paddingPrint (data);
+  finishFrame();
 
-    output_buffer->pop();
-  }
+  if ( output_length == 0 )  // The frame was empty
+    return;
 
-  std::fflush(stdout);
+  writeOutputBuffer();
   static auto& mouse = FMouseControl::getInstance();
   mouse.drawPointer();
   time_last_flush = FObjectTimer::getCurrentTime();
@@ -1221,14 +1284,14 @@ inline void FTermOutput::flushTimeAdjustment()
 
   if ( diff > milliseconds(400) )
   {
-    flush_wait = MIN_FLUSH_WAIT;  // Reset to minimum values after 400 ms
-    flush_average = MIN_FLUSH_WAIT;
-    flush_median = MIN_FLUSH_WAIT;
+    flush_wait = min_flush_wait;  // Reset to minimum values after 400 ms
+    flush_average = min_flush_wait;
+    flush_median = min_flush_wait;
   }
   else
   {
     auto usec = uInt64(duration_cast<microseconds>(diff).count());
-    usec = std::min(std::max(usec, MIN_FLUSH_WAIT), MAX_FLUSH_WAIT);
+    usec = std::min(std::max(usec, min_flush_wait), MAX_FLUSH_WAIT);
 
     if ( usec >= flush_average )
       flush_average += (usec - flush_average) / 10;
@@ -1252,6 +1315,65 @@ inline void FTermOutput::flushTimeAdjustment()
 
     flush_wait = flush_median;
   }
+
+  // Give a slow terminal time to take the last frame
+  flush_wait = flush_scheduler.adjustFlushWait(flush_wait);
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::initFrameBudget()
+{
+  // The frame budget limits the frame rate, so that several redraws
+  // within the budget are combined into one terminal update
+
+  const auto& start_options = getStartOptions();
+  const auto frame_rate = uInt64(start_options.max_frame_rate);
+  min_flush_wait = ( frame_rate > 0 )
+                 ? std::min(1'000'000 / frame_rate, MAX_FLUSH_WAIT)
+                 : 0;  // No frame rate limit
+  flush_wait = min_flush_wait;
+  flush_average = min_flush_wait;
+  flush_median = min_flush_wait;
+  flush_scheduler.setFrameBudget(min_flush_wait);
+  flush_scheduler.reset();
+
+  // Terminals with synchronized output (DEC private mode 2026)
+  // display each frame at once
+  synchronized_update = start_options.synchronized_update
+                     && fterm_data->hasSynchronizedUpdate();
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::startFrame()
+{
+  // Starts a frame that lasts until the output buffer is written
+
+  if ( frame_open )
+    return;
+
+  frame_open = true;
+
+  if ( synchronized_update )
+    appendOutputBuffer (CSI "?2026h");  // Begin synchronized update
+
+  frame_start = output_length;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::finishFrame()
+{
+  if ( ! frame_open )
+    return;
+
+  frame_open = false;
+
+  if ( ! synchronized_update )
+    return;
+
+  if ( output_length == frame_start && frame_start > 0 )
+    output_length -= std::strlen(CSI "?2026h");  // Nothing to synchronize
+  else
+    appendOutputBuffer (CSI "?2026l");  // End synchronized update
 }
 
 //----------------------------------------------------------------------
@@ -1294,9 +1416,11 @@ inline void FTermOutput::newFontChanges (FChar& next_char) const
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::charsetChanges (FChar& next_char) const
+inline void FTermOutput::charsetChanges (FChar& next_char)
 {
-  auto iter_enc_ch = next_char.encoded_char.begin();
+  // The encoded output character is only determined at output time
+
+  auto iter_enc_ch = encoded_char.begin();
   auto iter_ch = next_char.ch.cbegin();
   auto end_ch = next_char.ch.cend();
 
@@ -1322,7 +1446,7 @@ inline void FTermOutput::charsetChanges (FChar& next_char) const
   if ( ch_enc == ch )
     return;
 
-  auto& first_enc_char = next_char.encoded_char[0];
+  auto& first_enc_char = encoded_char[0];
 
   if ( ch_enc == 0 )
   {
@@ -1371,20 +1495,22 @@ inline void FTermOutput::appendCharacter (FChar& next_char)
 //----------------------------------------------------------------------
 inline void FTermOutput::appendChar (FChar& next_char)
 {
+  static const auto& opti_attr = FOptiAttr::getInstance();
   newFontChanges (next_char);
   charsetChanges (next_char);
   appendAttributes (next_char);
-  characterFilter (next_char);
 
-  for (const auto& ch : next_char.encoded_char)
+  if ( opti_attr.isFakeInvisible(next_char) )
+    encoded_char[0] = L' ';  // Simulate invisible characters
+
+  characterFilter();
+
+  for (const auto& ch : encoded_char)
   {
-    if ( ch != L'\0')
-    {
-      if ( internal::var::terminal_encoding == Encoding::UTF8 )
-        appendOutputBuffer (unicode_to_utf8(ch));
-      else
-        appendOutputBuffer (std::string(1, char(uChar(ch))));
-    }
+    if ( ch == L'\0')
+      return;
+
+    appendOutputBuffer (ch);
 
     if ( ! combined_char_support )
       return;
@@ -1462,14 +1588,14 @@ void FTermOutput::appendLowerRight (FChar& last_char)
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::characterFilter (FChar& next_char)
+inline void FTermOutput::characterFilter()
 {
   static const auto& sub_map = getFTerm().getCharSubstitutionMap();
 
   if ( sub_map.isEmpty() )
     return;
 
-  auto& first_enc_char = next_char.encoded_char[0];
+  auto& first_enc_char = encoded_char[0];
   const auto& entry = sub_map.getMappedChar(first_enc_char);
 
   if ( entry )
@@ -1477,41 +1603,204 @@ inline void FTermOutput::characterFilter (FChar& next_char)
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::checkFreeBufferSize()
+auto FTermOutput::setScrollRegion (int top, int bottom) -> bool
+{
+  // Limits scrolling to the lines from top to bottom
+
+  const int last_line = int(getLineNumber()) - 1;
+  const auto& cs = TCAP(t_change_scroll_region);
+
+  if ( top < 0 || top >= bottom || bottom > last_line )
+    return false;
+
+  const bool is_full_screen = top == 0 && bottom == last_line;
+
+  if ( ! is_full_screen && ! cs )
+    return false;
+
+  // The scrolled-in line gets the default colors
+  FChar normal_char{};
+  normal_char.fg_color = FColor::Default;
+  normal_char.bg_color = FColor::Default;
+  appendAttributes (normal_char);
+
+  if ( is_full_screen )
+    return true;
+
+  appendOutputBuffer (FTermControl{FTermcap::encodeParameter(cs, top, bottom)});
+  term_pos->setPoint(-1, -1);  // The cursor position is now undefined
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::resetScrollRegion (int top, int bottom)
+{
+  // Restores the full screen scroll region
+
+  const int last_line = int(getLineNumber()) - 1;
+
+  if ( top == 0 && bottom == last_line )
+    return;
+
+  const auto& cs = TCAP(t_change_scroll_region);
+  appendOutputBuffer (FTermControl{FTermcap::encodeParameter(cs, 0, last_line)});
+  term_pos->setPoint(-1, -1);
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasPaddingDelay (const FTermControl& ctrl) -> bool
 {
-  if ( output_buffer->isFull() )
-    flush();
+  // Termcap strings with a "$<..>" padding specification
+  // must be output by FTerm::paddingPrint()
+
+  const auto end = ctrl.data + ctrl.length;
+  const auto* iter = static_cast<const char*>(std::memchr(ctrl.data, '$', ctrl.length));
+
+  while ( iter && iter + 1 < end )
+  {
+    if ( iter[1] == '<' )
+      return true;
+
+    ++iter;
+    iter = static_cast<const char*>(std::memchr(iter, '$', std::size_t(end - iter)));
+  }
+
+  return false;
 }
 
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const FTermControl& ctrl)
 {
-  output_buffer->emplace(OutputType::Control, ctrl.string);
-  checkFreeBufferSize();
+  if ( ctrl.length == 0 )
+    return;
+
+  if ( ! hasPaddingDelay(ctrl) )
+  {
+    // Control sequence without padding is copied as raw bytes
+    appendOutputBuffer (ctrl.data, ctrl.length);
+    return;
+  }
+
+  writeOutputBuffer();
+  FTerm::paddingPrint (std::string(ctrl.data, ctrl.length));
+  std::fflush(stdout);
 }
 
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const UniChar& ch)
 {
-  appendOutputBuffer(unicode_to_utf8(wchar_t(ch)));
+  auto buf = reserveOutputBuffer(UTF8_MAX_BYTES);
+  output_length += unicode_to_utf8(wchar_t(ch), buf);
 }
 
 //----------------------------------------------------------------------
-void FTermOutput::appendOutputBuffer (std::string&& string)
+inline void FTermOutput::appendOutputBuffer (wchar_t ch)
 {
-  auto& last = output_buffer->back();
+  // The character is encoded directly into the output buffer
+
+  auto buf = reserveOutputBuffer(UTF8_MAX_BYTES);
 
-  if ( ! output_buffer->isEmpty() && last.type == OutputType::String )
+  if ( internal::var::terminal_encoding == Encoding::UTF8 )
   {
-    // Append string data to the back element
-    auto& string_buf = last.data;
-    string_buf.append(string);
+    output_length += unicode_to_utf8(ch, buf);
   }
   else
   {
-    output_buffer->emplace(OutputType::String, std::move(string));
-    checkFreeBufferSize();
+    *buf = char(uChar(ch));
+    output_length++;
   }
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::appendOutputBuffer (const char* data, std::size_t length)
+{
+  std::memcpy (reserveOutputBuffer(length), data, length);
+  output_length += length;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::reserveOutputBuffer (std::size_t length) -> char*
+{
+  // Returns the write position for length bytes. A full buffer grows
+  // instead of being written out, so that a frame never reaches the
+  // terminal in parts.
+
+  if ( length > output_buffer->size() - output_length )
+    output_buffer->resize(std::max(2 * output_buffer->size(), output_length + length));
+
+  return output_buffer->data() + output_length;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::writeOutputBuffer()
+{
+  // Writes the whole buffer content with a single system call
+
+  if ( output_length == 0 )
+    return;
+
+  std::fflush(stdout);  // Preserve the order of previous stdio output
+  flush_scheduler.startWrite ( FObjectTimer::getCurrentTime()
+                             , getOutputQueueLength() );
+  const bool blocked = writeBytes (output_buffer->data(), output_length);
+  flush_scheduler.finishWrite ( FObjectTimer::getCurrentTime()
+                              , output_length, blocked
+                              , getOutputQueueLength() );
+  FRenderStatistics::getInstance().count ( FRenderStatistics::Counter::WrittenBytes
+                                         , output_length );
+  output_length = 0;
+  frame_start = 0;  // The begin of an open frame has been written
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::writeBytes (const char* data, std::size_t length) const -> bool
+{
+  // Returns true if the terminal could not take all bytes at once
+
+  static const auto& fsys = FSystem::getInstance();
+  const int fd = fileno(stdout);
+  bool blocked{false};
+
+  while ( length > 0 )
+  {
+    const auto bytes = fsys->write(fd, data, length);
+
+    if ( bytes > 0 )
+    {
+      data += bytes;
+      length -= std::size_t(bytes);
+      blocked = blocked || length > 0;  // Partial write
+    }
+    else if ( bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+    {
+      // The output file descriptor shares the non-blocking
+      // mode with stdin - wait until the terminal can take data
+      struct pollfd pfd{fd, POLLOUT, 0};
+      ::poll (&pfd, 1, -1);
+      blocked = true;
+    }
+    else if ( bytes == 0 || errno != EINTR )
+      break;  // Output error
+  }
+
+  return blocked;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getOutputQueueLength() const -> int
+{
+  // Returns the number of bytes that the terminal has not yet taken
+  // from the tty output queue, or -1 if this is unknown
+
+#if defined(TIOCOUTQ)
+  static const auto& fsys = FSystem::getInstance();
+  int queue{0};
+
+  if ( fsys->ioctl(fileno(stdout), TIOCOUTQ, &queue) == 0 )
+    return queue;
+#endif
+
+  return -1;
+}
+
 }  // namespace finalcut
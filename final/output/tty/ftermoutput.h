@@ -40,12 +40,15 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "final/output/foutput.h"
+#include "final/output/tty/fflushscheduler.h"
 #include "final/output/tty/fterm.h"
 
 namespace finalcut
@@ -54,8 +57,6 @@ namespace finalcut
 // class forward declaration
 class FStartOptions;
 class FTermData;
-template <typename T, std::size_t Capacity>
-class FRingBuffer;
 
 //----------------------------------------------------------------------
 // class FTermOutput
@@ -75,6 +76,7 @@ class FTermOutput final : public FOutput
     // Accessors
     auto getClassName() const -> FString override;
     auto getFTerm() & -> FTerm&;
+    auto getFlushScheduler() const & -> const FFlushScheduler&;
     auto getColumnNumber() const -> std::size_t override;
     auto getLineNumber() const -> std::size_t override;
     auto getTabstop() const -> int override;
@@ -98,6 +100,7 @@ class FTermOutput final : public FOutput
     auto isNewFont() const -> bool override;
     auto isEncodable (const wchar_t&) const -> bool override;
     auto isFlushTimeout() const -> bool override;
+    auto hasPendingOutput() const -> bool override;
     auto hasTerminalResized() const -> bool override;
     auto allowsTerminalSizeManipulation() const -> bool override;
     auto canChangeColorPalette() const -> bool override;
@@ -114,6 +117,8 @@ class FTermOutput final : public FOutput
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalForward (int, int) -> bool override;
+    auto scrollTerminalReverse (int, int) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
@@ -124,7 +129,18 @@ class FTermOutput final : public FOutput
     // Constants
     struct FTermControl
     {
-      std::string string;
+      FTermControl (const std::string& str)  // implicit conversion
+        : data{str.data()}
+        , length{str.length()}
+      { }
+
+      FTermControl (const char* str)  // implicit conversion
+        : data{str}
+        , length{str ? std::strlen(str) : 0}
+      { }
+
+      const char* data;
+      std::size_t length;
     };
 
     // Enumerations
@@ -136,34 +152,15 @@ class FTermOutput final : public FOutput
       LineCompletelyPrinted
     };
 
-    enum class OutputType : uInt8  // Output data type of the terminal
-    {
-      String,
-      Control
-    };
-
-    struct OutputData
-    {
-      OutputData() = default;
-
-      OutputData (OutputType t, std::string s)
-        : type{t}
-        , data{std::move(s)}
-      { }
-
-      OutputType  type{OutputType::String};
-      std::string data{};
-    };
-
     // Constants
-    //   Upper and lower flush limit
+    //   Default frame budget and upper flush limit
     static constexpr uInt64 MIN_FLUSH_WAIT = 16'667;   //  16.6 ms = 60 Hz
     static constexpr uInt64 MAX_FLUSH_WAIT = 200'000;  // 200.0 ms = 5 Hz
-    //   Output buffer size
-    static constexpr std::size_t BUFFER_SIZE = 32'768;  // 32 KB
+    //   Initial output buffer size (large enough for a full-screen repaint)
+    static constexpr std::size_t BUFFER_SIZE = 262'144;  // 256 KB
 
     // Using-declaration
-    using OutputBuffer = FRingBuffer<OutputData, BUFFER_SIZE>;
+    using OutputBuffer = std::vector<char>;
 
     // Accessors
     auto getFSetPaletteRef() const & -> const FSetPalette& override;
@@ -195,38 +192,55 @@ class FTermOutput final : public FOutput
     auto updateTerminalLine (uInt) -> bool;
     auto updateTerminalCursor() -> bool;
     void flushTimeAdjustment();
+    void initFrameBudget();
+    void startFrame();
+    void finishFrame();
     void markAsPrinted (uInt, uInt) const;
     void markAsPrinted (uInt, uInt, uInt) const;
     void newFontChanges (FChar&) const;
-    void charsetChanges (FChar&) const;
+    void charsetChanges (FChar&);
     void appendCharacter (FChar&);
     void appendChar (FChar&);
     void appendAttributes (FChar&);
     void appendLowerRight (FChar&);
-    void characterFilter (FChar&);
-    void checkFreeBufferSize();
+    void characterFilter();
+    auto setScrollRegion (int, int) -> bool;
+    void resetScrollRegion (int, int);
+    static auto hasPaddingDelay (const FTermControl&) -> bool;
     void appendOutputBuffer (const FTermControl&);
     void appendOutputBuffer (const UniChar&);
-    void appendOutputBuffer (std::string&&);
+    void appendOutputBuffer (wchar_t);
+    void appendOutputBuffer (const char*, std::size_t);
+    auto reserveOutputBuffer (std::size_t) -> char*;
+    void writeOutputBuffer();
+    auto writeBytes (const char*, std::size_t) const -> bool;
+    auto getOutputQueueLength() const -> int;
 
     // Data members
     FTerm                         fterm{};
     static FVTerm::FTermArea*     vterm;
     static FTermData*             fterm_data;
     std::shared_ptr<OutputBuffer> output_buffer{};
+    std::size_t                   output_length{0};  // Used buffer bytes
     std::shared_ptr<FPoint>       term_pos{};  // terminal cursor position
     TimeValue                     time_last_flush{};
     FChar                         term_attribute{};
+    FUnicode                      encoded_char{};  // Encoded output character
+    std::size_t                   frame_start{0};  // Buffer bytes before the frame
     bool                          cursor_hideable{false};
     bool                          combined_char_support{false};
+    bool                          synchronized_update{false};
+    bool                          frame_open{false};
     uInt                          erase_char_length{};
     uInt                          repeat_char_length{};
     uInt                          clr_bol_length{};
     uInt                          clr_eol_length{};
     uInt                          cursor_address_length{};
+    uInt64                        min_flush_wait{MIN_FLUSH_WAIT};
     uInt64                        flush_wait{MIN_FLUSH_WAIT};
     uInt64                        flush_average{MIN_FLUSH_WAIT};
     uInt64                        flush_median{MIN_FLUSH_WAIT};
+    FFlushScheduler               flush_scheduler{};
 };
 
 // FTermOutput inline functions
@@ -238,6 +252,10 @@ inline auto FTermOutput::getClassName() const -> FString
 inline auto FTermOutput::getFTerm() & -> FTerm&
 { return fterm; }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::getFlushScheduler() const & -> const FFlushScheduler&
+{ return flush_scheduler; }
+
 //----------------------------------------------------------------------
 inline void FTermOutput::showCursor()
 { return hideCursor(false); }
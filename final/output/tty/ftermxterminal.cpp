@@ -174,6 +174,17 @@ void FTermXTerminal::setFocusSupport (bool enable)
     disableXTermFocus();
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::setBracketedPaste (bool enable)
+{
+  // activate/deactivate the bracketed paste mode
+
+  if ( enable )
+    enableXTermBracketedPaste();
+  else
+    disableXTermBracketedPaste();
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::metaSendsESC (bool enable)
 {
@@ -293,16 +304,42 @@ void FTermXTerminal::resetTitle()
 //----------------------------------------------------------------------
 void FTermXTerminal::captureFontAndTitle()
 {
+  // The font and title queries are a second batch after the terminal
+  // detection batch. They may only be sent once the detection has
+  // identified an xterm-compatible terminal (other terminals print the
+  // unknown sequences), and oscPrefix() depends on the detected
+  // terminal multiplexer.
+
   static const auto& fterm_data = FTermData::getInstance();
 
   if ( fterm_data.isTermType(FTermType::xterm | FTermType::urxvt)
     && ! fterm_data.isTermType(FTermType::rxvt) )
   {
+    const bool font_query = canCaptureXTermFont();
+    const bool title_query = canCaptureXTermTitle();
+
+    if ( ! font_query && ! title_query )
+      return;
+
     FTermios::setCaptureSendCharacters();
     static auto& keyboard = FKeyboard::getInstance();
     keyboard.setNonBlockingInput();
-    xterm_font  = captureXTermFont();
-    xterm_title = captureXTermTitle();
+
+    if ( font_query )  // Querying the terminal font
+    {
+      oscPrefix();
+      FTerm::paddingPrint (OSC "50;?" BEL);
+      oscPostfix();
+    }
+
+    if ( title_query )  // Report window title
+      FTerm::paddingPrint (CSI "21t");
+
+    std::fflush(stdout);
+    // Both replies arrive before the DA1 reply
+    const auto& replies = queryTerminal("", 0, 300'000);
+    xterm_font  = font_query ? getXTermFontReply(replies) : FString{};
+    xterm_title = title_query ? getXTermTitleReply(replies) : FString{};
     keyboard.unsetNonBlockingInput();
     FTermios::unsetCaptureSendCharacters();
   }
@@ -740,35 +777,34 @@ void FTermXTerminal::oscPostfix() const
 }
 
 //----------------------------------------------------------------------
-auto FTermXTerminal::captureXTermFont() const -> FString
+auto FTermXTerminal::canCaptureXTermFont() const -> bool
 {
   static const auto& fterm_data = FTermData::getInstance();
 
-  if ( ! fterm_data.isTermType(FTermType::xterm | FTermType::screen)
-    && ! FTermcap::osc_support )
-  {
-    return {};
-  }
+  return fterm_data.isTermType(FTermType::xterm | FTermType::screen)
+      || FTermcap::osc_support;
+}
 
-  // Querying the terminal font
-  oscPrefix();
-  FTerm::paddingPrint (OSC "50;?" BEL);
-  oscPostfix();
-  std::fflush(stdout);
-  std::array<char, 150> temp{};
-  // BEL = \a = bell character
-  auto isWithout_BEL = [] (const auto& t) { return ! std::strchr(t.data(), '\a'); };
-  auto pos = captureTerminalInput(temp, 150'000, isWithout_BEL);
+//----------------------------------------------------------------------
+auto FTermXTerminal::canCaptureXTermTitle() const -> bool
+{
+  return ! FTermData::getInstance().isTermType(FTermType::kde_konsole);
+}
 
-  if ( pos > 5 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == '5'
-               && temp[3] == '0' && temp[4] == ';' )
+//----------------------------------------------------------------------
+auto FTermXTerminal::getXTermFontReply (const std::vector<std::string>& replies) const -> FString
+{
+  for (const auto& reply : replies)
   {
     // Skip leading Esc ] 5 0 ;
-    std::string str = &temp[5];
+    if ( reply.length() <= 5 || reply.compare(0, 5, OSC "50;") != 0 )
+      continue;
+
+    std::string str = reply.substr(5);
     const std::size_t n = str.length();
 
-    // BEL + '\0' = string terminator
-    if ( n >= 5 && str[n - 1] == BEL[0] && str[n] == '\0' )
+    // BEL = string terminator
+    if ( n >= 5 && str[n - 1] == BEL[0] )
       str.erase(n - 1);
 
     return {str};
@@ -778,23 +814,15 @@ auto FTermXTerminal::captureXTermFont() const -> FString
 }
 
 //----------------------------------------------------------------------
-auto FTermXTerminal::captureXTermTitle() const -> FString
+auto FTermXTerminal::getXTermTitleReply (const std::vector<std::string>& replies) const -> FString
 {
-  if ( FTermData::getInstance().isTermType(FTermType::kde_konsole) )
-    return {};
-
-  // Report window title
-  FTerm::paddingPrint (CSI "21t");
-  std::fflush(stdout);
-  std::array<char, 512> temp{};
-  // ST = ESC + \ = string terminator
-  auto isWithout_ST  = [] (const auto& t) { return ! std::strstr(t.data(), ESC "\\"); };
-  auto pos = captureTerminalInput(temp, 150'000, isWithout_ST);
-
-  if ( pos > 6 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == 'l' )
+  for (const auto& reply : replies)
   {
     // Skip leading Esc + ] + l = OSC l
-    std::string str = &temp[3];
+    if ( reply.length() <= 6 || reply.compare(0, 3, OSC "l") != 0 )
+      continue;
+
+    std::string str = reply.substr(3);
     const std::size_t n = str.length();
 
     // Esc + \ = OSC string terminator
@@ -871,6 +899,32 @@ void FTermXTerminal::disableXTermFocus()
   focus_support = false;
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermBracketedPaste()
+{
+  // Activate the bracketed paste mode
+
+  if ( bracketed_paste )
+    return;  // The bracketed paste mode is already activated
+
+  FTerm::paddingPrint (CSI "?2004h");  // enable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermBracketedPaste()
+{
+  // Deactivate the bracketed paste mode
+
+  if ( ! bracketed_paste )
+    return;  // The bracketed paste mode was already deactivated
+
+  FTerm::paddingPrint (CSI "?2004l");  // disable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = false;
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::enableXTermMetaSendsESC()
 {
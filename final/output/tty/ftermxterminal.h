@@ -35,6 +35,9 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <string>
+#include <vector>
+
 #include "final/util/fstring.h"
 
 namespace finalcut
@@ -69,6 +72,8 @@ class FTermXTerminal final
     static void  unsetMouseSupport();
     void  setFocusSupport (bool enable = true);
     void  unsetFocusSupport();
+    void  setBracketedPaste (bool enable = true);
+    void  unsetBracketedPaste();
     void  metaSendsESC (bool = true);
 
     // Accessors
@@ -128,18 +133,23 @@ class FTermXTerminal final
     auto  canResetColor() const -> bool;
     void  oscPrefix() const;
     void  oscPostfix() const;
-    auto  captureXTermFont() const -> FString;
-    auto  captureXTermTitle() const -> FString;
+    auto  canCaptureXTermFont() const -> bool;
+    auto  canCaptureXTermTitle() const -> bool;
+    auto  getXTermFontReply (const std::vector<std::string>&) const -> FString;
+    auto  getXTermTitleReply (const std::vector<std::string>&) const -> FString;
     static void enableXTermMouse();
     static void disableXTermMouse();
     void  enableXTermFocus();
     void  disableXTermFocus();
+    void  enableXTermBracketedPaste();
+    void  disableXTermBracketedPaste();
     void  enableXTermMetaSendsESC();
     void  disableXTermMetaSendsESC();
 
     // Data members
     static bool       mouse_support;
     bool              focus_support{false};
+    bool              bracketed_paste{false};
     bool              meta_sends_esc{false};
     bool              xterm_default_colors{false};
     bool              title_was_changed{false};
@@ -218,6 +228,10 @@ inline void FTermXTerminal::unsetMouseSupport()
 inline void FTermXTerminal::unsetFocusSupport()
 { setFocusSupport (false); }
 
+//----------------------------------------------------------------------
+inline void FTermXTerminal::unsetBracketedPaste()
+{ setBracketedPaste (false); }
+
 }  // namespace finalcut
 
 #endif  // FTERMXTERMINAL_H
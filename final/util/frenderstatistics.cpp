@@ -0,0 +1,246 @@
+/***********************************************************************
+* frenderstatistics.cpp - Per-frame render counters and phase timers   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+#include "final/util/frenderstatistics.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// struct FRenderStatistics::FFrame
+//----------------------------------------------------------------------
+
+// public methods of FRenderStatistics::FFrame
+//----------------------------------------------------------------------
+auto FRenderStatistics::FFrame::getTotalTime() const noexcept -> uInt64
+{
+  return std::accumulate (phase_time.begin(), phase_time.end(), uInt64(0));
+}
+
+
+//----------------------------------------------------------------------
+// class FRenderStatistics
+//----------------------------------------------------------------------
+
+// public methods of FRenderStatistics
+//----------------------------------------------------------------------
+auto FRenderStatistics::getClassName() const -> FString
+{
+  return "FRenderStatistics";
+}
+
+//----------------------------------------------------------------------
+auto FRenderStatistics::getInstance() -> FRenderStatistics&
+{
+  static const auto& render_statistics = std::make_unique<FRenderStatistics>();
+  return *render_statistics;
+}
+
+//----------------------------------------------------------------------
+auto FRenderStatistics::getPhaseName (Phase phase) -> const char*
+{
+  static constexpr std::array<const char*, PHASES> names
+  {{ "input", "timer", "event", "draw", "compose", "encode", "flush" }};
+
+  if ( phase >= Phase::Count )
+    return "";
+
+  return names[std::size_t(phase)];
+}
+
+//----------------------------------------------------------------------
+auto FRenderStatistics::getCounterName (Counter type) -> const char*
+{
+  static constexpr std::array<const char*, COUNTERS> names
+  {{ "events", "drawn widgets", "copied cells", "updated lines"
+   , "written bytes" }};
+
+  if ( type >= Counter::Count )
+    return "";
+
+  return names[std::size_t(type)];
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::setEnable (bool enable) noexcept
+{
+  if ( enabled == enable )
+    return;
+
+  // Data from a partially measured frame is discarded
+  for (auto& value : counter)
+    value.store(0, std::memory_order_relaxed);
+
+  phase_time.fill(0);
+  phase_depth = 0;
+  enabled = enable;
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::setFrameHandler (FFrameHandler&& handler)
+{
+  frame_handler = std::move(handler);
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::startPhase (Phase phase) noexcept
+{
+  const auto now = Clock::now();
+
+  if ( phase_depth > 0 )
+    addElapsedTime(now);  // Pauses the enclosing phase
+
+  if ( phase_depth < MAX_PHASE_DEPTH )
+    phase_stack[phase_depth] = phase;
+
+  phase_depth++;
+  phase_start = now;
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::stopPhase() noexcept
+{
+  if ( phase_depth == 0 )
+    return;
+
+  const auto now = Clock::now();
+  addElapsedTime(now);
+  phase_depth--;
+  phase_start = now;  // Resumes the enclosing phase
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::finishFrame()
+{
+  // Completes the current frame and passes it to the frame handler
+
+  if ( ! enabled )
+    return;
+
+  if ( phase_depth > 0 )
+  {
+    // Assigns the time of a running phase to this frame
+    const auto now = Clock::now();
+    addElapsedTime(now);
+    phase_start = now;
+  }
+
+  if ( ! hasFrameData() )
+    return;
+
+  last_frame.number = total.number + 1;
+  last_frame.phase_time = phase_time;
+  phase_time.fill(0);
+
+  for (std::size_t i{0}; i < COUNTERS; i++)
+    last_frame.counter[i] = counter[i].exchange(0, std::memory_order_relaxed);
+
+  total.number = last_frame.number;
+
+  for (std::size_t i{0}; i < PHASES; i++)
+    total.phase_time[i] += last_frame.phase_time[i];
+
+  for (std::size_t i{0}; i < COUNTERS; i++)
+    total.counter[i] += last_frame.counter[i];
+
+  if ( frame_handler )
+    frame_handler(last_frame);
+}
+
+//----------------------------------------------------------------------
+void FRenderStatistics::reset() noexcept
+{
+  for (auto& value : counter)
+    value.store(0, std::memory_order_relaxed);
+
+  phase_time.fill(0);
+  phase_depth = 0;
+  last_frame = FFrame{};
+  total = FFrame{};
+}
+
+//----------------------------------------------------------------------
+auto FRenderStatistics::toString (const FFrame& frame) -> std::string
+{
+  // Returns a one-line summary of the frame (times in microseconds)
+
+  std::ostringstream out{};
+  out << "frame " << frame.number << ":";
+
+  for (std::size_t i{0}; i < PHASES; i++)
+  {
+    out << (( i == 0 ) ? " " : ", ")
+        << getPhaseName(Phase(i)) << " "
+        << frame.phase_time[i] / 1000 << " us";
+  }
+
+  out << " |";
+
+  for (std::size_t i{0}; i < COUNTERS; i++)
+  {
+    out << (( i == 0 ) ? " " : ", ")
+        << getCounterName(Counter(i)) << " "
+        << frame.counter[i];
+  }
+
+  return out.str();
+}
+
+
+// private methods of FRenderStatistics
+//----------------------------------------------------------------------
+inline void FRenderStatistics::addElapsedTime (Clock::time_point now) noexcept
+{
+  // Adds the time since the last phase change to the innermost phase
+
+  if ( phase_depth > MAX_PHASE_DEPTH )
+    return;
+
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  const auto phase = phase_stack[phase_depth - 1];
+  const auto elapsed = duration_cast<nanoseconds>(now - phase_start).count();
+  phase_time[std::size_t(phase)] += uInt64(elapsed);  // Monotonic clock
+}
+
+//----------------------------------------------------------------------
+auto FRenderStatistics::hasFrameData() const noexcept -> bool
+{
+  if ( std::any_of ( phase_time.begin(), phase_time.end()
+                   , [] (uInt64 time) { return time > 0; } ) )
+    return true;
+
+  return std::any_of ( counter.begin(), counter.end()
+                     , [] (const std::atomic<uInt64>& value)
+                       {
+                         return value.load(std::memory_order_relaxed) > 0;
+                       } );
+}
+
+}  // namespace finalcut
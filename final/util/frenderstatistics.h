@@ -0,0 +1,262 @@
+/***********************************************************************
+* frenderstatistics.h - Per-frame render counters and phase timers     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FRenderStatistics ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The render statistics are disabled by default. When disabled,
+// every hook costs a single flag check. Phase times are exclusive:
+// a phase that starts inside another phase (e.g. drawing during
+// event dispatch) pauses the outer phase until it ends.
+
+#ifndef FRENDERSTATISTICS_H
+#define FRENDERSTATISTICS_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FString;
+
+//----------------------------------------------------------------------
+// class FRenderStatistics
+//----------------------------------------------------------------------
+
+class FRenderStatistics final
+{
+  public:
+    // Enumerations
+    enum class Phase : std::size_t
+    {
+      Input,    // Keyboard and mouse input processing
+      Timer,    // Timer event processing
+      Event,    // Dispatch of queued, resize and close events
+      Draw,     // Drawing of widgets into their virtual windows
+      Compose,  // Adding the window layers to the virtual terminal
+      Encode,   // Encoding the changes as terminal control sequences
+      Flush,    // Writing the output buffer to the terminal
+      Count     // Number of phases
+    };
+
+    enum class Counter : std::size_t
+    {
+      Events,        // Dispatched events
+      DrawnWidgets,  // Widget draw calls
+      CopiedCells,   // Cells copied by addLayer into the virtual terminal
+      UpdatedLines,  // Terminal lines with encoded changes
+      WrittenBytes,  // Bytes written by flush()
+      Count          // Number of counters
+    };
+
+    // Constants
+    static constexpr auto PHASES = std::size_t(Phase::Count);
+    static constexpr auto COUNTERS = std::size_t(Counter::Count);
+
+    struct FFrame
+    {
+      // Accessors
+      auto getTime (Phase) const noexcept -> uInt64;
+      auto getTotalTime() const noexcept -> uInt64;
+      auto getCount (Counter) const noexcept -> uInt64;
+
+      // Data members
+      uInt64                        number{0};      // Frame number
+      std::array<uInt64, PHASES>    phase_time{};   // Nanoseconds
+      std::array<uInt64, COUNTERS>  counter{};
+    };
+
+    class FPhaseTimer;  // forward declaration
+
+    // Using-declaration
+    using FFrameHandler = std::function<void(const FFrame&)>;
+
+    // Constructor
+    FRenderStatistics() = default;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    static auto getInstance() -> FRenderStatistics&;
+    auto getLastFrame() const noexcept -> const FFrame&;
+    auto getTotal() const noexcept -> const FFrame&;
+    auto getFrameCount() const noexcept -> uInt64;
+    static auto getPhaseName (Phase) -> const char*;
+    static auto getCounterName (Counter) -> const char*;
+
+    // Mutators
+    void setEnable (bool = true) noexcept;
+    void unsetEnable() noexcept;
+    void setLogging (bool = true) noexcept;
+    void unsetLogging() noexcept;
+    void setFrameHandler (FFrameHandler&&);
+
+    // Inquiries
+    auto isEnabled() const noexcept -> bool;
+    auto isLogging() const noexcept -> bool;
+
+    // Methods
+    void count (Counter, uInt64 = 1) noexcept;
+    void startPhase (Phase) noexcept;
+    void stopPhase() noexcept;
+    void finishFrame();
+    void reset() noexcept;
+    static auto toString (const FFrame&) -> std::string;
+
+  private:
+    // Using-declaration
+    using Clock = std::chrono::steady_clock;
+
+    // Constants
+    static constexpr std::size_t MAX_PHASE_DEPTH = 16;
+
+    // Methods
+    void addElapsedTime (Clock::time_point) noexcept;
+    auto hasFrameData() const noexcept -> bool;
+
+    // Data members
+    std::array<std::atomic<uInt64>, COUNTERS>  counter{};
+    std::array<uInt64, PHASES>                 phase_time{};
+    std::array<Phase, MAX_PHASE_DEPTH>         phase_stack{};
+    std::size_t                                phase_depth{0};
+    Clock::time_point                          phase_start{};
+    FFrame                                     last_frame{};
+    FFrame                                     total{};
+    FFrameHandler                              frame_handler{};
+    bool                                       enabled{false};
+    bool                                       logging{false};
+};
+
+
+//----------------------------------------------------------------------
+// class FRenderStatistics::FPhaseTimer
+//----------------------------------------------------------------------
+
+class FRenderStatistics::FPhaseTimer final
+{
+  public:
+    // Constructor
+    explicit FPhaseTimer (Phase) noexcept;
+
+    // Disable copy constructor
+    FPhaseTimer (const FPhaseTimer&) = delete;
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FPhaseTimer&) -> FPhaseTimer& = delete;
+
+    // Destructor
+    ~FPhaseTimer() noexcept;
+
+  private:
+    // Data member
+    bool started{false};
+};
+
+
+// FRenderStatistics::FFrame inline functions
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::FFrame::getTime (Phase phase) const noexcept -> uInt64
+{ return phase_time[std::size_t(phase)]; }
+
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::FFrame::getCount (Counter type) const noexcept -> uInt64
+{ return counter[std::size_t(type)]; }
+
+// FRenderStatistics inline functions
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::getLastFrame() const noexcept -> const FFrame&
+{ return last_frame; }
+
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::getTotal() const noexcept -> const FFrame&
+{ return total; }
+
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::getFrameCount() const noexcept -> uInt64
+{ return total.number; }
+
+//----------------------------------------------------------------------
+inline void FRenderStatistics::unsetEnable() noexcept
+{ setEnable(false); }
+
+//----------------------------------------------------------------------
+inline void FRenderStatistics::setLogging (bool enable) noexcept
+{ logging = enable; }
+
+//----------------------------------------------------------------------
+inline void FRenderStatistics::unsetLogging() noexcept
+{ setLogging(false); }
+
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::isEnabled() const noexcept -> bool
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline auto FRenderStatistics::isLogging() const noexcept -> bool
+{ return logging; }
+
+//----------------------------------------------------------------------
+inline void FRenderStatistics::count (Counter type, uInt64 n) noexcept
+{
+  // Counters may also be incremented by compositing worker threads
+  if ( enabled )
+    counter[std::size_t(type)].fetch_add(n, std::memory_order_relaxed);
+}
+
+// FRenderStatistics::FPhaseTimer inline functions
+//----------------------------------------------------------------------
+inline FRenderStatistics::FPhaseTimer::FPhaseTimer (Phase phase) noexcept
+{
+  auto& stats = FRenderStatistics::getInstance();
+
+  if ( ! stats.isEnabled() )
+    return;
+
+  stats.startPhase(phase);
+  started = true;
+}
+
+//----------------------------------------------------------------------
+inline FRenderStatistics::FPhaseTimer::~FPhaseTimer() noexcept
+{
+  if ( started )
+    FRenderStatistics::getInstance().stopPhase();
+}
+
+}  // namespace finalcut
+
+#endif  // FRENDERSTATISTICS_H
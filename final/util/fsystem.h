@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <pwd.h>
+#include <sys/types.h>
 
 #include "final/ftypes.h"
 
@@ -70,6 +71,7 @@ class FSystem
     virtual auto fclose (FILE*) -> int = 0;
     virtual auto fputs (const char*, FILE*) -> int = 0;
     virtual auto putchar (int) -> int = 0;
+    virtual auto write (int, const void*, std::size_t) -> ssize_t = 0;
     virtual auto getuid() -> uid_t = 0;
     virtual auto geteuid() -> uid_t = 0;
     virtual auto getpwuid_r ( uid_t, struct passwd*, char*
@@ -162,6 +162,11 @@ class FSystemImpl : public FSystem
 #endif
     }
 
+    inline auto write (int fd, const void* buf, std::size_t count) -> ssize_t override
+    {
+      return ::write (fd, buf, count);
+    }
+
     inline auto getuid() -> uid_t override
     {
       return ::getuid();
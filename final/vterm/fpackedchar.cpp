@@ -0,0 +1,164 @@
+/***********************************************************************
+* fpackedchar.cpp - Compact character cell representation              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2023 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <functional>
+
+#include "final/vterm/fpackedchar.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FGraphemeTable
+//----------------------------------------------------------------------
+
+// public methods of FGraphemeTable
+//----------------------------------------------------------------------
+auto FGraphemeTable::intern (const FUnicode& ch) -> uInt32
+{
+  // Returns the table index of a multi-code point character cluster
+
+  FUnicode cluster{};  // Characters after the terminating null are ignored
+  const auto end = std::find(ch.cbegin(), ch.cend(), L'\0');
+  std::copy (ch.cbegin(), end, cluster.begin());
+  const auto iter = cluster_index.find(cluster);
+
+  if ( iter != cluster_index.end() )
+    return iter->second;
+
+  const auto code = uInt32(clusters.size()) | CLUSTER_FLAG;
+  clusters.push_back(cluster);
+  cluster_index.emplace(cluster, code);
+  return code;
+}
+
+//----------------------------------------------------------------------
+void FGraphemeTable::clear() noexcept
+{
+  if ( clusters.empty() )
+    return;
+
+  clusters.clear();
+  cluster_index.clear();
+}
+
+
+// private methods of FGraphemeTable
+//----------------------------------------------------------------------
+auto FGraphemeTable::FUnicodeHash::operator () (const FUnicode& ch) const noexcept -> std::size_t
+{
+  std::size_t hash{0};
+
+  for (const auto& c : ch)
+    hash = hash * 31 + std::hash<wchar_t>{}(c);
+
+  return hash;
+}
+
+
+//----------------------------------------------------------------------
+// class FPackedCharBuffer
+//----------------------------------------------------------------------
+
+// public methods of FPackedCharBuffer
+//----------------------------------------------------------------------
+void FPackedCharBuffer::resize (std::size_t size)
+{
+  data.resize(size);
+}
+
+//----------------------------------------------------------------------
+void FPackedCharBuffer::assign (const FCharVector& fchar_vector)
+{
+  // Replaces the buffer content with the packed characters
+
+  graphemes.clear();
+  data.resize(fchar_vector.size());
+  auto iter = data.begin();
+
+  for (const auto& fchar : fchar_vector)
+  {
+    *iter = pack(fchar);
+    ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+void FPackedCharBuffer::move (std::size_t from, std::size_t to, std::size_t count)
+{
+  // Moves "count" packed characters from index "from" to index "to"
+  // (the source and destination ranges may overlap)
+
+  if ( from + count > data.size() || to + count > data.size() )
+    return;
+
+  const auto source = data.begin() + std::ptrdiff_t(from);
+  const auto destination = data.begin() + std::ptrdiff_t(to);
+
+  if ( to < from )
+    std::copy (source, source + std::ptrdiff_t(count), destination);
+  else
+    std::copy_backward ( source, source + std::ptrdiff_t(count)
+                       , destination + std::ptrdiff_t(count) );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharBuffer::fill (std::size_t index, std::size_t count, const FChar& fchar)
+{
+  // Sets "count" characters from index "index" to "fchar"
+
+  if ( index + count > data.size() )
+    return;
+
+  std::fill_n (data.begin() + std::ptrdiff_t(index), count, pack(fchar));
+}
+
+//----------------------------------------------------------------------
+auto FPackedCharBuffer::pack (const FChar& fchar) -> FPackedChar
+{
+  const auto code = isSingleCodePoint(fchar.ch)
+                  ? uInt32(fchar.ch[0])
+                  : graphemes.intern(fchar.ch);
+  return { code, fchar.fg_color, fchar.bg_color, packAttribute(fchar) };
+}
+
+//----------------------------------------------------------------------
+auto FPackedCharBuffer::unpack (std::size_t index) const -> FChar
+{
+  const auto& packed = data[index];
+  FChar fchar{};
+
+  if ( FGraphemeTable::isCluster(packed.code) )
+    fchar.ch = graphemes.getCluster(packed.code);
+  else
+    fchar.ch[0] = wchar_t(packed.code);
+
+  fchar.fg_color = packed.fg_color;
+  fchar.bg_color = packed.bg_color;
+  fchar.attr.byte[0] = uInt8(packed.attr & 0xff);
+  fchar.attr.byte[1] = uInt8((packed.attr >> 8) & 0xff);
+  fchar.attr.bit.fullwidth_padding = (packed.attr >> 16) & 0x01;
+  return fchar;
+}
+
+}  // namespace finalcut
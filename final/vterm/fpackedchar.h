@@ -0,0 +1,207 @@
+/***********************************************************************
+* fpackedchar.h - Compact character cell representation                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2023 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FPackedCharBuffer ▏- -┬- -▕ FGraphemeTable ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏   :   ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                         :
+ *                         :  *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *                         └- -▕ FPackedChar ▏
+ *                             ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FPACKEDCHAR_H
+#define FPACKEDCHAR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// struct FPackedChar
+//----------------------------------------------------------------------
+
+struct FPackedChar
+{
+  uInt32 code{0};         // Code point or grapheme table index
+  FColor fg_color{};      // Foreground color
+  FColor bg_color{};      // Background color
+  uInt32 attr{0};         // Attribute bytes #0 and #1 + full-width padding
+};
+
+static_assert ( sizeof(FPackedChar) == 12, "FPackedChar must be 12 bytes" );
+
+
+//----------------------------------------------------------------------
+// class FGraphemeTable
+//----------------------------------------------------------------------
+
+class FGraphemeTable final
+{
+  public:
+    // Constant
+    static constexpr uInt32 CLUSTER_FLAG = 0x80000000;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getSize() const noexcept -> std::size_t;
+    auto getCluster (uInt32) const noexcept -> const FUnicode&;
+
+    // Inquiry
+    static auto isCluster (uInt32) noexcept -> bool;
+
+    // Methods
+    auto intern (const FUnicode&) -> uInt32;
+    void clear() noexcept;
+
+  private:
+    struct FUnicodeHash
+    {
+      auto operator () (const FUnicode&) const noexcept -> std::size_t;
+    };
+
+    // Using-declaration
+    using ClusterIndex = std::unordered_map<FUnicode, uInt32, FUnicodeHash>;
+
+    // Data members
+    std::vector<FUnicode> clusters{};
+    ClusterIndex          cluster_index{};
+};
+
+// FGraphemeTable inline functions
+//----------------------------------------------------------------------
+inline auto FGraphemeTable::getClassName() const -> FString
+{ return "FGraphemeTable"; }
+
+//----------------------------------------------------------------------
+inline auto FGraphemeTable::getSize() const noexcept -> std::size_t
+{ return clusters.size(); }
+
+//----------------------------------------------------------------------
+inline auto FGraphemeTable::getCluster (uInt32 code) const noexcept -> const FUnicode&
+{ return clusters[code & ~CLUSTER_FLAG]; }
+
+//----------------------------------------------------------------------
+inline auto FGraphemeTable::isCluster (uInt32 code) noexcept -> bool
+{ return (code & CLUSTER_FLAG) != 0; }
+
+
+//----------------------------------------------------------------------
+// class FPackedCharBuffer
+//----------------------------------------------------------------------
+
+class FPackedCharBuffer final
+{
+  public:
+    // Using-declarations
+    using FCharVector       = std::vector<FChar>;
+    using FPackedCharVector = std::vector<FPackedChar>;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getSize() const noexcept -> std::size_t;
+    auto getGraphemeTable() const & noexcept -> const FGraphemeTable&;
+
+    // Inquiry
+    auto isEqual (std::size_t, const FChar&) const noexcept -> bool;
+
+    // Methods
+    void resize (std::size_t);
+    void assign (const FCharVector&);
+    void move (std::size_t, std::size_t, std::size_t);
+    void fill (std::size_t, std::size_t, const FChar&);
+    auto pack (const FChar&) -> FPackedChar;
+    auto unpack (std::size_t) const -> FChar;
+
+  private:
+    // Methods
+    static auto packAttribute (const FChar&) noexcept -> uInt32;
+    static auto isSingleCodePoint (const FUnicode&) noexcept -> bool;
+
+    // Data members
+    FPackedCharVector data{};
+    FGraphemeTable    graphemes{};
+};
+
+// FPackedCharBuffer inline functions
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::getClassName() const -> FString
+{ return "FPackedCharBuffer"; }
+
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::getSize() const noexcept -> std::size_t
+{ return data.size(); }
+
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::getGraphemeTable() const & noexcept -> const FGraphemeTable&
+{ return graphemes; }
+
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::isEqual ( std::size_t index
+                                       , const FChar& fchar ) const noexcept -> bool
+{
+  // Same comparison as operator == (const FChar&, const FChar&)
+
+  const auto& packed = data[index];
+
+  if ( packed.fg_color != fchar.fg_color
+    || packed.bg_color != fchar.bg_color
+    || packed.attr != packAttribute(fchar) )
+    return false;
+
+  if ( FGraphemeTable::isCluster(packed.code) )
+    return isFUnicodeEqual (graphemes.getCluster(packed.code), fchar.ch);
+
+  return isSingleCodePoint(fchar.ch) && packed.code == uInt32(fchar.ch[0]);
+}
+
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::packAttribute (const FChar& fchar) noexcept -> uInt32
+{
+  return uInt32(fchar.attr.byte[0])
+       | uInt32(fchar.attr.byte[1]) << 8
+       | uInt32(fchar.attr.bit.fullwidth_padding) << 16;
+}
+
+//----------------------------------------------------------------------
+inline auto FPackedCharBuffer::isSingleCodePoint (const FUnicode& ch) noexcept -> bool
+{
+  return ( ch[0] == L'\0' || ch[1] == L'\0' )
+      && ( uInt32(ch[0]) & FGraphemeTable::CLUSTER_FLAG ) == 0;
+}
+
+}  // namespace finalcut
+
+#endif  // FPACKEDCHAR_H
@@ -20,12 +20,19 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/fstartoptions.h"
 #include "final/ftypes.h"
 #include "final/output/tty/ftermoutput.h"
 #include "final/util/flog.h"
@@ -43,14 +50,271 @@ namespace finalcut
 namespace internal
 {
 
+using FAreaOwnerMap = std::vector<const FVTerm::FTermArea*>;
+using FLineHashList = std::vector<uInt64>;
+using FLinePositionList = std::vector<std::pair<uInt64, int>>;
+
+// Areas with fewer characters are composited without worker threads
+constexpr int min_parallel_cells{1024};
+
+//----------------------------------------------------------------------
+// class FRowBandPool
+//----------------------------------------------------------------------
+
+class FRowBandPool final
+{
+  public:
+    // Using-declaration
+    using FBandFunction = std::function<void(int, int)>;
+
+    // Constructor
+    explicit FRowBandPool (std::size_t);
+
+    // Disable copy constructor
+    FRowBandPool (const FRowBandPool&) = delete;
+
+    // Destructor
+    ~FRowBandPool();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FRowBandPool&) -> FRowBandPool& = delete;
+
+    // Accessor
+    auto getThreadCount() const noexcept -> std::size_t;
+
+    // Method
+    void run (int, const FBandFunction&);
+
+  private:
+    // Methods
+    auto getBandStart (std::size_t) const noexcept -> int;
+    void waitForBands() noexcept;
+    void worker (std::size_t);
+
+    // Data members
+    std::vector<std::thread> threads{};
+    std::mutex               mutex{};
+    std::condition_variable  start_condition{};
+    std::condition_variable  done_condition{};
+    const FBandFunction*     band_function{nullptr};
+    int                      rows{0};
+    std::size_t              generation{0};
+    std::size_t              pending{0};
+    bool                     stop{false};
+};
+
+//----------------------------------------------------------------------
+FRowBandPool::FRowBandPool (std::size_t count)
+{
+  threads.reserve(count);
+
+  for (std::size_t n{0}; n < count; n++)
+    threads.emplace_back (&FRowBandPool::worker, this, n + 1);
+}
+
+//----------------------------------------------------------------------
+FRowBandPool::~FRowBandPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+
+  start_condition.notify_all();
+
+  for (auto&& thread : threads)
+    thread.join();
+}
+
+//----------------------------------------------------------------------
+inline auto FRowBandPool::getThreadCount() const noexcept -> std::size_t
+{
+  return threads.size();
+}
+
+//----------------------------------------------------------------------
+void FRowBandPool::run (int row_count, const FBandFunction& function)
+{
+  // Splits the rows into one band per thread. The calling thread
+  // processes the first band and waits for the remaining bands.
+  // A std::system_error can only be thrown before a band has started.
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    band_function = &function;
+    rows = row_count;
+    pending = threads.size();
+    generation++;
+  }
+
+  start_condition.notify_all();
+  function (0, getBandStart(1));
+  waitForBands();
+}
+
+//----------------------------------------------------------------------
+inline auto FRowBandPool::getBandStart (std::size_t band) const noexcept -> int
+{
+  const auto bands = threads.size() + 1;
+  return int(std::size_t(rows) * band / bands);
+}
+
+//----------------------------------------------------------------------
+void FRowBandPool::waitForBands() noexcept
+{
+  // The workers use the band function until pending is zero,
+  // so a failed wait terminates instead of returning early
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done_condition.wait (lock, [this] { return pending == 0; });
+  band_function = nullptr;
+}
+
+//----------------------------------------------------------------------
+void FRowBandPool::worker (std::size_t band)
+{
+  std::size_t seen_generation{0};
+
+  while ( true )
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    start_condition.wait ( lock
+                         , [this, seen_generation]
+                           {
+                             return stop || generation != seen_generation;
+                           } );
+
+    if ( stop )
+      return;
+
+    seen_generation = generation;
+    const auto& function = *band_function;
+    const int first = getBandStart(band);
+    const int last = getBandStart(band + 1);
+    lock.unlock();
+    function (first, last);
+    lock.lock();
+
+    if ( --pending == 0 )
+      done_condition.notify_one();
+  }
+}
+
 struct var
 {
-  static bool  fvterm_initialized;  // Global init state
-  static uInt8 b1_transparent_mask;
+  static bool                  fvterm_initialized;  // Global init state
+  static uInt8                 b1_transparent_mask;
+  static bool                  area_owner_changed;  // Owner map needs a rebuild
+  static FAreaOwnerMap         area_owner;          // Topmost area of each vterm cell
+  static FVTerm::FDamageRegion overlap_damage;      // Changed cells passed upwards
+  static FVTerm::FDamageRegion restore_damage;      // Cells restored from below
+  static FLineHashList         line_hashes;         // Hashes of the saved terminal lines
+  static FLineHashList         next_line_hashes;    // Hashes of the current vterm lines
+  static FLinePositionList      line_positions;      // Saved lines sorted by hash (-1 = not unique)
+  static std::unique_ptr<FRowBandPool> compositing_pool;  // Worker threads for addLayer
 };
 
-bool  var::fvterm_initialized{false};
-uInt8 var::b1_transparent_mask{};
+bool                  var::fvterm_initialized{false};
+uInt8                 var::b1_transparent_mask{};
+bool                  var::area_owner_changed{true};
+FAreaOwnerMap         var::area_owner{};
+FVTerm::FDamageRegion var::overlap_damage{};
+FVTerm::FDamageRegion var::restore_damage{};
+FLineHashList         var::line_hashes{};
+FLineHashList         var::next_line_hashes{};
+FLinePositionList      var::line_positions{};
+std::unique_ptr<FRowBandPool> var::compositing_pool{};
+
+//----------------------------------------------------------------------
+inline auto hasTransparency (const FChar& fchar) noexcept -> bool
+{
+  return (fchar.attr.byte[1] & var::b1_transparent_mask) != 0;
+}
+
+//----------------------------------------------------------------------
+void mapLinePositions (const FLineHashList& hashes)
+{
+  // Sorts the known line hashes with their line numbers,
+  // so that a line can be found by binary search
+
+  auto& positions = var::line_positions;
+  positions.clear();
+
+  for (std::size_t y{0}; y < hashes.size(); y++)
+    if ( hashes[y] != 0 )  // Skip unknown lines
+      positions.emplace_back(hashes[y], int(y));
+
+  std::sort (positions.begin(), positions.end());
+  const auto end = positions.end();
+  auto out = positions.begin();
+  auto iter = positions.begin();
+
+  while ( iter != end )
+  {
+    auto next = std::next(iter);
+
+    while ( next != end && next->first == iter->first )
+      ++next;
+
+    *out = *iter;
+
+    if ( next - iter > 1 )  // Not unique
+      out->second = -1;
+
+    ++out;
+    iter = next;
+  }
+
+  positions.erase (out, end);
+}
+
+//----------------------------------------------------------------------
+inline auto findLinePosition (uInt64 hash) noexcept -> int
+{
+  // Returns the saved line with this hash, or -1 if it
+  // does not exist or is not unique
+
+  const auto& positions = var::line_positions;
+  const auto iter = std::lower_bound ( positions.begin(), positions.end(), hash
+                                     , [] (const std::pair<uInt64, int>& entry, uInt64 h)
+                                       {
+                                         return entry.first < h;
+                                       } );
+
+  if ( iter == positions.end() || iter->first != hash )
+    return -1;
+
+  return iter->second;
+}
+
+//----------------------------------------------------------------------
+inline auto findOpaqueRunEnd (const FChar* first, const FChar* last) noexcept
+    -> const FChar*
+{
+  // Tests four characters at once to skip long opaque runs quickly
+
+  const auto mask = var::b1_transparent_mask;
+
+  while ( last - first >= 4
+       && ( ( first[0].attr.byte[1] | first[1].attr.byte[1]
+            | first[2].attr.byte[1] | first[3].attr.byte[1] ) & mask ) == 0 )
+    first += 4;
+
+  while ( first < last && (first->attr.byte[1] & mask) == 0 )
+    ++first;
+
+  return first;
+}
+
+//----------------------------------------------------------------------
+inline auto findTransparentRunEnd (const FChar* first, const FChar* last) noexcept
+    -> const FChar*
+{
+  while ( first < last && hasTransparency(*first) )
+    ++first;
+
+  return first;
+}
 
 }  // namespace internal
 
@@ -117,6 +381,13 @@ auto FVTerm::getPrintCursor() -> FPoint
   return {0, 0};  // Fallback coordinates
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::getCompositingThreads() noexcept -> std::size_t
+{
+  const auto& pool = internal::var::compositing_pool;
+  return pool ? pool->getThreadCount() : 0;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::setTerminalUpdates (TerminalUpdate refresh_state) const
 {
@@ -151,6 +422,23 @@ void FVTerm::setNonBlockingRead (bool enable)
   init_object->foutput->setNonBlockingRead (enable);
 }
 
+//----------------------------------------------------------------------
+void FVTerm::setCompositingThreads (std::size_t count)
+{
+  // Sets the number of worker threads that composite large areas
+  // in row bands into the virtual terminal (0 = no worker threads)
+
+  auto& pool = internal::var::compositing_pool;
+
+  if ( count == getCompositingThreads() )
+    return;
+
+  pool.reset();
+
+  if ( count > 0 )
+    pool = std::make_unique<internal::FRowBandPool>(count);
+}
+
 //----------------------------------------------------------------------
 void FVTerm::clearArea (wchar_t fillchar)
 {
@@ -174,7 +462,10 @@ void FVTerm::createVTerm (const FSize& size) noexcept
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   vterm = createArea(box);
-  vterm_old = createArea(box);
+  vterm_old = std::make_shared<FPackedCharBuffer>();
+  vterm_old->resize(vterm->data.size());
+  internal::var::line_hashes.clear();
+  invalidateAreaOwnerMap();
 }
 
 //----------------------------------------------------------------------
@@ -184,7 +475,8 @@ void FVTerm::resizeVTerm (const FSize& size) const noexcept
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   resizeArea (box, vterm.get());
-  resizeArea (box, vterm_old.get());
+  vterm_old->resize(vterm->data.size());
+  internal::var::line_hashes.clear();
 }
 
 //----------------------------------------------------------------------
@@ -205,12 +497,20 @@ auto FVTerm::updateTerminal() const -> bool
 {
   // Update terminal screen when modified
 
-  auto terminal_updated = canUpdateTerminalNow()
-                        ? foutput->updateTerminal()
-                        : false;
+  if ( ! canUpdateTerminalNow() )
+    return false;
+
+  FRenderStatistics::FPhaseTimer phase_timer{FRenderStatistics::Phase::Encode};
+
+  // Shifted line blocks are moved on the terminal by scrolling
+  scrollMovedTerminalLines();
+  auto terminal_updated = foutput->updateTerminal();
 
   if ( terminal_updated )
+  {
     saveCurrentVTerm();
+    internal::var::line_hashes.swap(internal::var::next_line_hashes);
+  }
 
   return terminal_updated;
 }
@@ -228,32 +528,31 @@ void FVTerm::reduceTerminalLineUpdates (uInt y)
   if ( xmin > xmax )  // No changes
     return;
 
-  const auto* first = &vterm->getFChar(int(xmin), int(y));
-  const auto* first_old = &vterm_old->getFChar(int(xmin), int(y));
+  const auto line_start = std::size_t(y) * std::size_t(vterm->width);
+  auto* first = &vterm->getFChar(int(xmin), int(y));
   auto* last = &vterm->getFChar(int(xmax), int(y));
-  const auto* last_old = &vterm_old->getFChar(int(xmax), int(y));
 
-  while ( xmin < xmax && *first == *first_old )
+  while ( xmin < xmax && vterm_old->isEqual(line_start + xmin, *first) )
   {
     xmin++;
     first++;
-    first_old++;
   }
 
-  while ( last >= first && *last == *last_old )
+  while ( last >= first && vterm_old->isEqual(line_start + xmax, *last) )
   {
     xmax--;
     last--;
-    last_old--;
   }
 
+  auto x = xmax;
+
   while ( last > first )
   {
-    if ( *last == *last_old )
+    if ( vterm_old->isEqual(line_start + x, *last) )
       last->attr.bit.no_changes = true;
 
     last--;
-    last_old--;
+    x--;
   }
 }
 
@@ -484,6 +783,7 @@ auto FVTerm::print (FTermArea* area, const FChar& term_char) const noexcept -> i
 //----------------------------------------------------------------------
 void FVTerm::flush() const
 {
+  FRenderStatistics::FPhaseTimer phase_timer{FRenderStatistics::Phase::Flush};
   foutput->flush();
 }
 
@@ -553,6 +853,8 @@ void FVTerm::resizeArea ( const FRect& box
   if ( ! area )
     return;
 
+  invalidateAreaOwnerMap();
+
   if ( width == area->width
     && height == area->height
     && rsw == area->right_shadow
@@ -614,17 +916,23 @@ void FVTerm::restoreVTerm (const FRect& box) const noexcept
     || box.getWidth() == 0 || box.getHeight() == 0 )
     return;
 
-  const auto vterm_size = FSize{ std::size_t(vterm->width)
-                               , std::size_t(vterm->height) };
+  // Only the areas below the damaged cells are added again.
+  // The region is reused, so that only its damaged lines are reset.
+  auto& damage = internal::var::restore_damage;
+  damage.clear (vterm->width, vterm->height);
+  damage.add (box);
+
+  if ( damage.isEmpty() )
+    return;
 
-  if ( vdesktop && vdesktop->reprint(box, vterm_size) )
+  if ( vdesktop && vdesktop->reprint(damage) )
     addLayer(vdesktop.get());
 
   for (auto&& win_obj : *win_list)
   {
     const auto& win = win_obj->getVWin();
 
-    if ( win && win->visible && win->layer > 0 && win->reprint(box, vterm_size) )
+    if ( win && win->visible && win->layer > 0 && win->reprint(damage) )
       addLayer(win);
   }
 }
@@ -750,17 +1058,61 @@ void FVTerm::addLayer (FTermArea* area) const noexcept
   if ( ! area || ! area->visible )
     return;
 
+  // Call the preprocessing handler methods (child area change handling)
+  callPreprocessingHandler(area);
+  addLayerLines(area);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::addLayerLines (FTermArea* area) const noexcept
+{
+  // Transmit the changed lines of area to the virtual terminal
+
+  const int width = getFullAreaWidth(area);
+  const int height = area->minimized ? area->min_height : getFullAreaHeight(area);
+  const int y_end = std::min(vterm->height - area->offset_top, height);
+  const auto& pool = internal::var::compositing_pool;
+  updateAreaOwnerMap();
+
+  if ( pool && y_end > int(pool->getThreadCount())
+    && y_end * width >= internal::min_parallel_cells )
+  {
+    // The lines are independent of each other, so that row bands
+    // can be composited in parallel with an identical result
+    try
+    {
+      pool->run ( y_end
+                , [this, area] (int first, int last)
+                  {
+                    addLayerLines (area, first, last);
+                  } );
+    }
+    catch (const std::system_error&)
+    {
+      // Locking failed before any band was started,
+      // so the calling thread processes all lines
+      addLayerLines (area, 0, y_end);
+    }
+  }
+  else
+    addLayerLines (area, 0, y_end);
+
+  vterm->has_changes = true;
+  updateVTermCursor(area);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::addLayerLines (FTermArea* area, int y_start, int y_end) const noexcept
+{
+  // Transmit the changed lines from y_start to y_end - 1
+
   const int ax = std::max(area->offset_left, 0);
   const int ol = std::max(0, -area->offset_left);  // Outside left
   const int ay = area->offset_top;
   const int width = getFullAreaWidth(area);
-  const int height = area->minimized ? area->min_height : getFullAreaHeight(area);
-  const int y_end = std::min(vterm->height - ay, height);
+  std::size_t copied_cells{0};
 
-  // Call the preprocessing handler methods (child area change handling)
-  callPreprocessingHandler(area);
-
-  for (auto y{0}; y < y_end; y++)  // Line loop
+  for (auto y{y_start}; y < y_end; y++)  // Line loop
   {
     auto& line_changes = area->changes[unsigned(y)];
     auto line_xmin = int(line_changes.xmin);
@@ -779,34 +1131,48 @@ void FVTerm::addLayer (FTermArea* area) const noexcept
       continue;
 
     // Area character
-    const auto& ac = area->getFChar(line_xmin, y);
+    const auto* ac = &area->getFChar(line_xmin, y);
 
     // Terminal character
-    auto& tc = vterm->getFChar(tx + line_xmin, ty);
+    auto* tc = &vterm->getFChar(tx + line_xmin, ty);
 
-    if ( line_changes.trans_count > 0 )
-    {
-      // Line with hidden and transparent characters
-      addAreaLineWithTransparency (&ac, &tc, length);
-    }
-    else
+    const bool has_transparency = line_changes.trans_count > 0;
+    const int first_x = tx + line_xmin;  // Terminal x-position of ac
+    int new_xmin{vterm->width};
+    int new_xmax{-1};
+    std::size_t start{0};
+
+    // Characters that are covered by an opaque character of
+    // a higher window are not copied to the virtual terminal
+    for (std::size_t i{0}; i <= length; i++)
     {
-      // Line has only covered characters
-      putAreaLine (ac, tc, length);
+      if ( i < length && ! isCoveredCharacter(area, first_x + int(i), ty) )
+        continue;
+
+      if ( i > start )
+      {
+        addAreaLine (ac + start, tc + start, i - start, has_transparency);
+        copied_cells += i - start;
+        new_xmin = std::min(new_xmin, first_x + int(start));
+        new_xmax = first_x + int(i) - 1;
+      }
+
+      start = i + 1;
     }
 
-    int new_xmin = ax + line_xmin - ol;
-    int new_xmax = ax + line_xmax;
+    line_changes.xmin = uInt(width);
+    line_changes.xmax = 0;
+
+    if ( new_xmin > new_xmax )  // Fully covered
+      continue;
+
     auto& vterm_changes = vterm->changes[unsigned(ty)];
     vterm_changes.xmin = std::min(vterm_changes.xmin, uInt(new_xmin));
-    new_xmax = std::min(new_xmax, vterm->width - 1);
     vterm_changes.xmax = std::max (vterm_changes.xmax, uInt(new_xmax));
-    line_changes.xmin = uInt(width);
-    line_changes.xmax = 0;
   }
 
-  vterm->has_changes = true;
-  updateVTermCursor(area);
+  FRenderStatistics::getInstance().count ( FRenderStatistics::Counter::CopiedCells
+                                         , copied_cells );
 }
 
 //----------------------------------------------------------------------
@@ -876,6 +1242,7 @@ void FVTerm::determineWindowLayers() noexcept
 {
   // Determination of the window layer for all virtual windows
 
+  invalidateAreaOwnerMap();
   const auto& win_list = getWindowList();
 
   if ( ! win_list || win_list->empty() )
@@ -892,6 +1259,15 @@ void FVTerm::determineWindowLayers() noexcept
   }
 }
 
+//----------------------------------------------------------------------
+void FVTerm::invalidateAreaOwnerMap() noexcept
+{
+  // The window placement has changed, so the map with
+  // the topmost window of each cell must be rebuilt
+
+  internal::var::area_owner_changed = true;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::scrollAreaForward (FTermArea* area)
 {
@@ -903,11 +1279,10 @@ void FVTerm::scrollAreaForward (FTermArea* area)
   const int y_max = area->height - 1;
   const int x_max = area->width - 1;
 
+  rotateAreaLines (area, true);
+
   for (auto y{0}; y < y_max; y++)
   {
-    auto& dc = area->getFChar(0, y);  // destination character
-    const auto& sc = area->getFChar(0, y + 1);  // source character
-    putAreaLine (sc, dc, unsigned(area->width));
     auto& line_changes = area->changes[unsigned(y)];
     line_changes.xmin = 0;
     line_changes.xmax = uInt(x_max);
@@ -927,8 +1302,8 @@ void FVTerm::scrollAreaForward (FTermArea* area)
   new_line_changes.xmax = uInt(x_max);
   area->has_changes = true;
 
-  if ( area == vdesktop.get() )
-    scrollTerminalForward();  // Scrolls the terminal up one line
+  if ( canScrollTerminal(area) )  // Scrolls the terminal lines up
+    scrollTerminalForward (area->offset_top, area->offset_top + y_max);
 }
 
 //----------------------------------------------------------------------
@@ -942,11 +1317,10 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
   const int y_max = area->height - 1;
   const int x_max = area->width - 1;
 
+  rotateAreaLines (area, false);
+
   for (auto y = y_max; y > 0; y--)
   {
-    auto& dc = area->getFChar(0, y);  // destination character
-    const auto& sc = area->getFChar(0, y - 1);  // source character
-    putAreaLine (sc, dc, unsigned(area->width));
     auto& line_changes = area->changes[unsigned(y)];
     line_changes.xmin = 0;
     line_changes.xmax = uInt(x_max);
@@ -961,13 +1335,13 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
   nc.ch[1] = L'\0';
   auto& dc = area->getFChar(0, 0);  // destination character
   std::fill (&dc, &dc + area->width, nc);
-  auto& new_line_changes = area->changes[unsigned(y_max)];
+  auto& new_line_changes = area->changes[0];
   new_line_changes.xmin = 0;
   new_line_changes.xmax = uInt(x_max);
   area->has_changes = true;
 
-  if ( area == vdesktop.get() )
-    scrollTerminalReverse();  // Scrolls the terminal down one line
+  if ( canScrollTerminal(area) )  // Scrolls the terminal lines down
+    scrollTerminalReverse (area->offset_top, area->offset_top + y_max);
 }
 
 //----------------------------------------------------------------------
@@ -1048,7 +1422,10 @@ auto FVTerm::processTerminalUpdate() const -> bool
   if ( skip_one_vterm_update )
     skip_one_vterm_update = false;
   else
+  {
+    FRenderStatistics::FPhaseTimer phase_timer{FRenderStatistics::Phase::Compose};
     updateVTerm();
+  }
 
   // Update the visible terminal
   return updateTerminal();
@@ -1128,7 +1505,6 @@ inline void FVTerm::resetTextAreaToDefault ( FTermArea* area
   FChar default_char
   {
     { { L' ',  L'\0', L'\0', L'\0', L'\0' } },
-    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
     FColor::Default,
     FColor::Default,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
@@ -1137,6 +1513,16 @@ inline void FVTerm::resetTextAreaToDefault ( FTermArea* area
 
   FLineChanges unchanged { uInt(size.getWidth()), 0, 0 };
   std::fill (area->changes.begin(), area->changes.end(), unchanged);
+
+  // The lines are initially stored one after the other
+  area->line_offset.resize(size.getHeight());
+  std::size_t offset{0};
+
+  for (auto& line_start : area->line_offset)
+  {
+    line_start = offset;
+    offset += size.getWidth();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -1161,6 +1547,45 @@ inline auto FVTerm::resizeTextArea (FTermArea* area, std::size_t size) const ->
   return true;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::rotateAreaLines (FTermArea* area, bool forward) const noexcept
+{
+  // Scrolling changes only the line order of the area,
+  // the character data stays in place
+
+  const auto first_line = area->line_offset.begin();
+  const auto end_line = first_line + area->height;
+
+  if ( forward )
+    std::rotate (first_line, first_line + 1, end_line);
+  else
+    std::rotate (first_line, end_line - 1, end_line);
+
+  if ( area->right_shadow == 0 )
+    return;
+
+  // The right shadow does not scroll with the lines
+  const auto swap_shadow = [area] (int y1, int y2)
+  {
+    auto* shadow = &area->getFChar(area->width, y1);
+    std::swap_ranges ( shadow, shadow + area->right_shadow
+                     , &area->getFChar(area->width, y2) );
+  };
+
+  const int y_max = area->height - 1;
+
+  if ( forward )
+  {
+    for (auto y = y_max; y > 0; y--)
+      swap_shadow (y, y - 1);
+  }
+  else
+  {
+    for (auto y{0}; y < y_max; y++)
+      swap_shadow (y, y + 1);
+  }
+}
+
 //----------------------------------------------------------------------
 auto FVTerm::isCovered (const FPoint& pos, const FTermArea* area) const noexcept -> CoveredState
 {
@@ -1174,6 +1599,27 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermArea* area) const noexcept
     || win_list->back()->getVWin() == area )
     return CoveredState::None;
 
+  const bool is_inside_vterm = pos.getX() >= 0 && pos.getX() < vterm->width
+                            && pos.getY() >= 0 && pos.getY() < vterm->height;
+
+  if ( (found || area->layer > 0) && is_inside_vterm )
+  {
+    // The owner map gives the topmost window at this position
+    updateAreaOwnerMap();
+    const auto* owner = getAreaOwner(pos.getX(), pos.getY());
+
+    if ( ! owner || owner == area || owner->layer <= area->layer )
+      return CoveredState::None;
+
+    const auto& tmp = owner->getFChar ( pos.getX() - owner->offset_left
+                                      , pos.getY() - owner->offset_top );
+
+    if ( ! tmp.attr.bit.color_overlay && ! tmp.attr.bit.transparent )
+      return CoveredState::Full;
+
+    // Windows below the owner can still cover the position
+  }
+
   for (const auto& win_obj : *win_list)
   {
     const auto& win = win_obj->getVWin();
@@ -1203,6 +1649,75 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermArea* area) const noexcept
   return is_covered;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::updateAreaOwnerMap() const
+{
+  // Creates a map with the topmost window for each virtual terminal
+  // cell. It only gets rebuilt after invalidateAreaOwnerMap() has been
+  // called because a window was moved, resized, raised, lowered, shown
+  // or hidden.
+
+  if ( ! internal::var::area_owner_changed )
+    return;
+
+  internal::var::area_owner_changed = false;
+  auto& area_owner = internal::var::area_owner;
+  const int vterm_width = vterm->width;
+  const int vterm_height = vterm->height;
+  area_owner.assign(std::size_t(vterm_width * vterm_height), nullptr);
+  const auto& win_list = getWindowList();
+
+  if ( ! win_list )
+    return;
+
+  for (const auto& win_obj : *win_list)  // List from bottom to top
+  {
+    const auto& win = win_obj->getVWin();
+
+    if ( ! (win && win->visible && win->layer > 0) )
+      continue;
+
+    const int height = win->minimized ? win->min_height
+                                      : getFullAreaHeight(win);
+    const int x1 = std::max(win->offset_left, 0);
+    const int x2 = std::min(win->offset_left + getFullAreaWidth(win), vterm_width);
+    const int y1 = std::max(win->offset_top, 0);
+    const int y2 = std::min(win->offset_top + height, vterm_height);
+
+    if ( x1 >= x2 )
+      continue;
+
+    for (auto y{y1}; y < y2; y++)
+    {
+      const auto line = area_owner.begin() + y * vterm_width;
+      std::fill (line + x1, line + x2, win);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::getAreaOwner (int x, int y) const noexcept -> const FTermArea*
+{
+  return internal::var::area_owner[unsigned(y * vterm->width + x)];
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::isCoveredCharacter ( const FTermArea* area
+                                       , int x, int y ) const noexcept -> bool
+{
+  // Is the terminal position covered by an opaque character
+  // of a higher window?
+
+  const auto* owner = getAreaOwner(x, y);
+
+  if ( ! owner || owner == area || owner->layer <= area->layer )
+    return false;
+
+  const auto& ch = owner->getFChar ( x - owner->offset_left
+                                   , y - owner->offset_top );
+  return (ch.attr.byte[1] & internal::var::b1_transparent_mask) == 0;
+}
+
 //----------------------------------------------------------------------
 constexpr auto FVTerm::getFullAreaWidth (const FTermArea* area) const noexcept -> int
 {
@@ -1218,41 +1733,39 @@ constexpr auto FVTerm::getFullAreaHeight (const FTermArea* area) const noexcept
 //----------------------------------------------------------------------
 void FVTerm::passChangesToOverlap (const FTermArea* area) const
 {
+  // Pass the changed cells of area to the overlapping windows above
+
   const auto& win_list = getWindowList();
-  bool found{false};
 
   if ( ! area || ! win_list || win_list->empty() )
     return;
 
+  auto& damage = internal::var::overlap_damage;
+  damage.clear (vterm->width, vterm->height);
+  const int height = area->minimized ? area->min_height : getFullAreaHeight(area);
+  const int y_end = std::min(vterm->height - area->offset_top, height);
+
+  for (auto y{std::max(0, -area->offset_top)}; y < y_end; y++)  // Line loop
+  {
+    const auto& line_changes = area->changes[unsigned(y)];
+
+    if ( line_changes.xmin <= line_changes.xmax )
+      damage.add ( area->offset_top + y
+                 , area->offset_left + int(line_changes.xmin)
+                 , area->offset_left + int(line_changes.xmax) );
+  }
+
+  if ( damage.isEmpty() )
+    return;
+
+  bool found{false};
+
   for (auto&& win_obj : *win_list)
   {
     const auto& win = win_obj->getVWin();
 
-    if ( found && win && win->visible && win->isOverlapped(area) )
-    {
-      // Pass the changes to the overlapping window
-
-      win->has_changes = true;
-      const int win_offset_top = win->offset_top;
-      const int y_start = std::max(0, std::max(area->offset_top, win_offset_top)) - win_offset_top;
-      const int area_height = area->minimized ? area->min_height : getFullAreaHeight(area);
-      const int win_height = win->minimized ? win->min_height : getFullAreaHeight(win);
-      const int area_y2 = area->offset_top + area_height - 1;
-      const int win_y2 = win_offset_top + win_height - 1;
-      const int y_end = std::min(vterm->height - 1, std::min(area_y2, win_y2)) - win_offset_top;
-
-      for (auto y{y_start}; y <= y_end; y++)  // Line loop
-      {
-        const int win_offset_left = win->offset_left;
-        const int x_start = std::max(0, std::max(area->offset_left, win_offset_left)) - win_offset_left;
-        const int area_x2 = area->offset_left + area->width + area->right_shadow - 1;
-        const int win_x2 = win_offset_left + win->width + win->right_shadow - 1;
-        const int x_end = std::min(vterm->width - 1, std::min(area_x2, win_x2)) - win_offset_left;
-        auto& line_changes = win->changes[unsigned(y)];
-        line_changes.xmin = uInt(std::min(int(line_changes.xmin), x_start));
-        line_changes.xmax = uInt(std::max(int(line_changes.xmax), x_end));
-      }
-    }
+    if ( found && win && win->visible )
+      win->reprint(damage);
 
     if ( win == area )
       found = true;
@@ -1305,67 +1818,271 @@ void FVTerm::updateVTerm() const
 
     if ( hasPendingUpdates(v_win) )
     {
+      callPreprocessingHandler(v_win);
       passChangesToOverlap(v_win);
-      addLayer(v_win);
+      addLayerLines(v_win);
       v_win->has_changes = false;
     }
     else if ( hasChildAreaChanges(v_win) )
     {
+      callPreprocessingHandler(v_win);  // Child area processing
       passChangesToOverlap(v_win);
-      addLayer(v_win);  // and call the child area processing handler there
+      addLayerLines(v_win);
       clearChildAreaChanges(v_win);
     }
   }
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::scrollTerminalForward() const
+auto FVTerm::canScrollTerminal (const FTermArea* area) const -> bool
 {
-  // Scrolls the terminal up one line
+  // Checks whether the area occupies complete terminal lines
+  // that are not covered by another window
 
-  foutput->flush();  // Empty buffer before scrolling
+  if ( area == vdesktop.get() )
+    return true;
+
+  if ( ! area->visible
+    || area->minimized
+    || area->offset_left != 0
+    || area->width != vterm->width
+    || area->offset_top < 0
+    || area->offset_top + area->height > vterm->height )
+    return false;
 
-  if ( ! foutput->scrollTerminalForward() )
-    return;
+  const auto& win_list = getWindowList();
 
-  const int y_max = vdesktop->height - 1;
+  if ( ! win_list )
+    return false;
 
-  // avoid update lines from 0 to (y_max - 1)
-  for (auto y{0}; y < y_max; y++)
+  bool found{false};
+
+  for (const auto& win_obj : *win_list)
   {
-    auto& vdesktop_changes = vdesktop->changes[unsigned(y)];
-    vdesktop_changes.xmin = uInt(vdesktop->width - 1);
-    vdesktop_changes.xmax = 0;
+    const auto& win = win_obj->getVWin();
+
+    if ( ! (win && win->visible) )
+      continue;
+
+    if ( found && win->isOverlapped(area) )
+      return false;
+
+    if ( area == win )
+      found = true;
   }
 
-  putArea (FPoint{1, 1}, vdesktop.get());
-  saveCurrentVTerm();  // Ensure that the current terminal is comparable
-  forceTerminalUpdate();
+  return found;
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::scrollTerminalReverse() const
+inline auto FVTerm::scrollTerminalForward (int top, int bottom) const -> bool
 {
-  // Scrolls the terminal down one line
+  // Scrolls the terminal lines from top to bottom up one line
 
-  foutput->flush();  // Empty buffer before scrolling
+  if ( ! foutput->scrollTerminalForward(top, bottom) )
+    return false;
 
-  if ( ! foutput->scrollTerminalReverse() )
+  // Move the saved terminal content in the same way
+  const auto line_length = std::size_t(vterm->width);
+  const auto first = std::size_t(top) * line_length;
+  const auto count = std::size_t(bottom - top) * line_length;
+  vterm_old->move (first + line_length, first, count);
+  clearSavedTerminalLine (bottom);
+  markTerminalLinesChanged (top, bottom);
+  auto& hashes = internal::var::line_hashes;
+
+  if ( hashes.size() == std::size_t(vterm->height) )
+  {
+    std::rotate (&hashes[unsigned(top)], &hashes[unsigned(top) + 1], &hashes[unsigned(bottom)] + 1);
+    hashes[unsigned(bottom)] = 0;  // Unknown line
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::scrollTerminalReverse (int top, int bottom) const -> bool
+{
+  // Scrolls the terminal lines from top to bottom down one line
+
+  if ( ! foutput->scrollTerminalReverse(top, bottom) )
+    return false;
+
+  // Move the saved terminal content in the same way
+  const auto line_length = std::size_t(vterm->width);
+  const auto first = std::size_t(top) * line_length;
+  const auto count = std::size_t(bottom - top) * line_length;
+  vterm_old->move (first, first + line_length, count);
+  clearSavedTerminalLine (top);
+  markTerminalLinesChanged (top, bottom);
+  auto& hashes = internal::var::line_hashes;
+
+  if ( hashes.size() == std::size_t(vterm->height) )
+  {
+    std::rotate (&hashes[unsigned(top)], &hashes[unsigned(bottom)], &hashes[unsigned(bottom)] + 1);
+    hashes[unsigned(top)] = 0;  // Unknown line
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::scrollMovedTerminalLines() const
+{
+  // Compares the line hashes of the current and the last frame, and
+  // scrolls line blocks that have moved vertically to their new place
+  // (similar to the hashmap scroll optimization of curses)
+
+  const auto& old_hashes = internal::var::line_hashes;
+  auto& new_hashes = internal::var::next_line_hashes;
+  const int height = vterm->height;
+  const bool valid = old_hashes.size() == std::size_t(height);
+  new_hashes.resize(std::size_t(height));
+
+  for (auto y{0}; y < height; y++)
+  {
+    const auto& line_changes = vterm->changes[unsigned(y)];
+    const bool unchanged = line_changes.xmin > line_changes.xmax;
+    new_hashes[unsigned(y)] = ( valid && unchanged && old_hashes[unsigned(y)] != 0 )
+                            ? old_hashes[unsigned(y)]
+                            : getTerminalLineHash(y);
+  }
+
+  if ( ! valid )
     return;
 
-  const int y_max = vdesktop->height - 1;
+  internal::mapLinePositions (old_hashes);
+  const auto is_moved = [&old_hashes, &new_hashes, height] (int y, int shift)
+  {
+    const int old_y = y - shift;
+    return old_y >= 0 && old_y < height
+        && new_hashes[unsigned(y)] == old_hashes[unsigned(old_y)];
+  };
+  int last_bottom{-1};
+  int y{0};
 
-  // avoid update lines from 1 to y_max
-  for (auto y{0}; y < y_max; y++)
+  while ( y < height )
   {
-    auto& vdesktop_changes = vdesktop->changes[unsigned(y + 1)];
-    vdesktop_changes.xmin = uInt(vdesktop->width - 1);
-    vdesktop_changes.xmax = 0;
+    const int shift = findMovedTerminalLine(y);
+
+    if ( shift == 0 )
+    {
+      y++;
+      continue;
+    }
+
+    int top = y;
+    int bottom = y;
+
+    while ( top - 1 > last_bottom && is_moved(top - 1, shift) )
+      top--;
+
+    while ( bottom + 1 < height && is_moved(bottom + 1, shift) )
+      bottom++;
+
+    const int length = bottom - top + 1;
+    y = bottom + 1;
+
+    // Scrolling only pays off for blocks larger than the distance
+    if ( length < 2 || std::abs(shift) >= length
+      || (shift > 0 && top - shift <= last_bottom) )
+      continue;
+
+    for (auto n{0}; n < std::abs(shift); n++)
+    {
+      const bool scrolled = ( shift < 0 )
+                          ? scrollTerminalForward (top, bottom - shift)
+                          : scrollTerminalReverse (top - shift, bottom);
+
+      if ( ! scrolled )  // The terminal cannot scroll
+        return;
+    }
+
+    // Scrolling has moved the saved line hashes
+    internal::mapLinePositions (old_hashes);
+    last_bottom = bottom;
   }
+}
 
-  putArea (FPoint{1, 1}, vdesktop.get());
-  saveCurrentVTerm();  // Ensure that the current terminal is comparable
-  forceTerminalUpdate();
+//----------------------------------------------------------------------
+auto FVTerm::findMovedTerminalLine (int y) const noexcept -> int
+{
+  // Returns the line distance to the unique last frame position
+  // of a changed line, or 0 if the line has not moved
+
+  const auto& old_hashes = internal::var::line_hashes;
+  const auto& new_hashes = internal::var::next_line_hashes;
+  const auto& line_changes = vterm->changes[unsigned(y)];
+  const auto hash = new_hashes[unsigned(y)];
+
+  if ( line_changes.xmin > line_changes.xmax
+    || hash == old_hashes[unsigned(y)] )
+    return 0;
+
+  const int old_y = internal::findLinePosition(hash);
+
+  // The old line must be unique and not be needed in its place any longer
+  if ( old_y == -1 || new_hashes[unsigned(old_y)] == hash )
+    return 0;
+
+  return y - old_y;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::getTerminalLineHash (int y) const noexcept -> uInt64
+{
+  // FNV-1a hash of the line properties that are compared on output
+
+  constexpr uInt64 fnv_prime = 0x100000001b3;
+  uInt64 hash{0xcbf29ce484222325};
+  const auto* fchar = &vterm->getFChar(0, y);
+  const auto* const end = fchar + vterm->width;
+
+  for (; fchar < end; ++fchar)
+  {
+    hash = (hash ^ uInt64(fchar->ch[0])) * fnv_prime;
+    hash = (hash ^ uInt64(fchar->ch[1])) * fnv_prime;
+    hash = (hash ^ ( uInt64(fchar->fg_color)
+                   | uInt64(fchar->bg_color) << 16
+                   | uInt64(fchar->attr.byte[0]) << 32
+                   | uInt64(fchar->attr.byte[1]) << 40
+                   | uInt64(fchar->attr.bit.fullwidth_padding) << 48 )) * fnv_prime;
+  }
+
+  return ( hash == 0 ) ? 1 : hash;  // 0 marks an unknown line
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::clearSavedTerminalLine (int y) const
+{
+  // A line inserted by scrolling contains spaces in the default colors
+
+  static const FChar blank_char
+  {
+    { { L' ',  L'\0', L'\0', L'\0', L'\0' } },
+    FColor::Default,
+    FColor::Default,
+    { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
+  };
+
+  const auto line_length = std::size_t(vterm->width);
+  vterm_old->fill (std::size_t(y) * line_length, line_length, blank_char);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::markTerminalLinesChanged (int top, int bottom) const noexcept
+{
+  // The scrolled lines are compared completely with the saved
+  // terminal content so that only the differences are output
+
+  for (auto y = top; y <= bottom; y++)
+  {
+    auto& vterm_changes = vterm->changes[unsigned(y)];
+    vterm_changes.xmin = 0;
+    vterm_changes.xmax = uInt(vterm->width - 1);
+  }
+
+  vterm->has_changes = true;
 }
 
 //----------------------------------------------------------------------
@@ -1465,6 +2182,9 @@ void FVTerm::initSettings()
   createVDesktop (term_size);
   active_area = vdesktop.get();
 
+  // Start the compositing worker threads
+  setCompositingThreads (FStartOptions::getInstance().compositing_threads);
+
   // fvterm is now initialized
   internal::var::fvterm_initialized = true;
 }
@@ -1476,6 +2196,7 @@ void FVTerm::finish() const
   setNormal();
   foutput->finishTerminal();
   forceTerminalUpdate();
+  setCompositingThreads (0);
   internal::var::fvterm_initialized = false;
   setGlobalFVTermInstance(nullptr);
 }
@@ -1483,8 +2204,9 @@ void FVTerm::finish() const
 //----------------------------------------------------------------------
 inline void FVTerm::saveCurrentVTerm() const
 {
-  // Save the content of the virtual terminal
-  std::memcpy(vterm_old->data.data(), vterm->data.data(), vterm->data.size() * sizeof(FChar));
+  // Save the content of the virtual terminal in packed form
+  vterm_old->assign(vterm->data);
+  internal::var::line_hashes.clear();
 }
 
 
@@ -1503,60 +2225,26 @@ inline void FVTerm::putAreaLineWithTransparency ( const FChar* src_char
                                                 , const int length
                                                 , FPoint pos ) const
 {
-  const int end_char = pos.getX() + length;
-  const FChar* start_char{nullptr};
-  std::size_t trans_count{0};
-  std::size_t non_trans_count{0};
-
   // Line has one or more transparent characters
-  while ( pos.getX() < end_char )  // column loop
-  {
-    const auto isTransparent = \
-        bool((src_char->attr.byte[1] & internal::var::b1_transparent_mask) != 0);
 
-    if ( isTransparent && non_trans_count != 0 )
-    {
-      putAreaLine (*start_char, *dst_char, non_trans_count);
-      dst_char += non_trans_count;  // dst character
-      non_trans_count = 0;
-    }
-    else if ( ! isTransparent && trans_count != 0 )
-    {
-      putTransparentAreaLine (pos, trans_count);
-      dst_char += trans_count;  // dst character
-      trans_count = 0;
-    }
-
-    if ( isTransparent )
-    {
-      if ( trans_count == 0 )
-        start_char = src_char;
+  const auto end_char = src_char + length;
 
-      trans_count++;
-    }
+  while ( src_char < end_char )  // Run loop
+  {
+    const bool is_transparent = internal::hasTransparency(*src_char);
+    const auto run_end = is_transparent
+                       ? internal::findTransparentRunEnd(src_char, end_char)
+                       : internal::findOpaqueRunEnd(src_char, end_char);
+    const auto count = std::size_t(run_end - src_char);
+    pos.x_ref() += int(count);
+
+    if ( is_transparent )
+      putTransparentAreaLine (pos, count);
     else
-    {
-      if ( non_trans_count == 0 )
-        start_char = src_char;
-
-      non_trans_count++;
-    }
+      putAreaLine (*src_char, *dst_char, count);
 
-    pos.x_ref()++;
-
-    if ( pos.getX() == end_char )
-    {
-      if ( trans_count != 0 )
-      {
-        putTransparentAreaLine (pos, trans_count);
-      }
-      else if ( non_trans_count != 0 )
-        putAreaLine (*start_char, *dst_char, non_trans_count);
-
-      break;
-    }
-
-    ++src_char;  // src character
+    src_char = run_end;
+    dst_char += count;
   }
 }
 
@@ -1568,61 +2256,49 @@ inline void FVTerm::putTransparentAreaLine ( const FPoint& pos
   restoreVTerm(box);
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::addAreaLine ( const FChar* src_char
+                                , FChar* dst_char
+                                , const std::size_t length
+                                , bool has_transparency ) const
+{
+  if ( has_transparency )
+  {
+    // Line with hidden and transparent characters
+    addAreaLineWithTransparency (src_char, dst_char, length);
+  }
+  else
+  {
+    // Line has only covered characters
+    putAreaLine (*src_char, *dst_char, length);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::addAreaLineWithTransparency ( const FChar* src_char
                                                 , FChar* dst_char
                                                 , const std::size_t length ) const
 {
+  // Opaque runs are copied in one block, transparent runs are mixed
+  // with the characters below
+
   const auto end_char = src_char + length;
-  const auto last_char = end_char - 1;
-  const FChar* start_char{nullptr};
-  std::size_t trans_count{0};
-  std::size_t non_trans_count{0};
 
-  while ( src_char < end_char )  // column loop
+  while ( src_char < end_char )  // Run loop
   {
-    const auto isTransparent = \
-        bool((src_char->attr.byte[1] & internal::var::b1_transparent_mask) != 0);
-
-    if ( isTransparent && non_trans_count != 0 )
-    {
-      putAreaLine (*start_char, *dst_char, non_trans_count);
-      dst_char += non_trans_count;  // dst character
-      non_trans_count = 0;
-    }
-    else if ( ! isTransparent && trans_count != 0 )
-    {
-      addTransparentAreaLine (*start_char, *dst_char, trans_count);
-      dst_char += trans_count;  // dst character
-      trans_count = 0;
-    }
-
-    if ( isTransparent )
-    {
-      if ( trans_count == 0 )
-        start_char = src_char;
-
-      trans_count++;
-    }
+    const bool is_transparent = internal::hasTransparency(*src_char);
+    const auto run_end = is_transparent
+                       ? internal::findTransparentRunEnd(src_char, end_char)
+                       : internal::findOpaqueRunEnd(src_char, end_char);
+    const auto count = std::size_t(run_end - src_char);
+
+    if ( is_transparent )
+      addTransparentAreaLine (*src_char, *dst_char, count);
     else
-    {
-      if ( non_trans_count == 0 )
-        start_char = src_char;
-
-      non_trans_count++;
-    }
-
-    if ( src_char == last_char )
-    {
-      if ( trans_count != 0 )
-        addTransparentAreaLine (*start_char, *dst_char, trans_count);
-      else if ( non_trans_count != 0 )
-        putAreaLine (*start_char, *dst_char, non_trans_count);
-
-      break;
-    }
+      putAreaLine (*src_char, *dst_char, count);
 
-    src_char++;
+    src_char = run_end;
+    dst_char += count;
   }
 }
 
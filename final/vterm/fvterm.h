@@ -61,8 +61,10 @@
 #include "final/util/fdata.h"
 #include "final/util/fpoint.h"
 #include "final/util/frect.h"
+#include "final/util/frenderstatistics.h"
 #include "final/util/fsize.h"
 #include "final/util/fstringstream.h"
+#include "final/vterm/fpackedchar.h"
 #include "final/vterm/fvtermattribute.h"
 #include "final/vterm/fvtermbuffer.h"
 
@@ -97,6 +99,7 @@ class FVTerm : public FVTermAttribute
 {
   public:
     struct FTermArea;             // forward declaration
+    struct FDamageRegion;         // forward declaration
     struct FVTermPreprocessing;   // forward declaration
 
     struct FLineChanges
@@ -180,6 +183,8 @@ class FVTerm : public FVTermAttribute
     auto  getVWin() const noexcept -> const FTermArea*;
     auto  getPrintCursor() -> FPoint;
     static auto  getWindowList() -> FVTermList*;
+    static auto  getCompositingThreads() noexcept -> std::size_t;
+    static auto  getRenderStatistics() -> FRenderStatistics&;
 
     // Mutators
     void  setTerminalUpdates (TerminalUpdate) const;
@@ -187,6 +192,7 @@ class FVTerm : public FVTermAttribute
     void  setVWin (std::unique_ptr<FTermArea>&&) noexcept;
     static void  setNonBlockingRead (bool = true);
     static void  unsetNonBlockingRead();
+    static void  setCompositingThreads (std::size_t);
 
     // Inquiries
     static auto  isDrawingFinished() noexcept -> bool;
@@ -260,6 +266,7 @@ class FVTerm : public FVTermAttribute
     void  copyArea (FTermArea*, const FPoint&, const FTermArea* const)  const noexcept;
     static auto  getLayer (FVTerm&) noexcept -> int;
     static void  determineWindowLayers() noexcept;
+    static void  invalidateAreaOwnerMap() noexcept;
     void  scrollAreaForward (FTermArea*);
     void  scrollAreaReverse (FTermArea*);
     void  clearArea (FTermArea*, wchar_t = L' ') noexcept;
@@ -288,14 +295,26 @@ class FVTerm : public FVTermAttribute
     void  resetTextAreaToDefault (FTermArea*, const FSize&) const noexcept;
     auto  resizeTextArea (FTermArea*, std::size_t, std::size_t ) const -> bool;
     auto  resizeTextArea (FTermArea*, std::size_t) const -> bool;
+    void  rotateAreaLines (FTermArea*, bool) const noexcept;
     auto  isCovered (const FPoint&, const FTermArea*) const noexcept -> CoveredState;
+    void  updateAreaOwnerMap() const;
+    auto  getAreaOwner (int, int) const noexcept -> const FTermArea*;
+    auto  isCoveredCharacter (const FTermArea*, int, int) const noexcept -> bool;
     constexpr auto  getFullAreaWidth (const FTermArea*) const noexcept -> int;
     constexpr auto  getFullAreaHeight (const FTermArea*) const noexcept -> int;
     void  passChangesToOverlap (const FTermArea*) const;
+    void  addLayerLines (FTermArea*) const noexcept;
+    void  addLayerLines (FTermArea*, int, int) const noexcept;
     void  restoreOverlaidWindows (const FTermArea* area) const noexcept;
     void  updateVTerm() const;
-    void  scrollTerminalForward() const;
-    void  scrollTerminalReverse() const;
+    auto  canScrollTerminal (const FTermArea*) const -> bool;
+    auto  scrollTerminalForward (int, int) const -> bool;
+    auto  scrollTerminalReverse (int, int) const -> bool;
+    void  scrollMovedTerminalLines() const;
+    auto  findMovedTerminalLine (int) const noexcept -> int;
+    auto  getTerminalLineHash (int) const noexcept -> uInt64;
+    void  clearSavedTerminalLine (int) const;
+    void  markTerminalLinesChanged (int, int) const noexcept;
     void  callPreprocessingHandler (const FTermArea*) const;
     auto  hasChildAreaChanges (const FTermArea*) const -> bool;
     void  clearChildAreaChanges (const FTermArea*) const;
@@ -310,6 +329,7 @@ class FVTerm : public FVTermAttribute
     void  putAreaLine (const FChar&, FChar&, const std::size_t) const;
     void  putAreaLineWithTransparency (const FChar*, FChar*, const int, FPoint) const;
     void  putTransparentAreaLine (const FPoint&, const std::size_t) const;
+    void  addAreaLine (const FChar*, FChar*, const std::size_t, bool) const;
     void  addAreaLineWithTransparency (const FChar*, FChar*, const std::size_t) const;
     void  addTransparentAreaLine (const FChar&, FChar&, const std::size_t) const;
     void  addTransparentAreaChar (const FChar&, FChar&) const;
@@ -327,23 +347,23 @@ class FVTerm : public FVTermAttribute
     static auto hasPendingUpdates (const FTermArea*) noexcept -> bool;
 
     // Data members
-    FTermArea*                   print_area{nullptr};        // Print area for this object
-    FTermArea*                   child_print_area{nullptr};  // Print area for children
-    FVTermBuffer                 vterm_buffer{};             // Print buffer
-    FChar                        nc{};                       // next character
-    std::unique_ptr<FTermArea>   vwin{};                     // Virtual window
-    std::shared_ptr<FOutput>     foutput{};                  // Terminal output class
-    std::shared_ptr<FVTermList>  window_list{};              // List of all window owner
-    std::shared_ptr<FTermArea>   vterm{};                    // Virtual terminal
-    std::shared_ptr<FTermArea>   vterm_old{};                // Last virtual terminal
-    std::shared_ptr<FTermArea>   vdesktop{};                 // Virtual desktop
-    static FTermArea*            active_area;                // Active area
-    static uInt8                 b1_print_trans_mask;        // Transparency mask
-    static int                   tabstop;
-    static bool                  draw_completed;
-    static bool                  skip_one_vterm_update;
-    static bool                  no_terminal_updates;
-    static bool                  force_terminal_update;
+    FTermArea*                         print_area{nullptr};        // Print area for this object
+    FTermArea*                         child_print_area{nullptr};  // Print area for children
+    FVTermBuffer                       vterm_buffer{};             // Print buffer
+    FChar                              nc{};                       // next character
+    std::unique_ptr<FTermArea>         vwin{};                     // Virtual window
+    std::shared_ptr<FOutput>           foutput{};                  // Terminal output class
+    std::shared_ptr<FVTermList>        window_list{};              // List of all window owner
+    std::shared_ptr<FTermArea>         vterm{};                    // Virtual terminal
+    std::shared_ptr<FPackedCharBuffer> vterm_old{};                // Last virtual terminal
+    std::shared_ptr<FTermArea>         vdesktop{};                 // Virtual desktop
+    static FTermArea*                  active_area;                // Active area
+    static uInt8                       b1_print_trans_mask;        // Transparency mask
+    static int                         tabstop;
+    static bool                        draw_completed;
+    static bool                        skip_one_vterm_update;
+    static bool                        no_terminal_updates;
+    static bool                        force_terminal_update;
 
     // Friend function
     friend void setPrintArea (FWidget&, FTermArea*);
@@ -359,6 +379,7 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   // Using-declaration
   using FDataAccessPtr  = std::shared_ptr<FDataAccess>;
   using FLineChangesPtr = std::vector<FLineChanges>;
+  using FLineOffsetPtr  = std::vector<std::size_t>;
   using FCharPtr        = std::vector<FChar>;
 
   // Constructor
@@ -395,15 +416,16 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   auto isOverlapped (const FTermArea*) const noexcept -> bool;
   auto checkPrintPos() const noexcept -> bool;
   auto reprint (const FRect&, const FSize&) noexcept -> bool;
+  auto reprint (const FDamageRegion&) noexcept -> bool;
 
   inline auto getFChar (int x, int y) const noexcept -> const FChar&
   {
-    return data[unsigned(y) * unsigned(width + right_shadow) + unsigned(x)];
+    return data[line_offset[unsigned(y)] + unsigned(x)];
   }
 
   inline auto getFChar (int x, int y) noexcept -> FChar&
   {
-    return data[unsigned(y) * unsigned(width + right_shadow) + unsigned(x)];
+    return data[line_offset[unsigned(y)] + unsigned(x)];
   }
 
   inline auto getFChar (const FPoint& pos) const noexcept -> const FChar&
@@ -459,6 +481,7 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   FDataAccessPtr  owner{nullptr};      // Object that owns this FTermArea
   FPreprocVector  preproc_list{};
   FLineChangesPtr changes{};
+  FLineOffsetPtr  line_offset{};       // Start index of each line in data
   FCharPtr        data{};              // FChar data of the drawing area
 };
 
@@ -557,6 +580,117 @@ inline auto FVTerm::FTermArea::reprint (const FRect& box, const FSize& term_size
 }
 
 
+//----------------------------------------------------------------------
+// struct FVTerm::FDamageRegion
+//----------------------------------------------------------------------
+
+struct FVTerm::FDamageRegion  // Bounds of the damaged cells of each line
+{
+  struct FSpan
+  {
+    int xmin;  // First damaged column
+    int xmax;  // Last damaged column
+  };
+
+  // Using-declaration
+  using FSpanList = std::vector<FSpan>;
+
+  // Methods
+  void clear (int, int);
+  void add (int, int, int) noexcept;
+  void add (const FRect&) noexcept;
+  auto isEmpty() const noexcept -> bool;
+
+  // Data members
+  int       width{0};   // Terminal width
+  int       ymin{0};    // First damaged line
+  int       ymax{-1};   // Last damaged line
+  FSpanList spans{};
+};
+
+//----------------------------------------------------------------------
+inline void FVTerm::FDamageRegion::clear (int w, int h)
+{
+  // Only the previously damaged lines have to be reset
+
+  if ( width != w || spans.size() != std::size_t(std::max(h, 0)) )
+    spans.assign(std::size_t(std::max(h, 0)), FSpan{w, -1});
+  else
+    for (auto y{std::max(ymin, 0)}; y <= ymax; y++)
+      spans[std::size_t(y)] = FSpan{w, -1};
+
+  width = w;
+  ymin = h;
+  ymax = -1;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FDamageRegion::add (int y, int x1, int x2) noexcept
+{
+  x1 = std::max(x1, 0);
+  x2 = std::min(x2, width - 1);
+
+  if ( y < 0 || y >= int(spans.size()) || x1 > x2 )
+    return;
+
+  auto& span = spans[std::size_t(y)];
+  span.xmin = std::min(span.xmin, x1);
+  span.xmax = std::max(span.xmax, x2);
+  ymin = std::min(ymin, y);
+  ymax = std::max(ymax, y);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FDamageRegion::add (const FRect& box) noexcept
+{
+  const int x1 = box.getX() - 1;
+  const int x2 = x1 + int(box.getWidth()) - 1;
+  const int y1 = std::max(box.getY() - 1, 0);
+  const int y2 = std::min(box.getY() + int(box.getHeight()) - 2, int(spans.size()) - 1);
+
+  for (auto y{y1}; y <= y2; y++)
+    add (y, x1, x2);
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FDamageRegion::isEmpty() const noexcept -> bool
+{
+  return ymin > ymax;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermArea::reprint (const FDamageRegion& damage) noexcept -> bool
+{
+  // Marks the damaged terminal cells on my area as changed
+
+  const int current_height = minimized ? min_height : height + bottom_shadow;
+  const int x2 = offset_left + width + right_shadow - 1;
+  const int y_start = std::max(damage.ymin, offset_top);
+  const int y_end = std::min(damage.ymax, offset_top + current_height - 1);
+  bool marked{false};
+
+  for (auto y{y_start}; y <= y_end; y++)  // Line loop
+  {
+    const auto& span = damage.spans[std::size_t(y)];
+    const int x_start = std::max(span.xmin, offset_left);
+    const int x_end = std::min(span.xmax, x2);
+
+    if ( x_start > x_end )
+      continue;
+
+    auto& line_changes = changes[std::size_t(y - offset_top)];
+    line_changes.xmin = uInt(std::min(int(line_changes.xmin), x_start - offset_left));
+    line_changes.xmax = uInt(std::max(int(line_changes.xmax), x_end - offset_left));
+    marked = true;
+  }
+
+  if ( marked )
+    has_changes = true;
+
+  return marked;
+}
+
+
 //----------------------------------------------------------------------
 // struct FVTerm::FVTermPreprocessing
 //----------------------------------------------------------------------
@@ -718,9 +852,16 @@ inline auto FVTerm::getWindowList() -> FVTermList*
         : nullptr;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::getRenderStatistics() -> FRenderStatistics&
+{ return FRenderStatistics::getInstance(); }
+
 //----------------------------------------------------------------------
 inline void FVTerm::setVWin (std::unique_ptr<FTermArea>&& area) noexcept
-{ vwin = std::move(area); }
+{
+  vwin = std::move(area);
+  invalidateAreaOwnerMap();
+}
 
 //----------------------------------------------------------------------
 inline void FVTerm::unsetNonBlockingRead()
@@ -835,7 +976,7 @@ inline void FVTerm::init()
     foutput     = std::shared_ptr<FOutput>(init_object->foutput);
     window_list = std::shared_ptr<FVTermList>(init_object->window_list);
     vterm       = std::shared_ptr<FTermArea>(init_object->vterm);
-    vterm_old   = std::shared_ptr<FTermArea>(init_object->vterm_old);
+    vterm_old   = std::shared_ptr<FPackedCharBuffer>(init_object->vterm_old);
     vdesktop    = std::shared_ptr<FTermArea>(init_object->vdesktop);
   }
 }
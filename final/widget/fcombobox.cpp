@@ -369,6 +369,16 @@ void FComboBox::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FComboBox::onPaste (FPasteEvent* ev)
+{
+  if ( ! isEnabled() )
+    return;
+
+  // Insert the pasted text into the input field
+  input_field.onPaste(ev);
+}
+
 //----------------------------------------------------------------------
 void FComboBox::onMouseDown (FMouseEvent* ev)
 {
@@ -407,10 +417,13 @@ void FComboBox::onMouseMove (FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FComboBox::onWheel (FWheelEvent* ev)
 {
-  if ( ev->getWheel() == MouseWheel::Up )
-    onePosUp();
-  else if ( ev->getWheel() == MouseWheel::Down )
-    onePosDown();
+  for (int step{0}; step < ev->getDelta(); step++)
+  {
+    if ( ev->getWheel() == MouseWheel::Up )
+      onePosUp();
+    else if ( ev->getWheel() == MouseWheel::Down )
+      onePosDown();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -178,6 +178,7 @@ class FComboBox : public FWidget
 
     // Event handlers
     void onKeyPress (FKeyEvent*) override;
+    void onPaste (FPasteEvent*) override;
     void onMouseDown (FMouseEvent*) override;
     void onMouseMove (FMouseEvent*) override;
     void onWheel (FWheelEvent*) override;
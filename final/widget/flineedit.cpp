@@ -380,6 +380,59 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  // Inserts the first line of the pasted text in one step
+
+  if ( isReadOnly() )
+    return;
+
+  ev->accept();
+  FString input{};
+
+  for (const auto& ch : ev->getText())
+  {
+    if ( ch == L'\n' )
+      break;
+
+    const auto c = characterFilter(( ch == L'\t' ) ? L' ' : ch);
+
+    if ( c >= L' ' )
+      input << c;
+  }
+
+  const auto len = text.getLength();
+
+  if ( cursor_pos > len )
+    cursor_pos = len;
+
+  const auto available = ( insert_mode || cursor_pos >= len )
+                       ? max_length - std::min(len, max_length)
+                       : max_length - std::min(cursor_pos, max_length);
+
+  if ( input.getLength() > available )
+  {
+    input = input.left(available);
+    FVTerm::getFOutput()->beep();
+  }
+
+  if ( input.isEmpty() )
+    return;
+
+  if ( insert_mode )
+    text.insert(input, cursor_pos);
+  else
+    text.overwrite(input, cursor_pos);
+
+  cursor_pos += input.getLength();
+  print_text = ( isPasswordField() ) ? getPasswordText() : text;
+  adjustTextOffset();
+  drawInputField();
+  forceTerminalUpdate();
+  processChanged();
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -159,6 +159,7 @@ class FLineEdit : public FWidget
 
     // Event handlers
     void onKeyPress (FKeyEvent*) override;
+    void onPaste (FPasteEvent*) override;
     void onMouseDown (FMouseEvent*) override;
     void onMouseUp (FMouseEvent*) override;
     void onMouseMove (FMouseEvent*) override;
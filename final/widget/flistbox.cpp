@@ -65,6 +65,21 @@ FListBox::~FListBox()  // destructor
 
 
 // public methods of FListBox
+//----------------------------------------------------------------------
+auto FListBox::getItemText (std::size_t index) const -> FString
+{
+  // Returns the text of an inserted item or of a virtual row.
+  // Unlike getItem(), this works in both modes.
+
+  if ( index < 1 || index > getCount() )
+    return {};
+
+  if ( isVirtual() )
+    return getVirtualText(index - 1);
+
+  return index2iterator(index - 1)->getText();
+}
+
 //----------------------------------------------------------------------
 void FListBox::setCurrentItem (std::size_t index)
 {
@@ -94,17 +109,35 @@ void FListBox::setCurrentItem (FListBoxItems::iterator iter)
   setCurrentItem(index);
 }
 
+//----------------------------------------------------------------------
+void FListBox::setItemText (std::size_t index, const FString& txt)
+{
+  // Changes the item text and the horizontal scroll range
+
+  if ( isVirtual() || index < 1 || index > getCount() )
+    return;
+
+  auto iter = index2iterator(index - 1);
+  iter->setText (txt);
+  updateLineWidth (*iter);
+  updateMaxLineWidth();
+}
+
 //----------------------------------------------------------------------
 void FListBox::showInsideBrackets ( const std::size_t index
                                   , BracketType b )
 {
+  if ( isVirtual() )
+    return;
+
   auto iter = index2iterator(index - 1);
   iter->brackets = b;
 
   if ( b == BracketType::None )
     return;
 
-  const auto column_width = getColumnWidth(iter->getText()) + 2;
+  updateLineWidth (*iter);
+  const auto column_width = iter->line_width;
 
   if ( column_width > max_line_width )
   {
@@ -146,6 +179,31 @@ void FListBox::setText (const FString& txt)
   text.setString(txt);
 }
 
+//----------------------------------------------------------------------
+void FListBox::setVirtualRows ( std::size_t count
+                              , RowTextProvider provider
+                              , std::size_t cache_size )
+{
+  // The list box shows count rows without storing an item per row.
+  // The provider returns the text of a row (index 0 = first row) when
+  // it becomes visible. Up to cache_size texts are kept for reuse.
+
+  clear();
+
+  if ( ! provider )
+    return;
+
+  row_text_provider = std::move(provider);
+  row_cache_size = cache_size;
+  virtual_rows = count;
+
+  if ( count > 0 )
+    current = 1;
+
+  recalculateVerticalBar (count);
+  processChanged();
+}
+
 //----------------------------------------------------------------------
 void FListBox::hide()
 {
@@ -156,38 +214,45 @@ void FListBox::hide()
 //----------------------------------------------------------------------
 void FListBox::insert (const FListBoxItem& listItem)
 {
-  const auto column_width = getColumnWidth(listItem.text);
-  const bool has_brackets(listItem.brackets != BracketType::None);
-  recalculateHorizontalBar (column_width, has_brackets);
+  appendItem (FListBoxItem{listItem});
+  finishInsertion();
+}
 
-  itemlist.push_back (listItem);
+//----------------------------------------------------------------------
+void FListBox::insert ( FListBoxItems::const_iterator first
+                      , FListBoxItems::const_iterator last )
+{
+  // Inserts a range of items and updates the scrollbars only once
 
-  if ( current == 0 )
-    current = 1;
+  itemlist.reserve (itemlist.size() + std::size_t(std::distance(first, last)));
 
-  auto element_count = getCount();
-  recalculateVerticalBar (element_count);
-  processChanged();
+  while ( first != last )
+  {
+    appendItem (FListBoxItem{*first});
+    ++first;
+  }
+
+  finishInsertion();
 }
 
 //----------------------------------------------------------------------
-void FListBox::remove (std::size_t item)
+void FListBox::remove (std::size_t item, std::size_t count)
 {
-  if ( item > getCount() )
+  // Removes count items starting with the given item number
+
+  if ( isVirtual() || item < 1 || item > getCount() || count == 0 )
     return;
 
-  itemlist.erase (itemlist.cbegin() + int(item) - 1);
-  const std::size_t element_count = getCount();
-  max_line_width = 0;
+  count = std::min(count, getCount() - item + 1);
+  const auto first = itemlist.cbegin() + std::ptrdiff_t(item - 1);
+  const auto last = first + std::ptrdiff_t(count);
 
-  for (const auto& listbox_item : itemlist)
-  {
-    const auto column_width = getColumnWidth(listbox_item.getText());
-
-    if ( column_width > max_line_width )
-      max_line_width = column_width;
-  }
+  for (auto iter = first; iter != last; ++iter)
+    removeLineWidth (iter->line_width);
 
+  itemlist.erase (first, last);
+  const std::size_t element_count = getCount();
+  max_line_width = getMaxLineWidth();
   const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
                    ? int(max_line_width - getWidth() + nf_offset + 4)
                    : 0;
@@ -206,8 +271,10 @@ void FListBox::remove (std::size_t item)
   if ( vbar->isShown() && isVerticallyScrollable() )
     vbar->hide();
 
-  if ( current >= item && current > 1 )
-    current--;
+  if ( current >= item + count )
+    current -= count;
+  else if ( current >= item )
+    current = std::max(item - 1, std::size_t(1));
 
   if ( current > element_count )
     current = element_count;
@@ -221,15 +288,45 @@ void FListBox::remove (std::size_t item)
   processChanged();
 }
 
+//----------------------------------------------------------------------
+void FListBox::reloadVirtualRows (std::size_t count)
+{
+  // Changes the number of virtual rows and rereads the visible rows
+
+  if ( ! isVirtual() )
+    return;
+
+  virtual_rows = count;
+  row_cache.clear();
+  row_cache_index.clear();
+  selected_rows.erase (selected_rows.lower_bound(count), selected_rows.end());
+
+  if ( ! selected_rows.empty() && selected_rows.rbegin()->second >= count )
+    selected_rows.rbegin()->second = count - 1;
+
+  if ( current > count )
+    current = count;
+  else if ( current == 0 && count > 0 )
+    current = 1;
+
+  adjustYOffset (count);
+  recalculateVerticalBar (count);
+  vbar->setValue (yoffset);
+  last_yoffset = -1;
+  processChanged();
+}
+
 //----------------------------------------------------------------------
 void FListBox::clear()
 {
+  clearVirtualRows();
   itemlist.clear();
   itemlist.shrink_to_fit();
   current = 0;
   xoffset = 0;
   yoffset = 0;
   max_line_width = 0;
+  line_widths.clear();
   last_current = -1;
   last_yoffset = -1;
 
@@ -458,7 +555,8 @@ void FListBox::onWheel (FWheelEvent* ev)
 {
   const std::size_t current_before = current;
   const int yoffset_before = yoffset;
-  static constexpr int wheel_distance = 4;
+  static constexpr int wheel_step = 4;
+  const int wheel_distance = wheel_step * ev->getDelta();
   const auto& wheel = ev->getWheel();
 
   if ( isDragging(drag_scroll) )
@@ -581,9 +679,51 @@ void FListBox::adjustSize()
 
 // private methods of FListBox
 //----------------------------------------------------------------------
-inline auto FListBox::getString (FListBoxItems::iterator iter) -> FString
+auto FListBox::getVirtualText (std::size_t row) const -> FString
 {
-  return iter->getText();
+  // Returns the filtered text of a virtual row from the
+  // least recently used cache or from the row text provider
+
+  if ( row_cache_size == 0 )
+    return FListBoxItem::stringFilter(row_text_provider(row));
+
+  const auto iter = row_cache_index.find(row);
+
+  if ( iter != row_cache_index.end() )
+  {
+    row_cache.splice (row_cache.begin(), row_cache, iter->second);
+    return iter->second->text;
+  }
+
+  row_cache.push_front ({row, FListBoxItem::stringFilter(row_text_provider(row))});
+  row_cache_index[row] = row_cache.begin();
+
+  if ( row_cache.size() > row_cache_size )
+  {
+    row_cache_index.erase (row_cache.back().row);
+    row_cache.pop_back();
+  }
+
+  return row_cache.front().text;
+}
+
+//----------------------------------------------------------------------
+auto FListBox::getLineWidth (const FListBoxItem& item) -> std::size_t
+{
+  const auto column_width = getColumnWidth(item.text);
+  return ( item.brackets != BracketType::None ) ? column_width + 2 : column_width;
+}
+
+//----------------------------------------------------------------------
+auto FListBox::isRowSelected (std::size_t row) const -> bool
+{
+  auto iter = selected_rows.upper_bound(row);
+
+  if ( iter == selected_rows.begin() )
+    return false;
+
+  --iter;
+  return row <= iter->second;
 }
 
 //----------------------------------------------------------------------
@@ -650,6 +790,147 @@ void FListBox::processKeyAction (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FListBox::appendItem (FListBoxItem&& listItem)
+{
+  if ( isVirtual() )
+    clear();
+
+  listItem.line_width = getLineWidth(listItem);
+  addLineWidth (listItem.line_width);
+  itemlist.push_back (std::move(listItem));
+}
+
+//----------------------------------------------------------------------
+void FListBox::finishInsertion()
+{
+  // Updates the scrollbars after inserting items
+
+  if ( current == 0 && ! itemlist.empty() )
+    current = 1;
+
+  recalculateHorizontalBar (getMaxLineWidth(), false);
+  recalculateVerticalBar (getCount());
+  processChanged();
+}
+
+//----------------------------------------------------------------------
+void FListBox::resizeItemList (std::size_t size)
+{
+  // The line width of a lazy item is counted when it is converted
+
+  if ( isVirtual() )
+    clear();
+
+  for (auto n = size; n < itemlist.size(); n++)
+    removeLineWidth (itemlist[n].line_width);
+
+  if ( size > itemlist.size() )
+    line_widths[0] += size - itemlist.size();
+
+  itemlist.resize(size);
+}
+
+//----------------------------------------------------------------------
+void FListBox::addLineWidth (std::size_t width)
+{
+  line_widths[width]++;
+}
+
+//----------------------------------------------------------------------
+void FListBox::removeLineWidth (std::size_t width)
+{
+  const auto iter = line_widths.find(width);
+
+  if ( iter == line_widths.end() )
+    return;
+
+  if ( iter->second > 1 )
+    iter->second--;
+  else
+    line_widths.erase(iter);
+}
+
+//----------------------------------------------------------------------
+void FListBox::updateLineWidth (FListBoxItem& item)
+{
+  const auto width = getLineWidth(item);
+
+  if ( width == item.line_width )
+    return;
+
+  removeLineWidth (item.line_width);
+  addLineWidth (width);
+  item.line_width = width;
+}
+
+//----------------------------------------------------------------------
+void FListBox::selectRow (std::size_t row)
+{
+  // Selected virtual rows are stored as ranges of adjacent rows
+
+  if ( isRowSelected(row) )
+    return;
+
+  std::size_t first{row};
+  std::size_t last{row};
+  auto next = selected_rows.upper_bound(row);
+
+  if ( next != selected_rows.begin() )
+  {
+    auto prev = std::prev(next);
+
+    if ( prev->second + 1 == row )
+    {
+      first = prev->first;
+      selected_rows.erase(prev);
+    }
+  }
+
+  if ( next != selected_rows.end() && next->first == row + 1 )
+  {
+    last = next->second;
+    selected_rows.erase(next);
+  }
+
+  selected_rows[first] = last;
+}
+
+//----------------------------------------------------------------------
+void FListBox::unselectRow (std::size_t row)
+{
+  auto iter = selected_rows.upper_bound(row);
+
+  if ( iter == selected_rows.begin() )
+    return;
+
+  --iter;
+  const auto first = iter->first;
+  const auto last = iter->second;
+
+  if ( row > last )
+    return;
+
+  selected_rows.erase(iter);
+
+  if ( first < row )
+    selected_rows[first] = row - 1;
+
+  if ( row < last )
+    selected_rows[row + 1] = last;
+}
+
+//----------------------------------------------------------------------
+void FListBox::clearVirtualRows()
+{
+  row_text_provider = nullptr;
+  virtual_rows = 0;
+  row_cache_size = 0;
+  selected_rows.clear();
+  row_cache.clear();
+  row_cache_index.clear();
+}
+
 //----------------------------------------------------------------------
 void FListBox::draw()
 {
@@ -735,7 +1016,7 @@ void FListBox::drawHeadline()
 //----------------------------------------------------------------------
 void FListBox::drawList()
 {
-  if ( itemlist.empty() || getHeight() <= 2 || getWidth() <= 4 )
+  if ( getCount() == 0 || getHeight() <= 2 || getWidth() <= 4 )
     return;
 
   std::size_t start{};
@@ -755,41 +1036,65 @@ void FListBox::drawList()
     num = std::max(last_pos, current_pos) + 1;
   }
 
-  auto iter = index2iterator(start + std::size_t(yoffset));
+  const auto line_width = max_line_width;
+  auto index = start + std::size_t(yoffset);
 
-  for (std::size_t y = start; y < num && iter != itemlist.end() ; y++)
+  for (std::size_t y = start; y < num && index < getCount(); y++)
   {
-    bool serach_mark{false};
-    const bool lineHasBrackets = hasBrackets(iter);
-
-    // Import data via lazy conversion
-    lazyConvert (iter, y);
-
-    // Set screen position and attributes
-    setLineAttributes ( int(y), isSelected(iter), lineHasBrackets
-                      , serach_mark );
-
-    // print the entry
-    if ( lineHasBrackets )
+    if ( isVirtual() )
     {
-      drawListBracketsLine (int(y), iter, serach_mark);
+      // Request the text of a visible virtual row
+      const auto row_text = getVirtualText(index);
+      recalculateHorizontalBar (getColumnWidth(row_text), false);
+      drawListRow ( int(y), row_text, BracketType::None
+                  , isRowSelected(index) );
     }
-    else  // line has no brackets
+    else
     {
-      drawListLine (int(y), iter, serach_mark);
+      auto iter = index2iterator(index);
+
+      // Import data via lazy conversion
+      lazyConvert (iter, y);
+      drawListRow (int(y), iter->getText(), iter->brackets, iter->selected);
     }
 
-    ++iter;
+    index++;
   }
 
+  if ( max_line_width != line_width && hbar->isShown() )
+    hbar->redraw();
+
   unsetAttributes();
   last_yoffset = yoffset;
   last_current = int(current);
 }
 
+//----------------------------------------------------------------------
+inline void FListBox::drawListRow ( int y
+                                  , const FString& row_text
+                                  , BracketType brackets
+                                  , bool is_selected )
+{
+  bool serach_mark{false};
+  const bool lineHasBrackets( brackets != BracketType::None );
+
+  // Set screen position and attributes
+  setLineAttributes (y, is_selected, lineHasBrackets, serach_mark);
+
+  // print the entry
+  if ( lineHasBrackets )
+  {
+    drawListBracketsLine (y, row_text, brackets, serach_mark);
+  }
+  else  // line has no brackets
+  {
+    drawListLine (y, row_text, serach_mark);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FListBox::drawListLine ( int y
-                                   , FListBoxItems::iterator iter
+                                   , const FString& row_text
                                    , bool serach_mark )
 {
   const std::size_t inc_len = inc_search.getLength();
@@ -797,7 +1102,7 @@ inline void FListBox::drawListLine ( int y
   const bool isCurrentLine( y + yoffset + 1 == int(current) );
   const std::size_t first = std::size_t(xoffset) + 1;
   const std::size_t max_width = getWidth() - nf_offset - 4;
-  const FString element(getColumnSubString (getString(iter), first, max_width));
+  const FString element(getColumnSubString (row_text, first, max_width));
   auto column_width = getColumnWidth(element);
 
   if ( FVTerm::getFOutput()->isMonochron() && isCurrentLine && getFlags().focus.focus )
@@ -844,7 +1149,8 @@ inline void FListBox::printRightBracket (BracketType bracket_type)
 
 //----------------------------------------------------------------------
 inline void FListBox::drawListBracketsLine ( int y
-                                           , FListBoxItems::iterator iter
+                                           , const FString& row_text
+                                           , BracketType brackets
                                            , bool serach_mark )
 {
   std::size_t b{0};
@@ -859,14 +1165,14 @@ inline void FListBox::drawListBracketsLine ( int y
   if ( xoffset == 0 )
   {
     b = 1;  // Required bracket space
-    printLeftBracket (iter->brackets);
+    printLeftBracket (brackets);
   }
 
   const auto first = std::size_t(xoffset);
   const std::size_t max_width = getWidth() - nf_offset - 4 - b;
-  const FString element(getColumnSubString (getString(iter), first, max_width));
+  const FString element(getColumnSubString (row_text, first, max_width));
   auto column_width = getColumnWidth(element);
-  const std::size_t text_width = getColumnWidth(getString(iter));
+  const std::size_t text_width = getColumnWidth(row_text);
   std::size_t i{0};
   const auto& wc = getColorTheme();
 
@@ -890,7 +1196,7 @@ inline void FListBox::drawListBracketsLine ( int y
       setColor ( wc->current_element_focus_fg
                , wc->current_element_focus_bg );
 
-    printRightBracket (iter->brackets);
+    printRightBracket (brackets);
     column_width++;
   }
 
@@ -1061,6 +1367,31 @@ void FListBox::recalculateHorizontalBar (std::size_t len, bool has_brackets)
   }
 }
 
+//----------------------------------------------------------------------
+void FListBox::updateMaxLineWidth()
+{
+  // Applies the width of the widest item to the horizontal scrollbar
+
+  const auto width = getMaxLineWidth();
+
+  if ( width >= max_line_width )
+  {
+    recalculateHorizontalBar (width, false);
+    return;
+  }
+
+  max_line_width = width;
+  const int hmax = ( max_line_width > getWidth() - nf_offset - 4 )
+                   ? int(max_line_width - getWidth() + nf_offset + 4)
+                   : 0;
+  hbar->setMaximum (hmax);
+  hbar->setPageSize (int(max_line_width), int(getWidth() - nf_offset) - 4);
+  hbar->calculateSliderValues();
+
+  if ( isShown() && ! isHorizontallyScrollable() )
+    hbar->hide();
+}
+
 //----------------------------------------------------------------------
 void FListBox::recalculateVerticalBar (std::size_t element_count) const
 {
@@ -1487,6 +1818,30 @@ inline auto FListBox::isWithinListBounds (const FPoint& pos) const -> bool
       && pos.getY() < int(getHeight());
 }
 
+//----------------------------------------------------------------------
+auto FListBox::findItem (const FString& prefix) const -> std::size_t
+{
+  // Returns the number of the first item that starts
+  // with the given prefix (case-insensitive) or 0
+
+  const auto len = prefix.getLength();
+  const auto search = prefix.toLower();
+
+  for (std::size_t index{0}; index < getCount(); index++)
+  {
+    // Virtual rows are read directly to keep the cache
+    // for the visible rows
+    const auto item_text = isVirtual()
+                         ? FListBoxItem::stringFilter(row_text_provider(index))
+                         : itemlist[index].getText();
+
+    if ( search == item_text.left(len).toLower() )
+      return index + 1;
+  }
+
+  return 0;
+}
+
 //----------------------------------------------------------------------
 inline auto FListBox::skipIncrementalSearch() -> bool
 {
@@ -1514,28 +1869,15 @@ inline auto FListBox::spacebarProcessing() -> bool
   if ( inc_len > 0 )  // Enter a spacebar for incremental search
   {
     inc_search += L' ';
-    bool inc_found{false};
-    auto iter = itemlist.begin();
-
-    while ( iter != itemlist.end() )
-    {
-      if ( ! inc_found
-        && inc_search.toLower()
-        == iter->getText().left(inc_len + 1).toLower() )
-      {
-        setCurrentItem(iter);
-        inc_found = true;
-        break;
-      }
-
-      ++iter;
-    }
+    const auto item = findItem(inc_search);
 
-    if ( ! inc_found )
+    if ( item == 0 )
     {
       inc_search.remove(inc_len, 1);
       return false;
     }
+
+    setCurrentItem(item);
   }
   else if ( isMultiSelection() )  // Change selection
   {
@@ -1591,19 +1933,10 @@ inline auto FListBox::deletePreviousCharacter() -> bool
 
   if ( inc_len > 1 )
   {
-    auto iter = itemlist.begin();
+    const auto item = findItem(inc_search);
 
-    while ( iter != itemlist.end() )
-    {
-      if ( inc_search.toLower()
-           == iter->getText().left(inc_len - 1).toLower() )
-      {
-        setCurrentItem(iter);
-        break;
-      }
-
-      ++iter;
-    }
+    if ( item > 0 )
+      setCurrentItem(item);
   }
 
   return true;
@@ -1622,29 +1955,15 @@ inline auto FListBox::keyIncSearchInput (FKey key) -> bool
     inc_search += wchar_t(key);
 
   const auto& inc_len = inc_search.getLength();
-  bool inc_found{false};
-  auto iter = itemlist.begin();
-
-  while ( iter != itemlist.end() )
-  {
-    if ( ! inc_found
-      && inc_search.toLower()
-      == iter->getText().left(inc_len).toLower() )
-    {
-      setCurrentItem(iter);
-      inc_found = true;
-      break;
-    }
-
-    ++iter;
-  }
+  const auto item = findItem(inc_search);
 
-  if ( ! inc_found )
+  if ( item == 0 )
   {
     inc_search.remove(inc_len - 1, 1);
     return inc_len != 1;
   }
 
+  setCurrentItem(item);
   return true;
 }
 
@@ -1694,8 +2013,8 @@ void FListBox::lazyConvert(FListBoxItems::iterator iter, std::size_t y)
     return;
 
   lazy_inserter (*iter, source_container, y + std::size_t(yoffset));
-  const auto column_width = getColumnWidth(iter->text);
-  recalculateHorizontalBar (column_width, hasBrackets(iter));
+  updateLineWidth (*iter);
+  recalculateHorizontalBar (iter->line_width, false);
 
   if ( hbar->isShown() )
     hbar->redraw();
@@ -48,6 +48,9 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <cassert>
+#include <list>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -113,12 +116,13 @@ class FListBoxItem
     using FDataAccessPtr = std::shared_ptr<FDataAccess>;
 
     // Methods
-    auto stringFilter(const FString&) const -> FString;
+    static auto stringFilter (const FString&) -> FString;
 
     // Data members
     FString         text{};
     FDataAccessPtr  data_pointer{};
     BracketType     brackets{BracketType::None};
+    std::size_t     line_width{0};  // Width counted by the list box
     bool            selected{false};
 
     // Friend classes
@@ -172,7 +176,7 @@ inline void FListBoxItem::clear()
 { text.clear(); }
 
 //----------------------------------------------------------------------
-inline auto FListBoxItem::stringFilter (const FString& txt) const -> FString
+inline auto FListBoxItem::stringFilter (const FString& txt) -> FString
 {
   return txt.rtrim()
             .expandTabs(FVTerm::getFOutput()->getTabstop())
@@ -192,6 +196,7 @@ class FListBox : public FWidget
     // Using-declaration
     using FWidget::setGeometry;
     using FListBoxItems = std::vector<FListBoxItem>;
+    using RowTextProvider = std::function<FString(std::size_t)>;
 
     // Constructor
     explicit FListBox (FWidget* = nullptr);
@@ -224,6 +229,7 @@ class FListBox : public FWidget
     auto getItem (std::size_t) const & -> const FListBoxItem&;
     auto getItem (FListBoxItems::iterator) & -> FListBoxItem&;
     auto getItem (FListBoxItems::const_iterator) const & -> const FListBoxItem&;
+    auto getItemText (std::size_t) const -> FString;
     auto currentItem() const noexcept -> std::size_t;
     auto getData() & -> FListBoxItems&;
     auto getData() const & -> const FListBoxItems&;
@@ -236,6 +242,7 @@ class FListBox : public FWidget
     void selectItem (FListBoxItems::iterator) const;
     void unselectItem (std::size_t);
     void unselectItem (FListBoxItems::iterator) const;
+    void setItemText (std::size_t, const FString&);
     void showInsideBrackets (const std::size_t, BracketType);
     void showNoBrackets (std::size_t);
     void showNoBrackets (FListBoxItems::iterator) const;
@@ -245,11 +252,13 @@ class FListBox : public FWidget
     void unsetMultiSelection ();
     auto setDisable() -> bool override;
     void setText (const FString&);
+    void setVirtualRows (std::size_t, RowTextProvider, std::size_t = 0);
 
     // Inquiries
     auto isSelected (std::size_t) const -> bool;
     auto isSelected (FListBoxItems::iterator) const -> bool;
     auto isMultiSelection() const -> bool;
+    auto isVirtual() const -> bool;
     auto hasBrackets (std::size_t) const -> bool;
     auto hasBrackets (FListBoxItems::iterator) const -> bool;
 
@@ -265,6 +274,8 @@ class FListBox : public FWidget
             , typename LazyConverter>
     void insert (Container*, LazyConverter&&);
     void insert (const FListBoxItem&);
+    void insert ( FListBoxItems::const_iterator
+                , FListBoxItems::const_iterator );
     template <typename T
             , typename DT = std::nullptr_t>
     void insert ( const std::initializer_list<T>& list
@@ -278,7 +289,9 @@ class FListBox : public FWidget
                 , bool = false
                 , DT&& = DT() );
     void remove (std::size_t);
+    void remove (std::size_t, std::size_t);
     void reserve (std::size_t);
+    void reloadVirtualRows (std::size_t);
     void clear();
 
     // Event handlers
@@ -303,6 +316,17 @@ class FListBox : public FWidget
     using KeyMap = std::unordered_map<FKey, std::function<void()>, EnumHash<FKey>>;
     using KeyMapResult = std::unordered_map<FKey, std::function<bool()>, EnumHash<FKey>>;
     using LazyInsert = std::function<void(FListBoxItem&, FDataAccess*, std::size_t)>;
+    using LineWidths = std::map<std::size_t, std::size_t>;  // Width -> items
+    using SelectedRows = std::map<std::size_t, std::size_t>;  // First -> last row
+
+    struct CachedRow
+    {
+      std::size_t  row{0};
+      FString      text{};
+    };
+
+    using RowCache = std::list<CachedRow>;  // Most recently used first
+    using RowCacheIndex = std::unordered_map<std::size_t, RowCache::iterator>;
 
     // Enumeration
     enum class ConvertType
@@ -313,9 +337,12 @@ class FListBox : public FWidget
     };
 
     // Accessors
-    static auto getString (FListBoxItems::iterator) -> FString;
+    auto getVirtualText (std::size_t) const -> FString;
+    static auto getLineWidth (const FListBoxItem&) -> std::size_t;
+    auto getMaxLineWidth() const -> std::size_t;
 
-    // Inquiry
+    // Inquiries
+    auto isRowSelected (std::size_t) const -> bool;
     auto isHorizontallyScrollable() const -> bool;
     auto isVerticallyScrollable() const -> bool;
 
@@ -323,21 +350,32 @@ class FListBox : public FWidget
     void init();
     void mapKeyFunctions();
     void processKeyAction (FKeyEvent*);
+    void appendItem (FListBoxItem&&);
+    void finishInsertion();
+    void resizeItemList (std::size_t);
+    void addLineWidth (std::size_t);
+    void removeLineWidth (std::size_t);
+    void updateLineWidth (FListBoxItem&);
+    void selectRow (std::size_t);
+    void unselectRow (std::size_t);
+    void clearVirtualRows();
     void draw() override;
     void drawBorder() override;
     void drawScrollbars() const;
     void drawHeadline();
     void drawList();
-    void drawListLine (int, FListBoxItems::iterator, bool);
+    void drawListRow (int, const FString&, BracketType, bool);
+    void drawListLine (int, const FString&, bool);
     void printLeftBracket (BracketType);
     void printRightBracket (BracketType);
-    void drawListBracketsLine (int, FListBoxItems::iterator, bool);
+    void drawListBracketsLine (int, const FString&, BracketType, bool);
     void setInitialLineAttributes (bool) const;
     void setCurrentLineAttributes (int, bool, bool, bool&);
     void setLineAttributes (int, bool, bool, bool&);
     void unsetAttributes() const;
     void updateDrawing (bool, bool);
     void recalculateHorizontalBar (std::size_t, bool);
+    void updateMaxLineWidth();
     void recalculateVerticalBar (std::size_t) const;
     void multiSelection (std::size_t);
     void multiSelectionUpTo (std::size_t);
@@ -365,6 +403,7 @@ class FListBox : public FWidget
     void firstPos();
     void lastPos();
     auto isWithinListBounds (const FPoint&) const -> bool;
+    auto findItem (const FString&) const -> std::size_t;
     auto skipIncrementalSearch() -> bool;
     void acceptSelection();
     auto spacebarProcessing() -> bool;
@@ -385,6 +424,7 @@ class FListBox : public FWidget
 
     // Function Pointer
     LazyInsert      lazy_inserter{};
+    RowTextProvider row_text_provider{};
 
     // Data members
     FListBoxItems   itemlist{};
@@ -395,6 +435,10 @@ class FListBox : public FWidget
     FString         inc_search{};
     KeyMap          key_map{};
     KeyMapResult    key_map_result{};
+    LineWidths      line_widths{};
+    SelectedRows    selected_rows{};
+    mutable RowCache       row_cache{};
+    mutable RowCacheIndex  row_cache_index{};
     ConvertType     conv_type{ConvertType::None};
     DragScrollMode  drag_scroll{DragScrollMode::None};
     int             scroll_repeat{100};
@@ -407,6 +451,8 @@ class FListBox : public FWidget
     std::size_t     current{0};
     std::size_t     nf_offset{0};
     std::size_t     max_line_width{0};
+    std::size_t     virtual_rows{0};
+    std::size_t     row_cache_size{0};
     bool            multi_select{false};
     bool            mouse_select{false};
     bool            scroll_timer{false};
@@ -463,11 +509,12 @@ inline auto FListBox::getClassName() const -> FString
 
 //----------------------------------------------------------------------
 inline auto FListBox::getCount() const -> std::size_t
-{ return itemlist.size(); }
+{ return isVirtual() ? virtual_rows : itemlist.size(); }
 
 //----------------------------------------------------------------------
 inline auto FListBox::getItem (std::size_t index) & -> FListBoxItem&
 {
+  // Virtual rows have no items, use getItemText() in both modes
   auto iter = index2iterator(index - 1);
   return *iter;
 }
@@ -475,6 +522,7 @@ inline auto FListBox::getItem (std::size_t index) & -> FListBoxItem&
 //----------------------------------------------------------------------
 inline auto FListBox::getItem (std::size_t index) const & -> const FListBoxItem&
 {
+  // Virtual rows have no items, use getItemText() in both modes
   auto iter = index2iterator(index - 1);
   return *iter;
 }
@@ -505,7 +553,12 @@ inline auto FListBox::getText() & -> FString&
 
 //----------------------------------------------------------------------
 inline void FListBox::selectItem (std::size_t index)
-{ index2iterator(index - 1)->selected = true; }
+{
+  if ( isVirtual() )
+    selectRow(index - 1);
+  else
+    index2iterator(index - 1)->selected = true;
+}
 
 //----------------------------------------------------------------------
 inline void FListBox::selectItem (FListBoxItems::iterator iter) const
@@ -513,7 +566,12 @@ inline void FListBox::selectItem (FListBoxItems::iterator iter) const
 
 //----------------------------------------------------------------------
 inline void FListBox::unselectItem (std::size_t index)
-{ index2iterator(index - 1)->selected = false; }
+{
+  if ( isVirtual() )
+    unselectRow(index - 1);
+  else
+    index2iterator(index - 1)->selected = false;
+}
 
 //----------------------------------------------------------------------
 inline void FListBox::unselectItem (FListBoxItems::iterator iter) const
@@ -521,7 +579,10 @@ inline void FListBox::unselectItem (FListBoxItems::iterator iter) const
 
 //----------------------------------------------------------------------
 inline void FListBox::showNoBrackets (std::size_t index)
-{ index2iterator(index - 1)->brackets = BracketType::None; }
+{
+  if ( ! isVirtual() )
+    index2iterator(index - 1)->brackets = BracketType::None;
+}
 
 //----------------------------------------------------------------------
 inline void FListBox::showNoBrackets (FListBoxItems::iterator iter) const
@@ -541,7 +602,10 @@ inline auto FListBox::setDisable() -> bool
 
 //----------------------------------------------------------------------
 inline auto FListBox::isSelected (std::size_t index) const -> bool
-{ return index2iterator(index - 1)->selected; }
+{
+  return isVirtual() ? isRowSelected(index - 1)
+                     : index2iterator(index - 1)->selected;
+}
 
 //----------------------------------------------------------------------
 inline auto FListBox::isSelected (FListBoxItems::iterator iter) const -> bool
@@ -551,14 +615,25 @@ inline auto FListBox::isSelected (FListBoxItems::iterator iter) const -> bool
 inline auto FListBox::isMultiSelection() const -> bool
 { return multi_select; }
 
+//----------------------------------------------------------------------
+inline auto FListBox::isVirtual() const -> bool
+{ return bool(row_text_provider); }
+
 //----------------------------------------------------------------------
 inline auto FListBox::hasBrackets(std::size_t index) const -> bool
-{ return index2iterator(index - 1)->brackets != BracketType::None; }
+{
+  return ! isVirtual()
+      && index2iterator(index - 1)->brackets != BracketType::None;
+}
 
 //----------------------------------------------------------------------
 inline auto FListBox::hasBrackets(FListBoxItems::iterator iter) const -> bool
 { return iter->brackets != BracketType::None; }
 
+//----------------------------------------------------------------------
+inline void FListBox::remove (std::size_t item)
+{ remove (item, 1); }
+
 //----------------------------------------------------------------------
 inline void FListBox::reserve (std::size_t new_cap)
 { itemlist.reserve(new_cap); }
@@ -574,9 +649,11 @@ inline void FListBox::insert ( Iterator first
 
   while ( first != last )
   {
-    insert (convert(first), BracketType::None, false, &(*first));
+    appendItem (FListBoxItem{FString() << convert(first), &(*first)});
     ++first;
   }
+
+  finishInsertion();
 }
 
 //----------------------------------------------------------------------
@@ -590,7 +667,7 @@ void FListBox::insert (const Container& container, LazyConverter&& converter)
   const std::size_t size = container.size();
 
   if ( size > 0 )
-    itemlist.resize(size);
+    resizeItemList(size);
 
   recalculateVerticalBar(size);
 }
@@ -616,8 +693,10 @@ void FListBox::insert ( const std::initializer_list<T>& list
     FListBoxItem listItem (FString() << item, std::forward<DT>(d));
     listItem.brackets = b;
     listItem.selected = s;
-    insert (listItem);
+    appendItem (std::move(listItem));
   }
+
+  finishInsertion();
 }
 
 //----------------------------------------------------------------------
@@ -634,6 +713,10 @@ void FListBox::insert ( const ItemT& item
   insert (listItem);
 }
 
+//----------------------------------------------------------------------
+inline auto FListBox::getMaxLineWidth() const -> std::size_t
+{ return line_widths.empty() ? 0 : line_widths.crbegin()->first; }
+
 //----------------------------------------------------------------------
 inline auto FListBox::isHorizontallyScrollable() const -> bool
 { return max_line_width + 1 >= getClientWidth(); }
@@ -646,6 +729,7 @@ inline auto FListBox::isVerticallyScrollable() const -> bool
 inline auto \
     FListBox::index2iterator (std::size_t index) -> FListBoxItems::iterator
 {
+  assert ( ! isVirtual() );  // Virtual rows have no items
   auto iter = itemlist.begin();
   std::advance (iter, index);
   return iter;
@@ -655,6 +739,7 @@ inline auto \
 inline auto \
     FListBox::index2iterator (std::size_t index) const -> FListBoxItems::const_iterator
 {
+  assert ( ! isVirtual() );  // Virtual rows have no items
   auto iter = itemlist.begin();
   std::advance (iter, index);
   return iter;
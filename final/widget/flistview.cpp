@@ -21,8 +21,10 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <cctype>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -40,12 +42,8 @@
 namespace finalcut
 {
 
-// Function prototypes
+// Function prototype
 auto firstNumberFromString (const FString&) -> uInt64;
-auto sortAscendingByName (const FObject*, const FObject*) -> bool;
-auto sortDescendingByName (const FObject*, const FObject*) -> bool;
-auto sortAscendingByNumber (const FObject*, const FObject*) -> bool;
-auto sortDescendingByNumber (const FObject*, const FObject*) -> bool;
 
 // non-member functions
 //----------------------------------------------------------------------
@@ -109,56 +107,237 @@ auto firstNumberFromString (const FString& str) -> uInt64
   return number;
 }
 
+namespace internal
+{
+
+// Minimum number of rows per sort thread
+constexpr std::size_t MIN_ROWS_PER_SORT_THREAD = 4096;
+
+template <typename KeyT>
+using SortEntries = std::vector<std::pair<KeyT, FObject*>>;
+
+//----------------------------------------------------------------------
+inline auto getNameKey (const FString& text) -> std::wstring
+{
+  // Case-folded key in the order of FStringCaseCompare()
+
+  auto key = text.toWString();
+
+  for (auto& ch : key)
+    ch = wchar_t(std::tolower(ch));
+
+  return key;
+}
+
+//----------------------------------------------------------------------
+template <typename Function>
+void runInParts (std::size_t size, std::size_t parts, const Function& function)
+{
+  // Calls function(first, last) for each part of the index range
+  // [0, size) in its own thread. The calling thread takes the first part.
+
+  if ( parts < 2 )
+  {
+    function (0, size);
+    return;
+  }
+
+  std::vector<std::thread> workers{};
+
+  for (std::size_t n{1}; n < parts; n++)
+    workers.emplace_back (function, size * n / parts, size * (n + 1) / parts);
+
+  function (0, size / parts);
+
+  for (auto&& worker : workers)
+    worker.join();
+}
+
+//----------------------------------------------------------------------
+template <typename Iter, typename Less>
+void stableSort (Iter first, Iter last, const Less& less, std::size_t parts)
+{
+  // Parallel merge sort: Each thread sorts a part of the range,
+  // then the sorted runs are merged in pairs until one run is left
+
+  if ( parts < 2 )
+  {
+    std::stable_sort (first, last, less);
+    return;
+  }
+
+  const auto size = std::size_t(std::distance(first, last));
+  runInParts ( size, parts
+             , [first, &less] (std::size_t begin, std::size_t end)
+               {
+                 std::stable_sort ( first + std::ptrdiff_t(begin)
+                                  , first + std::ptrdiff_t(end), less );
+               } );
+  std::vector<Iter> bounds{};  // Begin of each run and the end
+
+  for (std::size_t n{0}; n <= parts; n++)
+    bounds.push_back (first + std::ptrdiff_t(size * n / parts));
+
+  while ( bounds.size() > 2 )
+  {
+    std::vector<std::thread> workers{};
+    std::vector<Iter> merged_bounds{};
+    std::size_t n{0};
+
+    for (; n + 2 < bounds.size(); n += 2)
+    {
+      merged_bounds.push_back (bounds[n]);
+      workers.emplace_back ([&bounds, &less, n] ()
+                            {
+                              std::inplace_merge ( bounds[n], bounds[n + 1]
+                                                 , bounds[n + 2], less );
+                            });
+    }
+
+    for (; n < bounds.size(); n++)
+      merged_bounds.push_back (bounds[n]);
+
+    for (auto&& worker : workers)
+      worker.join();
+
+    bounds.swap(merged_bounds);
+  }
+}
+
+//----------------------------------------------------------------------
+template <typename KeyFunction>
+void sortByKey ( FObject::FObjectList& list, int column, SortOrder order
+               , std::size_t threads, KeyFunction get_key )
+{
+  // Extracts the sort key of each item once and
+  // sorts the key/item pairs instead of the items
+
+  using KeyT = decltype(get_key(FString{}));
+  using Entry = typename SortEntries<KeyT>::value_type;
+  const auto size = list.size();
+  const auto parts = std::min(threads, size / MIN_ROWS_PER_SORT_THREAD);
+  SortEntries<KeyT> entries(size);
+
+  runInParts ( size, parts
+             , [&list, &entries, column, get_key] (std::size_t first, std::size_t last)
+               {
+                 for (auto n = first; n < last; n++)
+                 {
+                   const auto item = static_cast<const FListViewItem*>(list[n]);
+                   entries[n] = Entry{get_key(item->getText(column)), list[n]};
+                 }
+               } );
+
+  if ( order == SortOrder::Descending )
+    stableSort ( entries.begin(), entries.end()
+               , [] (const Entry& lhs, const Entry& rhs)
+                 {
+                   return rhs.first < lhs.first;
+                 }
+               , parts );
+  else
+    stableSort ( entries.begin(), entries.end()
+               , [] (const Entry& lhs, const Entry& rhs)
+                 {
+                   return lhs.first < rhs.first;
+                 }
+               , parts );
+
+  for (std::size_t n{0}; n < size; n++)
+    list[n] = entries[n].second;
+}
+
+}  // namespace internal
+
+
+//----------------------------------------------------------------------
+// class FListViewLines
 //----------------------------------------------------------------------
-auto sortAscendingByName (const FObject* lhs, const FObject* rhs) -> bool
+
+// public methods of FListViewLines
+//----------------------------------------------------------------------
+auto FListViewLines::getClassName() const -> FString
 {
-  const auto& l_item = static_cast<const FListViewItem*>(lhs);
-  const auto& r_item = static_cast<const FListViewItem*>(rhs);
-  const int column = l_item->getSortColumn();
-  const auto& l_string = l_item->getText(column);
-  const auto& r_string = r_item->getText(column);
+  return "FListViewLines";
+}
+
+//----------------------------------------------------------------------
+auto FListViewLines::getLinesBefore (std::size_t index) const noexcept -> std::size_t
+{
+  // Returns the visible lines of the items in front of index
+
+  std::size_t sum{0};
+  index = std::min(index, tree.size());
 
-  // lhs < rhs
-  return FStringCaseCompare(l_string, r_string) < 0;
+  while ( index > 0 )
+  {
+    sum += tree[index - 1];
+    index &= index - 1;  // Clear the lowest set bit
+  }
+
+  return sum;
 }
 
 //----------------------------------------------------------------------
-auto sortDescendingByName (const FObject* lhs, const FObject* rhs) -> bool
+auto FListViewLines::findIndex (std::size_t& line) const noexcept -> std::size_t
 {
-  const auto& l_item = static_cast<const FListViewItem*>(lhs);
-  const auto& r_item = static_cast<const FListViewItem*>(rhs);
-  const int column = l_item->getSortColumn();
-  const auto& l_string = l_item->getText(column);
-  const auto& r_string = r_item->getText(column);
+  // Returns the index of the item that shows the line and
+  // reduces line to the line offset within this item
+
+  const auto size = tree.size();
+  std::size_t index{0};
+  std::size_t step{1};
+
+  while ( step * 2 <= size )
+    step *= 2;
+
+  for (; step > 0; step /= 2)
+  {
+    const auto next = index + step;
 
-  // lhs > rhs
-  return FStringCaseCompare(l_string, r_string) > 0;
+    if ( next <= size && tree[next - 1] <= line )
+    {
+      index = next;
+      line -= tree[next - 1];
+    }
+  }
+
+  return index;
 }
 
 //----------------------------------------------------------------------
-auto sortAscendingByNumber (const FObject* lhs, const FObject* rhs) -> bool
+void FListViewLines::append (std::size_t lines)
 {
-  const auto& l_item = static_cast<const FListViewItem*>(lhs);
-  const auto& r_item = static_cast<const FListViewItem*>(rhs);
-  const int column = l_item->getSortColumn();
-  const auto& l_number = firstNumberFromString(l_item->getText(column));
-  const auto& r_number = firstNumberFromString(r_item->getText(column));
+  // The new node i covers the items (i - lowest_bit, i]
 
-  // lhs < rhs
-  return l_number < r_number;
+  const auto i = tree.size() + 1;
+  const auto lowest_bit = i & (~i + 1);
+  const auto covered = getLinesBefore(i - 1) - getLinesBefore(i - lowest_bit);
+  tree.push_back (covered + lines);
+  total += lines;
 }
 
 //----------------------------------------------------------------------
-auto sortDescendingByNumber (const FObject* lhs, const FObject* rhs) -> bool
+void FListViewLines::replace ( std::size_t index
+                             , std::size_t old_lines
+                             , std::size_t lines ) noexcept
 {
-  const auto& l_item = static_cast<const FListViewItem*>(lhs);
-  const auto& r_item = static_cast<const FListViewItem*>(rhs);
-  const int column = l_item->getSortColumn();
-  const auto& l_number = firstNumberFromString(l_item->getText(column));
-  const auto& r_number = firstNumberFromString(r_item->getText(column));
+  // The unsigned wrap-around of the difference keeps
+  // the sums correct when the number of lines decreases
 
-  // lhs > rhs
-  return l_number > r_number;
+  const std::size_t diff = lines - old_lines;
+
+  for (auto i = index + 1; i <= tree.size(); i += i & (~i + 1))
+    tree[i - 1] += diff;
+
+  total += diff;
+}
+
+//----------------------------------------------------------------------
+void FListViewLines::clear() noexcept
+{
+  tree.clear();
+  total = 0;
 }
 
 
@@ -354,13 +533,14 @@ void FListViewItem::remove (FListViewItem* item) const
     parent = item->getParent();
     parent->delChild(item);
     auto parent_item = static_cast<FListViewItem*>(parent);
-    parent_item->visible_lines--;
 
     if ( ! parent_item->hasChildren() )
     {
       parent_item->expandable = false;
       parent_item->is_expand = false;
     }
+
+    parent_item->indexChildren();
   }
 }
 
@@ -370,8 +550,8 @@ void FListViewItem::expand()
   if ( isExpand() || ! hasChildren() )
     return;
 
-  resetVisibleLineCounter();
   is_expand = true;
+  updateVisibleLines();
 }
 
 //----------------------------------------------------------------------
@@ -380,14 +560,14 @@ void FListViewItem::collapse()
   if ( ! isExpand() )
     return;
 
-  resetVisibleLineCounter();
   is_expand = false;
+  updateVisibleLines();
 }
 
 // private methods of FListView
 //----------------------------------------------------------------------
-template <typename Compare>
-void FListViewItem::sort (Compare cmp)
+template <typename SortFunction>
+void FListViewItem::sort (const SortFunction& sort_list)
 {
   if ( ! isExpandable() )
     return;
@@ -396,20 +576,25 @@ void FListViewItem::sort (Compare cmp)
   auto& children = getChildren();
 
   if ( ! children.empty() )
-    std::sort(children.begin(), children.end(), cmp);
+  {
+    sort_list(children);
+    indexChildren();
+  }
 
   // Sort the sublevels
   for (auto&& item : children)
-    static_cast<FListViewItem*>(item)->sort(cmp);
+    static_cast<FListViewItem*>(item)->sort(sort_list);
 }
 
 //----------------------------------------------------------------------
 auto FListViewItem::appendItem (FListViewItem* child) -> FObject::iterator
 {
   expandable = true;
-  resetVisibleLineCounter();
   child->root = root;
+  child->list_index = child_lines.getSize();
   addChild (child);
+  child_lines.append (child->getVisibleLines());
+  updateVisibleLines();
   // Return iterator to child/last element
   return --FObject::end();
 }
@@ -427,29 +612,6 @@ void FListViewItem::replaceControlCodes()
   }
 }
 
-//----------------------------------------------------------------------
-auto FListViewItem::getVisibleLines() -> std::size_t
-{
-  if ( visible_lines > 1 )
-    return visible_lines;
-
-  visible_lines = 1;
-
-  if ( ! isExpand() || ! hasChildren() )
-    return visible_lines;
-
-  auto iter = FObject::cbegin();
-
-  while ( iter != FObject::cend() )
-  {
-    const auto& child = static_cast<FListViewItem*>(*iter);
-    visible_lines += child->getVisibleLines();
-    ++iter;
-  }
-
-  return visible_lines;
-}
-
 //----------------------------------------------------------------------
 void FListViewItem::setCheckable (bool enable)
 {
@@ -465,16 +627,51 @@ void FListViewItem::setCheckable (bool enable)
 }
 
 //----------------------------------------------------------------------
-void FListViewItem::resetVisibleLineCounter()
+void FListViewItem::updateVisibleLines()
 {
-  visible_lines = 0;
+  // Recounts the visible lines and passes the
+  // difference on to the line counts of the parents
+
+  const std::size_t lines = ( isExpand() ) ? 1 + child_lines.getLines() : 1;
+
+  if ( lines == visible_lines )
+    return;
+
+  const auto old_lines = visible_lines;
+  visible_lines = lines;
   auto parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
+  if ( ! parent )
+    return;
+
+  if ( parent->isInstanceOf("FListViewItem") )
   {
     auto parent_item = static_cast<FListViewItem*>(parent);
-    return parent_item->resetVisibleLineCounter();
+    parent_item->child_lines.replace (list_index, old_lines, lines);
+    parent_item->updateVisibleLines();
+  }
+  else if ( parent->isInstanceOf("FListView") )
+  {
+    auto listview = static_cast<FListView*>(parent);
+    listview->itemlist_lines.replace (list_index, old_lines, lines);
+  }
+}
+
+//----------------------------------------------------------------------
+void FListViewItem::indexChildren()
+{
+  // Numbers the child items and recounts their visible lines
+
+  child_lines.clear();
+
+  for (auto&& child : getChildren())
+  {
+    auto child_item = static_cast<FListViewItem*>(child);
+    child_item->list_index = child_lines.getSize();
+    child_lines.append (child_item->getVisibleLines());
   }
+
+  updateVisibleLines();
 }
 
 
@@ -531,6 +728,9 @@ auto FListViewIterator::operator -- (int) -> FListViewIterator  // postfix
 //----------------------------------------------------------------------
 auto FListViewIterator::operator += (int n) -> FListViewIterator&
 {
+  if ( n > 1 && seek(position + n) )
+    return *this;
+
   for (int i = n; i > 0 ; i--)
     nextElement(node);
 
@@ -540,6 +740,9 @@ auto FListViewIterator::operator += (int n) -> FListViewIterator&
 //----------------------------------------------------------------------
 auto FListViewIterator::operator -= (int n) -> FListViewIterator&
 {
+  if ( n > 1 && seek(position - n) )
+    return *this;
+
   for (int i = n; i > 0 ; i--)
     prevElement(node);
 
@@ -618,6 +821,47 @@ void FListViewIterator::prevElement (Iterator& iter)
   }
 }
 
+//----------------------------------------------------------------------
+auto FListViewIterator::seek (int target) -> bool
+{
+  // Descends from the top level directly to the line at the target
+  // position. Each level finds the item containing the line by
+  // the visible line counts, so no line in between is visited.
+
+  const auto item = static_cast<FListViewItem*>(*node);
+
+  if ( item->root == Iterator{} )
+    return false;
+
+  const auto listview = static_cast<FListView*>(*item->root);
+
+  if ( target < 0 || std::size_t(target) >= listview->getCount() )
+    return false;
+
+  auto line = std::size_t(target);
+  auto first = listview->itemlist.begin();
+  const FListViewLines* lines = &listview->itemlist_lines;
+  iter_path = IteratorStack{};
+
+  while ( true )
+  {
+    node = first + std::ptrdiff_t(lines->findIndex(line));
+
+    if ( line == 0 )  // The line of the item itself
+      break;
+
+    // The line belongs to a descendant of the expanded item
+    const auto parent = static_cast<FListViewItem*>(*node);
+    iter_path.push(node);
+    first = parent->begin();
+    lines = &parent->child_lines;
+    line--;
+  }
+
+  position = target;
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FListViewIterator::parentElement()
 {
@@ -653,15 +897,19 @@ FListView::~FListView()  // destructor
 //----------------------------------------------------------------------
 auto FListView::getCount() const -> std::size_t
 {
-  int n{0};
+  if ( hasModel() )
+    return model_tree.getCount();
 
-  for (auto&& item : itemlist)
-  {
-    const auto& listitem = static_cast<FListViewItem*>(item);
-    n += listitem->getVisibleLines();
-  }
+  return itemlist_lines.getLines();
+}
+
+//----------------------------------------------------------------------
+auto FListView::getCurrentNode() const -> FListViewModel::Node
+{
+  if ( isListEmpty() )
+    return FListViewModel::ROOT;
 
-  return std::size_t(n);
+  return model_tree.getLine(std::size_t(model_current_line)).node;
 }
 
 //----------------------------------------------------------------------
@@ -723,6 +971,23 @@ void FListView::setGeometry ( const FPoint& pos, const FSize& size
   changeOnResize();
 }
 
+//----------------------------------------------------------------------
+void FListView::setModel (FListViewModel* list_model)
+{
+  // With a model, the list view shows the rows of the model
+  // instead of the inserted items. nullptr shows the items again.
+
+  model = list_model;
+  model_tree.setModel(list_model);
+  model_rows.clear();
+  model_current_line = 0;
+  model_first_line = 0;
+  first_line_position_before = -1;
+  xoffset = 0;
+  recalculateVerticalBar (getCount());
+  processChanged();
+}
+
 //----------------------------------------------------------------------
 void FListView::setColumnAlignment (int column, Align align)
 {
@@ -866,7 +1131,7 @@ auto FListView::removeColumn (int column) -> int
   {
     const auto& item = static_cast<FListViewItem*>(*iter);
     item->column_list.erase (item->column_list.begin() + column - 1);
-    std::size_t line_width = determineLineWidth (item);
+    std::size_t line_width = determineLineWidth (item->column_list);
     recalculateHorizontalBar (line_width);
     ++iter;
   }
@@ -975,13 +1240,13 @@ void FListView::remove (FListViewItem* item)
       auto last = std::remove (itemlist.begin(), itemlist.end(), item);
       itemlist.erase(last, itemlist.end());
       delChild(item);
+      indexItems();
       current_iter.getPosition()--;
     }
     else
     {
       parent->delChild(item);
       auto parent_item = static_cast<FListViewItem*>(parent);
-      parent_item->visible_lines--;
       current_iter.getPosition()--;
 
       if ( ! parent_item->hasChildren() )
@@ -989,6 +1254,8 @@ void FListView::remove (FListViewItem* item)
         parent_item->expandable = false;
         parent_item->is_expand = false;
       }
+
+      parent_item->indexChildren();
     }
   }
 
@@ -1017,6 +1284,7 @@ void FListView::remove (FListViewItem* item)
 void FListView::clear()
 {
   itemlist.clear();
+  itemlist_lines.clear();
   current_iter = getNullIterator();
   first_visible_line = getNullIterator();
   last_visible_line = getNullIterator();
@@ -1030,6 +1298,21 @@ void FListView::clear()
   processChanged();
 }
 
+//----------------------------------------------------------------------
+void FListView::reloadModel()
+{
+  // Rereads the row count after the model data has changed.
+  // All expanded nodes are collapsed.
+
+  if ( ! hasModel() )
+    return;
+
+  model_tree.reset();
+  adjustViewport (int(getCount()));
+  recalculateVerticalBar (getCount());
+  processChanged();
+}
+
 //----------------------------------------------------------------------
 void FListView::sort()
 {
@@ -1038,35 +1321,59 @@ void FListView::sort()
   if ( sort_column < 1 || sort_column > int(header.size()) )
     return;
 
-  SortType column_sort_type = getColumnSortType(sort_column);
-  std::function<bool(const FObject*, const FObject*)> comparator;
+  if ( hasModel() )
+  {
+    model->sort (sort_column, sort_order);
+    model_tree.reset();
+    model_current_line = 0;
+    model_first_line = 0;
+    processChanged();
+    return;
+  }
+
+  const int column = sort_column;
+  const auto order = sort_order;
+  const auto threads = sort_threads;
+  std::function<void(FObjectList&)> sort_list;
 
-  switch ( column_sort_type )
+  switch ( getColumnSortType(sort_column) )
   {
     case SortType::Unknown:
     case SortType::Name:
-      comparator = ( sort_order == SortOrder::Ascending )
-                 ? sortAscendingByName
-                 : sortDescendingByName;
+      sort_list = [column, order, threads] (FObjectList& list)
+      {
+        internal::sortByKey (list, column, order, threads, internal::getNameKey);
+      };
       break;
 
     case SortType::Number:
-      comparator = ( sort_order == SortOrder::Ascending )
-                 ? sortAscendingByNumber
-                 : sortDescendingByNumber;
+      sort_list = [column, order, threads] (FObjectList& list)
+      {
+        internal::sortByKey (list, column, order, threads, firstNumberFromString);
+      };
       break;
 
     case SortType::UserDefined:
-      comparator = ( sort_order == SortOrder::Ascending )
-                 ? user_defined_ascending
-                 : user_defined_descending;
+    {
+      const auto cmp = ( sort_order == SortOrder::Ascending )
+                     ? user_defined_ascending
+                     : user_defined_descending;
+
+      if ( ! cmp )
+        return;
+
+      sort_list = [cmp] (FObjectList& list)
+      {
+        std::stable_sort (list.begin(), list.end(), cmp);
+      };
       break;
+    }
 
     default:
       throw std::invalid_argument{"Invalid sort type"};
   }
 
-  sort(comparator);
+  sort(sort_list);
   current_iter = itemlist.begin();
   first_visible_line = itemlist.begin();
   processChanged();
@@ -1075,19 +1382,19 @@ void FListView::sort()
 //----------------------------------------------------------------------
 void FListView::onKeyPress (FKeyEvent* ev)
 {
-  const int position_before = current_iter.getPosition();
+  const int position_before = getCurrentPosition();
   const int xoffset_before = xoffset;
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
   clicked_expander_pos.setPoint(-1, -1);
   processKeyAction(ev);  // Process the keystrokes
 
-  if ( position_before != current_iter.getPosition() )
+  if ( position_before != getCurrentPosition() )
     processRowChanged();
 
   if ( ev->isAccepted() )
   {
     const bool draw_vbar( first_line_position_before
-                       != first_visible_line.getPosition() );
+                       != getFirstVisiblePosition() );
     const bool draw_hbar(xoffset_before != xoffset);
     updateDrawing (draw_vbar, draw_hbar);
   }
@@ -1103,13 +1410,13 @@ void FListView::onMouseDown (FMouseEvent* ev)
   }
 
   setWidgetFocus(this);
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( isWithinHeaderBounds(ev->getPos()) )
   {
     clicked_header_pos = ev->getPos();  // Handle events in the header
   }
-  else if ( isWithinListBounds(ev->getPos()) && ! isItemListEmpty() )
+  else if ( isWithinListBounds(ev->getPos()) && ! isListEmpty() )
   {
     handleListEvent(ev);  // Handle events in the list
   }
@@ -1140,9 +1447,25 @@ void FListView::onMouseUp (FMouseEvent* ev)
     return;
   }
 
-  if ( isItemListEmpty() )
+  if ( isListEmpty() )
     return;
 
+  if ( hasModel() )
+  {
+    if ( isTreeView() && clicked_expander_pos == ev->getPos() )
+    {
+      toggleModelExpandState();
+      adjustScrollbars (getCount());
+
+      if ( isShown() )
+        draw();
+    }
+
+    processRowChanged();
+    resetClickedPositions();
+    return;
+  }
+
   int indent{0};
   const auto& item = getCurrentItem();
 
@@ -1184,11 +1507,11 @@ void FListView::onMouseMove (FMouseEvent* ev)
   }
 
   const int mouse_y = ev->getY();
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( isWithinListBounds(ev->getPos()) )
   {
-    const int new_pos = first_visible_line.getPosition() + mouse_y - 2;
+    const int new_pos = getFirstVisiblePosition() + mouse_y - 2;
 
     if ( new_pos < int(getCount()) )
       setRelativePosition (mouse_y - 2);
@@ -1196,9 +1519,9 @@ void FListView::onMouseMove (FMouseEvent* ev)
     if ( isShown() )
       drawList();
 
-    vbar->setValue (first_visible_line.getPosition());
+    vbar->setValue (getFirstVisiblePosition());
 
-    if ( first_line_position_before != first_visible_line.getPosition() )
+    if ( first_line_position_before != getFirstVisiblePosition() )
       vbar->drawBar();
 
     forceTerminalUpdate();
@@ -1221,15 +1544,23 @@ void FListView::onMouseDoubleClick (FMouseEvent* ev)
 
   if ( isWithinListBounds(ev->getPos()) )
   {
-    if ( first_visible_line.getPosition() + ev->getY() - 1 > int(getCount()) )
+    if ( getFirstVisiblePosition() + ev->getY() - 1 > int(getCount()) )
       return;
 
-    if ( isItemListEmpty() )
+    if ( isListEmpty() )
       return;
 
     auto item = getCurrentItem();
 
-    if ( isTreeView() && item->isExpandable() )
+    if ( hasModel() && isTreeView() )
+    {
+      toggleModelExpandState();
+      adjustScrollbars (getCount());  // after expand or collapse
+
+      if ( isShown() )
+        draw();
+    }
+    else if ( item && isTreeView() && item->isExpandable() )
     {
       toggleItemExpandState(item);
       adjustScrollbars (getCount());  // after expand or collapse
@@ -1247,8 +1578,8 @@ void FListView::onMouseDoubleClick (FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FListView::onTimer (FTimerEvent*)
 {
-  const int position_before = current_iter.getPosition();
-  first_line_position_before = first_visible_line.getPosition();
+  const int position_before = getCurrentPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( ( drag_scroll == DragScrollMode::Upward
       || drag_scroll == DragScrollMode::SelectUpward )
@@ -1267,9 +1598,9 @@ void FListView::onTimer (FTimerEvent*)
   if ( isShown() )
     drawList();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
-  if ( first_line_position_before != first_visible_line.getPosition() )
+  if ( first_line_position_before != getFirstVisiblePosition() )
     vbar->drawBar();
 
   forceTerminalUpdate();
@@ -1278,10 +1609,11 @@ void FListView::onTimer (FTimerEvent*)
 //----------------------------------------------------------------------
 void FListView::onWheel (FWheelEvent* ev)
 {
-  const int position_before = current_iter.getPosition();
-  static constexpr int wheel_distance = 4;
+  const int position_before = getCurrentPosition();
+  static constexpr int wheel_step = 4;
+  const int wheel_distance = wheel_step * ev->getDelta();
   const auto& wheel = ev->getWheel();
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   if ( isDragging(drag_scroll) )
     stopDragScroll();
@@ -1295,15 +1627,15 @@ void FListView::onWheel (FWheelEvent* ev)
   else if ( wheel == MouseWheel::Right )
     wheelRight (wheel_distance);
 
-  if ( position_before != current_iter.getPosition() )
+  if ( position_before != getCurrentPosition() )
     processRowChanged();
 
   if ( isShown() )
     drawList();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
-  if ( first_line_position_before != first_visible_line.getPosition() )
+  if ( first_line_position_before != getFirstVisiblePosition() )
     vbar->drawBar();
 
   forceTerminalUpdate();
@@ -1333,6 +1665,20 @@ void FListView::adjustViewport (const int element_count)
 {
   const auto height = int(getClientHeight());
 
+  if ( hasModel() )
+  {
+    clampModelLines();
+
+    if ( height > 0 )  // Keep the current line visible
+    {
+      const int last_line = model_first_line + height - 1;
+      model_current_line = std::min(model_current_line, last_line);
+      model_current_line = std::max(model_current_line, model_first_line);
+    }
+
+    return;
+  }
+
   if ( height <= 0 || element_count == 0 )
     return;
 
@@ -1490,15 +1836,16 @@ void FListView::processKeyAction (FKeyEvent* ev)
 }
 
 //----------------------------------------------------------------------
-template <typename Compare>
-void FListView::sort (Compare cmp)
+template <typename SortFunction>
+void FListView::sort (const SortFunction& sort_list)
 {
   // Sort the top level
-  std::sort(itemlist.begin(), itemlist.end(), cmp);
+  sort_list(itemlist);
+  indexItems();
 
   // Sort the sublevels
   for (auto&& item : itemlist)
-    static_cast<FListViewItem*>(item)->sort(cmp);
+    static_cast<FListViewItem*>(item)->sort(sort_list);
 }
 
 //----------------------------------------------------------------------
@@ -1539,7 +1886,7 @@ auto FListView::getListEnd (const FListViewItem* item) -> FObject::iterator
 //----------------------------------------------------------------------
 void FListView::draw()
 {
-  if ( current_iter.getPosition() < 1 )
+  if ( ! hasModel() && current_iter.getPosition() < 1 )
     current_iter = itemlist.begin();
 
   useParentWidgetColor();
@@ -1621,6 +1968,12 @@ void FListView::drawHeadlines()
 //----------------------------------------------------------------------
 void FListView::drawList()
 {
+  if ( hasModel() )
+  {
+    drawModelList();
+    return;
+  }
+
   if ( isItemListEmpty() || getHeight() <= 2 || getWidth() <= 4 )
     return;
 
@@ -1658,6 +2011,49 @@ void FListView::drawList()
     ++iter;
   }
 
+  drawEmptyLines(y);
+}
+
+//----------------------------------------------------------------------
+void FListView::drawModelList()
+{
+  if ( isListEmpty() || getHeight() <= 2 || getWidth() <= 4 )
+    return;
+
+  if ( fetchModelRows() )  // The column widths have grown
+    drawHeadlines();
+
+  int y{0};
+
+  for (const auto& row : model_rows)
+  {
+    const bool is_current_line( model_first_line + y == model_current_line );
+    const int tree_offset = isTreeView() ? int(row.line.depth << 1u) + 1 : 0;
+    print() << FPoint{2, 2 + y};
+
+    // Draw one model row
+    drawModelLine (row, getFlags().focus.focus, is_current_line);
+
+    if ( getFlags().focus.focus && is_current_line )
+    {
+      int xpos = 3 + tree_offset - xoffset;
+
+      if ( xpos < 2 )  // Hide the cursor
+        xpos = -9999;  // by moving it outside the visible area
+
+      setVisibleCursor (false);
+      setCursorPos ({xpos, 2 + y});  // first character
+    }
+
+    y++;
+  }
+
+  drawEmptyLines(y);
+}
+
+//----------------------------------------------------------------------
+void FListView::drawEmptyLines (int y)
+{
   // Reset color
   setColor();
 
@@ -1697,60 +2093,86 @@ void FListView::drawListLine ( const FListViewItem* item
   FString line{getLinePrefix (item, indent)};
 
   // Print columns
-  if ( ! item->column_list.empty() )
+  appendColumns (line, item->column_list, indent, item->isCheckable());
+  printLine (line);
+}
+
+//----------------------------------------------------------------------
+void FListView::drawModelLine ( const ModelRow& row
+                              , bool is_focus
+                              , bool is_current )
+{
+  // Set line color and attributes
+  setLineAttributes (is_current, is_focus);
+
+  // Print the row
+  const std::size_t indent = row.line.depth << 1u;  // indent = 2 * depth
+  FString line{getTreePrefix (indent, row.line.expandable, row.line.expanded)};
+  appendColumns (line, row.columns, indent, false);
+  printLine (line);
+}
+
+//----------------------------------------------------------------------
+void FListView::appendColumns ( FString& line
+                              , const FStringList& columns
+                              , std::size_t indent
+                              , bool is_checkable ) const
+{
+  for (std::size_t col{0}; col < columns.size(); )
   {
-    for (std::size_t col{0}; col < item->column_list.size(); )
+    if ( ! header[col].visible )
     {
-      if ( ! header[col].visible )
-      {
-        col++;
-        continue;
-      }
-
-      static constexpr std::size_t ellipsis_length = 2;
-      const auto& text = item->column_list[col];
-      auto width = std::size_t(header[col].width);
-      const std::size_t column_width = getColumnWidth(text);
-      // Increment the value of col for the column position
-      // and the next iteration
       col++;
-      const auto align = getColumnAlignment(int(col));
-      const std::size_t align_offset = getAlignOffset (align, column_width, width);
+      continue;
+    }
 
-      if ( isTreeView() && col == 1 )
-        adjustWidthForTreeView (width, indent, item->isCheckable());
+    static constexpr std::size_t ellipsis_length = 2;
+    const auto& text = columns[col];
+    auto width = std::size_t(header[col].width);
+    const std::size_t column_width = getColumnWidth(text);
+    // Increment the value of col for the column position
+    // and the next iteration
+    col++;
+    const auto align = getColumnAlignment(int(col));
+    const std::size_t align_offset = getAlignOffset (align, column_width, width);
 
-      // Insert alignment spaces
-      if ( align_offset > 0 )
-        line += FString{align_offset, L' '};
+    if ( isTreeView() && col == 1 )
+      adjustWidthForTreeView (width, indent, is_checkable);
 
-      if ( align_offset + column_width <= width )
-      {
-        // Insert text and trailing space
-        static constexpr std::size_t leading_space = 1;
-        line += getColumnSubString (text, 1, width);
-        line += FString { leading_space + width
-                        - align_offset - column_width, L' '};
-      }
-      else if ( align == Align::Right )
-      {
-        // Ellipse right align text
-        const std::size_t first = getColumnWidth(text) + 1 - width;
-        line += FString {L".."};
-        line += getColumnSubString (text, first, width - ellipsis_length);
-        line += L' ';
-      }
-      else
-      {
-        // Ellipse left align text and center text
-        line += getColumnSubString (text, 1, width - ellipsis_length);
-        line += FString {L".. "};
-      }
+    // Insert alignment spaces
+    if ( align_offset > 0 )
+      line += FString{align_offset, L' '};
+
+    if ( align_offset + column_width <= width )
+    {
+      // Insert text and trailing space
+      static constexpr std::size_t leading_space = 1;
+      line += getColumnSubString (text, 1, width);
+      line += FString { leading_space + width
+                      - align_offset - column_width, L' '};
+    }
+    else if ( align == Align::Right )
+    {
+      // Ellipse right align text
+      const std::size_t first = getColumnWidth(text) + 1 - width;
+      line += FString {L".."};
+      line += getColumnSubString (text, first, width - ellipsis_length);
+      line += L' ';
+    }
+    else
+    {
+      // Ellipse left align text and center text
+      line += getColumnSubString (text, 1, width - ellipsis_length);
+      line += FString {L".. "};
     }
   }
+}
 
+//----------------------------------------------------------------------
+void FListView::printLine (const FString& text)
+{
   const std::size_t width = getWidth() - nf_offset - 2;
-  line = getColumnSubString ( line, std::size_t(xoffset) + 1, width );
+  const auto line = getColumnSubString ( text, std::size_t(xoffset) + 1, width );
   const std::size_t len = line.getLength();
   std::size_t char_width{0};
 
@@ -1862,6 +2284,19 @@ inline auto FListView::getCheckBox (const FListViewItem* item) const -> FString
 //----------------------------------------------------------------------
 inline auto FListView::getLinePrefix ( const FListViewItem* item
                                      , std::size_t indent ) const -> FString
+{
+  FString line{getTreePrefix (indent, item->isExpandable(), item->isExpand())};
+
+  if ( item->isCheckable() )
+    line += getCheckBox(item);
+
+  return line;
+}
+
+//----------------------------------------------------------------------
+inline auto FListView::getTreePrefix ( std::size_t indent
+                                     , bool is_expandable
+                                     , bool is_expand ) const -> FString
 {
   FString line{""};
 
@@ -1870,9 +2305,9 @@ inline auto FListView::getLinePrefix ( const FListViewItem* item
     if ( indent > 0 )
       line = FString{indent, L' '};
 
-    if ( item->isExpandable()  )
+    if ( is_expandable )
     {
-      if ( item->isExpand() )
+      if ( is_expand )
       {
         line += UniChar::BlackDownPointingTriangle;  // ▼
         line += L' ';
@@ -1889,9 +2324,6 @@ inline auto FListView::getLinePrefix ( const FListViewItem* item
   else
     line.setString(" ");
 
-  if ( item->isCheckable() )
-    line += getCheckBox(item);
-
   return line;
 }
 
@@ -2107,7 +2539,7 @@ void FListView::updateLayout()
                 , [this] (FObject* obj_item)
                   {
                     const auto& item = static_cast<FListViewItem*>(obj_item);
-                    std::size_t line_width = determineLineWidth (item);
+                    std::size_t line_width = determineLineWidth (item->column_list);
                     recalculateHorizontalBar (line_width);
                   }
                 );
@@ -2124,7 +2556,7 @@ void FListView::updateDrawing (bool draw_vbar, bool draw_hbar)
   if ( isShown() )
     draw();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
   if ( draw_vbar )
     vbar->drawBar();
@@ -2138,12 +2570,12 @@ void FListView::updateDrawing (bool draw_vbar, bool draw_hbar)
 }
 
 //----------------------------------------------------------------------
-auto FListView::determineLineWidth (FListViewItem* item) -> std::size_t
+auto FListView::determineLineWidth (const FStringList& columns) -> std::size_t
 {
   std::size_t padding_space = 1;
   std::size_t line_width = padding_space;  // leading space
   std::size_t column_idx{0};
-  const auto entries = std::size_t(item->column_list.size());
+  const auto entries = std::size_t(columns.size());
 
   if ( hasCheckableItems() )
     line_width += checkbox_space;
@@ -2158,7 +2590,7 @@ auto FListView::determineLineWidth (FListViewItem* item) -> std::size_t
       std::size_t len{0};
 
       if ( column_idx < entries )
-        len = getColumnWidth(item->column_list[column_idx]);
+        len = getColumnWidth(columns[column_idx]);
 
       if ( len > width )
         header_item.width = int(len);
@@ -2177,10 +2609,44 @@ auto FListView::determineLineWidth (FListViewItem* item) -> std::size_t
   return line_width;
 }
 
+//----------------------------------------------------------------------
+auto FListView::fetchModelRows() -> bool
+{
+  // Requests the column texts of the visible lines from the model.
+  // Returns true if a column has become wider.
+
+  const auto width_before = max_line_width;
+  const auto page_height = std::max(int(getHeight()) - 2, 0);
+  const auto end = std::min(model_first_line + page_height, int(getCount()));
+  model_rows.resize(std::size_t(std::max(end - model_first_line, 0)));
+  auto line = std::size_t(model_first_line);
+  bool has_grown{false};
+
+  for (auto& row : model_rows)
+  {
+    row.line = model_tree.getLine(line);
+    row.columns.resize(header.size());
+    int column{1};
+
+    for (auto& text : row.columns)
+    {
+      text = model->getText(row.line.node, column).replaceControlCodes();
+      column++;
+    }
+
+    const auto line_width = determineLineWidth (row.columns);
+    has_grown = has_grown || line_width > width_before;
+    recalculateHorizontalBar (line_width);
+    line++;
+  }
+
+  return has_grown;
+}
+
 //----------------------------------------------------------------------
 inline void FListView::beforeInsertion (FListViewItem* item)
 {
-  std::size_t line_width = determineLineWidth (item);
+  std::size_t line_width = determineLineWidth (item->column_list);
   recalculateHorizontalBar (line_width);
 }
 
@@ -2298,6 +2764,12 @@ void FListView::mouseHeaderClicked()
 //----------------------------------------------------------------------
 void FListView::wheelUp (int pagesize)
 {
+  if ( hasModel() )
+  {
+    scrollModelLines(-pagesize);
+    return;
+  }
+
   if ( isItemListEmpty() || current_iter.getPosition() == 0 )
     return;
 
@@ -2322,6 +2794,12 @@ void FListView::wheelUp (int pagesize)
 //----------------------------------------------------------------------
 void FListView::wheelDown (int pagesize)
 {
+  if ( hasModel() )
+  {
+    scrollModelLines(pagesize);
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2351,7 +2829,7 @@ void FListView::wheelDown (int pagesize)
 //----------------------------------------------------------------------
 void FListView::wheelLeft (int pagesize)
 {
-  if ( isItemListEmpty() || xoffset == 0 )
+  if ( isListEmpty() || xoffset == 0 )
     return;
 
   const int xoffset_before = xoffset;
@@ -2363,7 +2841,7 @@ void FListView::wheelLeft (int pagesize)
 //----------------------------------------------------------------------
 void FListView::wheelRight (int pagesize)
 {
-  if ( isItemListEmpty() )
+  if ( isListEmpty() )
     return;
 
   const int xoffset_before = xoffset;
@@ -2407,7 +2885,7 @@ void FListView::dragUp (MouseButton mouse_button)
     && scroll_distance < int(getClientHeight()) )
     scroll_distance++;
 
-  if ( ! scroll_timer && current_iter.getPosition() > 0 )
+  if ( ! scroll_timer && getCurrentPosition() > 0 )
   {
     scroll_timer = true;
     addTimer(scroll_repeat);
@@ -2418,7 +2896,7 @@ void FListView::dragUp (MouseButton mouse_button)
       drag_scroll = DragScrollMode::Upward;
   }
 
-  if ( current_iter.getPosition() == 0 )
+  if ( getCurrentPosition() == 0 )
   {
     delOwnTimers();
     drag_scroll = DragScrollMode::None;
@@ -2432,7 +2910,7 @@ void FListView::dragDown (MouseButton mouse_button)
     && scroll_distance < int(getClientHeight()) )
     scroll_distance++;
 
-  if ( ! scroll_timer && current_iter.getPosition() <= int(getCount()) )
+  if ( ! scroll_timer && getCurrentPosition() <= int(getCount()) )
   {
     scroll_timer = true;
     addTimer(scroll_repeat);
@@ -2443,7 +2921,7 @@ void FListView::dragDown (MouseButton mouse_button)
       drag_scroll = DragScrollMode::Downward;
   }
 
-  if ( current_iter.getPosition() - 1 == int(getCount()) )
+  if ( getCurrentPosition() - 1 == int(getCount()) )
   {
     delOwnTimers();
     drag_scroll = DragScrollMode::None;
@@ -2468,6 +2946,17 @@ inline void FListView::toggleItemExpandState (FListViewItem* item) const
     item->expand();
 }
 
+//----------------------------------------------------------------------
+void FListView::toggleModelExpandState()
+{
+  const auto line = std::size_t(model_current_line);
+
+  if ( model_tree.getLine(line).expanded )
+    model_tree.collapse(line);
+  else
+    model_tree.expand(line);
+}
+
 //----------------------------------------------------------------------
 inline auto FListView::isCheckboxClicked (int mouse_x, int indent) const -> bool
 {
@@ -2507,38 +2996,67 @@ auto FListView::isWithinListBounds (const FPoint& pos) const -> bool
 auto FListView::appendItem (FListViewItem* item) -> FObject::iterator
 {
   item->root = root;
+  item->list_index = itemlist_lines.getSize();
   addChild (item);
   itemlist.push_back (item);
+  itemlist_lines.append (item->getVisibleLines());
   return --itemlist.end();
 }
 
+//----------------------------------------------------------------------
+void FListView::indexItems()
+{
+  // Numbers the top-level items and recounts their visible lines
+
+  itemlist_lines.clear();
+
+  for (auto&& item : itemlist)
+  {
+    auto listitem = static_cast<FListViewItem*>(item);
+    listitem->list_index = itemlist_lines.getSize();
+    itemlist_lines.append (listitem->getVisibleLines());
+  }
+}
+
 //----------------------------------------------------------------------
 void FListView::handleListEvent (const FMouseEvent* ev)
 {
   int indent = 0;
-  const int new_pos = first_visible_line.getPosition() + ev->getY() - 2;
+  const int new_pos = getFirstVisiblePosition() + ev->getY() - 2;
 
   if ( new_pos < int(getCount()) )
     setRelativePosition (ev->getY() - 2);
 
-  const auto& item = getCurrentItem();
-
-  if ( isTreeView() )  // Handle tree view events
+  if ( hasModel() )
   {
-    indent = int(item->getDepth() << 1u);  // indent = 2 * depth
+    const auto line = model_tree.getLine(std::size_t(model_current_line));
+    indent = int(line.depth << 1u);  // indent = 2 * depth
 
-    if ( item->isExpandable() && ev->getX() - 2 == indent - xoffset )
+    if ( isTreeView() && line.expandable
+      && ev->getX() - 2 == indent - xoffset )
       clicked_expander_pos = ev->getPos();
   }
-
-  if ( hasCheckableItems() )  // Handle checkable item events
+  else
   {
-    if ( isTreeView() )
-      indent++;  // Plus one space
+    const auto& item = getCurrentItem();
+
+    if ( isTreeView() )  // Handle tree view events
+    {
+      indent = int(item->getDepth() << 1u);  // indent = 2 * depth
+
+      if ( item->isExpandable() && ev->getX() - 2 == indent - xoffset )
+        clicked_expander_pos = ev->getPos();
+    }
 
-    if ( item->isCheckable() && isCheckboxClicked(ev->getX(), indent) )
+    if ( hasCheckableItems() )  // Handle checkable item events
     {
-      clicked_checkbox_item = item;
+      if ( isTreeView() )
+        indent++;  // Plus one space
+
+      if ( item->isCheckable() && isCheckboxClicked(ev->getX(), indent) )
+      {
+        clicked_checkbox_item = item;
+      }
     }
   }
 
@@ -2546,9 +3064,9 @@ void FListView::handleListEvent (const FMouseEvent* ev)
   if ( isShown() )
     drawList();
 
-  vbar->setValue (first_visible_line.getPosition());
+  vbar->setValue (getFirstVisiblePosition());
 
-  if ( first_line_position_before != first_visible_line.getPosition() )
+  if ( first_line_position_before != getFirstVisiblePosition() )
     vbar->drawBar();
 
   forceTerminalUpdate();
@@ -2557,7 +3075,7 @@ void FListView::handleListEvent (const FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FListView::processClick() const
 {
-  if ( isItemListEmpty() )
+  if ( isListEmpty() )
     return;
 
   emitCallback("clicked");
@@ -2593,6 +3111,9 @@ void FListView::changeOnResize() const
 //----------------------------------------------------------------------
 inline void FListView::toggleCheckbox()
 {
+  if ( hasModel() )  // The model rows have no check boxes
+    return;
+
   if ( isItemListEmpty() )
     return;
 
@@ -2605,6 +3126,12 @@ inline void FListView::toggleCheckbox()
 //----------------------------------------------------------------------
 inline void FListView::collapseAndScrollLeft()
 {
+  if ( hasModel() )
+  {
+    collapseModelAndScrollLeft();
+    return;
+  }
+
   const int position_before = current_iter.getPosition();
   auto item = getCurrentItem();
 
@@ -2659,6 +3186,13 @@ inline void FListView::collapseAndScrollLeft()
 //----------------------------------------------------------------------
 inline void FListView::expandAndScrollRight()
 {
+  if ( hasModel() && expandSubtree() )
+  {
+    // Force vertical scrollbar redraw
+    first_line_position_before = -1;
+    return;
+  }
+
   const int xoffset_end = int(max_line_width) - int(getClientWidth());
   auto item = getCurrentItem();
 
@@ -2685,6 +3219,13 @@ inline void FListView::expandAndScrollRight()
 //----------------------------------------------------------------------
 inline void FListView::firstPos()
 {
+  if ( hasModel() )
+  {
+    model_current_line = 0;
+    model_first_line = 0;
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2697,6 +3238,14 @@ inline void FListView::firstPos()
 //----------------------------------------------------------------------
 inline void FListView::lastPos()
 {
+  if ( hasModel() )
+  {
+    model_current_line = int(getCount()) - 1;
+    model_first_line = model_current_line;
+    clampModelLines();
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2710,6 +3259,16 @@ inline void FListView::lastPos()
 //----------------------------------------------------------------------
 inline auto FListView::expandSubtree() -> bool
 {
+  if ( hasModel() )
+  {
+    if ( ! isTreeView()
+      || ! model_tree.expand(std::size_t(model_current_line)) )
+      return false;
+
+    adjustScrollbars (getCount());
+    return true;
+  }
+
   if ( isItemListEmpty() )
     return false;
 
@@ -2728,6 +3287,16 @@ inline auto FListView::expandSubtree() -> bool
 //----------------------------------------------------------------------
 inline auto FListView::collapseSubtree() -> bool
 {
+  if ( hasModel() )
+  {
+    if ( ! isTreeView()
+      || ! model_tree.collapse(std::size_t(model_current_line)) )
+      return false;
+
+    adjustScrollbars (getCount());
+    return true;
+  }
+
   if ( isItemListEmpty() )
     return false;
 
@@ -2746,6 +3315,13 @@ inline auto FListView::collapseSubtree() -> bool
 //----------------------------------------------------------------------
 void FListView::setRelativePosition (int ry)
 {
+  if ( hasModel() )
+  {
+    model_current_line = model_first_line + ry;
+    clampModelLines();
+    return;
+  }
+
   current_iter = first_visible_line;
   current_iter += ry;
 }
@@ -2753,6 +3329,12 @@ void FListView::setRelativePosition (int ry)
 //----------------------------------------------------------------------
 void FListView::stepForward()
 {
+  if ( hasModel() )
+  {
+    stepModelLine(1);
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2775,6 +3357,12 @@ void FListView::stepForward()
 //----------------------------------------------------------------------
 void FListView::stepBackward()
 {
+  if ( hasModel() )
+  {
+    stepModelLine(-1);
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2792,6 +3380,12 @@ void FListView::stepBackward()
 //----------------------------------------------------------------------
 void FListView::stepForward (int distance)
 {
+  if ( hasModel() )
+  {
+    stepModelLine(distance);
+    return;
+  }
+
   if ( isItemListEmpty() )
     return;
 
@@ -2828,6 +3422,12 @@ void FListView::stepForward (int distance)
 //----------------------------------------------------------------------
 void FListView::stepBackward (int distance)
 {
+  if ( hasModel() )
+  {
+    stepModelLine(-distance);
+    return;
+  }
+
   if ( isItemListEmpty() || current_iter.getPosition() == 0 )
     return;
 
@@ -2856,6 +3456,83 @@ void FListView::stepBackward (int distance)
   }
 }
 
+//----------------------------------------------------------------------
+void FListView::stepModelLine (int distance)
+{
+  // Moves the current line and scrolls the view by the
+  // same distance when the line leaves the visible area
+
+  const int line_before = model_current_line;
+  const auto height = std::max(int(getClientHeight()), 1);
+  model_current_line += distance;
+  clampModelLines();
+  const int moved = model_current_line - line_before;
+
+  if ( model_current_line < model_first_line
+    || model_current_line >= model_first_line + height )
+  {
+    model_first_line += moved;
+    model_first_line = std::min(model_first_line, model_current_line);
+    model_first_line = std::max(model_first_line, model_current_line - height + 1);
+  }
+
+  clampModelLines();
+}
+
+//----------------------------------------------------------------------
+void FListView::scrollModelLines (int distance)
+{
+  // Scrolls the view and keeps the current line
+  // at the same position relative to the first line
+
+  const int first_before = model_first_line;
+  model_first_line += distance;
+  clampModelLines();
+  model_current_line += model_first_line - first_before;
+  clampModelLines();
+}
+
+//----------------------------------------------------------------------
+void FListView::clampModelLines()
+{
+  // Keeps the current line and the visible area within the list
+
+  const auto element_count = int(getCount());
+  const auto height = std::max(int(getClientHeight()), 1);
+  model_first_line = std::min(model_first_line, element_count - height);
+  model_first_line = std::max(model_first_line, 0);
+  model_current_line = std::min(model_current_line, element_count - 1);
+  model_current_line = std::max(model_current_line, 0);
+}
+
+//----------------------------------------------------------------------
+void FListView::collapseModelAndScrollLeft()
+{
+  if ( xoffset != 0 || isListEmpty() )
+  {
+    if ( xoffset > 0 )  // Scroll left
+      xoffset--;
+
+    return;
+  }
+
+  const auto line = model_tree.getLine(std::size_t(model_current_line));
+
+  if ( isTreeView() && line.expanded )
+  {
+    // Collapse element
+    model_tree.collapse(std::size_t(model_current_line));
+    adjustSize();
+    vbar->calculateSliderValues();
+    // Force vertical scrollbar redraw
+    first_line_position_before = -1;
+    return;
+  }
+
+  if ( line.parent_line >= 0 )  // Jump to parent element
+    stepModelLine(line.parent_line - model_current_line);
+}
+
 //----------------------------------------------------------------------
 void FListView::scrollToX (int x)
 {
@@ -2875,6 +3552,12 @@ void FListView::scrollToX (int x)
 //----------------------------------------------------------------------
 void FListView::scrollToY (int y)
 {
+  if ( hasModel() )
+  {
+    scrollModelLines(y - model_first_line);
+    return;
+  }
+
   const int pagesize = int(getClientHeight()) - 1;
   const auto element_count = int(getCount());
 
@@ -2926,7 +3609,7 @@ void FListView::cb_vbarChange (const FWidget*)
   const FScrollbar::ScrollType scroll_type = vbar->getScrollType();
   static constexpr int wheel_distance = 4;
   int distance{1};
-  first_line_position_before = first_visible_line.getPosition();
+  first_line_position_before = getFirstVisiblePosition();
 
   switch ( scroll_type )
   {
@@ -2968,9 +3651,9 @@ void FListView::cb_vbarChange (const FWidget*)
   if ( scroll_type >= FScrollbar::ScrollType::StepBackward
     && scroll_type <= FScrollbar::ScrollType::PageForward )
   {
-    vbar->setValue (first_visible_line.getPosition());
+    vbar->setValue (getFirstVisiblePosition());
 
-    if ( first_line_position_before != first_visible_line.getPosition() )
+    if ( first_line_position_before != getFirstVisiblePosition() )
       vbar->drawBar();
 
     forceTerminalUpdate();
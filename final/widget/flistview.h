@@ -38,6 +38,12 @@
  *      ▕▔▔▔▔▔▔▔▔▔▔▔▏1     *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▏
  *      ▕ FListView ▏- - - -▕ FListViewItem ▏- - - -▕ FData ▏
  *      ▕▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▏
+ *            :1
+ *            :
+ *            :0..1
+ *   ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *   ▕ FListViewModel ▏
+ *   ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  */
 
 #ifndef FLISTVIEW_H
@@ -58,6 +64,7 @@
 #include "final/fwidget.h"
 #include "final/util/fdata.h"
 #include "final/vterm/fvtermbuffer.h"
+#include "final/widget/flistviewmodel.h"
 #include "final/widget/fscrollbar.h"
 
 namespace finalcut
@@ -68,6 +75,45 @@ class FListView;
 class FScrollbar;
 class FString;
 
+//----------------------------------------------------------------------
+// class FListViewLines
+//----------------------------------------------------------------------
+
+// Binary indexed tree over the visible lines of sibling items.
+// Counting the lines in front of an item and finding the item
+// that shows a given line take O(log n).
+
+class FListViewLines final
+{
+  public:
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getSize() const noexcept -> std::size_t;
+    auto getLines() const noexcept -> std::size_t;
+    auto getLinesBefore (std::size_t) const noexcept -> std::size_t;
+
+    // Methods
+    auto findIndex (std::size_t&) const noexcept -> std::size_t;
+    void append (std::size_t);
+    void replace (std::size_t, std::size_t, std::size_t) noexcept;
+    void clear() noexcept;
+
+  private:
+    // Data members
+    std::vector<std::size_t>  tree{};  // tree[i - 1] holds node i
+    std::size_t               total{0};
+};
+
+// FListViewLines inline functions
+//----------------------------------------------------------------------
+inline auto FListViewLines::getSize() const noexcept -> std::size_t
+{ return tree.size(); }
+
+//----------------------------------------------------------------------
+inline auto FListViewLines::getLines() const noexcept -> std::size_t
+{ return total; }
+
+
 //----------------------------------------------------------------------
 // class FListViewItem
 //----------------------------------------------------------------------
@@ -125,18 +171,21 @@ class FListViewItem : public FObject
     auto isCheckable() const -> bool;
 
     // Methods
-    template <typename Compare>
-    void sort (Compare);
+    template <typename SortFunction>
+    void sort (const SortFunction&);
     auto appendItem (FListViewItem*) -> iterator;
     void replaceControlCodes();
-    auto getVisibleLines() -> std::size_t;
-    void resetVisibleLineCounter();
+    auto getVisibleLines() const -> std::size_t;
+    void updateVisibleLines();
+    void indexChildren();
 
     // Data members
     FStringList     column_list{};
     FDataAccessPtr  data_pointer{};
     iterator        root{};
+    FListViewLines  child_lines{};
     std::size_t     visible_lines{1};
+    std::size_t     list_index{0};  // Position in the parent list
     bool            expandable{false};
     bool            is_expand{false};
     bool            checkable{false};
@@ -208,6 +257,10 @@ inline auto FListViewItem::isExpandable() const -> bool
 inline auto FListViewItem::isCheckable() const -> bool
 { return checkable; }
 
+//----------------------------------------------------------------------
+inline auto FListViewItem::getVisibleLines() const -> std::size_t
+{ return visible_lines; }
+
 
 //----------------------------------------------------------------------
 // class FListViewIterator
@@ -260,6 +313,7 @@ class FListViewIterator
     // Methods
     void nextElement (Iterator&);
     void prevElement (Iterator&);
+    auto seek (int) -> bool;
 
     // Data members
     IteratorStack  iter_path{};
@@ -340,7 +394,10 @@ class FListView : public FWidget
     auto getColumnSortType (int) const -> SortType;
     auto getSortOrder() const -> SortOrder;
     auto getSortColumn() const -> int;
+    auto getSortThreads() const noexcept -> std::size_t;
     auto getCurrentItem() -> FListViewItem*;
+    auto getModel() const -> FListViewModel*;
+    auto getCurrentNode() const -> FListViewModel::Node;
 
     // Mutators
     void setSize (const FSize&, bool = true) override;
@@ -354,14 +411,17 @@ class FListView : public FWidget
     void setUserAscendingCompare (Compare);
     template <typename Compare>
     void setUserDescendingCompare (Compare);
+    void setSortThreads (std::size_t) noexcept;
     void hideSortIndicator (bool = true);
     void showColumn (int);
     void hideColumn (int);
     auto setTreeView (bool = true) -> bool;
     auto unsetTreeView() -> bool;
+    void setModel (FListViewModel*);
 
     // Inquiries
     auto isColumnHidden (int) const -> bool;
+    auto hasModel() const -> bool;
 
     // Methods
     virtual auto addColumn (const FString&, int = USE_MAX_SIZE) -> int;
@@ -393,6 +453,7 @@ class FListView : public FWidget
     auto insert (const std::vector<ColT>&, DT&&, iterator) -> iterator;
     void remove (FListViewItem*);
     void clear();
+    void reloadModel();
     auto getData() & -> FListViewItems&;
     auto getData() const & -> const FListViewItems&;
 
@@ -418,11 +479,18 @@ class FListView : public FWidget
   private:
     struct Header;  // forward declaration
 
+    struct ModelRow
+    {
+      FListViewModelTree::FLine  line{};
+      FStringList                columns{};
+    };
+
     // Using-declaration
     using KeyMap = std::unordered_map<FKey, std::function<void()>, EnumHash<FKey>>;
     using KeyMapResult = std::unordered_map<FKey, std::function<bool()>, EnumHash<FKey>>;
     using HeaderItems = std::vector<Header>;
     using SortTypes = std::vector<SortType>;
+    using ModelRows = std::vector<ModelRow>;
 
     // Constants
     static constexpr std::size_t checkbox_space = 4;
@@ -436,6 +504,10 @@ class FListView : public FWidget
     // Mutators
     static void setNullIterator (const iterator&);
 
+    // Accessors
+    auto getCurrentPosition() -> int;
+    auto getFirstVisiblePosition() -> int;
+
     // Inquiry
     auto isHorizontallyScrollable() const -> bool;
     auto isVerticallyScrollable() const -> bool;
@@ -444,8 +516,8 @@ class FListView : public FWidget
     void init();
     void mapKeyFunctions();
     void processKeyAction (FKeyEvent*);
-    template <typename Compare>
-    void sort (Compare);
+    template <typename SortFunction>
+    void sort (const SortFunction&);
     auto getAlignOffset ( const Align
                         , const std::size_t
                         , const std::size_t ) const -> std::size_t;
@@ -455,12 +527,18 @@ class FListView : public FWidget
     void drawScrollbars() const;
     void drawHeadlines();
     void drawList();
+    void drawModelList();
+    void drawEmptyLines (int);
     void adjustWidthForTreeView (std::size_t&, std::size_t, bool) const;
     void drawListLine (const FListViewItem*, bool, bool);
+    void drawModelLine (const ModelRow&, bool, bool);
+    void appendColumns (FString&, const FStringList&, std::size_t, bool) const;
+    void printLine (const FString&);
     void clearList();
     void setLineAttributes (bool, bool) const;
     auto getCheckBox (const FListViewItem* item) const -> FString;
     auto getLinePrefix (const FListViewItem*, std::size_t) const -> FString;
+    auto getTreePrefix (std::size_t, bool, bool) const -> FString;
     void drawSortIndicator (std::size_t&, std::size_t);
     void drawHeadlineLabel (const HeaderItems::const_iterator&);
     void drawHeaderBorder (std::size_t);
@@ -471,7 +549,8 @@ class FListView : public FWidget
                             , const FString& );
     void updateLayout();
     void updateDrawing (bool, bool);
-    auto determineLineWidth (FListViewItem*) -> std::size_t;
+    auto determineLineWidth (const FStringList&) -> std::size_t;
+    auto fetchModelRows() -> bool;
     void beforeInsertion (FListViewItem*);
     void afterInsertion();
     void recalculateHorizontalBar (std::size_t);
@@ -487,12 +566,14 @@ class FListView : public FWidget
     void dragDown (MouseButton);
     void stopDragScroll();
     void toggleItemExpandState (FListViewItem*) const;
+    void toggleModelExpandState();
     void toggleItemCheckState (FListViewItem*) const;
     auto isCheckboxClicked (int, int) const -> bool;
     void resetClickedPositions();
     auto isWithinHeaderBounds (const FPoint&) const -> bool;
     auto isWithinListBounds (const FPoint&) const -> bool;
     auto appendItem (FListViewItem*) -> iterator;
+    void indexItems();
     void handleListEvent (const FMouseEvent*);
     void processClick() const;
     void processRowChanged() const;
@@ -510,12 +591,17 @@ class FListView : public FWidget
     void stepBackward();
     void stepForward (int);
     void stepBackward (int);
+    void stepModelLine (int);
+    void scrollModelLines (int);
+    void clampModelLines();
+    void collapseModelAndScrollLeft();
     void scrollToX (int);
     void scrollToY (int);
     void scrollTo (const FPoint&);
     void scrollTo (int, int);
     void scrollBy (int, int);
     auto isItemListEmpty() const -> bool;
+    auto isListEmpty() const -> bool;
     auto isTreeView() const -> bool;
     auto isColumnIndexInvalid (int) const -> bool;
     auto hasCheckableItems() const -> bool;
@@ -528,6 +614,7 @@ class FListView : public FWidget
     iterator              root{};
     FObjectList           selflist{};
     FObjectList           itemlist{};
+    FListViewLines        itemlist_lines{};
     FListViewIterator     current_iter{};
     FListViewIterator     first_visible_line{};
     FListViewIterator     last_visible_line{};
@@ -535,6 +622,9 @@ class FListView : public FWidget
     FVTermBuffer          headerline{};
     FScrollbarPtr         vbar{nullptr};
     FScrollbarPtr         hbar{nullptr};
+    FListViewModel*       model{nullptr};
+    FListViewModelTree    model_tree{};
+    ModelRows             model_rows{};  // Rows of the visible lines
     SortTypes             sort_type{};
     FPoint                clicked_expander_pos{-1, -1};
     FPoint                clicked_header_pos{-1, -1};
@@ -543,8 +633,11 @@ class FListView : public FWidget
     const FListViewItem*  clicked_checkbox_item{nullptr};
     std::size_t           nf_offset{0};
     std::size_t           max_line_width{1};
+    std::size_t           sort_threads{0};  // 0 = sort in the calling thread
     DragScrollMode        drag_scroll{DragScrollMode::None};
     int                   first_line_position_before{-1};
+    int                   model_current_line{0};
+    int                   model_first_line{0};
     int                   scroll_repeat{100};
     int                   scroll_distance{1};
     int                   xoffset{0};
@@ -559,8 +652,9 @@ class FListView : public FWidget
     bool (*user_defined_ascending) (const FObject*, const FObject*){nullptr};
     bool (*user_defined_descending) (const FObject*, const FObject*){nullptr};
 
-    // Friend class
+    // Friend classes
     friend class FListViewItem;
+    friend class FListViewIterator;
 };
 
 
@@ -594,9 +688,17 @@ inline auto FListView::getSortOrder() const -> SortOrder
 inline auto FListView::getSortColumn() const -> int
 { return sort_column; }
 
+//----------------------------------------------------------------------
+inline auto FListView::getSortThreads() const noexcept -> std::size_t
+{ return sort_threads; }
+
 //----------------------------------------------------------------------
 inline auto FListView::getCurrentItem() -> FListViewItem*
-{ return static_cast<FListViewItem*>(*current_iter); }
+{ return hasModel() ? nullptr : static_cast<FListViewItem*>(*current_iter); }
+
+//----------------------------------------------------------------------
+inline auto FListView::getModel() const -> FListViewModel*
+{ return model; }
 
 //----------------------------------------------------------------------
 template <typename Compare>
@@ -608,6 +710,10 @@ template <typename Compare>
 inline void FListView::setUserDescendingCompare (Compare cmp)
 { user_defined_descending = cmp; }
 
+//----------------------------------------------------------------------
+inline void FListView::setSortThreads (std::size_t threads) noexcept
+{ sort_threads = threads; }
+
 //----------------------------------------------------------------------
 inline void FListView::hideSortIndicator (bool hide)
 { hide_sort_indicator = hide; }
@@ -620,6 +726,10 @@ inline auto FListView::setTreeView (bool enable) -> bool
 inline auto FListView::unsetTreeView() -> bool
 { return setTreeView(false); }
 
+//----------------------------------------------------------------------
+inline auto FListView::hasModel() const -> bool
+{ return model != nullptr; }
+
 //----------------------------------------------------------------------
 inline auto FListView::insert (FListViewItem* item) -> FObject::iterator
 { return insert (item, root); }
@@ -753,6 +863,14 @@ inline auto FListView::getData() const & -> const FListViewItems&
   return *static_cast<const FListViewItems*>(static_cast<const void*>(ptr));
 }
 
+//----------------------------------------------------------------------
+inline auto FListView::getCurrentPosition() -> int
+{ return hasModel() ? model_current_line : current_iter.getPosition(); }
+
+//----------------------------------------------------------------------
+inline auto FListView::getFirstVisiblePosition() -> int
+{ return hasModel() ? model_first_line : first_visible_line.getPosition(); }
+
 //----------------------------------------------------------------------
 inline auto FListView::isHorizontallyScrollable() const -> bool
 { return max_line_width > getClientWidth(); }
@@ -777,6 +895,10 @@ inline void FListView::scrollTo (const FPoint& pos)
 inline auto FListView::isItemListEmpty() const -> bool
 { return itemlist.empty(); }
 
+//----------------------------------------------------------------------
+inline auto FListView::isListEmpty() const -> bool
+{ return hasModel() ? model_tree.getCount() == 0 : itemlist.empty(); }
+
 //----------------------------------------------------------------------
 inline auto FListView::isTreeView() const -> bool
 { return tree_view; }
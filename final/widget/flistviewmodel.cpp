@@ -0,0 +1,251 @@
+/***********************************************************************
+* flistviewmodel.cpp - Item model interface for FListView              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <memory>
+
+#include "final/util/fstring.h"
+#include "final/widget/flistviewmodel.h"
+
+namespace finalcut
+{
+
+// static class attribute
+constexpr FListViewModel::Node FListViewModel::ROOT;
+
+//----------------------------------------------------------------------
+// class FListViewModel
+//----------------------------------------------------------------------
+
+// destructor
+//----------------------------------------------------------------------
+FListViewModel::~FListViewModel() noexcept = default;
+
+
+// public methods of FListViewModel
+//----------------------------------------------------------------------
+auto FListViewModel::getClassName() const -> FString
+{
+  return "FListViewModel";
+}
+
+//----------------------------------------------------------------------
+auto FListViewModel::getNode (Node, std::size_t row) const -> Node
+{
+  // The row number identifies the node of a flat model
+  return row;
+}
+
+//----------------------------------------------------------------------
+auto FListViewModel::hasChildren (Node) const -> bool
+{
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FListViewModel::sort (int, SortOrder)
+{
+  // A model can sort its rows when a column header is clicked
+}
+
+
+//----------------------------------------------------------------------
+// class FListViewModelTree
+//----------------------------------------------------------------------
+
+// constructor
+//----------------------------------------------------------------------
+FListViewModelTree::FListViewModelTree (const FListViewModel* list_model)
+{
+  setModel (list_model);
+}
+
+
+// public methods of FListViewModelTree
+//----------------------------------------------------------------------
+auto FListViewModelTree::getClassName() const -> FString
+{
+  return "FListViewModelTree";
+}
+
+//----------------------------------------------------------------------
+auto FListViewModelTree::getLine (std::size_t line) const -> FLine
+{
+  if ( ! model || line >= getCount() )
+    return {};
+
+  RowPath path{};
+  return findLine (line, path);
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTree::setModel (const FListViewModel* list_model)
+{
+  model = list_model;
+  reset();
+}
+
+//----------------------------------------------------------------------
+auto FListViewModelTree::expand (std::size_t line) -> bool
+{
+  if ( ! model || line >= getCount() )
+    return false;
+
+  RowPath path{};
+  const auto item = findLine (line, path);
+
+  if ( ! item.expandable || item.expanded )
+    return false;
+
+  auto parent = &root;
+
+  for (const auto row : path)
+    parent = parent->children[row].get();
+
+  auto child = std::make_unique<ExpandedNode>();
+  child->node = item.node;
+  child->lines = model->getRowCount(item.node);
+  const auto lines = child->lines;
+  parent->children[item.row] = std::move(child);
+  addLines (path, lines);
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FListViewModelTree::collapse (std::size_t line) -> bool
+{
+  if ( ! model || line >= getCount() )
+    return false;
+
+  RowPath path{};
+  const auto item = findLine (line, path);
+
+  if ( ! item.expanded )
+    return false;
+
+  auto parent = &root;
+
+  for (const auto row : path)
+    parent = parent->children[row].get();
+
+  const auto lines = parent->children[item.row]->lines;
+  parent->children.erase(item.row);
+  removeLines (path, lines);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTree::reset()
+{
+  // Collapses all nodes and rereads the number of top-level rows
+
+  root.children.clear();
+  root.lines = ( model ) ? model->getRowCount() : 0;
+}
+
+
+// private methods of FListViewModelTree
+//----------------------------------------------------------------------
+auto FListViewModelTree::findLine (std::size_t line, RowPath& path) const -> FLine
+{
+  // Only the expanded nodes are stored, so each level is searched
+  // in steps of expanded rows instead of single rows
+
+  FLine result{};
+  const ExpandedNode* parent = &root;
+  std::size_t base{0};    // Line number of the first child line
+  std::size_t index{line};  // Line index within the parent node
+
+  while ( true )
+  {
+    const ExpandedNode* expanded{nullptr};
+    std::size_t row{0};  // First row after the last expanded row
+    std::size_t pos{0};  // Line index of this row
+
+    for (const auto& entry : parent->children)
+    {
+      const auto child_pos = pos + entry.first - row;
+
+      if ( index < child_pos )
+        break;
+
+      row = entry.first;
+      pos = child_pos;
+
+      if ( index <= pos + entry.second->lines )
+      {
+        expanded = entry.second.get();
+        break;
+      }
+
+      // Skip the expanded row and its visible descendants
+      row++;
+      pos += 1 + entry.second->lines;
+    }
+
+    if ( ! expanded || index == pos )
+    {
+      // The line shows a row of this parent node
+      row += index - pos;
+      result.node = model->getNode(parent->node, row);
+      result.row = row;
+      result.expanded = ( expanded != nullptr );
+      result.expandable = result.expanded || model->hasChildren(result.node);
+      return result;
+    }
+
+    // The line is inside the subtree of an expanded row
+    path.push_back(row);
+    result.parent_line = int(base + pos);
+    result.depth++;
+    base += pos + 1;
+    index -= pos + 1;
+    parent = expanded;
+  }
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTree::addLines (const RowPath& path, std::size_t lines)
+{
+  auto node = &root;
+  node->lines += lines;
+
+  for (const auto row : path)
+  {
+    node = node->children[row].get();
+    node->lines += lines;
+  }
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTree::removeLines (const RowPath& path, std::size_t lines)
+{
+  auto node = &root;
+  node->lines -= lines;
+
+  for (const auto row : path)
+  {
+    node = node->children[row].get();
+    node->lines -= lines;
+  }
+}
+
+}  // namespace finalcut
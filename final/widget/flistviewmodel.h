@@ -0,0 +1,165 @@
+/***********************************************************************
+* flistviewmodel.h - Item model interface for FListView                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FListViewModel ▏- - - -▕ FListViewModelTree ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// An FListViewModel supplies the rows of an FListView on demand.
+// The list view only requests the rows of the visible lines, so its
+// memory use does not depend on the size of the data set.
+//
+// The model identifies each row by a node value of its own choice.
+// A flat model only has to implement getRowCount() and getText().
+// A hierarchical model also overrides getNode() and hasChildren().
+
+#ifndef FLISTVIEWMODEL_H
+#define FLISTVIEWMODEL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FString;
+
+//----------------------------------------------------------------------
+// class FListViewModel
+//----------------------------------------------------------------------
+
+class FListViewModel
+{
+  public:
+    // Using-declaration
+    using Node = std::size_t;
+
+    // Constants
+    static constexpr Node ROOT = static_cast<Node>(-1);
+
+    // Constructor
+    FListViewModel() = default;
+
+    // Destructor
+    virtual ~FListViewModel() noexcept;
+
+    // Accessors
+    virtual auto getClassName() const -> FString;
+    virtual auto getRowCount (Node = ROOT) const -> std::size_t = 0;
+    virtual auto getNode (Node, std::size_t) const -> Node;
+    virtual auto getText (Node, int) const -> FString = 0;
+
+    // Inquiry
+    virtual auto hasChildren (Node) const -> bool;
+
+    // Method
+    virtual void sort (int, SortOrder);
+};
+
+
+//----------------------------------------------------------------------
+// class FListViewModelTree
+//----------------------------------------------------------------------
+
+class FListViewModelTree final
+{
+  public:
+    // Using-declaration
+    using Node = FListViewModel::Node;
+
+    struct FLine
+    {
+      Node         node{FListViewModel::ROOT};
+      std::size_t  row{0};          // Row within the parent node
+      uInt         depth{0};
+      int          parent_line{-1};  // -1 = top level
+      bool         expandable{false};
+      bool         expanded{false};
+    };
+
+    // Constructor
+    explicit FListViewModelTree (const FListViewModel* = nullptr);
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getModel() const -> const FListViewModel*;
+    auto getCount() const -> std::size_t;
+    auto getLine (std::size_t) const -> FLine;
+
+    // Mutator
+    void setModel (const FListViewModel*);
+
+    // Methods
+    auto expand (std::size_t) -> bool;
+    auto collapse (std::size_t) -> bool;
+    void reset();
+
+  private:
+    struct ExpandedNode;  // forward declaration
+
+    // Using-declarations
+    using ExpandedNodePtr = std::unique_ptr<ExpandedNode>;
+    using ExpandedNodes = std::map<std::size_t, ExpandedNodePtr>;
+    using RowPath = std::vector<std::size_t>;
+
+    struct ExpandedNode
+    {
+      Node           node{FListViewModel::ROOT};
+      std::size_t    lines{0};  // Visible lines of all descendants
+      ExpandedNodes  children{};  // Expanded child nodes by row
+    };
+
+    // Methods
+    auto findLine (std::size_t, RowPath&) const -> FLine;
+    void addLines (const RowPath&, std::size_t);
+    void removeLines (const RowPath&, std::size_t);
+
+    // Data members
+    const FListViewModel*  model{nullptr};
+    ExpandedNode           root{};
+};
+
+// FListViewModelTree inline functions
+//----------------------------------------------------------------------
+inline auto FListViewModelTree::getModel() const -> const FListViewModel*
+{ return model; }
+
+//----------------------------------------------------------------------
+inline auto FListViewModelTree::getCount() const -> std::size_t
+{ return root.lines; }
+
+}  // namespace finalcut
+
+#endif  // FLISTVIEWMODEL_H
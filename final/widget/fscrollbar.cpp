@@ -398,7 +398,8 @@ void FScrollbar::onWheel (FWheelEvent* ev)
   else if ( wheel == MouseWheel::Right )
     scroll_type = ScrollType::WheelRight;
 
-  processScroll();
+  for (int step{0}; step < ev->getDelta(); step++)
+    processScroll();
 }
 
 //----------------------------------------------------------------------
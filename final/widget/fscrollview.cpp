@@ -530,7 +530,8 @@ void FScrollView::onMouseMove (FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FScrollView::onWheel (FWheelEvent* ev)
 {
-  static constexpr int distance = 4;
+  static constexpr int step = 4;
+  const int distance = step * ev->getDelta();
 
   if ( ev->getWheel() == MouseWheel::Up )
   {
@@ -239,12 +239,12 @@ void FSpinBox::onWheel (FWheelEvent* ev)
 
   if ( wheel == MouseWheel::Up )
   {
-    increaseValue();
+    increaseValue(ev->getDelta());
     updateInputField();
   }
   else if ( wheel == MouseWheel::Down )
   {
-    decreaseValue();
+    decreaseValue(ev->getDelta());
     updateInputField();
   }
 }
@@ -380,6 +380,25 @@ void FTextView::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FTextView::onPaste (FPasteEvent* ev)
+{
+  // Appends the pasted text in one step and shows its end
+
+  ev->accept();
+  append (ev->getText());
+  const int last_yoffset = yoffset;
+  scrollToEnd();
+
+  if ( ! isShown() || yoffset != last_yoffset )
+    return;  // Already drawn by scrollToEnd()
+
+  if ( vbar->isShown() )
+    vbar->drawBar();
+
+  drawText();
+}
+
 //----------------------------------------------------------------------
 void FTextView::onMouseDown (FMouseEvent* ev)
 {
@@ -411,7 +430,8 @@ void FTextView::onMouseMove (FMouseEvent* ev)
 //----------------------------------------------------------------------
 void FTextView::onWheel (FWheelEvent* ev)
 {
-  static constexpr int distance = 4;
+  static constexpr int step = 4;
+  const int distance = step * ev->getDelta();
   const auto& wheel = ev->getWheel();
 
   if ( wheel == MouseWheel::Up )
@@ -305,7 +305,10 @@ void FWindow::drawBorder()
 void FWindow::show()
 {
   if ( isVirtualWindow() )
+  {
     getVWin()->visible = true;
+    invalidateAreaOwnerMap();
+  }
 
   FWidget::show();
 }
@@ -323,7 +326,10 @@ void FWindow::hide()
   }
 
   if ( isVirtualWindow() )
+  {
     virtual_win->visible = false;
+    invalidateAreaOwnerMap();
+  }
 
   FWidget::hide();
   const auto& t_geometry = getTermGeometryWithShadow();
@@ -336,7 +342,10 @@ void FWindow::setX (int x, bool adjust)
   FWidget::setX (x, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->offset_left = getTermX() - 1;
+    invalidateAreaOwnerMap();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -348,7 +357,10 @@ void FWindow::setY (int y, bool adjust)
   FWidget::setY (y, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->offset_top = getTermY() - 1;
+    invalidateAreaOwnerMap();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -366,6 +378,7 @@ void FWindow::setPos (const FPoint& p, bool adjust)
     auto virtual_win = getVWin();
     virtual_win->offset_left = getTermX() - 1;
     virtual_win->offset_top = getTermY() - 1;
+    invalidateAreaOwnerMap();
   }
 }
 
@@ -442,6 +455,8 @@ void FWindow::setGeometry ( const FPoint& p, const FSize& size, bool adjust)
 
     if ( getY() != old_y )
       getVWin()->offset_top = getTermY() - 1;
+
+    invalidateAreaOwnerMap();
   }
 }
 
@@ -455,6 +470,7 @@ void FWindow::move (const FPoint& pos)
     auto virtual_win = getVWin();
     virtual_win->offset_left = getTermX() - 1;
     virtual_win->offset_top = getTermY() - 1;
+    invalidateAreaOwnerMap();
   }
 }
 
@@ -656,6 +672,7 @@ auto FWindow::minimizeWindow() -> bool
 
   const auto& virtual_win = getVWin();
   virtual_win->minimized = bool( ! isMinimized() );
+  invalidateAreaOwnerMap();
   const auto& t_geometry = getTermGeometryWithShadow();
   restoreVTerm (t_geometry);
 
@@ -760,6 +777,8 @@ void FWindow::adjustSize()
 
     if ( getTermY() != old_y )
       getVWin()->offset_top = getTermY() - 1;
+
+    invalidateAreaOwnerMap();
   }
 }
 
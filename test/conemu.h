@@ -905,6 +905,8 @@ inline void ConEmu::closeSlavePTY()
 //----------------------------------------------------------------------
 inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
 {
+  // Queries can follow each other directly, so the position
+  // is set to the last character of each recognized sequence
   for (std::size_t i = 0; i < length; i++)
   {
     if ( buffer[i] == ENQ[0] )  // Enquiry character
@@ -923,7 +925,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DECID )
         write (fd_master, DECID, std::strlen(DECID));
 
-      i += 2;
+      i += 1;
     }
     else if ( i < length - 3  // Device status report (DSR)
            && buffer[i] == '\033'
@@ -936,7 +938,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DSR )
         write (fd_master, DSR, std::strlen(DSR));
 
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 3  // Report cursor position (CPR)
            && buffer[i] == '\033'
@@ -945,7 +947,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
            && buffer[i + 3] == 'n' )
     {
       write (fd_master, "\033[25;80R", 8);  // row 25 ; column 80
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 2  // Device attributes (DA)
            && buffer[i] == '\033'
@@ -957,7 +959,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( DA )
         write (fd_master, DA, std::strlen(DA));
 
-      i += 3;
+      i += 2;
     }
     else if ( i < length - 3  // Device attributes (DA1)
            && buffer[i] == '\033'
@@ -969,7 +971,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
 
       if ( DA1 )
         write (fd_master, DA1, std::strlen(DA1));
-      i += 4;
+      i += 3;
     }
     else if ( i < length - 3  // Secondary device attributes (SEC_DA)
            && buffer[i] == '\033'
@@ -982,7 +984,17 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
       if ( SEC_DA )
         write (fd_master, SEC_DA, std::strlen(SEC_DA));
 
-      i += 4;
+      i += 3;
+    }
+    else if ( i < length - 8  // Request synchronized update mode (DECRQM)
+           && std::strncmp(&buffer[i], "\033[?2026$p", 9) == 0 )
+    {
+      if ( con == console::kitty || con == console::mintty )
+        write (fd_master, "\033[?2026;2$y", 11);  // Mode is reset
+      else if ( con == console::xterm )
+        write (fd_master, "\033[?2026;0$y", 11);  // Mode not recognized
+
+      i += 8;
     }
     else if ( i < length - 4  // Report xterm window's title
            && buffer[i] == '\033'
@@ -1015,7 +1027,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
              && con != console::kitty )
         write (fd_master, "\033]lTITLE\033\\", 10);
 
-      i += 5;
+      i += 4;
     }
     else if ( i < length - 7  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1051,7 +1063,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         write (fd_master, "\a", 1);
       }
 
-      i += 8;
+      i += 7;
     }
     else if ( i < length - 8  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1090,7 +1102,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         write (fd_master, "\a", 1);
       }
 
-      i += 9;
+      i += 8;
     }
     else if ( i < length - 9  // Get xterm color name 0-9
            && buffer[i] == '\033'
@@ -1136,7 +1148,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
         }
       }
 
-      i += 10;
+      i += 9;
     }
     else
     {
@@ -72,6 +72,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
     void fhideeventTest();
     void fcloseeventTest();
     void ftimereventTest();
+    void fpasteeventTest();
     void fusereventTest();
 
   private:
@@ -90,6 +91,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (fhideeventTest);
     CPPUNIT_TEST (fcloseeventTest);
     CPPUNIT_TEST (ftimereventTest);
+    CPPUNIT_TEST (fpasteeventTest);
     CPPUNIT_TEST (fusereventTest);
 
     // End of test suite definition
@@ -446,6 +448,25 @@ void FEventTest::ftimereventTest()
   CPPUNIT_ASSERT ( event2.getTimerId() == 99 );
 }
 
+//----------------------------------------------------------------------
+void FEventTest::fpasteeventTest()
+{
+  finalcut::FPasteEvent event (finalcut::Event::Paste, "");
+  CPPUNIT_ASSERT ( event.getType() == finalcut::Event::Paste );
+  CPPUNIT_ASSERT ( event.getText().isEmpty() );
+  CPPUNIT_ASSERT ( ! event.isAccepted() );
+
+  const finalcut::FString text{std::wstring(100000, L'x') + L"\nline 2"};
+  finalcut::FPasteEvent event1 (finalcut::Event::Paste, text);
+  CPPUNIT_ASSERT ( event1.getText() == text );
+  CPPUNIT_ASSERT ( event1.getText().getLength() == 100007 );
+  CPPUNIT_ASSERT ( ! event1.isAccepted() );
+  event1.accept();
+  CPPUNIT_ASSERT ( event1.isAccepted() );
+  event1.ignore();
+  CPPUNIT_ASSERT ( ! event1.isAccepted() );
+}
+
 //----------------------------------------------------------------------
 void FEventTest::fusereventTest()
 {
@@ -0,0 +1,438 @@
+/***********************************************************************
+* fflushscheduler-test.cpp - FFlushScheduler unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <thread>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FFlushSchedulerTest
+//----------------------------------------------------------------------
+
+class FFlushSchedulerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FFlushSchedulerTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void fastTerminalTest();
+    void blockedWriteTest();
+    void slowWriteTest();
+    void outputQueueTest();
+    void resetTest();
+    void termOutputTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FFlushSchedulerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (fastTerminalTest);
+    CPPUNIT_TEST (blockedWriteTest);
+    CPPUNIT_TEST (slowWriteTest);
+    CPPUNIT_TEST (outputQueueTest);
+    CPPUNIT_TEST (resetTest);
+    CPPUNIT_TEST (termOutputTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Method
+    static auto after (int) -> TimeValue;
+};
+
+
+//----------------------------------------------------------------------
+// class FSystemTest
+//----------------------------------------------------------------------
+
+class FSystemTest : public finalcut::FSystem
+{
+  public:
+    // Constructor
+    FSystemTest() = default;
+
+    // Methods
+    auto inPortByte (uShort) -> uChar override
+    {
+      return 0;
+    }
+
+    void outPortByte (uChar, uShort) override
+    { }
+
+    auto isTTY (int) const -> int override
+    {
+      return 1;
+    }
+
+    auto ioctl (int, uLong request, ...) -> int override
+    {
+      va_list args{};
+      void* argp{};
+      int ret_val{-1};
+
+      va_start (args, request);
+      argp = va_arg (args, void*);
+
+      switch ( request )
+      {
+        case TIOCGWINSZ:
+        {
+          auto win_size = static_cast<winsize*>(argp);
+          win_size->ws_col = 80;
+          win_size->ws_row = 24;
+          ret_val = 0;
+          break;
+        }
+
+#if defined(TIOCOUTQ)
+        case TIOCOUTQ:
+          // A pseudo terminal reports an empty output queue
+          *static_cast<int*>(argp) = 0;
+          ret_val = 0;
+          break;
+#endif
+
+        default:
+          break;
+      }
+
+      va_end (args);
+      return ret_val;
+    }
+
+    auto open (const char*, int, ...) -> int override
+    {
+      return 0;
+    }
+
+    auto close (int) -> int override
+    {
+      return 0;
+    }
+
+    auto fopen (const char*, const char*) -> FILE* override
+    {
+      return nullptr;
+    }
+
+    auto fputs (const char*, FILE*) -> int override
+    {
+      return 0;
+    }
+
+    auto fclose (FILE*) -> int override
+    {
+      return 0;
+    }
+
+    auto putchar (int c) -> int override
+    {
+      return c;
+    }
+
+    auto write (int, const void*, std::size_t count) -> ssize_t override
+    {
+      // A blocking write that returns when the terminal took all bytes
+      std::this_thread::sleep_for(std::chrono::milliseconds(write_delay));
+      written_bytes += count;
+      return ssize_t(count);
+    }
+
+    auto getuid() -> uid_t override
+    {
+      return 0;
+    }
+
+    auto geteuid() -> uid_t override
+    {
+      return 0;
+    }
+
+    auto getpwuid_r ( uid_t, struct passwd*, char*
+                   , size_t, struct passwd** ) -> int override
+    {
+      return 0;
+    }
+
+    auto realpath (const char*, char*) -> char* override
+    {
+      return const_cast<char*>("");
+    }
+
+    // Data members
+    static int write_delay;  // Milliseconds
+    static std::size_t written_bytes;
+};
+
+// static class attributes
+int         FSystemTest::write_delay{0};
+std::size_t FSystemTest::written_bytes{0};
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::classNameTest()
+{
+  const finalcut::FFlushScheduler scheduler{};
+  const finalcut::FString& classname = scheduler.getClassName();
+  CPPUNIT_ASSERT ( classname == "FFlushScheduler" );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::noArgumentTest()
+{
+  const finalcut::FFlushScheduler scheduler{};
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 0 );
+  CPPUNIT_ASSERT ( scheduler.getBacklogLimit() == finalcut::FFlushScheduler::MIN_BACKLOG );
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.canFlush(-1) );
+  CPPUNIT_ASSERT ( scheduler.canFlush(0) );
+  CPPUNIT_ASSERT ( scheduler.canFlush(4096) );
+  CPPUNIT_ASSERT ( ! scheduler.canFlush(4097) );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 16'667 );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::fastTerminalTest()
+{
+  // A terminal that takes every frame at once is never throttled
+
+  finalcut::FFlushScheduler scheduler{};
+  scheduler.setFrameBudget(16'667);
+
+  for (int i{0}; i < 10; i++)
+  {
+    scheduler.startWrite (after(i * 20), 0);
+    scheduler.finishWrite (after(i * 20 + 1), 50'000, false, 0);
+  }
+
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 16'667 );
+
+  // Without an output queue length
+  scheduler.startWrite (after(300), -1);
+  scheduler.finishWrite (after(301), 50'000, false, -1);
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::blockedWriteTest()
+{
+  // A blocked write of 10000 bytes in 100 ms gives 100000 bytes/s
+
+  finalcut::FFlushScheduler scheduler{};
+  scheduler.setFrameBudget(16'667);
+  scheduler.startWrite (after(0), -1);
+  scheduler.finishWrite (after(100), 10'000, true, -1);
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(300'000) == 300'000 );
+  CPPUNIT_ASSERT ( scheduler.getBacklogLimit() == finalcut::FFlushScheduler::MIN_BACKLOG );
+
+  // The moving average follows a slower link
+  scheduler.startWrite (after(200), -1);
+  scheduler.finishWrite (after(400), 10'000, true, -1);
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 87'500 );
+
+  // The drain time is limited
+  scheduler.startWrite (after(500), -1);
+  scheduler.finishWrite (after(501), 1'000'000, false, -1);
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == finalcut::FFlushScheduler::MAX_DRAIN_WAIT );
+
+  // A write that does not block ends the backpressure
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 16'667 );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::slowWriteTest()
+{
+  // A blocking write does not return early, but its duration shows
+  // that the terminal took 20000 bytes in 200 ms (100000 bytes/s)
+
+  finalcut::FFlushScheduler scheduler{};
+  scheduler.setFrameBudget(16'667);
+  scheduler.startWrite (after(0), 0);
+  scheduler.finishWrite (after(200), 20'000, false, 0);
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 200'000 );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 200'000 );
+
+  // Writes below MIN_BLOCKED_WRITE_TIME are not sampled
+  scheduler.startWrite (after(400), 0);
+  scheduler.finishWrite (after(401), 20'000, false, 0);
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(16'667) == 16'667 );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::outputQueueTest()
+{
+  finalcut::FFlushScheduler scheduler{};
+  scheduler.setFrameBudget(100'000);
+  scheduler.startWrite (after(0), 0);
+  scheduler.finishWrite (after(1), 30'000, false, 30'000);
+
+  // The queue exceeds the backlog limit
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( ! scheduler.canFlush(30'000) );
+  CPPUNIT_ASSERT ( scheduler.canFlush(2'000) );
+
+  // 20000 bytes were drained in 200 ms
+  scheduler.startWrite (after(201), 10'000);
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 100'000 );
+  CPPUNIT_ASSERT ( scheduler.getBacklogLimit() == 10'000 );
+  CPPUNIT_ASSERT ( scheduler.canFlush(10'000) );
+  CPPUNIT_ASSERT ( ! scheduler.canFlush(10'001) );
+
+  scheduler.finishWrite (after(202), 5'000, false, 15'000);
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 200'000 );
+  CPPUNIT_ASSERT ( scheduler.adjustFlushWait(100'000) == 200'000 );
+
+  // The terminal has drained the queue
+  scheduler.startWrite (after(500), 0);
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 100'000 );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::resetTest()
+{
+  finalcut::FFlushScheduler scheduler{};
+  scheduler.startWrite (after(0), -1);
+  scheduler.finishWrite (after(10), 10'000, true, 8'000);
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 1'000'000 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 18'000 );
+
+  scheduler.reset();
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FFlushSchedulerTest::termOutputTest()
+{
+  // FTermOutput writes its frames through a slow FSystem::write()
+
+  std::unique_ptr<finalcut::FSystem> fsys = std::make_unique<FSystemTest>();
+  finalcut::FTerm::setFSystem(fsys);
+
+  class TestDialog : public finalcut::FDialog
+  {
+    public:
+      explicit TestDialog (finalcut::FWidget* parent = nullptr)
+        : finalcut::FDialog{parent}
+      { }
+
+      void p_forceTerminalUpdate() const
+      {
+        forceTerminalUpdate();
+      }
+  };
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  TestDialog dialog(&fapp);
+  dialog.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{80, 24});
+  dialog.show();
+
+  const auto& output = std::static_pointer_cast<finalcut::FTermOutput>
+                       (finalcut::FVTerm::getFOutput());
+  CPPUNIT_ASSERT ( output->getClassName() == "FTermOutput" );
+  const auto& scheduler = output->getFlushScheduler();
+  const auto getLine = [] (wchar_t first)
+  {
+    // Different characters, so that the line is not repeated
+    finalcut::FString line{};
+
+    for (wchar_t ch{0}; ch < 78; ch++)
+      line += wchar_t(first + ch % 26);
+
+    return line;
+  };
+
+  // The terminal takes the frame at once
+  FSystemTest::write_delay = 0;
+  FSystemTest::written_bytes = 0;
+  dialog.print() << finalcut::FPoint{2, 2} << getLine(L'a');
+  dialog.p_forceTerminalUpdate();
+  CPPUNIT_ASSERT ( FSystemTest::written_bytes >= 78 );
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() == 0 );
+
+  // The write blocks until the terminal has taken the frame
+  FSystemTest::write_delay = 20;
+  FSystemTest::written_bytes = 0;
+  dialog.print() << finalcut::FPoint{2, 2} << getLine(L'b');
+  dialog.p_forceTerminalUpdate();
+  CPPUNIT_ASSERT ( FSystemTest::written_bytes >= 78 );
+  CPPUNIT_ASSERT ( scheduler.isBackpressured() );
+  CPPUNIT_ASSERT ( scheduler.getThroughput() > 0 );
+  CPPUNIT_ASSERT ( scheduler.getDrainTime() >= 10'000 );
+
+  // The terminal is fast again
+  FSystemTest::write_delay = 0;
+  dialog.print() << finalcut::FPoint{2, 2} << getLine(L'c');
+  dialog.p_forceTerminalUpdate();
+  CPPUNIT_ASSERT ( ! scheduler.isBackpressured() );
+}
+
+//----------------------------------------------------------------------
+auto FFlushSchedulerTest::after (int milliseconds) -> TimeValue
+{
+  static const auto start = TimeValue{} + std::chrono::hours(1);
+  return start + std::chrono::milliseconds(milliseconds);
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FFlushSchedulerTest);
+
+// The general unit test main part
+#include <main-test.inc>
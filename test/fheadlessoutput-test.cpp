@@ -0,0 +1,471 @@
+/***********************************************************************
+* fheadlessoutput-test.cpp - FHeadlessOutput unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FVTerm_headless
+//----------------------------------------------------------------------
+
+class FVTerm_headless : public finalcut::FVTerm
+{
+  public:
+    // Constructor
+    FVTerm_headless()
+      : finalcut::FVTerm{finalcut::outputClass<finalcut::FHeadlessOutput>{}}
+    {
+      initTerminal();
+      finishDrawing();
+    }
+
+    // Using-declarations
+    using finalcut::FVTerm::print;
+    using finalcut::FVTerm::processTerminalUpdate;
+    using finalcut::FVTerm::getVirtualDesktop;
+    using finalcut::FVTerm::scrollAreaForward;
+
+    // Accessor
+    static auto getOutput() -> finalcut::FHeadlessOutput*
+    {
+      return static_cast<finalcut::FHeadlessOutput*>(getFOutput().get());
+    }
+};
+
+
+//----------------------------------------------------------------------
+// class FHeadlessOutputTest
+//----------------------------------------------------------------------
+
+class FHeadlessOutputTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FHeadlessOutputTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void scrollTest();
+    void cursorTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FHeadlessOutputTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (scrollTest);
+    CPPUNIT_TEST (cursorTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    void frameTest();
+    void byteSinkTest();
+    void desktopScrollTest();
+    void movedLinesTest();
+    void repaintTest();
+
+    // Data member
+    FVTerm_headless fvterm{};
+};
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::classNameTest()
+{
+  const finalcut::FHeadlessOutput output{};
+  const finalcut::FString& classname = output.getClassName();
+  CPPUNIT_ASSERT ( classname == "FHeadlessOutput" );
+  CPPUNIT_ASSERT ( fvterm.getOutput()->getClassName() == "FHeadlessOutput" );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::noArgumentTest()
+{
+  const auto output = fvterm.getOutput();
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 80 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 24 );
+  CPPUNIT_ASSERT ( output->getTabstop() == 8 );
+  CPPUNIT_ASSERT ( output->getMaxColor() == 256 );
+  CPPUNIT_ASSERT ( output->getEncoding() == finalcut::Encoding::UTF8 );
+  CPPUNIT_ASSERT ( output->isCursorHideable() );
+  CPPUNIT_ASSERT ( output->isCursorHidden() );
+  CPPUNIT_ASSERT ( ! output->isMonochron() );
+  CPPUNIT_ASSERT ( ! output->isNewFont() );
+  CPPUNIT_ASSERT ( output->isFlushTimeout() );
+  CPPUNIT_ASSERT ( ! output->hasTerminalResized() );
+  CPPUNIT_ASSERT ( output->allowsTerminalSizeManipulation() );
+  CPPUNIT_ASSERT ( output->getLine(-1).isEmpty() );
+  CPPUNIT_ASSERT ( output->getLine(24).isEmpty() );
+  CPPUNIT_ASSERT ( output->getLine(0) == finalcut::FString(80, L' ') );
+  CPPUNIT_ASSERT ( output->getFChar({0, 0}).fg_color == finalcut::FColor::Default );
+  CPPUNIT_ASSERT ( output->getFChar({0, 0}).bg_color == finalcut::FColor::Default );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::applicationTest()
+{
+  // The application object shares the headless output
+  // of the first FVTerm object
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::isQuit() );
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getFOutput()->getClassName() == "FHeadlessOutput" );
+  frameTest();
+  byteSinkTest();
+  desktopScrollTest();
+  movedLinesTest();
+  repaintTest();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::frameTest()
+{
+  const auto output = fvterm.getOutput();
+  output->resetStatistics();
+  CPPUNIT_ASSERT ( output->getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( output->getByteCount() == 0 );
+
+  fvterm.setColor (finalcut::FColor::Yellow, finalcut::FColor::Blue);
+  fvterm.print() << finalcut::FPoint{3, 2} << "Hello";
+  CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+  CPPUNIT_ASSERT ( output->getFrameCount() == 1 );
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() > 5 );
+  CPPUNIT_ASSERT ( output->getByteCount() == output->getLastFrameBytes() );
+  CPPUNIT_ASSERT ( output->getLine(1).left(9) == "  Hello  " );
+  CPPUNIT_ASSERT ( output->getFChar({2, 1}).ch[0] == L'H' );
+  CPPUNIT_ASSERT ( output->getFChar({2, 1}).fg_color == finalcut::FColor::Yellow );
+  CPPUNIT_ASSERT ( output->getFChar({2, 1}).bg_color == finalcut::FColor::Blue );
+  CPPUNIT_ASSERT ( output->getFChar({1, 1}).bg_color == finalcut::FColor::Default );
+
+  // Without changes no frame is produced
+  CPPUNIT_ASSERT ( ! fvterm.processTerminalUpdate() );
+  CPPUNIT_ASSERT ( output->getFrameCount() == 1 );
+
+  // A single changed cell produces a small frame
+  const auto bytes = output->getByteCount();
+  fvterm.print() << finalcut::FPoint{4, 2} << "a";
+  CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+  CPPUNIT_ASSERT ( output->getFrameCount() == 2 );
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() > 0 );
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() < 16 );
+  CPPUNIT_ASSERT ( output->getByteCount() == bytes + output->getLastFrameBytes() );
+  CPPUNIT_ASSERT ( output->getLine(1).left(9) == "  Hallo  " );
+
+  // Overwriting with the same content produces no bytes
+  fvterm.print() << finalcut::FPoint{3, 2} << "Hallo";
+  fvterm.processTerminalUpdate();
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() == 0 );
+  fvterm.setNormal();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::byteSinkTest()
+{
+  const auto output = fvterm.getOutput();
+  std::string stream{};
+  output->setByteSink ( [&stream] (const char* data, std::size_t length)
+                        {
+                          stream.append (data, length);
+                        }
+                      );
+  output->flush();  // Writes out the remaining bytes
+  stream.clear();
+  CPPUNIT_ASSERT ( ! output->hasPendingOutput() );
+
+  fvterm.setColor (finalcut::FColor::Red, finalcut::FColor::Default);
+  fvterm.setBold();
+  fvterm.print() << finalcut::FPoint{1, 24} << "x";
+  fvterm.setNormal();
+  CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+  CPPUNIT_ASSERT ( output->hasPendingOutput() );
+  CPPUNIT_ASSERT ( stream.empty() );
+
+  fvterm.flush();
+  CPPUNIT_ASSERT ( ! output->hasPendingOutput() );
+  CPPUNIT_ASSERT ( stream.length() == output->getLastFrameBytes() );
+  CPPUNIT_ASSERT ( stream == "\033[24;1H\033[0;1;38;5;1mx" );  // Red
+
+  // The bell is counted, but not written
+  output->beep();
+  CPPUNIT_ASSERT ( output->getBellCount() == 1 );
+  output->setByteSink ({});
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::desktopScrollTest()
+{
+  // The desktop scroll moves the saved terminal lines, so that
+  // the next frame does not output the scrolled lines again
+
+  const auto output = fvterm.getOutput();
+
+  for (auto y{0}; y < 24; y++)
+    fvterm.print() << finalcut::FPoint{1, y + 1}
+                   << finalcut::FString(80, wchar_t(L'A' + y));
+
+  CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+  output->flush();
+  CPPUNIT_ASSERT ( output->getLine(0) == finalcut::FString(80, L'A') );
+  CPPUNIT_ASSERT ( output->getLine(23) == finalcut::FString(80, L'X') );
+
+  // Only the terminal scroll changes the grid
+  fvterm.scrollAreaForward (fvterm.getVirtualDesktop());
+  fvterm.processTerminalUpdate();
+  output->flush();
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() == 0 );
+
+  for (auto y{0}; y < 23; y++)
+    CPPUNIT_ASSERT ( output->getLine(y) == finalcut::FString(80, wchar_t(L'B' + y)) );
+
+  CPPUNIT_ASSERT ( output->getLine(23) == finalcut::FString(80, L' ') );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::movedLinesTest()
+{
+  // Line blocks that moved vertically since the last frame
+  // are scrolled on the terminal before the frame is output
+
+  const auto output = fvterm.getOutput();
+  std::string stream{};
+  output->setByteSink ( [&stream] (const char* data, std::size_t length)
+                        {
+                          stream.append (data, length);
+                        }
+                      );
+
+  const auto print_line = [this] (int y, wchar_t ch)
+  {
+    fvterm.print() << finalcut::FPoint{1, y + 1} << finalcut::FString(80, ch);
+  };
+
+  const auto update = [this, &output, &stream] ()
+  {
+    output->flush();
+    stream.clear();
+    fvterm.processTerminalUpdate();
+    output->flush();
+  };
+
+  const auto count = [&stream] (const std::string& sequence)
+  {
+    std::size_t n{0};
+    auto pos = stream.find(sequence);
+
+    while ( pos != std::string::npos )
+    {
+      n++;
+      pos = stream.find(sequence, pos + sequence.length());
+    }
+
+    return n;
+  };
+
+  const auto is_line = [&output] (int y, wchar_t ch)
+  {
+    return output->getLine(y) == finalcut::FString(80, ch);
+  };
+
+  for (auto y{0}; y < 24; y++)
+    print_line (y, wchar_t(L'A' + y));
+
+  update();
+
+  // Unchanged lines
+  update();
+  CPPUNIT_ASSERT ( stream.empty() );
+
+  // Rewritten lines with the same content
+  for (auto y{0}; y < 24; y++)
+    print_line (y, wchar_t(L'A' + y));
+
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 0 );
+
+  // Lines 6 to 15 move up one line
+  for (auto y{5}; y < 15; y++)
+    print_line (y, wchar_t(L'A' + y + 1));
+
+  print_line (15, L'#');
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 1 );
+  CPPUNIT_ASSERT ( count("\033[6;16r\033[16;1H\n\033[r") == 1 );
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() < 160 );
+
+  for (auto y{5}; y < 15; y++)
+    CPPUNIT_ASSERT ( is_line(y, wchar_t(L'A' + y + 1)) );
+
+  CPPUNIT_ASSERT ( is_line(15, L'#') );
+  CPPUNIT_ASSERT ( is_line(16, L'Q') );
+
+  // Lines 16 to 21 move down two lines
+  for (auto y{18}; y < 24; y++)
+    print_line (y, wchar_t(L'A' + y - 2));
+
+  print_line (16, L'$');
+  print_line (17, L'%');
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 2 );
+  CPPUNIT_ASSERT ( count("\033[17;24r\033[17;1H\033M\033[r") == 2 );
+  CPPUNIT_ASSERT ( output->getLastFrameBytes() < 240 );
+  CPPUNIT_ASSERT ( is_line(15, L'#') );
+  CPPUNIT_ASSERT ( is_line(16, L'$') );
+  CPPUNIT_ASSERT ( is_line(17, L'%') );
+
+  for (auto y{18}; y < 24; y++)
+    CPPUNIT_ASSERT ( is_line(y, wchar_t(L'A' + y - 2)) );
+
+  // A single moved line is output directly
+  print_line (0, L'B');
+  print_line (1, L'&');
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 0 );
+  CPPUNIT_ASSERT ( is_line(0, L'B') );
+
+  // Lines with the same hash have no unique old position
+  print_line (2, L'p');
+  print_line (3, L'q');
+  print_line (10, L'p');
+  print_line (11, L'q');
+  update();
+  print_line (1, L'p');
+  print_line (2, L'q');
+  print_line (3, L'*');
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 0 );
+  CPPUNIT_ASSERT ( is_line(1, L'p') );
+  CPPUNIT_ASSERT ( is_line(2, L'q') );
+  CPPUNIT_ASSERT ( is_line(3, L'*') );
+
+  // The same move of unique lines is scrolled
+  print_line (10, L'+');
+  print_line (11, L'-');
+  update();
+  print_line (0, L'p');
+  print_line (1, L'q');
+  print_line (2, L'/');
+  update();
+  CPPUNIT_ASSERT ( count("\033[r") == 1 );
+  CPPUNIT_ASSERT ( count("\033[1;3r\033[3;1H\n\033[r") == 1 );
+  CPPUNIT_ASSERT ( is_line(0, L'p') );
+  CPPUNIT_ASSERT ( is_line(1, L'q') );
+  CPPUNIT_ASSERT ( is_line(2, L'/') );
+  CPPUNIT_ASSERT ( is_line(3, L'*') );
+  output->setByteSink ({});
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::scrollTest()
+{
+  const auto output = fvterm.getOutput();
+  CPPUNIT_ASSERT ( output->clearTerminal() );
+  output->setTerminalSize ({10, 4});
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 10 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 4 );
+  CPPUNIT_ASSERT ( ! output->scrollTerminalForward(0, 4) );
+  CPPUNIT_ASSERT ( ! output->scrollTerminalForward(2, 2) );
+  CPPUNIT_ASSERT ( ! output->scrollTerminalReverse(-1, 3) );
+
+  CPPUNIT_ASSERT ( output->clearTerminal(L'0') );
+  CPPUNIT_ASSERT ( output->getLine(0) == "0000000000" );
+  CPPUNIT_ASSERT ( output->getLine(3) == "0000000000" );
+
+  CPPUNIT_ASSERT ( output->scrollTerminalForward(1, 3) );
+  CPPUNIT_ASSERT ( output->getLine(0) == "0000000000" );
+  CPPUNIT_ASSERT ( output->getLine(2) == "0000000000" );
+  CPPUNIT_ASSERT ( output->getLine(3) == "          " );
+
+  CPPUNIT_ASSERT ( output->scrollTerminalReverse() );
+  CPPUNIT_ASSERT ( output->getLine(0) == "          " );
+  CPPUNIT_ASSERT ( output->getLine(1) == "0000000000" );
+  CPPUNIT_ASSERT ( output->getLine(3) == "0000000000" );
+  output->flush();
+
+  output->setTerminalSize ({80, 24});
+  CPPUNIT_ASSERT ( output->getLine(0) == finalcut::FString(80, L' ') );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::cursorTest()
+{
+  const auto output = fvterm.getOutput();
+  CPPUNIT_ASSERT ( output->isCursorHidden() );
+  output->showCursor();
+  CPPUNIT_ASSERT ( ! output->isCursorHidden() );
+  output->hideCursor();
+  CPPUNIT_ASSERT ( output->isCursorHidden() );
+  output->setCursor ({5, 6});
+  CPPUNIT_ASSERT ( output->getCursorPos() == finalcut::FPoint(5, 6) );
+  output->flush();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::repaintTest()
+{
+  // Counts frames and bytes per frame for repainting the whole
+  // screen (the frame rate is measured in scenario-bench)
+
+  const auto output = fvterm.getOutput();
+  output->resetStatistics();
+  const finalcut::FString line(80, L'#');
+  const finalcut::FString alt_line(80, L'*');
+  const int frames{20};
+
+  for (auto n{0}; n < frames; n++)
+  {
+    fvterm.setColor (finalcut::FColor(n % 16), finalcut::FColor::Black);
+
+    for (auto y{1}; y <= 24; y++)
+      fvterm.print() << finalcut::FPoint{1, y} << ((n % 2) ? alt_line : line);
+
+    CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+    output->flush();
+    CPPUNIT_ASSERT ( output->getLastFrameBytes() >= 80 * 24 );
+  }
+
+  CPPUNIT_ASSERT ( output->getFrameCount() == uInt64(frames) );
+  CPPUNIT_ASSERT ( output->getByteCount() >= uInt64(frames * 80 * 24) );
+  CPPUNIT_ASSERT ( output->getLine(0) == alt_line );
+  CPPUNIT_ASSERT ( output->getLine(23) == alt_line );
+  fvterm.setNormal();
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FHeadlessOutputTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -20,7 +20,9 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <clocale>
 #include <string>
 #include <thread>
 
@@ -300,6 +302,7 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void escapeKeyTest();
     void characterwiseInputTest();
     void severalKeysTest();
+    void bulkInputTest();
     void functionKeyTest();
     void metaKeyTest();
     void sequencesTest();
@@ -307,6 +310,7 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void mouseTest();
     void utf8Test();
     void unknownKeyTest();
+    void bracketedPasteTest();
 
   private:
     // Adds code needed to register the test suite
@@ -319,6 +323,7 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (escapeKeyTest);
     CPPUNIT_TEST (characterwiseInputTest);
     CPPUNIT_TEST (severalKeysTest);
+    CPPUNIT_TEST (bulkInputTest);
     CPPUNIT_TEST (functionKeyTest);
     CPPUNIT_TEST (metaKeyTest);
     CPPUNIT_TEST (sequencesTest);
@@ -326,6 +331,7 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (unknownKeyTest);
+    CPPUNIT_TEST (bracketedPasteTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -337,11 +343,14 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void keyReleased();
     void escapeKeyPressed();
     void mouseTracking();
+    void pasteText();
 
     // Data members
     finalcut::FKey key_pressed{finalcut::FKey::None};
     finalcut::FKey key_released{finalcut::FKey::None};
     int number_of_keys{0};
+    int number_of_pastes{0};
+    finalcut::FString paste_text{};
     finalcut::FKeyboard* keyboard{nullptr};
 };
 
@@ -537,6 +546,33 @@ void FKeyboardTest::severalKeysTest()
   clear();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::bulkInputTest()
+{
+  keyboard->resetSyscallCount();
+  CPPUNIT_ASSERT ( keyboard->getSyscallCount() == 0 );
+
+  // Input of 200 characters at once
+  input(std::string(200, 'x'));
+  processInput();
+
+  while ( keyboard->hasPendingInput() )  // Key queue was full
+  {
+    keyboard->fetchKeyCode();
+    keyboard->processQueuedInput();
+  }
+
+  std::cout << " - Keys: " << number_of_keys
+            << " (syscalls: " << keyboard->getSyscallCount() << ")" << std::endl;
+  CPPUNIT_ASSERT ( number_of_keys == 200 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('x') );
+  CPPUNIT_ASSERT ( ! keyboard->hasPendingInput() );
+
+  // The bytes are not read individually
+  CPPUNIT_ASSERT ( keyboard->getSyscallCount() < 50 );
+  clear();
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::functionKeyTest()
 {
@@ -3143,6 +3179,116 @@ void FKeyboardTest::unknownKeyTest()
   CPPUNIT_ASSERT ( keyboard->getKeyName(key_pressed) == "" );
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::bracketedPasteTest()
+{
+  // Higher timeout for systems with high load
+  keyboard->setKeypressTimeout(250000);  // 250 ms
+  CPPUNIT_ASSERT ( keyboard->getKeyName(finalcut::FKey::Bracketed_paste)
+                   == "bracketed paste" );
+
+  // The pasted text is delivered in one piece
+  input("\033[200~Hello \033[A World\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( paste_text == "Hello \033[A World" );
+  CPPUNIT_ASSERT ( keyboard->getPasteText().isEmpty() );
+  clear();
+
+  // Line endings are converted to '\n'
+  input("\033[200~1\r2\n3\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( paste_text == "1\n2\n3" );
+  clear();
+
+  // Paste text distributed over several reads
+  input("\033[200~abc\033[20");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  input("1def\033[201");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  input("~x");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( paste_text == "abc\033[201def" );
+  // Keys after the paste end sequence are processed normally
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('x') );
+  clear();
+
+  // Large paste
+  input("\033[200~" + std::string(3000, 'p') + "\033[201~");
+  processInput();
+
+  while ( keyboard->hasPendingInput() )
+  {
+    keyboard->fetchKeyCode();
+    keyboard->processQueuedInput();
+  }
+
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( paste_text.getLength() == 3000 );
+  clear();
+
+  // A paste without end sequence is delivered after the keypress timeout
+  input("\033[200~abc");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  CPPUNIT_ASSERT ( keyboard->hasUnprocessedInput() );
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( paste_text == "abc" );
+  CPPUNIT_ASSERT ( ! keyboard->hasUnprocessedInput() );
+  // The following keys are processed normally
+  input("x");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('x') );
+  clear();
+
+  // A paste above the chunk size of 65536 bytes is delivered in
+  // chunks without splitting the 3-byte UTF-8 character "€"
+  // (e2 82 ac), which spans the cut position 65531
+  auto ret = std::setlocale (LC_CTYPE, "en_US.UTF-8");
+
+  if ( ! ret )
+    ret = std::setlocale (LC_CTYPE, "C.UTF-8");
+
+  CPPUNIT_ASSERT ( ret != nullptr );
+  std::string pasted(65529, 'p');
+  pasted += "€";
+  pasted += std::string(65536 - pasted.size(), 'q');
+  std::size_t pos{0};
+  input("\033[200~");
+  processInput();
+
+  while ( pos < pasted.size() )
+  {
+    // Stay below the line buffer size of the tty
+    const auto length = std::min(std::size_t(3000), pasted.size() - pos);
+    input(pasted.substr(pos, length));
+    processInput();
+    pos += length;
+  }
+
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( paste_text.getLength() == 65529 );
+  CPPUNIT_ASSERT ( paste_text.back() == L'p' );
+  input("r\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 2 );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( paste_text == L"€" + finalcut::FString(4, L'q') + L"r" );
+  std::setlocale (LC_CTYPE, "C");
+  clear();
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::init()
 {
@@ -3153,14 +3299,17 @@ void FKeyboardTest::init()
   auto cmd2 = [this] () { this->keyReleased(); };
   auto cmd3 = [this] () { this->escapeKeyPressed(); };
   auto cmd4 = [this] () { this->mouseTracking(); };
+  auto cmd5 = [this] () { this->pasteText(); };
   finalcut::FKeyboardCommand key_cmd1 (cmd1);
   finalcut::FKeyboardCommand key_cmd2 (cmd2);
   finalcut::FKeyboardCommand key_cmd3 (cmd3);
   finalcut::FKeyboardCommand key_cmd4 (cmd4);
+  finalcut::FKeyboardCommand key_cmd5 (cmd5);
   keyboard->setPressCommand (key_cmd1);
   keyboard->setReleaseCommand (key_cmd2);
   keyboard->setEscPressedCommand (key_cmd3);
   keyboard->setMouseTrackingCommand (key_cmd4);
+  keyboard->setPasteCommand (key_cmd5);
   keyboard->setKeypressTimeout (100000);  // 100 ms
   processInput();
   CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
@@ -3222,6 +3371,8 @@ void FKeyboardTest::clear()
 {
   keyboard->clearKeyBuffer();
   number_of_keys = 0;
+  number_of_pastes = 0;
+  paste_text.clear();
   key_pressed = finalcut::FKey::None;
   key_released = finalcut::FKey::None;
 }
@@ -3253,6 +3404,13 @@ void FKeyboardTest::mouseTracking()
   key_pressed = keyboard->getKey();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::pasteText()
+{
+  paste_text = keyboard->getPasteText();
+  number_of_pastes++;
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FKeyboardTest);
 
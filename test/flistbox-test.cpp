@@ -0,0 +1,437 @@
+/***********************************************************************
+* flistbox-test.cpp - FListBox unit tests                              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FListBoxTest
+//----------------------------------------------------------------------
+
+class FListBoxTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListBoxTest() = default;
+
+  protected:
+    void classNameTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListBoxTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    void insertTest (finalcut::FWidget*);
+    void removeTest (finalcut::FWidget*);
+    void lineWidthTest (finalcut::FWidget*);
+    void virtualRowsTest (finalcut::FWidget*);
+    void virtualSelectionTest (finalcut::FWidget*);
+    void rowCacheTest (finalcut::FWidget*);
+    static auto getHorizontalOffset (finalcut::FListBox&) -> int;
+    static void pressKey (finalcut::FListBox&, finalcut::FKey);
+
+    // Data member
+    finalcut::FVTerm fvterm{finalcut::outputClass<finalcut::FHeadlessOutput>{}};
+};
+
+//----------------------------------------------------------------------
+void FListBoxTest::classNameTest()
+{
+  const finalcut::FListBoxItem item{};
+  CPPUNIT_ASSERT ( item.getClassName() == "FListBoxItem" );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::applicationTest()
+{
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  insertTest (&fapp);
+  removeTest (&fapp);
+  lineWidthTest (&fapp);
+  virtualRowsTest (&fapp);
+  virtualSelectionTest (&fapp);
+  rowCacheTest (&fapp);
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::insertTest (finalcut::FWidget* parent)
+{
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+  int changed{0};
+  listbox.addCallback ("changed", [&changed] () { changed++; });
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 0 );
+
+  // A range of items is inserted with one change notification
+  finalcut::FListBox::FListBoxItems items{};
+
+  for (int i{1}; i <= 100; i++)
+    items.emplace_back (finalcut::FString() << "Item " << i);
+
+  listbox.insert (items.cbegin(), items.cend());
+  CPPUNIT_ASSERT ( changed == 1 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 100 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 1 );
+  CPPUNIT_ASSERT ( listbox.getItem(100).getText() == "Item 100" );
+
+  // The same applies to an initializer list
+  listbox.insert ({"a", "b", "c"}, finalcut::BracketType::Brackets);
+  CPPUNIT_ASSERT ( changed == 2 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 103 );
+  CPPUNIT_ASSERT ( listbox.hasBrackets(103) );
+
+  // ...and to converted container elements
+  const std::vector<int> numbers{1, 2, 3, 4, 5};
+  listbox.insert ( numbers.cbegin(), numbers.cend()
+                 , [] (std::vector<int>::const_iterator iter)
+                   {
+                     return finalcut::FString() << *iter * 10;
+                   } );
+  CPPUNIT_ASSERT ( changed == 3 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 108 );
+  CPPUNIT_ASSERT ( listbox.getItem(108).getText() == "50" );
+
+  // Single items
+  listbox.insert ("last");
+  CPPUNIT_ASSERT ( changed == 4 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 109 );
+
+  // An empty range
+  listbox.insert (items.cend(), items.cend());
+  CPPUNIT_ASSERT ( listbox.getCount() == 109 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::removeTest (finalcut::FWidget* parent)
+{
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+
+  for (int i{1}; i <= 100; i++)
+    listbox.insert (finalcut::FString() << i);
+
+  int changed{0};
+  listbox.addCallback ("changed", [&changed] () { changed++; });
+
+  // Items behind the current item
+  listbox.setCurrentItem (50);
+  listbox.remove (60, 10);
+  CPPUNIT_ASSERT ( changed == 1 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 90 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 50 );
+  CPPUNIT_ASSERT ( listbox.getItem(60).getText() == "70" );
+
+  // Items in front of the current item
+  listbox.remove (11, 20);
+  CPPUNIT_ASSERT ( changed == 2 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 70 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 30 );
+  CPPUNIT_ASSERT ( listbox.getItem(30).getText() == "50" );
+
+  // The range contains the current item
+  listbox.remove (21, 20);
+  CPPUNIT_ASSERT ( listbox.getCount() == 50 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 20 );
+  CPPUNIT_ASSERT ( listbox.getItem(21).getText() == "71" );
+
+  // The count is limited to the last item
+  listbox.remove (41, 100);
+  CPPUNIT_ASSERT ( listbox.getCount() == 40 );
+  CPPUNIT_ASSERT ( listbox.getItem(40).getText() == "90" );
+
+  // Single item
+  listbox.remove (1);
+  CPPUNIT_ASSERT ( listbox.getCount() == 39 );
+  CPPUNIT_ASSERT ( listbox.getItem(1).getText() == "2" );
+
+  // Invalid arguments are ignored
+  changed = 0;
+  listbox.remove (0, 1);
+  listbox.remove (40, 1);
+  listbox.remove (1, 0);
+  CPPUNIT_ASSERT ( changed == 0 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 39 );
+
+  // Remove all items
+  listbox.remove (1, 39);
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::lineWidthTest (finalcut::FWidget* parent)
+{
+  // The horizontal scroll range follows the widest remaining item
+
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+  listbox.insert (finalcut::FString(30, L'x'));
+  listbox.insert (finalcut::FString(40, L'x'));
+  listbox.insert (finalcut::FString(25, L'x'));
+  listbox.insert (finalcut::FString(40, L'x'));
+  listbox.show();
+  const auto client_width = int(listbox.getClientWidth());
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 40 - client_width + 2 );
+
+  // One of the two widest items remains
+  listbox.remove (2);
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 40 - client_width + 2 );
+
+  listbox.remove (3);
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 30 - client_width + 2 );
+
+  // Brackets are part of the line width
+  listbox.showInsideBrackets (2, finalcut::BracketType::Brackets);
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 30 - client_width + 2 );
+  listbox.remove (1);
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 27 - client_width + 2 );
+
+  listbox.clear();
+  listbox.insert (finalcut::FString(22, L'x'));
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 22 - client_width + 2 );
+
+  // setItemText() counts the new width at once
+  listbox.insert (finalcut::FString(35, L'x'));
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 35 - client_width + 2 );
+  listbox.setItemText (2, "short");
+  CPPUNIT_ASSERT ( listbox.getItemText(2) == "short" );
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 22 - client_width + 2 );
+  listbox.setItemText (1, finalcut::FString(45, L'x'));
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 45 - client_width + 2 );
+
+  // The width is also current after removing another item
+  listbox.remove (2);
+  CPPUNIT_ASSERT ( getHorizontalOffset(listbox) == 45 - client_width + 2 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::virtualRowsTest (finalcut::FWidget* parent)
+{
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+  std::size_t requests{0};
+  int changed{0};
+  listbox.addCallback ("changed", [&changed] () { changed++; });
+  CPPUNIT_ASSERT ( ! listbox.isVirtual() );
+
+  // Ten million rows without an item per row
+  listbox.setVirtualRows ( 10'000'000
+                         , [&requests] (std::size_t row)
+                           {
+                             requests++;
+                             return finalcut::FString() << "Row " << row;
+                           } );
+  CPPUNIT_ASSERT ( listbox.isVirtual() );
+  CPPUNIT_ASSERT ( changed == 2 );  // Cleared and filled
+  CPPUNIT_ASSERT ( listbox.getCount() == 10'000'000 );
+  CPPUNIT_ASSERT ( listbox.getData().empty() );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 1 );
+  CPPUNIT_ASSERT ( ! listbox.hasBrackets(1) );
+  CPPUNIT_ASSERT ( requests == 0 );
+
+  // Only the visible rows are requested
+  listbox.show();
+  CPPUNIT_ASSERT ( requests > 0 );
+  CPPUNIT_ASSERT ( requests <= listbox.getClientHeight() );
+  CPPUNIT_ASSERT ( listbox.getItemText(5'000'000) == "Row 4999999" );
+  CPPUNIT_ASSERT ( listbox.getItemText(10'000'001).isEmpty() );
+
+  // Jump to the last row
+  pressKey (listbox, finalcut::FKey::End);
+  CPPUNIT_ASSERT ( listbox.currentItem() == 10'000'000 );
+
+  // Items cannot be removed from virtual rows
+  listbox.remove (1);
+  CPPUNIT_ASSERT ( listbox.getCount() == 10'000'000 );
+
+  // Incremental search
+  listbox.reloadVirtualRows (100);
+  CPPUNIT_ASSERT ( changed == 3 );
+  CPPUNIT_ASSERT ( listbox.getCount() == 100 );
+  CPPUNIT_ASSERT ( listbox.currentItem() == 100 );
+  pressKey (listbox, finalcut::FKey('r'));
+  CPPUNIT_ASSERT ( listbox.currentItem() == 1 );
+  pressKey (listbox, finalcut::FKey('o'));
+  pressKey (listbox, finalcut::FKey('w'));
+  pressKey (listbox, finalcut::FKey::Space);
+  pressKey (listbox, finalcut::FKey('4'));
+  pressKey (listbox, finalcut::FKey('2'));
+  CPPUNIT_ASSERT ( listbox.currentItem() == 43 );
+  CPPUNIT_ASSERT ( listbox.getItemText(listbox.currentItem()) == "Row 42" );
+  pressKey (listbox, finalcut::FKey::Erase);
+  CPPUNIT_ASSERT ( listbox.currentItem() == 5 );
+
+  // Inserting an item ends the virtual mode
+  listbox.insert ("Item");
+  CPPUNIT_ASSERT ( ! listbox.isVirtual() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 1 );
+  CPPUNIT_ASSERT ( listbox.getItemText(1) == "Item" );
+
+  listbox.setVirtualRows (5, [] (std::size_t) { return finalcut::FString("x"); });
+  CPPUNIT_ASSERT ( listbox.getCount() == 5 );
+  listbox.clear();
+  CPPUNIT_ASSERT ( ! listbox.isVirtual() );
+  CPPUNIT_ASSERT ( listbox.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::virtualSelectionTest (finalcut::FWidget* parent)
+{
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+  listbox.setMultiSelection();
+  listbox.setVirtualRows ( 1'000'000
+                         , [] (std::size_t row)
+                           {
+                             return finalcut::FString() << row;
+                           } );
+
+  auto selected = [&listbox] (std::size_t first, std::size_t last)
+  {
+    std::string result{};
+
+    for (auto item = first; item <= last; item++)
+      result += listbox.isSelected(item) ? '1' : '0';
+
+    return result;
+  };
+
+  for (std::size_t item{10}; item <= 20; item++)
+    listbox.selectItem(item);
+
+  listbox.selectItem (22);
+  CPPUNIT_ASSERT ( selected(8, 23) == "0011111111111010" );
+
+  // Fill the gap and split a range
+  listbox.selectItem (21);
+  listbox.unselectItem (15);
+  listbox.unselectItem (10);
+  listbox.unselectItem (30);
+  CPPUNIT_ASSERT ( selected(8, 23) == "0001111011111110" );
+
+  // Select rows with the space bar
+  listbox.setCurrentItem (999'999);
+  pressKey (listbox, finalcut::FKey::Space);
+  CPPUNIT_ASSERT ( listbox.isSelected(999'999) );
+  pressKey (listbox, finalcut::FKey::Space);
+  CPPUNIT_ASSERT ( ! listbox.isSelected(999'999) );
+  listbox.selectItem (1'000'000);
+
+  // Fewer rows drop the selection of removed rows
+  listbox.reloadVirtualRows (18);
+  CPPUNIT_ASSERT ( listbox.currentItem() == 18 );
+  listbox.reloadVirtualRows (1'000'000);
+  CPPUNIT_ASSERT ( selected(8, 23) == "0001111011100000" );
+  CPPUNIT_ASSERT ( ! listbox.isSelected(1'000'000) );
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::rowCacheTest (finalcut::FWidget* parent)
+{
+  finalcut::FListBox listbox{parent};
+  listbox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 10});
+  std::vector<std::size_t> requests{};
+
+  auto provider = [&requests] (std::size_t row)
+  {
+    requests.push_back(row);
+    return finalcut::FString() << "Row\t" << row;
+  };
+
+  // Without a cache, every access requests the text
+  listbox.setVirtualRows (100, provider);
+  CPPUNIT_ASSERT ( listbox.getItemText(1) == "Row     0" );
+  CPPUNIT_ASSERT ( listbox.getItemText(1) == "Row     0" );
+  CPPUNIT_ASSERT ( requests.size() == 2 );
+
+  // The cache keeps the three most recently used rows
+  requests.clear();
+  listbox.setVirtualRows (100, provider, 3);
+
+  for (std::size_t item{1}; item <= 3; item++)
+    listbox.getItemText(item);
+
+  listbox.getItemText(1);
+  listbox.getItemText(4);  // Removes row 1 (item 2)
+  listbox.getItemText(1);
+  listbox.getItemText(2);
+  const std::vector<std::size_t> expected{0, 1, 2, 3, 1};
+  CPPUNIT_ASSERT ( requests == expected );
+
+  // Reloading empties the cache
+  listbox.reloadVirtualRows (100);
+  listbox.getItemText(1);
+  CPPUNIT_ASSERT ( requests.size() == 6 );
+}
+
+//----------------------------------------------------------------------
+auto FListBoxTest::getHorizontalOffset (finalcut::FListBox& listbox) -> int
+{
+  // Scrolls to the right end and returns the horizontal offset
+
+  for (int i{0}; i < 100; i++)
+    pressKey (listbox, finalcut::FKey::Right);
+
+  for (auto&& child : listbox.getChildren())
+  {
+    const auto scrollbar = static_cast<finalcut::FScrollbar*>(child);
+
+    if ( scrollbar->getWidth() > scrollbar->getHeight() )
+      return scrollbar->getValue();
+  }
+
+  return -1;
+}
+
+//----------------------------------------------------------------------
+void FListBoxTest::pressKey (finalcut::FListBox& listbox, finalcut::FKey key)
+{
+  finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+  listbox.onKeyPress (&ev);
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListBoxTest);
+
+// The general unit test main part
+#include <main-test.inc>
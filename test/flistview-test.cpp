@@ -0,0 +1,456 @@
+/***********************************************************************
+* flistview-test.cpp - FListView unit tests                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FListViewTest
+//----------------------------------------------------------------------
+
+class FListViewTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListViewTest() = default;
+
+  protected:
+    void classNameTest();
+    void lineIndexTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListViewTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (lineIndexTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    void countTest (finalcut::FWidget*);
+    void seekTest (finalcut::FWidget*);
+    void sortTest (finalcut::FWidget*);
+    void parallelSortTest (finalcut::FWidget*);
+    static auto getTexts (const finalcut::FListView&, int) -> finalcut::FStringList;
+    static void pressKey (finalcut::FListView&, finalcut::FKey);
+    static auto currentText (finalcut::FListView&) -> finalcut::FString;
+
+    // Data member
+    finalcut::FVTerm fvterm{finalcut::outputClass<finalcut::FHeadlessOutput>{}};
+};
+
+//----------------------------------------------------------------------
+void FListViewTest::classNameTest()
+{
+  const finalcut::FListViewLines lines{};
+  CPPUNIT_ASSERT ( lines.getClassName() == "FListViewLines" );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::lineIndexTest()
+{
+  finalcut::FListViewLines lines{};
+  CPPUNIT_ASSERT ( lines.getSize() == 0 );
+  CPPUNIT_ASSERT ( lines.getLines() == 0 );
+  CPPUNIT_ASSERT ( lines.getLinesBefore(5) == 0 );
+
+  // Items with 1, 2, 3, ..., 20 lines
+  std::vector<std::size_t> values{};
+
+  for (std::size_t i{1}; i <= 20; i++)
+  {
+    lines.append(i);
+    values.push_back(i);
+  }
+
+  CPPUNIT_ASSERT ( lines.getSize() == 20 );
+  CPPUNIT_ASSERT ( lines.getLines() == 210 );
+
+  auto check = [&lines, &values] ()
+  {
+    std::size_t sum{0};
+
+    for (std::size_t i{0}; i < values.size(); i++)
+    {
+      CPPUNIT_ASSERT ( lines.getLinesBefore(i) == sum );
+
+      for (std::size_t n{0}; n < values[i]; n++)
+      {
+        std::size_t line = sum + n;
+        CPPUNIT_ASSERT ( lines.findIndex(line) == i );
+        CPPUNIT_ASSERT ( line == n );
+      }
+
+      sum += values[i];
+    }
+
+    CPPUNIT_ASSERT ( lines.getLines() == sum );
+  };
+
+  check();
+
+  // Change the number of lines
+  lines.replace (4, 5, 50);
+  values[4] = 50;
+  check();
+  lines.replace (4, 50, 1);
+  values[4] = 1;
+  lines.replace (19, 20, 1);
+  values[19] = 1;
+  check();
+  CPPUNIT_ASSERT ( lines.getLines() == 187 );
+
+  lines.clear();
+  CPPUNIT_ASSERT ( lines.getSize() == 0 );
+  CPPUNIT_ASSERT ( lines.getLines() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::applicationTest()
+{
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  countTest (&fapp);
+  seekTest (&fapp);
+  sortTest (&fapp);
+  parallelSortTest (&fapp);
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::countTest (finalcut::FWidget* parent)
+{
+  finalcut::FListView listview{parent};
+  listview.addColumn ("Name");
+  listview.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{30, 12});
+  CPPUNIT_ASSERT ( listview.getCount() == 0 );
+
+  // Every third item has 4 children, the second child has 2 children
+  std::vector<finalcut::FListViewItem*> parents{};
+
+  for (int i{0}; i < 10; i++)
+  {
+    auto iter = listview.insert ({finalcut::FString() << i});
+
+    if ( i % 3 != 0 )
+      continue;
+
+    parents.push_back (static_cast<finalcut::FListViewItem*>(*iter));
+
+    for (int j{0}; j < 4; j++)
+    {
+      auto child_iter = listview.insert ({finalcut::FString() << i << '.' << j}, iter);
+
+      if ( j == 1 )
+      {
+        listview.insert ({finalcut::FString() << i << ".1.0"}, child_iter);
+        listview.insert ({finalcut::FString() << i << ".1.1"}, child_iter);
+      }
+    }
+  }
+
+  auto second_child = [] (const finalcut::FListViewItem* item)
+  {
+    return static_cast<finalcut::FListViewItem*>(*(item->cbegin() + 1));
+  };
+
+  listview.show();
+  CPPUNIT_ASSERT ( listview.getCount() == 10 );
+
+  // Expand and collapse
+  parents[1]->expand();
+  CPPUNIT_ASSERT ( listview.getCount() == 14 );
+  second_child(parents[1])->expand();
+  CPPUNIT_ASSERT ( listview.getCount() == 16 );
+  parents[1]->collapse();
+  CPPUNIT_ASSERT ( listview.getCount() == 10 );
+  parents[1]->expand();
+  CPPUNIT_ASSERT ( listview.getCount() == 16 );
+
+  // Expanding below a collapsed item does not add visible lines
+  second_child(parents[2])->expand();
+  CPPUNIT_ASSERT ( listview.getCount() == 16 );
+  parents[2]->expand();
+  CPPUNIT_ASSERT ( listview.getCount() == 22 );
+
+  // Remove an expanded child with two children
+  delete second_child(parents[2]);
+  CPPUNIT_ASSERT ( listview.getCount() == 19 );
+
+  // Insert into an expanded item
+  auto parent_iter = std::find (listview.begin(), listview.end(), parents[2]);
+  listview.insert ({"6.4"}, parent_iter);
+  CPPUNIT_ASSERT ( listview.getCount() == 20 );
+
+  // Remove an expanded top-level item with 7 visible lines
+  delete parents[1];
+  CPPUNIT_ASSERT ( listview.getCount() == 13 );
+
+  listview.clear();
+  CPPUNIT_ASSERT ( listview.getCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::seekTest (finalcut::FWidget* parent)
+{
+  // Page down and up must reach the same lines as single steps
+
+  finalcut::FListView listview{parent};
+  listview.addColumn ("Name");
+  listview.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{30, 12});
+  std::vector<finalcut::FListViewItem*> parents{};
+
+  for (int i{0}; i < 200; i++)
+  {
+    auto iter = listview.insert ({finalcut::FString() << i});
+
+    if ( i % 7 != 0 )
+      continue;
+
+    parents.push_back (static_cast<finalcut::FListViewItem*>(*iter));
+
+    for (int j{0}; j < 3; j++)
+    {
+      auto child_iter = listview.insert ({finalcut::FString() << i << '.' << j}, iter);
+
+      for (int k{0}; k < j; k++)
+        listview.insert ({finalcut::FString() << i << '.' << j << '.' << k}, child_iter);
+    }
+  }
+
+  // Expand every second parent including its children
+  for (std::size_t n{0}; n < parents.size(); n += 2)
+  {
+    for (auto&& child : parents[n]->getChildren())
+      static_cast<finalcut::FListViewItem*>(child)->expand();
+
+    parents[n]->expand();
+  }
+
+  listview.show();
+  const auto count = listview.getCount();
+  CPPUNIT_ASSERT ( count == 200 + 15 * 6 );
+
+  // Collect the lines with single steps
+  std::vector<finalcut::FString> lines{};
+  lines.push_back (currentText(listview));
+
+  for (std::size_t n{1}; n < count; n++)
+  {
+    pressKey (listview, finalcut::FKey::Down);
+    lines.push_back (currentText(listview));
+  }
+
+  CPPUNIT_ASSERT ( lines[0] == "0" );
+  CPPUNIT_ASSERT ( lines[1] == "0.0" );
+  CPPUNIT_ASSERT ( lines[4] == "0.2" );
+  CPPUNIT_ASSERT ( lines[7] == "1" );
+  CPPUNIT_ASSERT ( lines.back() == "199" );
+
+  // Page up, page down, home and end
+  const std::size_t page = listview.getClientHeight() - 1;
+  pressKey (listview, finalcut::FKey::Home);
+  CPPUNIT_ASSERT ( currentText(listview) == lines[0] );
+  std::size_t line{0};
+
+  while ( line + page < count )
+  {
+    pressKey (listview, finalcut::FKey::Page_down);
+    line += page;
+    CPPUNIT_ASSERT ( currentText(listview) == lines[line] );
+  }
+
+  pressKey (listview, finalcut::FKey::Page_down);
+  CPPUNIT_ASSERT ( currentText(listview) == lines.back() );
+  pressKey (listview, finalcut::FKey::Page_up);
+  CPPUNIT_ASSERT ( currentText(listview) == lines[count - 1 - page] );
+  pressKey (listview, finalcut::FKey::Home);
+  CPPUNIT_ASSERT ( currentText(listview) == lines[0] );
+  pressKey (listview, finalcut::FKey::End);
+  CPPUNIT_ASSERT ( currentText(listview) == lines.back() );
+
+  // Go back line by line
+  for (std::size_t n = count - 1; n > 0; n--)
+  {
+    pressKey (listview, finalcut::FKey::Up);
+    CPPUNIT_ASSERT ( currentText(listview) == lines[n - 1] );
+  }
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::sortTest (finalcut::FWidget* parent)
+{
+  finalcut::FListView listview{parent};
+  listview.addColumn ("Name");
+  listview.addColumn ("Size");
+  listview.setColumnSortType (2, finalcut::SortType::Number);
+  listview.insert ({"beta", "12 kB"});
+  listview.insert ({"Alpha", "3 kB"});
+  auto iter = listview.insert ({"gamma", "100 kB"});
+  const auto gamma = static_cast<finalcut::FListViewItem*>(*iter);
+  listview.insert ({"c", "0 B"}, iter);
+  listview.insert ({"B", "0 B"}, iter);
+  listview.insert ({"a", "0 B"}, iter);
+  listview.insert ({"alpha", "12 MB"});
+  listview.insert ({"Beta", "3 MB"});
+
+  // Case-insensitive and stable
+  listview.setColumnSort (1, finalcut::SortOrder::Ascending);
+  listview.sort();
+  CPPUNIT_ASSERT ( getTexts(listview, 1)
+                   == finalcut::FStringList({"Alpha", "alpha", "beta", "Beta", "gamma"}) );
+
+  listview.setColumnSort (1, finalcut::SortOrder::Descending);
+  listview.sort();
+  CPPUNIT_ASSERT ( getTexts(listview, 1)
+                   == finalcut::FStringList({"gamma", "beta", "Beta", "Alpha", "alpha"}) );
+
+  // The children are sorted as well
+  finalcut::FStringList children{};
+
+  for (auto&& child : gamma->getChildren())
+    children.push_back(static_cast<finalcut::FListViewItem*>(child)->getText(1));
+
+  CPPUNIT_ASSERT ( children == finalcut::FStringList({"c", "B", "a"}) );
+
+  // Sort stable by the first number in the text
+  listview.setColumnSort (2, finalcut::SortOrder::Ascending);
+  listview.sort();
+  CPPUNIT_ASSERT ( getTexts(listview, 1)
+                   == finalcut::FStringList({"Beta", "Alpha", "beta", "alpha", "gamma"}) );
+
+  listview.setColumnSort (2, finalcut::SortOrder::Descending);
+  listview.sort();
+  CPPUNIT_ASSERT ( getTexts(listview, 2)
+                   == finalcut::FStringList({"100 kB", "12 kB", "12 MB", "3 MB", "3 kB"}) );
+
+  // User-defined compare function
+  listview.setColumnSortType (1, finalcut::SortType::UserDefined);
+  listview.setUserAscendingCompare
+  (
+    [] (const finalcut::FObject* lhs, const finalcut::FObject* rhs)
+    {
+      const auto l_item = static_cast<const finalcut::FListViewItem*>(lhs);
+      const auto r_item = static_cast<const finalcut::FListViewItem*>(rhs);
+      return l_item->getText(1).getLength() < r_item->getText(1).getLength();
+    }
+  );
+  listview.setColumnSort (1, finalcut::SortOrder::Ascending);
+  listview.sort();
+  CPPUNIT_ASSERT ( getTexts(listview, 1)
+                   == finalcut::FStringList({"beta", "Beta", "gamma", "alpha", "Alpha"}) );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::parallelSortTest (finalcut::FWidget* parent)
+{
+  // Sorting with several threads gives the same stable order
+
+  finalcut::FListView listview{parent};
+  listview.addColumn ("Index");
+  listview.addColumn ("Number");
+  listview.setColumnSortType (1, finalcut::SortType::Number);
+  listview.setColumnSortType (2, finalcut::SortType::Number);
+  CPPUNIT_ASSERT ( listview.getSortThreads() == 0 );
+  constexpr int rows = 50000;
+
+  for (int i{0}; i < rows; i++)
+    listview.insert ({ finalcut::FString() << i << '.'
+                     , finalcut::FString() << (i * 7919) % 1000 << " items" });
+
+  listview.setSortThreads (4);
+  CPPUNIT_ASSERT ( listview.getSortThreads() == 4 );
+  listview.setColumnSort (2, finalcut::SortOrder::Ascending);
+  listview.sort();
+  const auto& items = listview.getData();
+  CPPUNIT_ASSERT ( items.size() == std::size_t(rows) );
+
+  auto number = [&items] (std::size_t n, int column)
+  {
+    return std::stoi(items[n]->getText(column).toString());
+  };
+
+  for (std::size_t n{1}; n < items.size(); n++)
+  {
+    CPPUNIT_ASSERT ( number(n - 1, 2) <= number(n, 2) );
+
+    if ( number(n - 1, 2) == number(n, 2) )
+      CPPUNIT_ASSERT ( number(n - 1, 1) < number(n, 1) );
+  }
+
+  // Restore the original order
+  listview.setColumnSort (1, finalcut::SortOrder::Ascending);
+  listview.sort();
+
+  for (std::size_t n{0}; n < items.size(); n++)
+    CPPUNIT_ASSERT ( number(n, 1) == int(n) );
+
+  listview.setColumnSort (1, finalcut::SortOrder::Descending);
+  listview.sort();
+  CPPUNIT_ASSERT ( number(0, 1) == rows - 1 );
+  CPPUNIT_ASSERT ( number(items.size() - 1, 1) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FListViewTest::pressKey (finalcut::FListView& listview, finalcut::FKey key)
+{
+  finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+  listview.onKeyPress (&ev);
+}
+
+//----------------------------------------------------------------------
+auto FListViewTest::currentText (finalcut::FListView& listview) -> finalcut::FString
+{
+  return listview.getCurrentItem()->getText(1);
+}
+
+//----------------------------------------------------------------------
+auto FListViewTest::getTexts (const finalcut::FListView& listview, int column) -> finalcut::FStringList
+{
+  finalcut::FStringList texts{};
+
+  for (auto&& item : listview.getData())
+    texts.push_back(item->getText(column));
+
+  return texts;
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListViewTest);
+
+// The general unit test main part
+#include <main-test.inc>
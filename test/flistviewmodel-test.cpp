@@ -0,0 +1,298 @@
+/***********************************************************************
+* flistviewmodel-test.cpp - FListViewModel unit tests                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FlatModel
+//----------------------------------------------------------------------
+
+class FlatModel : public finalcut::FListViewModel
+{
+  public:
+    explicit FlatModel (std::size_t n)
+      : rows{n}
+    { }
+
+    auto getRowCount (Node parent) const -> std::size_t override
+    {
+      return ( parent == ROOT ) ? rows : 0;
+    }
+
+    auto getText (Node node, int column) const -> finalcut::FString override
+    {
+      return finalcut::FString() << column << ':' << node;
+    }
+
+    std::size_t rows;
+};
+
+//----------------------------------------------------------------------
+// class TreeModel
+//----------------------------------------------------------------------
+
+// Three levels with 10 rows per node. The node value of
+// the child row r is 10 * parent + r + 1 (top level: r + 1).
+
+class TreeModel : public finalcut::FListViewModel
+{
+  public:
+    auto getRowCount (Node parent) const -> std::size_t override
+    {
+      return ( parent == ROOT || hasChildren(parent) ) ? 10 : 0;
+    }
+
+    auto getNode (Node parent, std::size_t row) const -> Node override
+    {
+      return ( parent == ROOT ) ? row + 1 : parent * 10 + row + 1;
+    }
+
+    auto getText (Node node, int) const -> finalcut::FString override
+    {
+      return finalcut::FString() << node;
+    }
+
+    auto hasChildren (Node node) const -> bool override
+    {
+      return node <= 110;
+    }
+};
+
+//----------------------------------------------------------------------
+// class FListViewModelTest
+//----------------------------------------------------------------------
+
+class FListViewModelTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FListViewModelTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void flatModelTest();
+    void expandTest();
+    void nestedExpandTest();
+    void collapseTest();
+    void largeModelTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FListViewModelTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (flatModelTest);
+    CPPUNIT_TEST (expandTest);
+    CPPUNIT_TEST (nestedExpandTest);
+    CPPUNIT_TEST (collapseTest);
+    CPPUNIT_TEST (largeModelTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FListViewModelTest::classNameTest()
+{
+  const FlatModel model{0};
+  const finalcut::FListViewModelTree tree{};
+  CPPUNIT_ASSERT ( model.getClassName() == "FListViewModel" );
+  CPPUNIT_ASSERT ( tree.getClassName() == "FListViewModelTree" );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::noArgumentTest()
+{
+  finalcut::FListViewModelTree tree{};
+  CPPUNIT_ASSERT ( tree.getModel() == nullptr );
+  CPPUNIT_ASSERT ( tree.getCount() == 0 );
+  CPPUNIT_ASSERT ( ! tree.expand(0) );
+  CPPUNIT_ASSERT ( ! tree.collapse(0) );
+
+  const auto line = tree.getLine(0);
+  CPPUNIT_ASSERT ( line.node == finalcut::FListViewModel::ROOT );
+  CPPUNIT_ASSERT ( line.depth == 0 );
+  CPPUNIT_ASSERT ( line.parent_line == -1 );
+  CPPUNIT_ASSERT ( ! line.expandable );
+  CPPUNIT_ASSERT ( ! line.expanded );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::flatModelTest()
+{
+  FlatModel model{5};
+  finalcut::FListViewModelTree tree{&model};
+  CPPUNIT_ASSERT ( tree.getModel() == &model );
+  CPPUNIT_ASSERT ( tree.getCount() == 5 );
+
+  for (std::size_t i{0}; i < 5; i++)
+  {
+    const auto line = tree.getLine(i);
+    CPPUNIT_ASSERT ( line.node == i );
+    CPPUNIT_ASSERT ( line.row == i );
+    CPPUNIT_ASSERT ( line.depth == 0 );
+    CPPUNIT_ASSERT ( ! line.expandable );
+  }
+
+  // Rows without children cannot be expanded
+  CPPUNIT_ASSERT ( ! tree.expand(2) );
+  CPPUNIT_ASSERT ( tree.getCount() == 5 );
+  CPPUNIT_ASSERT ( tree.getLine(5).node == finalcut::FListViewModel::ROOT );
+
+  // The row count is reread on reset
+  model.rows = 8;
+  CPPUNIT_ASSERT ( tree.getCount() == 5 );
+  tree.reset();
+  CPPUNIT_ASSERT ( tree.getCount() == 8 );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::expandTest()
+{
+  TreeModel model{};
+  finalcut::FListViewModelTree tree{&model};
+  CPPUNIT_ASSERT ( tree.getCount() == 10 );
+  CPPUNIT_ASSERT ( tree.getLine(2).node == 3 );
+  CPPUNIT_ASSERT ( tree.getLine(2).expandable );
+  CPPUNIT_ASSERT ( ! tree.getLine(2).expanded );
+
+  // Expand node 3
+  CPPUNIT_ASSERT ( tree.expand(2) );
+  CPPUNIT_ASSERT ( ! tree.expand(2) );
+  CPPUNIT_ASSERT ( tree.getCount() == 20 );
+  CPPUNIT_ASSERT ( tree.getLine(2).expanded );
+
+  // Children of node 3 on the lines 3 to 12
+  for (std::size_t i{0}; i < 10; i++)
+  {
+    const auto line = tree.getLine(3 + i);
+    CPPUNIT_ASSERT ( line.node == 31 + i );
+    CPPUNIT_ASSERT ( line.row == i );
+    CPPUNIT_ASSERT ( line.depth == 1 );
+    CPPUNIT_ASSERT ( line.parent_line == 2 );
+  }
+
+  // The following top-level rows
+  CPPUNIT_ASSERT ( tree.getLine(13).node == 4 );
+  CPPUNIT_ASSERT ( tree.getLine(13).depth == 0 );
+  CPPUNIT_ASSERT ( tree.getLine(13).parent_line == -1 );
+  CPPUNIT_ASSERT ( tree.getLine(19).node == 10 );
+
+  // Expand node 1 in front of node 3
+  CPPUNIT_ASSERT ( tree.expand(0) );
+  CPPUNIT_ASSERT ( tree.getCount() == 30 );
+  CPPUNIT_ASSERT ( tree.getLine(1).node == 11 );
+  CPPUNIT_ASSERT ( tree.getLine(10).node == 20 );
+  CPPUNIT_ASSERT ( tree.getLine(11).node == 2 );
+  CPPUNIT_ASSERT ( tree.getLine(12).node == 3 );
+  CPPUNIT_ASSERT ( tree.getLine(13).node == 31 );
+  CPPUNIT_ASSERT ( tree.getLine(13).parent_line == 12 );
+  CPPUNIT_ASSERT ( tree.getLine(23).node == 4 );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::nestedExpandTest()
+{
+  TreeModel model{};
+  finalcut::FListViewModelTree tree{&model};
+  CPPUNIT_ASSERT ( tree.expand(9) );   // Node 10
+  CPPUNIT_ASSERT ( tree.expand(19) );  // Node 110
+  CPPUNIT_ASSERT ( tree.getCount() == 30 );
+
+  const auto deepest = tree.getLine(29);
+  CPPUNIT_ASSERT ( deepest.node == 1110 );
+  CPPUNIT_ASSERT ( deepest.depth == 2 );
+  CPPUNIT_ASSERT ( deepest.parent_line == 19 );
+  CPPUNIT_ASSERT ( ! deepest.expandable );
+  CPPUNIT_ASSERT ( ! tree.expand(29) );
+
+  // Expand node 102 above the expanded node 110
+  CPPUNIT_ASSERT ( tree.getLine(11).node == 102 );
+  CPPUNIT_ASSERT ( tree.expand(11) );
+  CPPUNIT_ASSERT ( tree.getCount() == 40 );
+  CPPUNIT_ASSERT ( tree.getLine(12).node == 1021 );
+  CPPUNIT_ASSERT ( tree.getLine(12).parent_line == 11 );
+  CPPUNIT_ASSERT ( tree.getLine(22).node == 103 );
+  CPPUNIT_ASSERT ( tree.getLine(29).node == 110 );
+  CPPUNIT_ASSERT ( tree.getLine(29).parent_line == 9 );
+  CPPUNIT_ASSERT ( tree.getLine(39).node == 1110 );
+  CPPUNIT_ASSERT ( tree.getLine(39).parent_line == 29 );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::collapseTest()
+{
+  TreeModel model{};
+  finalcut::FListViewModelTree tree{&model};
+  CPPUNIT_ASSERT ( tree.expand(0) );  // Node 1
+  CPPUNIT_ASSERT ( tree.expand(1) );  // Node 11
+  CPPUNIT_ASSERT ( tree.getCount() == 30 );
+  CPPUNIT_ASSERT ( ! tree.collapse(2) );
+
+  // Collapsing a node hides its expanded descendants
+  CPPUNIT_ASSERT ( tree.collapse(0) );
+  CPPUNIT_ASSERT ( ! tree.collapse(0) );
+  CPPUNIT_ASSERT ( tree.getCount() == 10 );
+  CPPUNIT_ASSERT ( tree.getLine(1).node == 2 );
+
+  // They are collapsed when the node is expanded again
+  CPPUNIT_ASSERT ( tree.expand(0) );
+  CPPUNIT_ASSERT ( tree.getCount() == 20 );
+  CPPUNIT_ASSERT ( ! tree.getLine(1).expanded );
+
+  // Reset collapses all nodes
+  CPPUNIT_ASSERT ( tree.expand(1) );
+  tree.reset();
+  CPPUNIT_ASSERT ( tree.getCount() == 10 );
+  CPPUNIT_ASSERT ( ! tree.getLine(0).expanded );
+}
+
+//----------------------------------------------------------------------
+void FListViewModelTest::largeModelTest()
+{
+  // The tree only stores expanded nodes,
+  // so the number of rows is not limited by memory
+
+  FlatModel model{std::size_t(1) << 40};
+  finalcut::FListViewModelTree tree{&model};
+  CPPUNIT_ASSERT ( tree.getCount() == std::size_t(1) << 40 );
+  const auto last = tree.getCount() - 1;
+  CPPUNIT_ASSERT ( tree.getLine(last).node == last );
+  CPPUNIT_ASSERT ( tree.getLine(last).row == last );
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FListViewModelTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -20,6 +20,8 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <string>
+
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -112,6 +114,7 @@ class FMouseTest : public CPPUNIT_NS::TestFixture
 
   private:
     auto insertData (std::initializer_list<char>) -> finalcut::FKeyboard::keybuffer;
+    auto insertData (const std::string&) -> finalcut::FKeyboard::keybuffer;
 
     // Adds code needed to register the test suite
     CPPUNIT_TEST_SUITE (FMouseTest);
@@ -1647,6 +1650,100 @@ void FMouseTest::mouseControlTest()
   CPPUNIT_ASSERT ( ! mouse_control.isMoved() );
 
   mouse_control.disable();
+
+  // Mouse event coalescing
+  finalcut::FMouseControl coalescing_control;
+  int number_of_events{0};
+  int wheel_delta{0};
+  finalcut::FPoint last_pos{};
+  auto coalescing = [&number_of_events, &wheel_delta, &last_pos] (const finalcut::FMouseData& md)
+                    {
+                      number_of_events++;
+                      last_pos = md.getPos();
+                      wheel_delta = md.isWheel() ? md.getWheelDelta() : 0;
+                    };
+  finalcut::FMouseCommand coalescing_cmd (coalescing);
+  coalescing_control.setEventCommand (coalescing_cmd);
+  coalescing_control.setMaxWidth(100);
+  coalescing_control.setMaxHeight(40);
+  CPPUNIT_ASSERT ( ! coalescing_control.isEventCoalescing() );
+  CPPUNIT_ASSERT ( coalescing_control.getDroppedMoveCount() == 0 );
+  CPPUNIT_ASSERT ( coalescing_control.getMergedWheelCount() == 0 );
+
+  auto sgr_input = [this, &coalescing_control] (const std::string& s)
+  {
+    auto rawdata = insertData(s);
+    coalescing_control.setRawData (finalcut::FMouse::MouseType::Sgr, rawdata);
+    coalescing_control.processEvent (finalcut::FObjectTimer::getCurrentTime());
+  };
+
+  auto drag = [&sgr_input] ()
+  {
+    sgr_input ("\033[<0;10;5M");  // Left button pressed
+
+    for (int x{11}; x <= 20; x++)  // Ten motion reports
+      sgr_input ("\033[<32;" + std::to_string(x) + ";5M");
+  };
+
+  // Without coalescing every motion report is dispatched
+  drag();
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 11 );
+  CPPUNIT_ASSERT ( last_pos == finalcut::FPoint(20, 5) );
+  sgr_input ("\033[<0;20;5m");  // Left button released
+  coalescing_control.processQueuedInput();
+  number_of_events = 0;
+
+  // Consecutive motion reports are merged into the latest position
+  coalescing_control.setEventCoalescing();
+  CPPUNIT_ASSERT ( coalescing_control.isEventCoalescing() );
+  drag();
+  CPPUNIT_ASSERT ( coalescing_control.getDroppedMoveCount() == 9 );
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 2 );  // Press + one motion
+  CPPUNIT_ASSERT ( last_pos == finalcut::FPoint(20, 5) );
+  sgr_input ("\033[<0;20;5m");
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 3 );
+
+  // Wheel steps at the same position are added up
+  number_of_events = 0;
+
+  for (int i{0}; i < 5; i++)
+    sgr_input ("\033[<64;20;5M");  // Wheel up
+
+  sgr_input ("\033[<65;20;5M");  // Wheel down
+  sgr_input ("\033[<65;21;5M");  // Wheel down on another position
+  CPPUNIT_ASSERT ( coalescing_control.getMergedWheelCount() == 4 );
+  CPPUNIT_ASSERT ( coalescing_control.hasDataInQueue() );
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 3 );
+  CPPUNIT_ASSERT ( wheel_delta == 1 );
+
+  number_of_events = 0;
+
+  for (int i{0}; i < 3; i++)
+    sgr_input ("\033[<64;20;5M");
+
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 1 );
+  CPPUNIT_ASSERT ( wheel_delta == 3 );
+  CPPUNIT_ASSERT ( coalescing_control.getMergedWheelCount() == 6 );
+
+  // Already dispatched events are not changed
+  number_of_events = 0;
+  sgr_input ("\033[<64;20;5M");
+  coalescing_control.processQueuedInput();
+  sgr_input ("\033[<64;20;5M");
+  coalescing_control.processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_events == 2 );
+  CPPUNIT_ASSERT ( wheel_delta == 1 );
+
+  coalescing_control.resetCoalescingCounters();
+  CPPUNIT_ASSERT ( coalescing_control.getDroppedMoveCount() == 0 );
+  CPPUNIT_ASSERT ( coalescing_control.getMergedWheelCount() == 0 );
+  coalescing_control.unsetEventCoalescing();
+  CPPUNIT_ASSERT ( ! coalescing_control.isEventCoalescing() );
 }
 
 //----------------------------------------------------------------------
@@ -1660,6 +1757,17 @@ auto FMouseTest::insertData (std::initializer_list<char> list) -> finalcut::FKey
   return buffer;
 }
 
+//----------------------------------------------------------------------
+auto FMouseTest::insertData (const std::string& str) -> finalcut::FKeyboard::keybuffer
+{
+  finalcut::FKeyboard::keybuffer buffer;
+
+  for (const char& ch : str)
+    buffer.push(ch);
+
+  return buffer;
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FMouseTest);
 
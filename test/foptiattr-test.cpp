@@ -1114,7 +1114,7 @@ void FOptiAttrTest::vt100Test()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to)
                         , CSI "0m\017$<2>" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
@@ -2057,7 +2057,7 @@ void FOptiAttrTest::rxvtTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to)
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
@@ -2527,7 +2527,7 @@ void FOptiAttrTest::linuxTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to)
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
@@ -3002,7 +3002,7 @@ void FOptiAttrTest::puttyTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to)
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
@@ -3473,7 +3473,7 @@ void FOptiAttrTest::teratermTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to)
                         , CSI "0m\017$<2>" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
@@ -3928,7 +3928,7 @@ void FOptiAttrTest::ibmColorTest()
   CPPUNIT_ASSERT ( from != to );
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to), "" );
   CPPUNIT_ASSERT ( from == to );
-  CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+  CPPUNIT_ASSERT ( oa.isFakeInvisible(to) );
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 
   // Invisible off (with default colors)
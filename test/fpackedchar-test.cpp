@@ -0,0 +1,287 @@
+/***********************************************************************
+* fpackedchar-test.cpp - FPackedCharBuffer unit tests                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2023 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FPackedCharTest
+//----------------------------------------------------------------------
+
+class FPackedCharTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FPackedCharTest() = default;
+
+  protected:
+    void classNameTest();
+    void sizeTest();
+    void graphemeTableTest();
+    void packTest();
+    void compareTest();
+    void assignTest();
+    void moveTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FPackedCharTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (sizeTest);
+    CPPUNIT_TEST (graphemeTableTest);
+    CPPUNIT_TEST (packTest);
+    CPPUNIT_TEST (compareTest);
+    CPPUNIT_TEST (assignTest);
+    CPPUNIT_TEST (moveTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+
+//----------------------------------------------------------------------
+void FPackedCharTest::classNameTest()
+{
+  const finalcut::FGraphemeTable table;
+  const finalcut::FString& classname1 = table.getClassName();
+  CPPUNIT_ASSERT ( classname1 == "FGraphemeTable" );
+
+  const finalcut::FPackedCharBuffer buffer;
+  const finalcut::FString& classname2 = buffer.getClassName();
+  CPPUNIT_ASSERT ( classname2 == "FPackedCharBuffer" );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::sizeTest()
+{
+  CPPUNIT_ASSERT ( sizeof(finalcut::FPackedChar) == 12 );
+  CPPUNIT_ASSERT ( sizeof(finalcut::FPackedChar) < sizeof(finalcut::FChar) );
+  CPPUNIT_ASSERT ( sizeof(finalcut::FChar) == 28 );
+
+  finalcut::FPackedCharBuffer buffer;
+  CPPUNIT_ASSERT ( buffer.getSize() == 0 );
+  buffer.resize(80 * 25);
+  CPPUNIT_ASSERT ( buffer.getSize() == 2000 );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::graphemeTableTest()
+{
+  finalcut::FGraphemeTable table;
+  CPPUNIT_ASSERT ( table.getSize() == 0 );
+
+  const finalcut::FUnicode cluster1{{ L'e', L'\U00000301', L'\0', L'\0', L'\0' }};
+  const finalcut::FUnicode cluster2{{ L'a', L'\U00000300', L'\0', L'\0', L'\0' }};
+  const finalcut::FUnicode cluster3{{ L'e', L'\U00000301', L'\0', L'x', L'y' }};
+  const auto code1 = table.intern(cluster1);
+  const auto code2 = table.intern(cluster2);
+  CPPUNIT_ASSERT ( table.getSize() == 2 );
+  CPPUNIT_ASSERT ( finalcut::FGraphemeTable::isCluster(code1) );
+  CPPUNIT_ASSERT ( finalcut::FGraphemeTable::isCluster(code2) );
+  CPPUNIT_ASSERT ( code1 != code2 );
+  CPPUNIT_ASSERT ( ! finalcut::FGraphemeTable::isCluster(uInt32(L'A')) );
+
+  // Characters after the terminating null are ignored
+  CPPUNIT_ASSERT ( table.intern(cluster3) == code1 );
+  CPPUNIT_ASSERT ( table.intern(cluster1) == code1 );
+  CPPUNIT_ASSERT ( table.getSize() == 2 );
+  CPPUNIT_ASSERT ( table.getCluster(code1) == cluster1 );
+  CPPUNIT_ASSERT ( table.getCluster(code2) == cluster2 );
+
+  table.clear();
+  CPPUNIT_ASSERT ( table.getSize() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::packTest()
+{
+  finalcut::FPackedCharBuffer buffer;
+  buffer.resize(2);
+
+  finalcut::FChar fchar{};
+  fchar.ch = {{ L'A', L'\0', L'\0', L'\0', L'\0' }};
+  fchar.fg_color = finalcut::FColor::Red;
+  fchar.bg_color = finalcut::FColor::White;
+  fchar.attr.bit.bold = true;
+  fchar.attr.bit.transparent = true;
+  fchar.attr.bit.char_width = 1;
+  auto packed = buffer.pack(fchar);
+  CPPUNIT_ASSERT ( packed.code == uInt32(L'A') );
+  CPPUNIT_ASSERT ( packed.fg_color == finalcut::FColor::Red );
+  CPPUNIT_ASSERT ( packed.bg_color == finalcut::FColor::White );
+  CPPUNIT_ASSERT ( buffer.getGraphemeTable().getSize() == 0 );
+
+  // Multi-code point character cluster
+  fchar.ch = {{ L'n', L'\U00000303', L'\0', L'\0', L'\0' }};
+  packed = buffer.pack(fchar);
+  CPPUNIT_ASSERT ( finalcut::FGraphemeTable::isCluster(packed.code) );
+  CPPUNIT_ASSERT ( buffer.getGraphemeTable().getSize() == 1 );
+
+  // Unpacking restores all compared properties
+  std::vector<finalcut::FChar> line{2, fchar};
+  line[0].ch = {{ L'Z', L'\0', L'\0', L'\0', L'\0' }};
+  line[1].attr.bit.fullwidth_padding = true;
+  buffer.assign(line);
+  const auto fchar0 = buffer.unpack(0);
+  const auto fchar1 = buffer.unpack(1);
+  CPPUNIT_ASSERT ( fchar0 == line[0] );
+  CPPUNIT_ASSERT ( fchar1 == line[1] );
+  CPPUNIT_ASSERT ( fchar1.ch[0] == L'n' );
+  CPPUNIT_ASSERT ( fchar1.ch[1] == L'\U00000303' );
+  CPPUNIT_ASSERT ( fchar1.attr.bit.bold );
+  CPPUNIT_ASSERT ( fchar1.attr.bit.transparent );
+  CPPUNIT_ASSERT ( fchar1.attr.bit.fullwidth_padding );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::compareTest()
+{
+  finalcut::FChar fchar{};
+  fchar.ch = {{ L'x', L'\0', L'\0', L'\0', L'\0' }};
+  fchar.fg_color = finalcut::FColor::Blue;
+  fchar.bg_color = finalcut::FColor::Black;
+  std::vector<finalcut::FChar> line{3, fchar};
+  line[1].ch = {{ L'u', L'\U00000308', L'\0', L'\0', L'\0' }};
+  line[2].ch = {{ L'\0', L'\0', L'\0', L'\0', L'\0' }};
+  line[2].attr.bit.fullwidth_padding = true;
+
+  finalcut::FPackedCharBuffer buffer;
+  buffer.assign(line);
+  CPPUNIT_ASSERT ( buffer.getSize() == 3 );
+  CPPUNIT_ASSERT ( buffer.isEqual(0, line[0]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(1, line[1]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(2, line[2]) );
+  CPPUNIT_ASSERT ( ! buffer.isEqual(0, line[1]) );
+  CPPUNIT_ASSERT ( ! buffer.isEqual(1, line[0]) );
+  CPPUNIT_ASSERT ( ! buffer.isEqual(2, line[0]) );
+
+  // The status flags "no_changes", "printed" and "char_width"
+  // are not part of the comparison
+  auto status_char = line[0];
+  status_char.attr.bit.no_changes = true;
+  status_char.attr.bit.printed = true;
+  status_char.attr.bit.char_width = 2;
+  CPPUNIT_ASSERT ( status_char == line[0] );
+  CPPUNIT_ASSERT ( buffer.isEqual(0, status_char) );
+
+  auto color_char = line[0];
+  color_char.fg_color = finalcut::FColor::Green;
+  CPPUNIT_ASSERT ( ! buffer.isEqual(0, color_char) );
+  color_char = line[0];
+  color_char.bg_color = finalcut::FColor::Green;
+  CPPUNIT_ASSERT ( ! buffer.isEqual(0, color_char) );
+
+  auto attr_char = line[0];
+  attr_char.attr.bit.underline = true;
+  CPPUNIT_ASSERT ( ! buffer.isEqual(0, attr_char) );
+  attr_char = line[0];
+  attr_char.attr.bit.inherit_background = true;
+  CPPUNIT_ASSERT ( ! buffer.isEqual(0, attr_char) );
+
+  // Characters after the terminating null are ignored
+  auto stale_char = line[0];
+  stale_char.ch[2] = L'q';
+  CPPUNIT_ASSERT ( buffer.isEqual(0, stale_char) );
+  stale_char = line[1];
+  stale_char.ch[3] = L'q';
+  CPPUNIT_ASSERT ( buffer.isEqual(1, stale_char) );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::assignTest()
+{
+  finalcut::FChar fchar{};
+  fchar.ch = {{ L'o', L'\U00000308', L'\0', L'\0', L'\0' }};
+  std::vector<finalcut::FChar> screen{100, fchar};
+  finalcut::FPackedCharBuffer buffer;
+  buffer.assign(screen);
+
+  // Identical clusters share one table entry
+  CPPUNIT_ASSERT ( buffer.getSize() == 100 );
+  CPPUNIT_ASSERT ( buffer.getGraphemeTable().getSize() == 1 );
+
+  // Each assignment rebuilds the grapheme table
+  screen[0].ch = {{ L'a', L'\U00000308', L'\0', L'\0', L'\0' }};
+  buffer.assign(screen);
+  CPPUNIT_ASSERT ( buffer.getGraphemeTable().getSize() == 2 );
+  screen.assign(100, finalcut::FChar{});
+  buffer.assign(screen);
+  CPPUNIT_ASSERT ( buffer.getGraphemeTable().getSize() == 0 );
+  CPPUNIT_ASSERT ( buffer.isEqual(99, finalcut::FChar{}) );
+}
+
+//----------------------------------------------------------------------
+void FPackedCharTest::moveTest()
+{
+  // Three lines with three characters
+  std::vector<finalcut::FChar> screen{9, finalcut::FChar{}};
+
+  for (std::size_t i{0}; i < screen.size(); i++)
+    screen[i].ch[0] = wchar_t(L'1' + i / 3);
+
+  finalcut::FPackedCharBuffer buffer;
+  buffer.assign(screen);
+
+  // Scroll up one line
+  buffer.move (3, 0, 6);
+  CPPUNIT_ASSERT ( buffer.isEqual(0, screen[3]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(2, screen[5]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(3, screen[6]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(8, screen[8]) );
+
+  // Scroll down one line
+  buffer.move (0, 3, 6);
+  CPPUNIT_ASSERT ( buffer.isEqual(0, screen[3]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(3, screen[3]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(6, screen[6]) );
+  CPPUNIT_ASSERT ( buffer.isEqual(8, screen[8]) );
+
+  // Clear the first line
+  finalcut::FChar blank{};
+  blank.ch[0] = L' ';
+  buffer.fill (0, 3, blank);
+  CPPUNIT_ASSERT ( buffer.isEqual(0, blank) );
+  CPPUNIT_ASSERT ( buffer.isEqual(2, blank) );
+  CPPUNIT_ASSERT ( buffer.isEqual(3, screen[3]) );
+
+  // Ranges outside the buffer are ignored
+  buffer.move (4, 0, 6);
+  buffer.fill (7, 3, blank);
+  CPPUNIT_ASSERT ( buffer.isEqual(0, blank) );
+  CPPUNIT_ASSERT ( buffer.isEqual(8, screen[8]) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FPackedCharTest);
+
+// The general unit test main part
+#include <main-test.inc>
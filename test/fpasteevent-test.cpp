@@ -0,0 +1,249 @@
+/***********************************************************************
+* fpasteevent-test.cpp - FPasteEvent widget unit tests                 *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FPasteEventTest
+//----------------------------------------------------------------------
+
+class FPasteEventTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FPasteEventTest() = default;
+
+  protected:
+    void classNameTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FPasteEventTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Methods
+    void lineEditTest (finalcut::FWidget*);
+    void lineEditLimitTest (finalcut::FWidget*);
+    void textViewTest (finalcut::FWidget*);
+    void comboBoxTest (finalcut::FWidget*);
+    static auto paste (finalcut::FWidget&, const finalcut::FString&) -> bool;
+
+    // Data member
+    finalcut::FVTerm fvterm{finalcut::outputClass<finalcut::FHeadlessOutput>{}};
+};
+
+//----------------------------------------------------------------------
+void FPasteEventTest::classNameTest()
+{
+  finalcut::FPasteEvent ev{finalcut::Event::Paste, "text"};
+  CPPUNIT_ASSERT ( ev.getType() == finalcut::Event::Paste );
+  CPPUNIT_ASSERT ( ev.getText() == "text" );
+  CPPUNIT_ASSERT ( ! ev.isAccepted() );
+  ev.accept();
+  CPPUNIT_ASSERT ( ev.isAccepted() );
+  ev.ignore();
+  CPPUNIT_ASSERT ( ! ev.isAccepted() );
+}
+
+//----------------------------------------------------------------------
+void FPasteEventTest::applicationTest()
+{
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  // The application object takes only one child
+  finalcut::FDialog dialog{&fapp};
+  dialog.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{40, 20});
+  dialog.show();
+  lineEditTest (&dialog);
+  lineEditLimitTest (&dialog);
+  textViewTest (&dialog);
+  comboBoxTest (&dialog);
+}
+
+//----------------------------------------------------------------------
+void FPasteEventTest::lineEditTest (finalcut::FWidget* parent)
+{
+  finalcut::FLineEdit lineedit{parent};
+  lineedit.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 1});
+  int changed{0};
+  lineedit.addCallback ("changed", [&changed] () { changed++; });
+  lineedit.setText ("ad");
+  lineedit.setCursorPosition (2);
+  CPPUNIT_ASSERT ( lineedit.getCursorPosition() == 1 );
+
+  // The text is inserted at the cursor in one step
+  CPPUNIT_ASSERT ( paste(lineedit, "bc") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abcd" );
+  CPPUNIT_ASSERT ( lineedit.getCursorPosition() == 3 );
+  CPPUNIT_ASSERT ( changed == 1 );
+
+  // Only the first line is used, tabs become spaces
+  // and control characters are removed
+  CPPUNIT_ASSERT ( paste(lineedit, "1\t2\0333\n4\n5") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abc1 23d" );
+  CPPUNIT_ASSERT ( lineedit.getCursorPosition() == 7 );
+  CPPUNIT_ASSERT ( changed == 2 );
+
+  // Nothing to insert
+  CPPUNIT_ASSERT ( paste(lineedit, "\nxyz") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abc1 23d" );
+  CPPUNIT_ASSERT ( changed == 2 );
+
+  // The input filter applies to pasted characters
+  lineedit.setText ("");
+  lineedit.setInputFilter ("[0-9]");
+  CPPUNIT_ASSERT ( paste(lineedit, "a1b2c3") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "123" );
+  lineedit.clearInputFilter();
+
+  // Overwrite mode replaces the characters after the cursor
+  finalcut::FKeyEvent key_ev{finalcut::Event::KeyPress, finalcut::FKey::Insert};
+  lineedit.onKeyPress (&key_ev);
+  lineedit.setText ("abcdef");
+  lineedit.setCursorPosition (3);
+  CPPUNIT_ASSERT ( paste(lineedit, "XY") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abXYef" );
+  CPPUNIT_ASSERT ( lineedit.getCursorPosition() == 4 );
+  lineedit.onKeyPress (&key_ev);
+
+  // A read-only field ignores the paste event
+  lineedit.setReadOnly();
+  CPPUNIT_ASSERT ( ! paste(lineedit, "xyz") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abXYef" );
+}
+
+//----------------------------------------------------------------------
+void FPasteEventTest::lineEditLimitTest (finalcut::FWidget* parent)
+{
+  finalcut::FLineEdit lineedit{parent};
+  lineedit.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 1});
+  lineedit.setMaxLength (5);
+  lineedit.setText ("abc");
+  lineedit.setCursorPosition (4);
+
+  // The pasted text is cut to the maximum length
+  CPPUNIT_ASSERT ( paste(lineedit, "defgh") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abcde" );
+  CPPUNIT_ASSERT ( lineedit.getCursorPosition() == 5 );
+
+  // A full field stays unchanged
+  CPPUNIT_ASSERT ( paste(lineedit, "x") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abcde" );
+
+  // In overwrite mode, only the characters up to the
+  // maximum length can be replaced
+  finalcut::FKeyEvent key_ev{finalcut::Event::KeyPress, finalcut::FKey::Insert};
+  lineedit.onKeyPress (&key_ev);
+  lineedit.setCursorPosition (4);
+  CPPUNIT_ASSERT ( paste(lineedit, "XYZ") );
+  CPPUNIT_ASSERT ( lineedit.getText() == "abcXY" );
+}
+
+//----------------------------------------------------------------------
+void FPasteEventTest::textViewTest (finalcut::FWidget* parent)
+{
+  finalcut::FTextView textview{parent};
+  textview.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 5});
+  textview.append ("first");
+  textview.show();  // Scrolling requires a visible widget
+  CPPUNIT_ASSERT ( textview.getRows() == 1 );
+
+  // All lines of the pasted text are appended in one step
+  CPPUNIT_ASSERT ( paste(textview, "line 1\nline 2\nline 3") );
+  CPPUNIT_ASSERT ( textview.getRows() == 4 );
+  CPPUNIT_ASSERT ( textview.getLine(0).text == "first" );
+  CPPUNIT_ASSERT ( textview.getLine(1).text == "line 1" );
+  CPPUNIT_ASSERT ( textview.getLine(3).text == "line 3" );
+
+  // A long paste scrolls to the end of the text
+  finalcut::FString long_text{};
+
+  for (int i{1}; i <= 20; i++)
+    long_text << "row " << i << '\n';
+
+  CPPUNIT_ASSERT ( paste(textview, long_text) );
+  CPPUNIT_ASSERT ( textview.getLine(4).text == "row 1" );
+  CPPUNIT_ASSERT ( textview.getLine(23).text == "row 20" );
+  CPPUNIT_ASSERT ( textview.getScrollPos().getY() > 0 );
+  CPPUNIT_ASSERT ( textview.getScrollPos().getY()
+                   + int(textview.getTextVisibleSize().getHeight())
+                   >= int(textview.getRows()) );
+}
+
+//----------------------------------------------------------------------
+void FPasteEventTest::comboBoxTest (finalcut::FWidget* parent)
+{
+  finalcut::FComboBox combobox{parent};
+  combobox.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 1});
+  combobox.insert ("one");
+  combobox.insert ("two");
+  combobox.setEditable();
+
+  // The pasted text goes into the input field
+  combobox.setText ("");
+  CPPUNIT_ASSERT ( paste(combobox, "three\nfour") );
+  CPPUNIT_ASSERT ( combobox.getText() == "three" );
+  CPPUNIT_ASSERT ( combobox.getCount() == 2 );
+
+  // A disabled combo box ignores the paste event
+  combobox.setDisable();
+  CPPUNIT_ASSERT ( ! paste(combobox, "five") );
+  CPPUNIT_ASSERT ( combobox.getText() == "three" );
+
+  // A combo box that is not editable has a read-only input field
+  combobox.setEnable();
+  combobox.unsetEditable();
+  CPPUNIT_ASSERT ( ! paste(combobox, "six") );
+  CPPUNIT_ASSERT ( combobox.getText() == "three" );
+}
+
+//----------------------------------------------------------------------
+auto FPasteEventTest::paste ( finalcut::FWidget& widget
+                            , const finalcut::FString& text ) -> bool
+{
+  // Returns true if the widget accepted the pasted text
+
+  finalcut::FPasteEvent ev{finalcut::Event::Paste, text};
+  finalcut::FApplication::sendEvent (&widget, &ev);
+  return ev.isAccepted();
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FPasteEventTest);
+
+// The general unit test main part
+#include <main-test.inc>
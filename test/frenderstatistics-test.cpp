@@ -0,0 +1,285 @@
+/***********************************************************************
+* frenderstatistics-test.cpp - FRenderStatistics unit tests            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+using Phase = finalcut::FRenderStatistics::Phase;
+using Counter = finalcut::FRenderStatistics::Counter;
+
+//----------------------------------------------------------------------
+// class FVTerm_headless
+//----------------------------------------------------------------------
+
+class FVTerm_headless : public finalcut::FVTerm
+{
+  public:
+    // Constructor
+    FVTerm_headless()
+      : finalcut::FVTerm{finalcut::outputClass<finalcut::FHeadlessOutput>{}}
+    {
+      initTerminal();
+      finishDrawing();
+    }
+
+    // Using-declarations
+    using finalcut::FVTerm::print;
+    using finalcut::FVTerm::processTerminalUpdate;
+};
+
+
+//----------------------------------------------------------------------
+// class FRenderStatisticsTest
+//----------------------------------------------------------------------
+
+class FRenderStatisticsTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FRenderStatisticsTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void counterTest();
+    void phaseTest();
+    void frameHandlerTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FRenderStatisticsTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (counterTest);
+    CPPUNIT_TEST (phaseTest);
+    CPPUNIT_TEST (frameHandlerTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Method
+    static void sleep (int);
+
+    // Data member
+    FVTerm_headless fvterm{};
+};
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::classNameTest()
+{
+  const finalcut::FRenderStatistics stats{};
+  const finalcut::FString& classname = stats.getClassName();
+  CPPUNIT_ASSERT ( classname == "FRenderStatistics" );
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::noArgumentTest()
+{
+  const finalcut::FRenderStatistics stats{};
+  CPPUNIT_ASSERT ( ! stats.isEnabled() );
+  CPPUNIT_ASSERT ( ! stats.isLogging() );
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().number == 0 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getTotalTime() == 0 );
+  CPPUNIT_ASSERT ( stats.getTotal().getCount(Counter::Events) == 0 );
+  CPPUNIT_ASSERT ( std::string(stats.getPhaseName(Phase::Input)) == "input" );
+  CPPUNIT_ASSERT ( std::string(stats.getPhaseName(Phase::Flush)) == "flush" );
+  CPPUNIT_ASSERT ( std::string(stats.getPhaseName(Phase::Count)) == "" );
+  CPPUNIT_ASSERT ( std::string(stats.getCounterName(Counter::CopiedCells)) == "copied cells" );
+  CPPUNIT_ASSERT ( std::string(stats.getCounterName(Counter::Count)) == "" );
+
+  // The application-wide instance is disabled by default
+  const auto& instance = finalcut::FVTerm::getRenderStatistics();
+  CPPUNIT_ASSERT ( &instance == &finalcut::FRenderStatistics::getInstance() );
+  CPPUNIT_ASSERT ( ! instance.isEnabled() );
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::counterTest()
+{
+  finalcut::FRenderStatistics stats{};
+
+  // Disabled statistics ignore all counts
+  stats.count (Counter::Events);
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 0 );
+
+  stats.setEnable();
+  CPPUNIT_ASSERT ( stats.isEnabled() );
+  stats.count (Counter::Events);
+  stats.count (Counter::Events);
+  stats.count (Counter::WrittenBytes, 512);
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 1 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().number == 1 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getCount(Counter::Events) == 2 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getCount(Counter::WrittenBytes) == 512 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getCount(Counter::UpdatedLines) == 0 );
+
+  // A frame without data is not counted
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 1 );
+
+  stats.count (Counter::WrittenBytes, 100);
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 2 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getCount(Counter::Events) == 0 );
+  CPPUNIT_ASSERT ( stats.getLastFrame().getCount(Counter::WrittenBytes) == 100 );
+  CPPUNIT_ASSERT ( stats.getTotal().getCount(Counter::Events) == 2 );
+  CPPUNIT_ASSERT ( stats.getTotal().getCount(Counter::WrittenBytes) == 612 );
+
+  // Counters of a partially measured frame are discarded
+  stats.count (Counter::Events, 10);
+  stats.unsetEnable();
+  stats.setEnable();
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 2 );
+
+  stats.reset();
+  CPPUNIT_ASSERT ( stats.isEnabled() );
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( stats.getTotal().getCount(Counter::WrittenBytes) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::phaseTest()
+{
+  auto& stats = finalcut::FRenderStatistics::getInstance();
+
+  {
+    // No time is measured when disabled
+    finalcut::FRenderStatistics::FPhaseTimer timer{Phase::Draw};
+    sleep(1);
+  }
+
+  stats.setEnable();
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 0 );
+
+  {
+    finalcut::FRenderStatistics::FPhaseTimer event_timer{Phase::Event};
+    sleep(5);
+
+    {
+      // The nested phase pauses the enclosing phase
+      finalcut::FRenderStatistics::FPhaseTimer draw_timer{Phase::Draw};
+      sleep(20);
+    }
+
+    sleep(5);
+  }
+
+  stats.finishFrame();
+  const auto& frame = stats.getLastFrame();
+  const uInt64 ms = 1000000;
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 1 );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Event) >= 10 * ms );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Event) < 20 * ms );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Draw) >= 20 * ms );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Input) == 0 );
+  CPPUNIT_ASSERT ( frame.getTotalTime() == frame.getTime(Phase::Event)
+                                         + frame.getTime(Phase::Draw) );
+
+  // An unbalanced stop has no effect
+  stats.stopPhase();
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 1 );
+  stats.reset();
+  stats.unsetEnable();
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::frameHandlerTest()
+{
+  finalcut::FRenderStatistics stats{};
+  std::string log{};
+  stats.setFrameHandler ( [&log] (const auto& frame)
+                          {
+                            log = finalcut::FRenderStatistics::toString(frame);
+                          }
+                        );
+  stats.setEnable();
+  stats.setLogging();
+  CPPUNIT_ASSERT ( stats.isLogging() );
+  stats.count (Counter::DrawnWidgets, 3);
+  stats.count (Counter::UpdatedLines, 2);
+  stats.finishFrame();
+  CPPUNIT_ASSERT ( log.find("frame 1: input 0 us, timer 0 us") == 0 );
+  CPPUNIT_ASSERT ( log.find("drawn widgets 3, copied cells 0, updated lines 2")
+                   != std::string::npos );
+  stats.unsetLogging();
+  CPPUNIT_ASSERT ( ! stats.isLogging() );
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::applicationTest()
+{
+  // The terminal output of the headless FVTerm object is
+  // only updated with an application object
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  auto& stats = finalcut::FApplication::getRenderStatistics();
+  stats.setEnable();
+  fvterm.print() << finalcut::FPoint{1, 1} << "Statistics";
+  CPPUNIT_ASSERT ( fvterm.processTerminalUpdate() );
+  fvterm.flush();
+  stats.finishFrame();
+
+  const auto& frame = stats.getLastFrame();
+  CPPUNIT_ASSERT ( stats.getFrameCount() == 1 );
+  CPPUNIT_ASSERT ( frame.getCount(Counter::CopiedCells) >= 10 );
+  CPPUNIT_ASSERT ( frame.getCount(Counter::UpdatedLines) == 1 );
+  CPPUNIT_ASSERT ( frame.getCount(Counter::WrittenBytes) > 10 );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Compose) > 0 );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Encode) > 0 );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Flush) > 0 );
+  stats.reset();
+  stats.unsetEnable();
+}
+
+//----------------------------------------------------------------------
+void FRenderStatisticsTest::sleep (int milliseconds)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FRenderStatisticsTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -19,6 +19,8 @@
 * License along with this program.  If not, see                        *
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
+#include <algorithm>
+#include <array>
 #include <cwchar>
 #include <limits>
 #include <memory>
@@ -59,10 +61,12 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     void rgb2ColorIndexTest();
     void isReverseNewFontcharTest();
     void cp437Test();
+    void charEncodeTest();
     void utf8Test();
     void FullWidthHalfWidthTest();
     void combiningCharacterTest();
     void readCursorPosTest();
+    void terminalRepliesTest();
 
   private:
     // Constant
@@ -77,10 +81,12 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (rgb2ColorIndexTest);
     CPPUNIT_TEST (isReverseNewFontcharTest);
     CPPUNIT_TEST (cp437Test);
+    CPPUNIT_TEST (charEncodeTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (FullWidthHalfWidthTest);
     CPPUNIT_TEST (combiningCharacterTest);
     CPPUNIT_TEST (readCursorPosTest);
+    CPPUNIT_TEST (terminalRepliesTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -330,6 +336,47 @@ void FTermFunctionsTest::cp437Test()
   CPPUNIT_ASSERT ( finalcut::unicode_to_cp437(L'⌡') == 0xf5 );
 }
 
+//----------------------------------------------------------------------
+void FTermFunctionsTest::charEncodeTest()
+{
+  const auto& character = finalcut::FCharMap::getCharEncodeMap();
+  constexpr auto NOT_FOUND = finalcut::FCharMap::NOT_FOUND;
+
+  // Every table entry is found at its first position
+  for (std::size_t pos{0}; pos < character.size(); pos++)
+  {
+    const auto c = character[pos].unicode;
+    const auto first = std::find_if ( character.cbegin(), character.cend()
+                                    , [&c] (const auto& entry)
+                                      { return entry.unicode == c; } );
+    const auto first_pos = std::size_t(first - character.cbegin());
+    CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(c) == first_pos );
+  }
+
+  // Characters without an entry
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(L'\0') == NOT_FOUND );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(L'A') == NOT_FOUND );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(L'ä') == NOT_FOUND );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(L'╬') == NOT_FOUND );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(L'\U0001f600') == NOT_FOUND );
+  CPPUNIT_ASSERT ( finalcut::FCharMap::getCharEncodeIndex(wchar_t(0x2500 + 0x10000)) == NOT_FOUND );
+
+  // Encoding of known characters
+  using finalcut::Encoding;
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', Encoding::UTF8) == L'─' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', Encoding::PC) == 0xc4 );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'─', Encoding::ASCII) == L'-' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'£', Encoding::VT100) == L'}' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'£', Encoding::PC) == 0x9c );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'√', Encoding::ASCII) == L'x' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'…', Encoding::PC) == L'.' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(wchar_t(0xe1c4), Encoding::PC) == 0xc4 );
+
+  // Characters without an entry stay unchanged
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'A', Encoding::ASCII) == L'A' );
+  CPPUNIT_ASSERT ( finalcut::FTerm::charEncode(L'ä', Encoding::PC) == L'ä' );
+}
+
 //----------------------------------------------------------------------
 void FTermFunctionsTest::utf8Test()
 {
@@ -704,6 +751,29 @@ void FTermFunctionsTest::utf8Test()
 
   CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(wchar_t(INT_MAX))  // maximum 32-bit value
                    == finalcut::unicode_to_utf8(L'�') );
+
+  //------------------------------
+  // Encoding into a given buffer
+  //------------------------------
+  std::array<char, finalcut::UTF8_MAX_BYTES + 1> buf{};
+  CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(L'A', buf.data()) == 1 );
+  CPPUNIT_ASSERT ( buf[0] == 'A' );
+  CPPUNIT_ASSERT ( buf[1] == '\0' );
+
+  CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(L'ß', buf.data()) == 2 );
+  CPPUNIT_ASSERT ( std::string(buf.data(), 2) == finalcut::unicode_to_utf8(L'ß') );
+  CPPUNIT_ASSERT ( buf[2] == '\0' );
+
+  CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(L'…', buf.data()) == 3 );
+  CPPUNIT_ASSERT ( std::string(buf.data(), 3) == finalcut::unicode_to_utf8(L'…') );
+  CPPUNIT_ASSERT ( buf[3] == '\0' );
+
+  CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(L'🦇', buf.data()) == 4 );
+  CPPUNIT_ASSERT ( std::string(buf.data(), 4) == finalcut::unicode_to_utf8(L'🦇') );
+  CPPUNIT_ASSERT ( buf[4] == '\0' );
+
+  CPPUNIT_ASSERT ( finalcut::unicode_to_utf8(wchar_t(0x200000), buf.data()) == 3 );
+  CPPUNIT_ASSERT ( std::string(buf.data(), 3) == finalcut::unicode_to_utf8(L'�') );
 }
 
 //----------------------------------------------------------------------
@@ -3079,6 +3149,76 @@ void FTermFunctionsTest::readCursorPosTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FTermFunctionsTest::terminalRepliesTest()
+{
+  // Split the replies to a batch of queries
+  auto replies = finalcut::splitTerminalReplies \
+  (
+    "PuTTY"                             // Answerback message
+    "\033[>0;136;0c"                    // Secondary DA
+    "\033]4;0;rgb:0000/0000/0000\a"     // Color name (BEL)
+    "\033]4;15;rgb:ffff/ffff/ffff\033\\"  // Color name (ST)
+    "\033]lTITLE\033\\"                 // Window title
+    "\033[?6c"                          // Primary DA
+  );
+  CPPUNIT_ASSERT ( replies.size() == 6 );
+  CPPUNIT_ASSERT ( replies[0] == "PuTTY" );
+  CPPUNIT_ASSERT ( replies[1] == "\033[>0;136;0c" );
+  CPPUNIT_ASSERT ( replies[2] == "\033]4;0;rgb:0000/0000/0000\a" );
+  CPPUNIT_ASSERT ( replies[3] == "\033]4;15;rgb:ffff/ffff/ffff\033\\" );
+  CPPUNIT_ASSERT ( replies[4] == "\033]lTITLE\033\\" );
+  CPPUNIT_ASSERT ( replies[5] == "\033[?6c" );
+  CPPUNIT_ASSERT ( ! finalcut::isDeviceAttributesReply(replies[0]) );
+  CPPUNIT_ASSERT ( finalcut::isDeviceAttributesReply(replies[1]) );
+  CPPUNIT_ASSERT ( ! finalcut::isDeviceAttributesReply(replies[2]) );
+  CPPUNIT_ASSERT ( ! finalcut::isDeviceAttributesReply(replies[4]) );
+  CPPUNIT_ASSERT ( finalcut::isDeviceAttributesReply(replies[5]) );
+
+  // Incomplete replies at the end are not returned
+  replies = finalcut::splitTerminalReplies ("\033[?6c\033]4;0;rgb:00");
+  CPPUNIT_ASSERT ( replies.size() == 1 );
+  CPPUNIT_ASSERT ( replies[0] == "\033[?6c" );
+  replies = finalcut::splitTerminalReplies ("\033[>0;136");
+  CPPUNIT_ASSERT ( replies.empty() );
+  replies = finalcut::splitTerminalReplies ("\033");
+  CPPUNIT_ASSERT ( replies.empty() );
+  replies = finalcut::splitTerminalReplies ("");
+  CPPUNIT_ASSERT ( replies.empty() );
+
+  // Query a terminal
+  auto& fterm_data = finalcut::FTermData::getInstance();
+  fterm_data.setTermType("xterm");
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    finalcut::FTermios::setCaptureSendCharacters();
+    replies = finalcut::queryTerminal ("\033[>c\033[21t", 1, 600'000);
+    finalcut::FTermios::unsetCaptureSendCharacters();
+    CPPUNIT_ASSERT ( replies.size() == 3 );
+    CPPUNIT_ASSERT ( replies[0] == "\033[>19;312;0c" );
+    CPPUNIT_ASSERT ( replies[1] == "\033]lTITLE\033\\" );
+    CPPUNIT_ASSERT ( replies[2] == "\033[?63;1;2;6;4;6;9;15;22c" );
+
+    closeConEmuStdStreams();
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::xterm);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FTermFunctionsTest);
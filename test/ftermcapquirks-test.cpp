@@ -105,6 +105,7 @@ static tcap_map tcap[] =
   { nullptr, "Ss" },  // set cursor style
   { nullptr, "sf" },  // scroll_forward
   { nullptr, "sr" },  // scroll_reverse
+  { nullptr, "cs" },  // change_scroll_region
   { nullptr, "ti" },  // enter_ca_mode
   { nullptr, "te" },  // exit_ca_mode
   { nullptr, "eA" },  // enable_acs
@@ -71,6 +71,7 @@ class FTermDetectionTest : public CPPUNIT_NS::TestFixture
     void mltermTest();
     void kittyTest();
     void ttytypeTest();
+    void cacheTest();
 
   private:
     // Adds code needed to register the test suite
@@ -102,6 +103,7 @@ class FTermDetectionTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (mltermTest);
     CPPUNIT_TEST (kittyTest);
     CPPUNIT_TEST (ttytypeTest);
+    CPPUNIT_TEST (cacheTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -250,6 +252,8 @@ void FTermDetectionTest::xtermTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( ! detect.hasSynchronizedUpdateSupport() );
+    CPPUNIT_ASSERT ( ! data.hasSynchronizedUpdate() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -1024,6 +1028,7 @@ void FTermDetectionTest::minttyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasSynchronizedUpdateSupport() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -1922,6 +1927,8 @@ void FTermDetectionTest::kittyTest()
     CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
     CPPUNIT_ASSERT ( detect.hasTerminalDetection() );
     CPPUNIT_ASSERT ( ! detect.hasSetCursorStyleSupport() );
+    CPPUNIT_ASSERT ( detect.hasSynchronizedUpdateSupport() );
+    CPPUNIT_ASSERT ( data.hasSynchronizedUpdate() );
     CPPUNIT_ASSERT ( detect.getTermType() == "xterm-kitty" );
     CPPUNIT_ASSERT ( detect.getTermType_256color() == "xterm-256color" );
     CPPUNIT_ASSERT ( detect.getTermType_Answerback() == "xterm-256color" );
@@ -2048,6 +2055,98 @@ void FTermDetectionTest::ttytypeTest()
   rmdir("new-root-dir");
 }
 
+//----------------------------------------------------------------------
+void FTermDetectionTest::cacheTest()
+{
+  const std::string cache_file{"terminal-cache.tmp"};
+  unlink(cache_file.c_str());
+
+  auto& data = finalcut::FTermData::getInstance();
+  finalcut::FTermDetection detect;
+  data.setTermType("xterm");
+  detect.setTerminalDetection(true);
+  CPPUNIT_ASSERT ( ! detect.hasTerminalDetectionCache() );
+  detect.setTerminalDetectionCache(true);
+  detect.setCacheFileName(cache_file);
+  CPPUNIT_ASSERT ( detect.hasTerminalDetectionCache() );
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // (gdb) set follow-fork-mode child
+    setenv ("TERM", "xterm", 1);
+    unsetenv("TERMCAP");
+    unsetenv("TERM_PROGRAM");
+    unsetenv("TERM_PROGRAM_VERSION");
+    unsetenv("COLORTERM");
+    unsetenv("COLORFGBG");
+    unsetenv("VTE_VERSION");
+    unsetenv("XTERM_VERSION");
+    unsetenv("ROXTERM_ID");
+    unsetenv("KONSOLE_DBUS_SESSION");
+    unsetenv("KONSOLE_DCOP");
+    unsetenv("TMUX");
+    unsetenv("KITTY_WINDOW_ID");
+
+    // The first detection queries the terminal
+    detect.detect();
+    CPPUNIT_ASSERT ( ! detect.isCachedResult() );
+    CPPUNIT_ASSERT ( detect.getTermType() == "putty-256color" );
+    CPPUNIT_ASSERT ( detect.getAnswerbackString() == "PuTTY" );
+    CPPUNIT_ASSERT ( detect.getSecDAString() == "\033[>0;136;0c" );
+
+    std::ifstream cache (cache_file);
+    std::string entry{};
+    CPPUNIT_ASSERT ( std::getline(cache, entry) );
+    CPPUNIT_ASSERT ( entry == "xterm\t\t\t\t\t\t?6c\tPuTTY\t0;136;0c\t256\t0" );
+    cache.close();
+
+    // The second detection uses the cached replies
+    setenv ("TERM", "xterm", 1);
+    detect.detect();
+    CPPUNIT_ASSERT ( detect.isCachedResult() );
+    CPPUNIT_ASSERT ( data.isTermType(finalcut::FTermType::putty) );
+    CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
+    CPPUNIT_ASSERT ( detect.getTermType() == "putty-256color" );
+    CPPUNIT_ASSERT ( detect.getAnswerbackString() == "PuTTY" );
+    CPPUNIT_ASSERT ( detect.getSecDAString() == "\033[>0;136;0c" );
+
+    // Another terminal program is not in the cache
+    setenv ("TERM", "xterm", 1);
+    setenv ("TERM_PROGRAM", "other", 1);
+    detect.detect();
+    CPPUNIT_ASSERT ( ! detect.isCachedResult() );
+
+    // A terminal with a different DA1 reply does not get the entry
+    std::ofstream foreign_cache (cache_file);
+    foreign_cache << "xterm\t\t\t\t\t\t?1;2c\tfoo\t1;2;0c\t88\t1\n";
+    foreign_cache.close();
+    unsetenv("TERM_PROGRAM");
+    setenv ("TERM", "xterm", 1);
+    detect.detect();
+    CPPUNIT_ASSERT ( ! detect.isCachedResult() );
+    CPPUNIT_ASSERT ( detect.getAnswerbackString() == "PuTTY" );
+
+    closeConEmuStdStreams();
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::putty);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+
+  unlink(cache_file.c_str());
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FTermDetectionTest);
@@ -62,6 +62,7 @@ class FSystemTest : public finalcut::FSystem
     auto              fclose (FILE*) -> int override;
     auto              fputs (const char*, FILE*) -> int override;
     auto              putchar (int) -> int override;
+    auto              write (int, const void*, std::size_t) -> ssize_t override;
     auto            getuid() -> uid_t override;
     auto            geteuid() -> uid_t override;
     auto              getpwuid_r (uid_t, struct passwd*, char*
@@ -528,6 +529,14 @@ auto FSystemTest::putchar (int c) -> int
   return 1;
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::write (int fd, const void* buf, std::size_t count) -> ssize_t
+{
+  std::cerr << "Call: write (fd=" << fd << ", count=" << count << ")\n";
+  characters.append(static_cast<const char*>(buf), count);
+  return ssize_t(count);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::getuid() -> uid_t
 {
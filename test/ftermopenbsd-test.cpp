@@ -63,6 +63,7 @@ class FSystemTest : public finalcut::FSystem
     auto              fputs (const char*, FILE*) -> int override;
     auto              fclose (FILE*) -> int override;
     auto              putchar (int) -> int override;
+    auto              write (int, const void*, std::size_t) -> ssize_t override;
     auto            getuid() -> uid_t override;
     auto            geteuid() -> uid_t override;
     auto              getpwuid_r (uid_t, struct passwd*, char*
@@ -246,6 +247,12 @@ auto FSystemTest::putchar (int c) -> int
 #endif
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::write (int fd, const void* buf, std::size_t count) -> ssize_t
+{
+  return ::write(fd, buf, count);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::getuid() -> uid_t
 {
@@ -114,6 +114,8 @@ class FTimerTest : public CPPUNIT_NS::TestFixture
     void classNameTest();
     void timeTest();
     void timerTest();
+    void nextTimeoutTest();
+    void timerQueueTest();
     void performTimerActionTest();
 
   private:
@@ -124,6 +126,8 @@ class FTimerTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (classNameTest);
     CPPUNIT_TEST (timeTest);
     CPPUNIT_TEST (timerTest);
+    CPPUNIT_TEST (nextTimeoutTest);
+    CPPUNIT_TEST (timerQueueTest);
     CPPUNIT_TEST (performTimerActionTest);
 
     // End of test suite definition
@@ -276,6 +280,105 @@ void FTimerTest::timerTest()
   CPPUNIT_ASSERT ( ! t1.delTimer(-1) );
 }
 
+//----------------------------------------------------------------------
+void FTimerTest::nextTimeoutTest()
+{
+  using finalcut::FObjectTimer;
+  test::FTimer_protected t1;
+  CPPUNIT_ASSERT ( t1.getTimerList()->empty() );
+  CPPUNIT_ASSERT ( FObjectTimer::getNextTimeout() == TimeValue::max() );
+
+  const auto start = FObjectTimer::getCurrentTime();
+  t1.addTimer(900);
+  const auto timeout1 = FObjectTimer::getNextTimeout();
+  CPPUNIT_ASSERT ( start + std::chrono::milliseconds(900) <= timeout1 );
+  CPPUNIT_ASSERT ( timeout1 <= FObjectTimer::getCurrentTime()
+                              + std::chrono::milliseconds(900) );
+
+  // The earliest expiry time is returned
+  const int id = t1.addTimer(300);
+  const auto timeout2 = FObjectTimer::getNextTimeout();
+  CPPUNIT_ASSERT ( timeout2 < timeout1 );
+  CPPUNIT_ASSERT ( start + std::chrono::milliseconds(300) <= timeout2 );
+
+  t1.delTimer(id);
+  CPPUNIT_ASSERT ( FObjectTimer::getNextTimeout() == timeout1 );
+
+  t1.delAllTimers();
+  CPPUNIT_ASSERT ( FObjectTimer::getNextTimeout() == TimeValue::max() );
+}
+
+//----------------------------------------------------------------------
+void FTimerTest::timerQueueTest()
+{
+  using TimerQueue = finalcut::FTimerQueue<finalcut::FObject>;
+  using TimerData = TimerQueue::FTimerData;
+  using std::chrono::milliseconds;
+  TimerQueue queue{};
+  const auto& classname = queue.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTimerQueue" );
+  CPPUNIT_ASSERT ( queue.empty() );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == TimeValue::max() );
+
+  finalcut::FObject obj1{};
+  finalcut::FObject obj2{};
+  const auto t0 = TimeValue{} + std::chrono::seconds(1000);
+  queue.insert({ 1, milliseconds(300), t0 + milliseconds(300), &obj1 });
+  queue.insert({ 2, milliseconds(100), t0 + milliseconds(100), &obj2 });
+  queue.insert({ 3, milliseconds(200), t0 + milliseconds(200), &obj1 });
+  queue.insert({ 4, milliseconds(0), t0, &obj2 });
+  CPPUNIT_ASSERT ( queue.size() == 4 );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 );
+
+  // Expired timers are returned in order of their expiry time
+  TimerData timer{};
+  CPPUNIT_ASSERT ( queue.popExpired(t0 + milliseconds(250), timer) );
+  CPPUNIT_ASSERT ( timer.id == 4 );
+  CPPUNIT_ASSERT ( queue.popExpired(t0 + milliseconds(250), timer) );
+  CPPUNIT_ASSERT ( timer.id == 2 );
+  CPPUNIT_ASSERT ( timer.object == &obj2 );
+  CPPUNIT_ASSERT ( queue.popExpired(t0 + milliseconds(250), timer) );
+  CPPUNIT_ASSERT ( timer.id == 3 );
+  CPPUNIT_ASSERT ( ! queue.popExpired(t0 + milliseconds(250), timer) );
+  CPPUNIT_ASSERT ( queue.size() == 4 );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 + milliseconds(300) );
+
+  // A zero interval timer expires only once until it is rearmed
+  queue.rearmExpired(t0 + milliseconds(250));
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 + milliseconds(250) );
+  CPPUNIT_ASSERT ( queue.popExpired(t0 + milliseconds(300), timer) );
+  CPPUNIT_ASSERT ( timer.id == 4 );
+  CPPUNIT_ASSERT ( queue.popExpired(t0 + milliseconds(300), timer) );
+  CPPUNIT_ASSERT ( timer.id == 1 );
+  CPPUNIT_ASSERT ( ! queue.popExpired(t0 + milliseconds(300), timer) );
+  CPPUNIT_ASSERT ( queue.erase(4) );  // Deleted before rearming
+  queue.rearmExpired(t0 + milliseconds(300));
+  CPPUNIT_ASSERT ( queue.size() == 3 );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 + milliseconds(350) );
+
+  // Deleting timers
+  CPPUNIT_ASSERT ( queue.erase(2) );
+  CPPUNIT_ASSERT ( ! queue.erase(2) );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 + milliseconds(400) );
+  CPPUNIT_ASSERT ( queue.erase(&obj1) );
+  CPPUNIT_ASSERT ( ! queue.erase(&obj1) );
+  CPPUNIT_ASSERT ( queue.empty() );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == TimeValue::max() );
+
+  // Many short-lived timers
+  for (int id{1}; id <= 1000; id++)
+    queue.insert({ id, milliseconds(id), t0 + milliseconds(id), &obj1 });
+
+  for (int id{1}; id < 1000; id++)
+    CPPUNIT_ASSERT ( queue.erase(id) );
+
+  CPPUNIT_ASSERT ( queue.size() == 1 );
+  CPPUNIT_ASSERT ( queue.getNextTimeout() == t0 + milliseconds(1000) );
+  queue.clear();
+  CPPUNIT_ASSERT ( queue.empty() );
+  CPPUNIT_ASSERT ( ! queue.popExpired(TimeValue::max(), timer) );
+}
+
 //----------------------------------------------------------------------
 void FTimerTest::performTimerActionTest()
 {
@@ -60,6 +60,17 @@ void setBellState (bool state = true)
 class FTermOutputTest : public finalcut::FOutput
 {
   public:
+    // Terminal scroll call
+    struct ScrollCall
+    {
+      bool forward;
+      int  top;
+      int  bottom;
+    };
+
+    // Using-declaration
+    using ScrollCallList = std::vector<ScrollCall>;
+
     // Constructor
     FTermOutputTest() = default;
     explicit FTermOutputTest (const finalcut::FVTerm&);
@@ -76,6 +87,7 @@ class FTermOutputTest : public finalcut::FOutput
     auto getMaxColor() const -> int override;
     auto getEncoding() const -> finalcut::Encoding override;
     auto getKeyName (finalcut::FKey) const -> finalcut::FString override;
+    static auto getScrollCalls() -> ScrollCallList&;
 
     // Mutators
     void setCursor (finalcut::FPoint) override;
@@ -94,6 +106,7 @@ class FTermOutputTest : public finalcut::FOutput
     auto isNewFont() const -> bool override;
     auto isEncodable (const wchar_t&) const -> bool override;
     auto isFlushTimeout() const -> bool override;
+    auto hasPendingOutput() const -> bool override;
     auto hasTerminalResized() const -> bool override;
     auto allowsTerminalSizeManipulation() const -> bool override;
     auto canChangeColorPalette() const -> bool override;
@@ -110,6 +123,8 @@ class FTermOutputTest : public finalcut::FOutput
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalForward (int, int) -> bool override;
+    auto scrollTerminalReverse (int, int) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
@@ -135,6 +150,7 @@ class FTermOutputTest : public finalcut::FOutput
     finalcut::FTerm                      fterm{};
     static finalcut::FVTerm::FTermArea*  vterm;
     static finalcut::FTermData*          fterm_data;
+    static ScrollCallList                scroll_calls;
     std::shared_ptr<OutputBuffer>        output_buffer{};
     std::shared_ptr<finalcut::FPoint>    term_pos{};
     finalcut::FChar                      term_attribute{};
@@ -145,6 +161,7 @@ class FTermOutputTest : public finalcut::FOutput
 bool                         FTermOutputTest::no_force{false};
 finalcut::FVTerm::FTermArea* FTermOutputTest::vterm{nullptr};
 finalcut::FTermData*         FTermOutputTest::fterm_data{nullptr};
+FTermOutputTest::ScrollCallList FTermOutputTest::scroll_calls{};
 
 
 // constructors and destructor
@@ -202,6 +219,12 @@ inline auto FTermOutputTest::getKeyName (finalcut::FKey keynum) const -> finalcu
   return keyboard.getKeyName (keynum);
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::getScrollCalls() -> ScrollCallList&
+{
+  return scroll_calls;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutputTest::isCursorHideable() const -> bool
 {
@@ -232,6 +255,12 @@ inline auto FTermOutputTest::isFlushTimeout() const -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::hasPendingOutput() const -> bool
+{
+  return false;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutputTest::hasTerminalResized() const -> bool
 {
@@ -368,6 +397,20 @@ inline auto FTermOutputTest::scrollTerminalReverse() -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::scrollTerminalForward (int top, int bottom) -> bool
+{
+  scroll_calls.push_back({true, top, bottom});
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::scrollTerminalReverse (int top, int bottom) -> bool
+{
+  scroll_calls.push_back({false, top, bottom});
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::clearTerminalAttributes()
 {
@@ -489,6 +532,7 @@ class FVTerm_protected : public finalcut::FVTerm
     void p_putArea (const finalcut::FPoint&, const FTermArea*) const;
     static auto p_getLayer (FVTerm&) -> int;
     static void p_determineWindowLayers();
+    static void p_invalidateAreaOwnerMap();
     void p_scrollAreaForward (FTermArea*);
     void p_scrollAreaReverse (FTermArea*);
     void p_clearArea (FTermArea*, wchar_t = L' ');
@@ -717,6 +761,12 @@ inline void FVTerm_protected::p_determineWindowLayers()
   finalcut::FVTerm::determineWindowLayers();
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm_protected::p_invalidateAreaOwnerMap()
+{
+  finalcut::FVTerm::invalidateAreaOwnerMap();
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm_protected::p_scrollAreaForward (FTermArea* area)
 {
@@ -783,7 +833,12 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     void FVTermPrintTest();
     void FVTermChildAreaPrintTest();
     void FVTermScrollTest();
+    void FVTermTerminalScrollTest();
     void FVTermOverlappingWindowsTest();
+    void FVTermCoveredCharactersTest();
+    void FVTermDamageRegionTest();
+    void FVTermTransparentRunsTest();
+    void FVTermParallelCompositingTest();
     void FVTermReduceUpdatesTest();
     void getFVTermAreaTest();
 
@@ -799,7 +854,12 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (FVTermPrintTest);
     CPPUNIT_TEST (FVTermChildAreaPrintTest);
     CPPUNIT_TEST (FVTermScrollTest);
+    CPPUNIT_TEST (FVTermTerminalScrollTest);
     CPPUNIT_TEST (FVTermOverlappingWindowsTest);
+    CPPUNIT_TEST (FVTermCoveredCharactersTest);
+    CPPUNIT_TEST (FVTermDamageRegionTest);
+    CPPUNIT_TEST (FVTermTransparentRunsTest);
+    CPPUNIT_TEST (FVTermParallelCompositingTest);
     CPPUNIT_TEST (FVTermReduceUpdatesTest);
     CPPUNIT_TEST (getFVTermAreaTest);
 
@@ -854,7 +914,6 @@ void FVTermTest::OwnFunctionsTest()
 {
   finalcut::FChar shadow_char;
   shadow_char.ch           = { L'\0', L'\0', L'\0', L'\0', L'\0' };
-  shadow_char.encoded_char = { L'\0', L'\0', L'\0', L'\0', L'\0' };
   shadow_char.fg_color     = finalcut::FColor::Default;
   shadow_char.bg_color     = finalcut::FColor::Default;
   shadow_char.attr.byte[0] = 0;
@@ -866,7 +925,6 @@ void FVTermTest::OwnFunctionsTest()
   // FChar struct
   finalcut::FChar test_char =
   {
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
@@ -995,7 +1053,6 @@ void FVTermTest::FVTermBasesTest()
 
   finalcut::FChar default_char;
   default_char.ch           = { L' ', L'\0', L'\0', L'\0', L'\0' };
-  default_char.encoded_char = { L'\0', L'\0', L'\0', L'\0', L'\0' };
   default_char.fg_color     = finalcut::FColor::Default;
   default_char.bg_color     = finalcut::FColor::Default;
   default_char.attr.byte[0] = 0;
@@ -1153,7 +1210,6 @@ void FVTermTest::FVTermBasesTest()
   finalcut::FChar bg_char =
   {
     { L'▒', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -1174,7 +1230,6 @@ void FVTermTest::FVTermBasesTest()
   auto width = std::size_t(vwin->width);
   finalcut::FChar shadow_char =
   {
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
@@ -1222,6 +1277,7 @@ void FVTermTest::FVTermBasesTest()
   // Makes the virtual window visible and thus displayable
   // on the virtual terminal
   vwin->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   CPPUNIT_ASSERT ( p_fvterm.p_isCursorHideable() );
   vwin->input_cursor_visible = true;
   p_fvterm.p_setActiveArea(vwin);
@@ -1246,6 +1302,7 @@ void FVTermTest::FVTermBasesTest()
   // Move
   vwin->offset_left = 0;
   vwin->offset_top = 0;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({1, 1}, nullptr);
   p_fvterm.p_processTerminalUpdate();
   CPPUNIT_ASSERT ( test::isAreaEqual(test_vterm_area, vterm) );
@@ -1266,6 +1323,7 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = -10;
   vwin->offset_top = -10;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({-9, -9}, vwin);
   p_fvterm.p_processTerminalUpdate();
   p_fvterm.p_restoreVTerm ({finalcut::FPoint{1, 1}, finalcut::FSize{22, 21}});
@@ -1276,6 +1334,7 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = 70;
   vwin->offset_top = -10;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({71, -9}, vwin);
   p_fvterm.p_processTerminalUpdate();
   p_fvterm.p_restoreVTerm ({finalcut::FPoint{1, 1}, finalcut::FSize{12, 11}});
@@ -1286,6 +1345,7 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = -10;
   vwin->offset_top = 14;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({-9, 15}, vwin);
   p_fvterm.p_processTerminalUpdate();
   p_fvterm.p_restoreVTerm ({finalcut::FPoint{71, 1}, finalcut::FSize{10, 11}});
@@ -1296,6 +1356,7 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = 70;
   vwin->offset_top = 14;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({71, 15}, vwin);
   p_fvterm.p_processTerminalUpdate();
   p_fvterm.p_restoreVTerm ({finalcut::FPoint{1, 15}, finalcut::FSize{12, 10}});
@@ -1307,6 +1368,7 @@ void FVTermTest::FVTermBasesTest()
   // Move outside
   vwin->offset_left = -20;
   vwin->offset_top = -20;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({-19, -19}, vwin);
   p_fvterm.p_processTerminalUpdate();
   p_fvterm.p_restoreVTerm ({finalcut::FPoint{71, 15}, finalcut::FSize{10, 10}});
@@ -1316,18 +1378,21 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = 80;
   vwin->offset_top = -20;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({81, -19}, vwin);
   p_fvterm.p_processTerminalUpdate();
   CPPUNIT_ASSERT ( test::isAreaEqual(test_vterm_area, vterm) );
 
   vwin->offset_left = -20;
   vwin->offset_top = 24;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({-19, 25}, vwin);
   p_fvterm.p_processTerminalUpdate();
   CPPUNIT_ASSERT ( test::isAreaEqual(test_vterm_area, vterm) );
 
   vwin->offset_left = 80;
   vwin->offset_top = 24;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({81, 25}, vwin);
   p_fvterm.p_processTerminalUpdate();
   CPPUNIT_ASSERT ( test::isAreaEqual(test_vterm_area, vterm) );
@@ -1346,6 +1411,7 @@ void FVTermTest::FVTermBasesTest()
 
   vwin->offset_left = -5;
   vwin->offset_top = -5;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_putArea ({-4, -4}, vwin);
 
   for (wchar_t i = 0; i < wchar_t(vterm->height); i++)
@@ -1497,7 +1563,6 @@ void FVTermTest::FVTermPrintTest()
     finalcut::FChar default_char =
     {
       { L' ', L'\0', L'\0', L'\0', L'\0' },
-      { L'\0', L'\0', L'\0', L'\0', L'\0' },
       finalcut::FColor::Default,
       finalcut::FColor::Default,
       { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -1674,7 +1739,6 @@ void FVTermTest::FVTermPrintTest()
     // std::vector<FChar>
     finalcut::FChar fchar =
     {
-      { L'\0', L'\0', L'\0', L'\0', L'\0' },
       { L'\0', L'\0', L'\0', L'\0', L'\0' },
       finalcut::FColor::Red,
       finalcut::FColor::White,
@@ -2011,6 +2075,7 @@ void FVTermTest::FVTermChildAreaPrintTest()
 
   CPPUNIT_ASSERT ( ! vwin->visible );
   vwin->visible = true;  // show()
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   CPPUNIT_ASSERT ( vwin->visible );
   CPPUNIT_ASSERT ( ! vterm->has_changes );
   p_fvterm.p_addLayer(vwin);
@@ -2022,6 +2087,7 @@ void FVTermTest::FVTermChildAreaPrintTest()
   p_fvterm.p_addLayer(vwin);
   CPPUNIT_ASSERT ( p_fvterm.value_ref() == 11 );
   vwin->visible = false;  // hide()
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_addLayer(vwin);
   CPPUNIT_ASSERT ( p_fvterm.value_ref() == 11 );
   p_fvterm.p_addLayer(nullptr);
@@ -2049,6 +2115,7 @@ void FVTermTest::FVTermChildAreaPrintTest()
 
   p_fvterm.p_addLayer(vwin);
   vwin->visible = true;  // show()
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   vterm->has_changes = false;
   p_fvterm.p_addLayer(vwin);
   CPPUNIT_ASSERT ( vterm->has_changes );
@@ -2077,7 +2144,6 @@ void FVTermTest::FVTermChildAreaPrintTest()
   finalcut::FChar space_char_1 =
   {
     { L' ', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2086,7 +2152,6 @@ void FVTermTest::FVTermChildAreaPrintTest()
   finalcut::FChar space_char_2 =
   {
     { L' ', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Red,
     finalcut::FColor::White,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2095,7 +2160,6 @@ void FVTermTest::FVTermChildAreaPrintTest()
   finalcut::FChar equal_sign_char =
   {
     { L'=', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Red,
     finalcut::FColor::White,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2150,7 +2214,6 @@ void FVTermTest::FVTermScrollTest()
   finalcut::FChar one_char =
   {
     { L'1', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2279,6 +2342,36 @@ void FVTermTest::FVTermScrollTest()
   CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
+  // The right shadow does not scroll
+
+  finalcut::FRect shadow_geometry {finalcut::FPoint{0, 0}, finalcut::FSize{3, 3}};
+  auto shadow_area_ptr = p_fvterm.p_createArea (shadow_geometry, finalcut::FSize{1, 0});
+  auto shadow_area = shadow_area_ptr.get();
+
+  for (auto y{0}; y < 3; y++)
+  {
+    shadow_area->getFChar(0, y).ch[0] = wchar_t(L'1' + y);
+    shadow_area->getFChar(3, y).ch[0] = wchar_t(L'a' + y);
+  }
+
+  p_fvterm.p_scrollAreaForward (shadow_area);
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 0).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 1).ch[0] == L'3' );
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 2).ch[0] == L' ' );
+
+  for (auto y{0}; y < 3; y++)
+    CPPUNIT_ASSERT ( shadow_area->getFChar(3, y).ch[0] == wchar_t(L'a' + y) );
+
+  p_fvterm.p_scrollAreaReverse (shadow_area);
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 0).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 1).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( shadow_area->getFChar(0, 2).ch[0] == L'3' );
+  CPPUNIT_ASSERT ( shadow_area->changes[0].xmin == 0 );
+  CPPUNIT_ASSERT ( shadow_area->changes[0].xmax == 2 );
+
+  for (auto y{0}; y < 3; y++)
+    CPPUNIT_ASSERT ( shadow_area->getFChar(3, y).ch[0] == wchar_t(L'a' + y) );
+
   // vdesktop scrolling
 
   auto&& vdesktop = p_fvterm.p_getVirtualDesktop();
@@ -2364,6 +2457,112 @@ void FVTermTest::FVTermScrollTest()
   test::printArea (vdesktop);
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermTerminalScrollTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  FVTerm_protected p_fvterm_1(finalcut::outputClass<FTermOutputTest>{});
+  FVTerm_protected p_fvterm_2(finalcut::outputClass<FTermOutputTest>{});
+  auto&& vterm = p_fvterm.p_getVirtualTerminal();
+  auto&& vdesktop = p_fvterm.p_getVirtualDesktop();
+  auto& scroll_calls = FTermOutputTest::getScrollCalls();
+  scroll_calls.clear();
+
+  const auto reset_changes = [&vterm] ()
+  {
+    for (auto y{0}; y < vterm->height; y++)
+    {
+      vterm->changes[unsigned(y)].xmin = uInt(vterm->width);
+      vterm->changes[unsigned(y)].xmax = 0;
+    }
+  };
+
+  const auto lines_changed = [&vterm] (int top, int bottom)
+  {
+    for (auto y{0}; y < vterm->height; y++)
+    {
+      const auto& line_changes = vterm->changes[unsigned(y)];
+      const bool changed = line_changes.xmin == 0
+                        && line_changes.xmax == uInt(vterm->width - 1);
+
+      if ( changed != (y >= top && y <= bottom) )
+        return false;
+    }
+
+    return true;
+  };
+
+  // The desktop scrolls the whole terminal
+  reset_changes();
+  p_fvterm.p_scrollAreaForward (vdesktop);
+  CPPUNIT_ASSERT ( scroll_calls.size() == 1 );
+  CPPUNIT_ASSERT ( scroll_calls[0].forward );
+  CPPUNIT_ASSERT ( scroll_calls[0].top == 0 );
+  CPPUNIT_ASSERT ( scroll_calls[0].bottom == 23 );
+  CPPUNIT_ASSERT ( lines_changed(0, 23) );
+
+  reset_changes();
+  p_fvterm.p_scrollAreaReverse (vdesktop);
+  CPPUNIT_ASSERT ( scroll_calls.size() == 2 );
+  CPPUNIT_ASSERT ( ! scroll_calls[1].forward );
+  CPPUNIT_ASSERT ( scroll_calls[1].top == 0 );
+  CPPUNIT_ASSERT ( scroll_calls[1].bottom == 23 );
+  CPPUNIT_ASSERT ( lines_changed(0, 23) );
+
+  // A full-width window scrolls only its own terminal lines
+  finalcut::FRect geometry_1 {finalcut::FPoint{0, 5}, finalcut::FSize{80, 6}};
+  finalcut::FRect geometry_2 {finalcut::FPoint{10, 8}, finalcut::FSize{20, 5}};
+  auto vwin_1_ptr = p_fvterm_1.p_createArea (geometry_1);
+  auto vwin_2_ptr = p_fvterm_2.p_createArea (geometry_2);
+  auto vwin_1 = vwin_1_ptr.get();
+  auto vwin_2 = vwin_2_ptr.get();
+  p_fvterm_1.setVWin(std::move(vwin_1_ptr));
+  p_fvterm_2.setVWin(std::move(vwin_2_ptr));
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm_1);
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm_2);
+  vwin_1->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  scroll_calls.clear();
+
+  reset_changes();
+  p_fvterm_1.p_scrollAreaForward (vwin_1);
+  CPPUNIT_ASSERT ( scroll_calls.size() == 1 );
+  CPPUNIT_ASSERT ( scroll_calls[0].forward );
+  CPPUNIT_ASSERT ( scroll_calls[0].top == 5 );
+  CPPUNIT_ASSERT ( scroll_calls[0].bottom == 10 );
+  CPPUNIT_ASSERT ( lines_changed(5, 10) );
+
+  reset_changes();
+  p_fvterm_1.p_scrollAreaReverse (vwin_1);
+  CPPUNIT_ASSERT ( scroll_calls.size() == 2 );
+  CPPUNIT_ASSERT ( ! scroll_calls[1].forward );
+  CPPUNIT_ASSERT ( scroll_calls[1].top == 5 );
+  CPPUNIT_ASSERT ( scroll_calls[1].bottom == 10 );
+  CPPUNIT_ASSERT ( lines_changed(5, 10) );
+
+  // A window covered by a later window does not scroll the terminal
+  vwin_2->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  scroll_calls.clear();
+  reset_changes();
+  p_fvterm_1.p_scrollAreaForward (vwin_1);
+  p_fvterm_1.p_scrollAreaReverse (vwin_1);
+  CPPUNIT_ASSERT ( scroll_calls.empty() );
+  CPPUNIT_ASSERT ( lines_changed(0, -1) );
+
+  // A window that does not span the terminal width
+  vwin_2->visible = false;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  p_fvterm_1.p_scrollAreaForward (vwin_1);
+  CPPUNIT_ASSERT ( scroll_calls.size() == 1 );
+  scroll_calls.clear();
+  p_fvterm_2.p_scrollAreaForward (vwin_2);
+  vwin_2->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  p_fvterm_2.p_scrollAreaForward (vwin_2);
+  CPPUNIT_ASSERT ( scroll_calls.empty() );
+}
+
 //----------------------------------------------------------------------
 void FVTermTest::FVTermOverlappingWindowsTest()
 {
@@ -2444,9 +2643,13 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   test::printArea (vwin_3);
   test::printArea (vwin_4);
   vwin_1->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   vwin_2->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   vwin_3->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   vwin_4->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
 
   CPPUNIT_ASSERT ( vwin_1->layer == -1 );
   CPPUNIT_ASSERT ( vwin_2->layer == -1 );
@@ -2478,7 +2681,6 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   finalcut::FChar bg_char =
   {
     { L'.', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::DarkGray,
     finalcut::FColor::LightBlue,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2492,7 +2694,6 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   finalcut::FChar vwin_1_char =  // with color overlay
   {
     { L'.', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Black,
     finalcut::FColor::White,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2501,7 +2702,6 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   finalcut::FChar vwin_2_char =  // with inherit background
   {
     { L'▒', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Black,
     finalcut::FColor::LightBlue,
     { { 0x00, 0x80, 0x08, 0x00} }  // byte 0..3
@@ -2510,7 +2710,6 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   finalcut::FChar vwin_3_char =  // with transparency
   {
     { L'.', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::DarkGray,
     finalcut::FColor::LightBlue,
     { { 0x00, 0x00, 0x09, 0x00} }  // byte 0..3
@@ -2519,7 +2718,6 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   finalcut::FChar vwin_4_char =
   {
     { L'█', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Black,
     finalcut::FColor::White,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -2546,6 +2744,7 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   test::moveArea(vwin_2, finalcut::FPoint{0, 2});
   test::moveArea(vwin_3, finalcut::FPoint{8, 2});
   test::moveArea(vwin_4, finalcut::FPoint{4, 4});
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm_1.p_restoreVTerm(geometry);
   p_fvterm_1.p_processTerminalUpdate();
   test::printArea (vterm);
@@ -2579,6 +2778,7 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   test::moveArea(vwin_2, finalcut::FPoint{0, 1});
   test::moveArea(vwin_3, finalcut::FPoint{6, 2});
   test::moveArea(vwin_4, finalcut::FPoint{3, 3});
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm_1.p_restoreVTerm(geometry);
   p_fvterm_1.p_processTerminalUpdate();
   test::printArea (vterm);
@@ -2607,6 +2807,7 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   test::moveArea(vwin_2, finalcut::FPoint{5, 0});
   test::moveArea(vwin_3, finalcut::FPoint{5, 2});
   test::moveArea(vwin_4, finalcut::FPoint{0, 2});
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm_1.p_restoreVTerm(geometry);
   p_fvterm_1.p_processTerminalUpdate();
   test::printArea (vterm);
@@ -2692,6 +2893,341 @@ void FVTermTest::FVTermOverlappingWindowsTest()
   CPPUNIT_ASSERT ( test::isAreaEqual(test_area, vterm) );
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermCoveredCharactersTest()
+{
+  //  ┌──────────┐
+  //  │ 1 ┌──────┼───┐
+  //  │   │ 2    │   │
+  //  └───┼──────┘   │
+  //      └──────────┘
+
+  FVTerm_protected p_fvterm_1(finalcut::outputClass<FTermOutputTest>{});
+  FVTerm_protected p_fvterm_2(finalcut::outputClass<FTermOutputTest>{});
+
+  // unique virtual terminal
+  auto&& vterm = p_fvterm_1.p_getVirtualTerminal();
+
+  // Create the virtual windows for the p_fvterm_1 and p_fvterm_2 objects
+  finalcut::FRect geometry_1 {finalcut::FPoint{0, 0}, finalcut::FSize{10, 3}};
+  finalcut::FRect geometry_2 {finalcut::FPoint{4, 1}, finalcut::FSize{10, 3}};
+  auto vwin_1_ptr = p_fvterm_1.p_createArea (geometry_1);
+  auto vwin_2_ptr = p_fvterm_2.p_createArea (geometry_2);
+  auto vwin_1 = vwin_1_ptr.get();
+  auto vwin_2 = vwin_2_ptr.get();
+  p_fvterm_1.setVWin(std::move(vwin_1_ptr));
+  p_fvterm_2.setVWin(std::move(vwin_2_ptr));
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm_1);
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm_2);
+  p_fvterm_1.p_determineWindowLayers();
+  CPPUNIT_ASSERT ( vwin_1->layer == 1 );
+  CPPUNIT_ASSERT ( vwin_2->layer == 2 );
+
+  p_fvterm_1.print() << finalcut::FPoint{1, 1}
+                     << std::wstring(30, L'1');
+  p_fvterm_2.print() << finalcut::FPoint{5, 2}
+                     << std::wstring(30, L'2');
+  vwin_1->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  vwin_2->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  p_fvterm_1.p_processTerminalUpdate();
+  test::printArea (vterm);
+  CPPUNIT_ASSERT ( vterm->getFChar(3, 1).ch[0] == L'1' );
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 1).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( vterm->getFChar(9, 2).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( vterm->getFChar(13, 3).ch[0] == L'2' );
+
+  for (auto y{0}; y < vterm->height; y++)
+  {
+    vterm->changes[unsigned(y)].xmin = uInt(vterm->width);
+    vterm->changes[unsigned(y)].xmax = 0;
+  }
+
+  // Characters under window 2 are not copied to the virtual terminal
+  p_fvterm_1.print() << finalcut::FPoint{5, 3} << L"xxxxxx";
+  p_fvterm_1.p_addLayer(vwin_1);
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 2).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( vterm->getFChar(9, 2).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( vterm->changes[2].xmin > vterm->changes[2].xmax );
+
+  // Only the uncovered part of a line is copied
+  p_fvterm_1.print() << finalcut::FPoint{1, 2} << L"yyyyyyyyyy";
+  p_fvterm_1.p_addLayer(vwin_1);
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 1).ch[0] == L'y' );
+  CPPUNIT_ASSERT ( vterm->getFChar(3, 1).ch[0] == L'y' );
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 1).ch[0] == L'2' );
+  CPPUNIT_ASSERT ( vterm->changes[1].xmin == 0 );
+  CPPUNIT_ASSERT ( vterm->changes[1].xmax == 3 );
+
+  // The owner map follows window movements
+  test::moveArea(vwin_2, finalcut::FPoint{20, 10});
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  p_fvterm_1.p_restoreVTerm(finalcut::FRect{finalcut::FPoint{5, 2}, finalcut::FSize{10, 3}});
+  p_fvterm_1.p_processTerminalUpdate();
+  test::printArea (vterm);
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 1).ch[0] == L'y' );
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 2).ch[0] == L'x' );
+  CPPUNIT_ASSERT ( vterm->getFChar(9, 2).ch[0] == L'x' );
+  CPPUNIT_ASSERT ( vterm->getFChar(13, 3).ch[0] != L'2' );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermDamageRegionTest()
+{
+  finalcut::FVTerm::FDamageRegion damage{};
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+
+  damage.clear (80, 25);
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+  CPPUNIT_ASSERT ( damage.spans.size() == 25 );
+
+  // Spans are clipped to the terminal
+  damage.add (3, -5, 10);
+  damage.add (3, 20, 90);
+  damage.add (30, 0, 5);
+  CPPUNIT_ASSERT ( ! damage.isEmpty() );
+  CPPUNIT_ASSERT ( damage.ymin == 3 );
+  CPPUNIT_ASSERT ( damage.ymax == 3 );
+  CPPUNIT_ASSERT ( damage.spans[3].xmin == 0 );
+  CPPUNIT_ASSERT ( damage.spans[3].xmax == 79 );
+
+  // Rectangles use terminal positions starting at 1
+  damage.add (finalcut::FRect{finalcut::FPoint{11, 21}, finalcut::FSize{40, 10}});
+  CPPUNIT_ASSERT ( damage.ymin == 3 );
+  CPPUNIT_ASSERT ( damage.ymax == 24 );
+  CPPUNIT_ASSERT ( damage.spans[19].xmin > damage.spans[19].xmax );
+  CPPUNIT_ASSERT ( damage.spans[20].xmin == 10 );
+  CPPUNIT_ASSERT ( damage.spans[20].xmax == 49 );
+  CPPUNIT_ASSERT ( damage.spans[24].xmin == 10 );
+  CPPUNIT_ASSERT ( damage.spans[24].xmax == 49 );
+
+  // An area marks only the damaged cells it contains
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  finalcut::FRect geometry {finalcut::FPoint{40, 20}, finalcut::FSize{20, 10}};
+  auto vwin = p_fvterm.p_createArea (geometry);
+
+  for (auto&& line_changes : vwin->changes)
+  {
+    line_changes.xmin = uInt(vwin->width);
+    line_changes.xmax = 0;
+  }
+
+  vwin->has_changes = false;
+  CPPUNIT_ASSERT ( vwin->reprint(damage) );
+  CPPUNIT_ASSERT ( vwin->has_changes );
+  CPPUNIT_ASSERT ( vwin->changes[0].xmin == 0 );
+  CPPUNIT_ASSERT ( vwin->changes[0].xmax == 9 );
+  CPPUNIT_ASSERT ( vwin->changes[4].xmin == 0 );
+  CPPUNIT_ASSERT ( vwin->changes[4].xmax == 9 );
+  CPPUNIT_ASSERT ( vwin->changes[5].xmin > vwin->changes[5].xmax );
+
+  // Only the previously damaged lines are reset
+  damage.clear (80, 25);
+  CPPUNIT_ASSERT ( damage.isEmpty() );
+  CPPUNIT_ASSERT ( damage.spans[3].xmin > damage.spans[3].xmax );
+  CPPUNIT_ASSERT ( damage.spans[24].xmin > damage.spans[24].xmax );
+  vwin->has_changes = false;
+  CPPUNIT_ASSERT ( ! vwin->reprint(damage) );
+  CPPUNIT_ASSERT ( ! vwin->has_changes );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermTransparentRunsTest()
+{
+  // Opaque and transparent runs of a window line
+  // ('#' = opaque, '.' = transparent)
+
+  const std::vector<std::string> lines
+  {
+    ".######...#########.",  // Runs away from a 4-cell boundary
+    "....................",  // All transparent
+    "#.#.#.#.#.#.#.#.#.#.",  // Single-cell runs
+    ".#.#.#.#.#.#.#.#.#.#",  // Single-cell runs
+    "..##################",  // Run up to the line end
+    "#..................#",  // Single-cell runs at both ends
+    "###.###....#######.#"   // Runs that end inside a 4-cell block
+  };
+
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto&& vterm = p_fvterm.p_getVirtualTerminal();
+  auto&& vdesktop = p_fvterm.p_getVirtualDesktop();
+  const int ax{3};  // Window position
+  const int ay{2};
+
+  // Create the virtual window for the p_fvterm object
+  finalcut::FRect geometry {finalcut::FPoint{ax, ay}, finalcut::FSize{20, lines.size()}};
+  auto vwin_ptr = p_fvterm.p_createArea (geometry);
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  vwin->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+
+  for (std::size_t y{0}; y < lines.size(); y++)
+  {
+    p_fvterm.print() << finalcut::FPoint{ax + 1, ay + int(y) + 1};
+
+    for (const auto& cell : lines[y])
+    {
+      p_fvterm.setTransparent (cell == '.');
+      p_fvterm.print() << ( cell == '.' ? L'T' : L'W' );
+    }
+  }
+
+  p_fvterm.unsetTransparent();
+  CPPUNIT_ASSERT ( vwin->changes[0].trans_count == 5 );
+  CPPUNIT_ASSERT ( vwin->changes[1].trans_count == 20 );
+  CPPUNIT_ASSERT ( vwin->changes[2].trans_count == 10 );
+
+  // Background characters that differ in each column
+  const auto background = [] (int x, int y)
+  {
+    return wchar_t(L'a' + (x + y) % 26);
+  };
+
+  const auto fill_background = [&background] (finalcut::FVTerm::FTermArea* area)
+  {
+    for (auto y{0}; y < area->height; y++)
+      for (auto x{0}; x < area->width; x++)
+        area->getFChar(x, y).ch[0] = background(x, y);
+  };
+
+  const auto is_composed = [&lines, &vterm, &background] (wchar_t beside)
+  {
+    for (std::size_t y{0}; y < lines.size(); y++)
+    {
+      const auto ty = ay + int(y);
+
+      for (std::size_t x{0}; x < lines[y].length(); x++)
+      {
+        const auto tx = ax + int(x);
+        const auto expected = ( lines[y][x] == '#' ) ? L'W'
+                                                     : background(tx, ty);
+
+        if ( vterm->getFChar(tx, ty).ch[0] != expected )
+          return false;
+      }
+
+      // The characters beside the window stay untouched
+      if ( vterm->getFChar(ax - 1, ty).ch[0] != (beside ? beside : background(ax - 1, ty))
+        || vterm->getFChar(ax + 20, ty).ch[0] != (beside ? beside : background(ax + 20, ty)) )
+        return false;
+    }
+
+    return true;
+  };
+
+  // addLayer() mixes the transparent runs with the virtual terminal
+  fill_background (vterm);
+  p_fvterm.p_addLayer(vwin);
+  test::printArea (vterm);
+  CPPUNIT_ASSERT ( is_composed(L'\0') );
+
+  // putArea() restores the transparent runs from the desktop
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm);
+  fill_background (vdesktop);
+
+  for (auto&& fchar : vterm->data)
+    fchar.ch[0] = L'?';
+
+  p_fvterm.p_putArea (finalcut::FPoint{ax + 1, ay + 1}, vwin);
+  test::printArea (vterm);
+  CPPUNIT_ASSERT ( is_composed(L'?') );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermParallelCompositingTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositingThreads() == 0 );
+  const finalcut::FSize term_size { std::size_t(vterm->width)
+                                  , std::size_t(vterm->height) };
+  p_fvterm.resizeVTerm (finalcut::FSize{400, 120});  // Large terminal
+  CPPUNIT_ASSERT ( vterm->width == 400 );
+  CPPUNIT_ASSERT ( vterm->height == 120 );
+
+  // Window with shadow over the full terminal width
+  finalcut::FRect geometry { finalcut::FPoint{0, 0}
+                           , finalcut::FSize{ std::size_t(vterm->width - 2)
+                                            , std::size_t(vterm->height - 1) } };
+  auto vwin_ptr = p_fvterm.p_createArea (geometry, finalcut::FSize{2, 1});
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  vwin->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
+  const finalcut::Style styles[] = { finalcut::Style::None
+                                   , finalcut::Style::ColorOverlay
+                                   , finalcut::Style::InheritBackground
+                                   , finalcut::Style::Transparent };
+
+  for (auto y{0}; y < vwin->height; y++)
+  {
+    p_fvterm.print() << finalcut::FPoint{1, y + 1};
+
+    for (auto x{0}; x < vwin->width; x++)
+    {
+      const auto style = styles[std::size_t((x / 7 + y) % 4)];
+      p_fvterm.print() << finalcut::FColorPair { finalcut::FColor(x % 16)
+                                               , finalcut::FColor(y % 16) }
+                       << finalcut::FStyle {style}
+                       << wchar_t(L'A' + (x + y) % 26)
+                       << finalcut::FStyle {finalcut::Style::None};
+    }
+  }
+
+  const auto compose = [&p_fvterm, vterm, vwin] ()
+  {
+    for (auto y{0}; y < vterm->height; y++)
+    {
+      for (auto x{0}; x < vterm->width; x++)
+      {
+        auto& fchar = vterm->getFChar(x, y);
+        fchar.ch[0] = wchar_t(L'0' + (x * y) % 10);
+        fchar.bg_color = finalcut::FColor((x + y) % 8);
+      }
+
+      vterm->changes[unsigned(y)].xmin = uInt(vterm->width);
+      vterm->changes[unsigned(y)].xmax = 0;
+    }
+
+    for (auto&& line_changes : vwin->changes)
+    {
+      line_changes.xmin = 0;
+      line_changes.xmax = uInt(vwin->width + vwin->right_shadow - 1);
+    }
+
+    p_fvterm.p_addLayer(vwin);
+  };
+
+  // Serial compositing
+  compose();
+  const auto serial_data = vterm->data;
+  const auto serial_changes = vterm->changes;
+
+  // Compositing in row bands with worker threads
+  for (std::size_t threads : {1U, 3U, 7U})
+  {
+    finalcut::FVTerm::setCompositingThreads(threads);
+    CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositingThreads() == threads );
+    compose();
+    CPPUNIT_ASSERT ( vterm->data.size() == serial_data.size() );
+    CPPUNIT_ASSERT ( std::memcmp ( vterm->data.data()
+                                 , serial_data.data()
+                                 , serial_data.size() * sizeof(finalcut::FChar) ) == 0 );
+
+    for (auto y{0}; y < vterm->height; y++)
+    {
+      CPPUNIT_ASSERT ( vterm->changes[unsigned(y)].xmin == serial_changes[unsigned(y)].xmin );
+      CPPUNIT_ASSERT ( vterm->changes[unsigned(y)].xmax == serial_changes[unsigned(y)].xmax );
+    }
+  }
+
+  finalcut::FVTerm::setCompositingThreads(0);
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositingThreads() == 0 );
+  p_fvterm.resizeVTerm (term_size);
+}
+
 //----------------------------------------------------------------------
 void FVTermTest::FVTermReduceUpdatesTest()
 {
@@ -2728,6 +3264,7 @@ void FVTermTest::FVTermReduceUpdatesTest()
   p_fvterm.print() << "0123456789:;<=>";   // Line 13
   p_fvterm.print() << "?@ABCDEFGHIJKLM";   // Line 14
   vwin->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_addLayer(vwin);
 
   // Write changes to the virtual terminal
@@ -2953,6 +3490,7 @@ void FVTermTest::getFVTermAreaTest()
   }
 
   vwin->visible = true;
+  FVTerm_protected::p_invalidateAreaOwnerMap();
   p_fvterm.p_addLayer(vwin);
 
   // Write changes to the virtual terminal
@@ -2971,7 +3509,6 @@ void FVTermTest::getFVTermAreaTest()
   finalcut::FChar bg_char =
   {
     { L' ', L'\0', L'\0', L'\0', L'\0' },
-    { L'\0', L'\0', L'\0', L'\0', L'\0' },
     finalcut::FColor::Default,
     finalcut::FColor::Default,
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
@@ -81,12 +81,6 @@ void showFCharData (const finalcut::FChar& fchar)
                           uInt32(fchar.ch[2]) << L", " <<
                           uInt32(fchar.ch[3]) << L", " <<
                           uInt32(fchar.ch[4]) << L"}\n";
-  std::wcout << L"               encoded_char: '" <<  fchar.encoded_char.data();
-  std::wcout << L"' {" << uInt32(fchar.encoded_char[0]) << L", " <<
-                          uInt32(fchar.encoded_char[1]) << L", " <<
-                          uInt32(fchar.encoded_char[2]) << L", " <<
-                          uInt32(fchar.encoded_char[3]) << L", " <<
-                          uInt32(fchar.encoded_char[4]) << L"}\n";
   std::wcout << L"                   fg_color: " << int(fchar.fg_color) << L'\n';
   std::wcout << L"                   bg_color: " << int(fchar.bg_color) << L'\n';
   std::wcout << L"                    attr[0]: " << int(fchar.attr.byte[0]) << L'\n';
@@ -144,13 +138,20 @@ auto isAreaEqual ( finalcut::FVTerm::FTermArea* area1
     || area1->bottom_shadow != area2->bottom_shadow )
     return false;
 
+  const auto full_width = area1->width + area1->right_shadow;
+
   for (std::size_t i{0U}; i < size1; i++)
   {
-    if ( ! isFCharEqual (area1->data[i], area2->data[i]) )
+    const auto x = int(i) % full_width;
+    const auto y = int(i) / full_width;
+    const auto& fchar1 = area1->getFChar(x, y);
+    const auto& fchar2 = area2->getFChar(x, y);
+
+    if ( ! isFCharEqual (fchar1, fchar2) )
     {
       std::wcout << L"differ: char " << i << L" '"
-                 << area1->data[i].ch[0] << L"' != '"
-                 << area2->data[i].ch[0] << L"'\n";
+                 << fchar1.ch[0] << L"' != '"
+                 << fchar2.ch[0] << L"'\n";
       return false;
     }
   }
@@ -167,7 +168,6 @@ auto isFCharEqual ( const finalcut::FChar& lhs
   attr.bit.printed = true;
 
   return finalcut::isFUnicodeEqual(lhs.ch, rhs.ch)
-      && finalcut::isFUnicodeEqual(lhs.encoded_char, rhs.encoded_char)
       && lhs.fg_color     == rhs.fg_color
       && lhs.bg_color     == rhs.bg_color
       && lhs.attr.byte[0] == rhs.attr.byte[0]
@@ -203,7 +203,7 @@ void printOnArea ( finalcut::FVTerm::FTermArea* area
     area->cursor_y = ay + 1;
   }
 
-  auto& ac = area->data[ay * line_length + ax];  // area character
+  auto& ac = area->getFChar(ax, ay);  // area character
   std::memcpy (&ac, &fchar, sizeof(ac));  // copy character to area
   area->cursor_x = ((ax + 1) % line_length) + 1;
   area->cursor_y = ((ax + 1) / line_length) + area->cursor_y;
@@ -262,7 +262,9 @@ void printArea ( finalcut::FVTerm::FTermArea* area )
 
   for (std::size_t i{0U}; i < size; i++)
   {
-    if ( area->data[i].attr.bit.fullwidth_padding )
+    const auto& fchar = area->getFChar(int(i) % width, int(i) / width);
+
+    if ( fchar.attr.bit.fullwidth_padding )
       continue;
 
     auto col = (i + 1) % width ;
@@ -271,7 +273,7 @@ void printArea ( finalcut::FVTerm::FTermArea* area )
     if ( col == 1 && line < std::size_t(height) )
       std::wcout << L"│";
 
-    auto ch = area->data[i].ch;
+    auto ch = fchar.ch;
 
     if ( ch[0] == L'\0' )
       ch[0] = L' ';
@@ -497,6 +497,11 @@ class FWidgetTest::FSystemTest : public finalcut::FSystem
 #endif
     }
 
+    auto write (int fd, const void* buf, std::size_t count) -> ssize_t override
+    {
+      return ::write(fd, buf, count);
+    }
+
     auto getuid() -> uid_t override
     {
       return 0;